@@ -1,8 +1,24 @@
 #pragma once
 
+#include "../core_functions.h"
+
 namespace sqlite_orm {
     namespace internal {
-        struct rank_t {};
+        /**
+         *  `rank` column of a FTS5 table, or RANK() window function if used with `over(...)`.
+         */
+        struct rank_t {
+            template<class... WArgs>
+            over_t<built_in_window_function_t<int, rank_string>, window_defn_t<WArgs...>> over(WArgs... args) const {
+                return {{{}}, {{std::forward<WArgs>(args)...}}};
+            }
+
+            template<class... WArgs>
+            over_t<built_in_window_function_t<int, rank_string>, window_ref_t>
+            over(const window_t<WArgs...>& window) const {
+                return {{{}}, {window.name}};
+            }
+        };
     }
 
     inline internal::rank_t rank() {
@@ -50,7 +50,7 @@ namespace sqlite_orm {
             void push_back(assign_t<L, R> assign) {
                 auto newContext = this->context;
                 newContext.skip_table_name = true;
-                iterate_ast(assign, this->collector);
+                iterate_ast(assign.lhs, this->collector);
                 std::stringstream ss;
                 ss << serialize(assign.lhs, newContext) << ' ' << assign.serialize() << ' '
                    << serialize(assign.rhs, context);
@@ -68,6 +68,7 @@ namespace sqlite_orm {
             void clear() {
                 this->entries.clear();
                 this->collector.table_names.clear();
+                this->collector.table_schemas.clear();
             }
 
             std::vector<entry_t> entries;
@@ -0,0 +1,185 @@
+#pragma once
+
+#include <string>  //  std::string
+#include <tuple>  //  std::tuple
+#include <utility>  //  std::move, std::forward
+
+#include "../functional/cxx_universal.h"
+#include "../functional/cxx_type_traits_polyfill.h"
+
+namespace sqlite_orm {
+    namespace internal {
+
+        /**
+         *  PARTITION BY pack holder of a window definition.
+         */
+        template<class... Args>
+        struct partition_by_t {
+            using args_type = std::tuple<Args...>;
+
+            args_type args;
+        };
+
+        struct unbounded_preceding_t {};
+
+        struct current_row_t {};
+
+        struct unbounded_following_t {};
+
+        template<class T>
+        struct preceding_t {
+            using expression_type = T;
+
+            expression_type expression;
+        };
+
+        template<class T>
+        struct following_t {
+            using expression_type = T;
+
+            expression_type expression;
+        };
+
+        enum class frame_units {
+            rows,
+            range,
+            groups,
+        };
+
+        /**
+         *  Frame specification of a window definition: `ROWS|RANGE|GROUPS BETWEEN start AND end`.
+         */
+        template<class B, class E>
+        struct frame_t {
+            using start_type = B;
+            using end_type = E;
+
+            frame_units units;
+            start_type start;
+            end_type end;
+        };
+
+        /**
+         *  Window definition: `([PARTITION BY ...] [ORDER BY ...] [frame])`.
+         *  Args are `partition_by_t`, `order_by_t`/`multi_order_by_t` and `frame_t` in this order.
+         */
+        template<class... Args>
+        struct window_defn_t {
+            using args_type = std::tuple<Args...>;
+
+            args_type args;
+        };
+
+        /**
+         *  Named window definition of a WINDOW clause.
+         *  Don't construct it manually, call `window(...)` function instead.
+         */
+        template<class... Args>
+        struct window_t {
+            using definition_type = window_defn_t<Args...>;
+
+            std::string name;
+            definition_type definition;
+        };
+
+        template<class T>
+        using is_window = polyfill::is_specialization_of<T, window_t>;
+
+        /**
+         *  Reference to a named window from an OVER clause.
+         */
+        struct window_ref_t {
+            std::string name;
+        };
+
+        /**
+         *  Window function or aggregate function used as a window function: `function OVER window`.
+         *  W is either `window_defn_t` or `window_ref_t`.
+         */
+        template<class F, class W>
+        struct over_t {
+            using function_type = F;
+            using window_type = W;
+
+            function_type function;
+            window_type window;
+        };
+    }
+
+    /**
+     *  PARTITION BY clause of a window definition.
+     *  Example: storage.select(columns(&Employee::name, rank().over(partition_by(&Employee::department),
+     *                                                               order_by(&Employee::salary).desc()))));
+     */
+    template<class... Args>
+    internal::partition_by_t<Args...> partition_by(Args... args) {
+        return {{std::forward<Args>(args)...}};
+    }
+
+    inline internal::unbounded_preceding_t unbounded_preceding() {
+        return {};
+    }
+
+    /**
+     *  `expression PRECEDING` frame boundary.
+     */
+    template<class T>
+    internal::preceding_t<T> preceding(T expression) {
+        return {std::move(expression)};
+    }
+
+    inline internal::current_row_t current_row() {
+        return {};
+    }
+
+    /**
+     *  `expression FOLLOWING` frame boundary.
+     */
+    template<class T>
+    internal::following_t<T> following(T expression) {
+        return {std::move(expression)};
+    }
+
+    inline internal::unbounded_following_t unbounded_following() {
+        return {};
+    }
+
+    /**
+     *  ROWS frame of a window definition, e.g. a running total:
+     *  sum(&Sale::amount).over(order_by(&Sale::date), rows(unbounded_preceding(), current_row()))
+     *  The frame ends with the current row if `end` is omitted.
+     */
+    template<class B, class E = internal::current_row_t>
+    internal::frame_t<B, E> rows(B start, E end = {}) {
+        return {internal::frame_units::rows, std::move(start), std::move(end)};
+    }
+
+    /**
+     *  RANGE frame of a window definition. The frame ends with the current row if `end` is omitted.
+     */
+    template<class B, class E = internal::current_row_t>
+    internal::frame_t<B, E> range(B start, E end = {}) {
+        return {internal::frame_units::range, std::move(start), std::move(end)};
+    }
+
+    /**
+     *  GROUPS frame of a window definition (SQLite 3.28.0). The frame ends with the current row if `end` is omitted.
+     */
+    template<class B, class E = internal::current_row_t>
+    internal::frame_t<B, E> groups(B start, E end = {}) {
+        return {internal::frame_units::groups, std::move(start), std::move(end)};
+    }
+
+    /**
+     *  Named window definition of the WINDOW clause which is referred to by `over(window)`.
+     *  Pass it to `select()` among the conditions; all windows passed make up one WINDOW clause, which is put after
+     *  WHERE/GROUP BY/HAVING and before ORDER BY/LIMIT regardless of their positions.
+     *  Example:
+     *  auto byDepartment = window("d", partition_by(&Employee::department), order_by(&Employee::salary));
+     *  storage.select(columns(rank().over(byDepartment), sum(&Employee::salary).over(byDepartment)), byDepartment);
+     */
+    template<class... Args>
+    internal::window_t<Args...> window(std::string name, Args... args) {
+        return {std::move(name), {{std::forward<Args>(args)...}}};
+    }
+}
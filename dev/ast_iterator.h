@@ -3,6 +3,7 @@
 #include <vector>  //  std::vector
 #include <functional>  //  std::reference_wrapper
 
+#include "tuple_helper/tuple_filter.h"
 #include "tuple_helper/tuple_iteration.h"
 #include "type_traits.h"
 #include "conditions.h"
@@ -21,6 +22,7 @@
 #include "ast/exists.h"
 #include "ast/set.h"
 #include "ast/match.h"
+#include "range_source.h"
 
 namespace sqlite_orm {
 
@@ -96,6 +98,21 @@ namespace sqlite_orm {
             }
         };
 
+#if SQLITE_VERSION_NUMBER >= 3020000
+        /**
+         *  The range is bound by pointer to the view stored in the node, which lives as long as the statement.
+         */
+        template<class O>
+        struct ast_iterator<range_source_t<O>, void> {
+            using node_type = range_source_t<O>;
+
+            template<class L>
+            void operator()(const node_type& node, L& lambda) const {
+                lambda(bind_pointer_statically<range_pointer_type>(&node.view));
+            }
+        };
+#endif
+
         template<class... Args>
         struct ast_iterator<group_by_t<Args...>, void> {
             using node_type = group_by_t<Args...>;
@@ -296,10 +313,51 @@ namespace sqlite_orm {
             template<class L>
             void operator()(const node_type& sel, L& lambda) const {
                 iterate_ast(sel.col, lambda);
-                iterate_ast(sel.conditions, lambda);
+                using conditions_type = typename node_type::conditions_type;
+                this->iterate_conditions(sel.conditions,
+                                         lambda,
+                                         polyfill::bool_constant<tuple_has<conditions_type, is_window>::value>{});
+            }
+
+          private:
+            template<class L>
+            static void iterate_conditions(const typename node_type::conditions_type& conditions,
+                                           L& lambda,
+                                           std::false_type) {
+                iterate_ast(conditions, lambda);
+            }
+
+            /**
+             *  The serializer moves the WINDOW clause before ORDER BY and LIMIT,
+             *  bindables have to be visited in the same order.
+             */
+            template<class L>
+            static void iterate_conditions(const typename node_type::conditions_type& conditions,
+                                           L& lambda,
+                                           std::true_type) {
+                using conditions_type = typename node_type::conditions_type;
+                auto visit = [&lambda](auto& condition) {
+                    iterate_ast(condition, lambda);
+                };
+                iterate_tuple(conditions, filter_tuple_sequence_t<conditions_type, is_window_predecessor>{}, visit);
+                iterate_tuple(conditions, filter_tuple_sequence_t<conditions_type, is_window>{}, visit);
+                iterate_tuple(conditions, filter_tuple_sequence_t<conditions_type, is_window_successor>{}, visit);
             }
         };
 
+#if SQLITE_VERSION_NUMBER >= 3035000
+        template<class S, class C>
+        struct ast_iterator<returning_t<S, C>, void> {
+            using node_type = returning_t<S, C>;
+
+            template<class L>
+            void operator()(const node_type& node, L& lambda) const {
+                iterate_ast(node.statement, lambda);
+                iterate_ast(node.columns, lambda);
+            }
+        };
+#endif
+
         template<class T, class R, class... Args>
         struct ast_iterator<get_all_t<T, R, Args...>, void> {
             using node_type = get_all_t<T, R, Args...>;
@@ -534,6 +592,88 @@ namespace sqlite_orm {
             }
         };
 
+        template<class R, class S, class... Args>
+        struct ast_iterator<built_in_window_function_t<R, S, Args...>, void> {
+            using node_type = built_in_window_function_t<R, S, Args...>;
+
+            template<class L>
+            void operator()(const node_type& node, L& lambda) const {
+                iterate_ast(node.args, lambda);
+            }
+        };
+
+        template<class F, class W>
+        struct ast_iterator<over_t<F, W>, void> {
+            using node_type = over_t<F, W>;
+
+            template<class L>
+            void operator()(const node_type& node, L& lambda) const {
+                iterate_ast(node.function, lambda);
+                iterate_ast(node.window, lambda);
+            }
+        };
+
+        template<class... Args>
+        struct ast_iterator<window_defn_t<Args...>, void> {
+            using node_type = window_defn_t<Args...>;
+
+            template<class L>
+            void operator()(const node_type& node, L& lambda) const {
+                iterate_ast(node.args, lambda);
+            }
+        };
+
+        template<class... Args>
+        struct ast_iterator<window_t<Args...>, void> {
+            using node_type = window_t<Args...>;
+
+            template<class L>
+            void operator()(const node_type& node, L& lambda) const {
+                iterate_ast(node.definition, lambda);
+            }
+        };
+
+        template<class... Args>
+        struct ast_iterator<partition_by_t<Args...>, void> {
+            using node_type = partition_by_t<Args...>;
+
+            template<class L>
+            void operator()(const node_type& node, L& lambda) const {
+                iterate_ast(node.args, lambda);
+            }
+        };
+
+        template<class B, class E>
+        struct ast_iterator<frame_t<B, E>, void> {
+            using node_type = frame_t<B, E>;
+
+            template<class L>
+            void operator()(const node_type& node, L& lambda) const {
+                iterate_ast(node.start, lambda);
+                iterate_ast(node.end, lambda);
+            }
+        };
+
+        template<class T>
+        struct ast_iterator<preceding_t<T>, void> {
+            using node_type = preceding_t<T>;
+
+            template<class L>
+            void operator()(const node_type& node, L& lambda) const {
+                iterate_ast(node.expression, lambda);
+            }
+        };
+
+        template<class T>
+        struct ast_iterator<following_t<T>, void> {
+            using node_type = following_t<T>;
+
+            template<class L>
+            void operator()(const node_type& node, L& lambda) const {
+                iterate_ast(node.expression, lambda);
+            }
+        };
+
         template<class Join>
         struct ast_iterator<Join, match_if<is_constrained_join, Join>> {
             using node_type = Join;
@@ -5,12 +5,52 @@
 #include <string>  //  std::string
 #include <memory>
 #include <utility>  //  std::move, std::exchange
+#include <chrono>  //  std::chrono::milliseconds
+#include <functional>  //  std::function
 
 #include "error_code.h"
 #include "connection_holder.h"
+#include "cancellation_token.h"
 
 namespace sqlite_orm {
 
+    /**
+     *  State of a backup started with `storage.start_backup()`, reported after each batch of pages.
+     */
+    struct backup_progress {
+        int remaining = 0;
+        int pagecount = 0;
+
+        /**
+         *  Number of times the copy started over because another connection changed the source database.
+         */
+        int restarts = 0;
+    };
+
+    struct backup_options {
+
+        /**
+         *  Number of pages copied in one batch, the source database is locked while a batch is copied.
+         */
+        int pages_per_step = 1024;
+
+        /**
+         *  Pause between two batches, caps the I/O bandwidth to `pages_per_step` pages per pause.
+         */
+        std::chrono::milliseconds sleep{10};
+
+        /**
+         *  Called from the backup thread after every batch.
+         */
+        std::function<void(const backup_progress&)> on_progress;
+
+        /**
+         *  Stops the backup before its next batch, the future then throws
+         *  `std::system_error{orm_error_code::backup_cancelled}`.
+         */
+        cancellation_token cancellation;
+    };
+
     namespace internal {
 
         /**
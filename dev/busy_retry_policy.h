@@ -0,0 +1,60 @@
+#pragma once
+
+#include <chrono>  //  std::chrono::microseconds, std::chrono::duration_cast
+#include <algorithm>  //  std::min
+
+#include "functional/cxx_universal.h"  //  ::int64
+
+namespace sqlite_orm {
+
+    /**
+     *  Describes how a storage reacts to SQLITE_BUSY, see `storage.retry_on_busy()`.
+     *  The delay before retry number `n` (starting with 1) is
+     *  `min(initial_backoff * multiplier^(n - 1), max_backoff)`, of which a random fraction up to `jitter`
+     *  is subtracted so that competing processes don't retry in lockstep.
+     */
+    struct busy_retry_policy {
+        /**
+         *  Total number of attempts including the first one. 1 means no retries.
+         */
+        int max_attempts = 5;
+        std::chrono::microseconds initial_backoff{1000};
+        std::chrono::microseconds max_backoff{100000};
+        double multiplier = 2;
+        double jitter = 0.5;
+
+        /**
+         *  @param retry number of the retry, starting with 1
+         *  @param random a random value in [0, 1)
+         */
+        std::chrono::microseconds backoff(int retry, double random) const {
+            double delay = double(this->initial_backoff.count());
+            for(int i = 1; i < retry && delay < double(this->max_backoff.count()); ++i) {
+                delay *= this->multiplier;
+            }
+            delay = (std::min)(delay, double(this->max_backoff.count()));
+            delay -= delay * this->jitter * random;
+            return std::chrono::microseconds{int64(delay)};
+        }
+    };
+
+    /**
+     *  Counters collected while retrying on SQLITE_BUSY, see `storage.busy_retry_stats()`.
+     */
+    struct busy_retry_stats {
+        /**
+         *  Number of times a lock was waited for by the busy handler.
+         */
+        int64 retries = 0;
+
+        /**
+         *  Number of times a whole `storage.transaction(f)` was started over.
+         */
+        int64 transaction_retries = 0;
+
+        /**
+         *  Accumulated time spent sleeping between retries.
+         */
+        std::chrono::microseconds wait_time{0};
+    };
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <atomic>  //  std::atomic_bool
+#include <memory>  //  std::shared_ptr, std::make_shared
+
+namespace sqlite_orm {
+
+    /**
+     *  A token used to cancel queries run inside `storage.with_cancellation(token, f)`.
+     *  Copies share the same state, so a copy can be handed over to another thread which calls `cancel()`.
+     *  The running statement is then interrupted at its next progress handler invocation
+     *  and `with_cancellation` throws `std::system_error{orm_error_code::query_cancelled}`.
+     */
+    struct cancellation_token {
+        void cancel() noexcept {
+            this->cancelled->store(true);
+        }
+
+        bool is_cancelled() const noexcept {
+            return this->cancelled->load();
+        }
+
+        /**
+         *  Makes the token usable again after a cancellation.
+         */
+        void reset() noexcept {
+            this->cancelled->store(false);
+        }
+
+      private:
+        std::shared_ptr<std::atomic_bool> cancelled = std::make_shared<std::atomic_bool>(false);
+    };
+}
@@ -124,6 +124,24 @@ namespace sqlite_orm {
             using type = std::unique_ptr<column_result_of_t<DBOs, X>>;
         };
 
+        template<class DBOs, class F, class W>
+        struct column_result_t<DBOs, filtered_aggregate_function<F, W>, void> : column_result_t<DBOs, F> {};
+
+        template<class DBOs, class F, class W>
+        struct column_result_t<DBOs, over_t<F, W>, void> : column_result_t<DBOs, F> {};
+
+        template<class DBOs, class R, class S, class... Args, class W>
+        struct column_result_t<DBOs, over_t<built_in_window_function_t<R, S, Args...>, W>, void> {
+            using type = R;
+        };
+
+        template<class DBOs, class X, class... Rest, class S, class W>
+        struct column_result_t<DBOs,
+                               over_t<built_in_window_function_t<unique_ptr_result_of<X>, S, X, Rest...>, W>,
+                               void> {
+            using type = std::unique_ptr<column_result_of_t<DBOs, X>>;
+        };
+
         template<class DBOs, class T>
         struct column_result_t<DBOs, count_asterisk_t<T>, void> {
             using type = int;
@@ -470,6 +470,12 @@ namespace sqlite_orm {
         template<class T>
         struct is_primary_key : polyfill::bool_constant<is_primary_key_v<T>> {};
 
+        template<class T>
+        SQLITE_ORM_INLINE_VAR constexpr bool is_unique_v = std::is_base_of<unique_base, T>::value;
+
+        template<class T>
+        struct is_unique : polyfill::bool_constant<is_unique_v<T>> {};
+
         template<class T>
         SQLITE_ORM_INLINE_VAR constexpr bool is_generated_always_v =
 #if SQLITE_VERSION_NUMBER >= 3031000
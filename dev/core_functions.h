@@ -16,6 +16,7 @@
 #include "tags.h"
 #include "table_reference.h"
 #include "ast/into.h"
+#include "ast/window.h"
 
 namespace sqlite_orm {
 
@@ -53,6 +54,11 @@ namespace sqlite_orm {
         template<class T>
         struct is_built_in_function : polyfill::bool_constant<is_built_in_function_v<T>> {};
 
+        /**
+         *  Aggregate function with a FILTER clause: `function FILTER (WHERE expression)`.
+         *  Only the rows for which `where` is true are aggregated, so several differently filtered aggregates
+         *  can be computed with a single scan.
+         */
         template<class F, class W>
         struct filtered_aggregate_function {
             using function_type = F;
@@ -60,6 +66,16 @@ namespace sqlite_orm {
 
             function_type function;
             where_expression where;
+
+            template<class... WArgs>
+            over_t<filtered_aggregate_function<F, W>, window_defn_t<WArgs...>> over(WArgs... args) {
+                return {*this, {{std::forward<WArgs>(args)...}}};
+            }
+
+            template<class... WArgs>
+            over_t<filtered_aggregate_function<F, W>, window_ref_t> over(const window_t<WArgs...>& window) {
+                return {*this, {window.name}};
+            }
         };
 
         template<class C>
@@ -75,6 +91,39 @@ namespace sqlite_orm {
             filtered_aggregate_function<built_in_aggregate_function_t<R, S, Args...>, W> filter(where_t<W> wh) {
                 return {*this, std::move(wh.expression)};
             }
+
+            /**
+             *  Use the aggregate function as a window function.
+             */
+            template<class... WArgs>
+            over_t<built_in_aggregate_function_t<R, S, Args...>, window_defn_t<WArgs...>> over(WArgs... args) {
+                return {*this, {{std::forward<WArgs>(args)...}}};
+            }
+
+            template<class... WArgs>
+            over_t<built_in_aggregate_function_t<R, S, Args...>, window_ref_t> over(const window_t<WArgs...>& window) {
+                return {*this, {window.name}};
+            }
+        };
+
+        /**
+         *  Function that can only be called as a window function, i.e. with `over(...)`.
+         */
+        template<class R, class S, class... Args>
+        struct built_in_window_function_t : built_in_function_t<R, S, Args...> {
+            using super = built_in_function_t<R, S, Args...>;
+
+            using super::super;
+
+            template<class... WArgs>
+            over_t<built_in_window_function_t<R, S, Args...>, window_defn_t<WArgs...>> over(WArgs... args) {
+                return {*this, {{std::forward<WArgs>(args)...}}};
+            }
+
+            template<class... WArgs>
+            over_t<built_in_window_function_t<R, S, Args...>, window_ref_t> over(const window_t<WArgs...>& window) {
+                return {*this, {window.name}};
+            }
         };
 
         struct typeof_string {
@@ -297,6 +346,16 @@ namespace sqlite_orm {
             filtered_aggregate_function<count_asterisk_t<T>, W> filter(where_t<W> wh) {
                 return {*this, std::move(wh.expression)};
             }
+
+            template<class... WArgs>
+            over_t<count_asterisk_t<T>, window_defn_t<WArgs...>> over(WArgs... args) {
+                return {*this, {{std::forward<WArgs>(args)...}}};
+            }
+
+            template<class... WArgs>
+            over_t<count_asterisk_t<T>, window_ref_t> over(const window_t<WArgs...>& window) {
+                return {*this, {window.name}};
+            }
         };
 
         /**
@@ -319,7 +378,12 @@ namespace sqlite_orm {
          *          group_by(&Customer::grade),
          *          having(greater_than(count(), 2))))));
          */
-        struct count_asterisk_without_type : count_string {};
+        struct count_asterisk_without_type : count_string {
+            template<class W>
+            filtered_aggregate_function<count_asterisk_without_type, W> filter(where_t<W> wh) {
+                return {*this, std::move(wh.expression)};
+            }
+        };
 
         struct avg_string {
             serialize_result_type serialize() const {
@@ -344,6 +408,72 @@ namespace sqlite_orm {
                 return "GROUP_CONCAT";
             }
         };
+
+        struct row_number_string {
+            serialize_result_type serialize() const {
+                return "ROW_NUMBER";
+            }
+        };
+
+        struct rank_string {
+            serialize_result_type serialize() const {
+                return "RANK";
+            }
+        };
+
+        struct dense_rank_string {
+            serialize_result_type serialize() const {
+                return "DENSE_RANK";
+            }
+        };
+
+        struct percent_rank_string {
+            serialize_result_type serialize() const {
+                return "PERCENT_RANK";
+            }
+        };
+
+        struct cume_dist_string {
+            serialize_result_type serialize() const {
+                return "CUME_DIST";
+            }
+        };
+
+        struct ntile_string {
+            serialize_result_type serialize() const {
+                return "NTILE";
+            }
+        };
+
+        struct lag_string {
+            serialize_result_type serialize() const {
+                return "LAG";
+            }
+        };
+
+        struct lead_string {
+            serialize_result_type serialize() const {
+                return "LEAD";
+            }
+        };
+
+        struct first_value_string {
+            serialize_result_type serialize() const {
+                return "FIRST_VALUE";
+            }
+        };
+
+        struct last_value_string {
+            serialize_result_type serialize() const {
+                return "LAST_VALUE";
+            }
+        };
+
+        struct nth_value_string {
+            serialize_result_type serialize() const {
+                return "NTH_VALUE";
+            }
+        };
 #ifdef SQLITE_ENABLE_MATH_FUNCTIONS
         struct acos_string {
             serialize_result_type serialize() const {
@@ -1915,6 +2045,93 @@ namespace sqlite_orm {
     internal::built_in_aggregate_function_t<std::string, internal::group_concat_string, X, Y> group_concat(X x, Y y) {
         return {std::tuple<X, Y>{std::forward<X>(x), std::forward<Y>(y)}};
     }
+
+    /**
+     *  ROW_NUMBER() window function https://www.sqlite.org/windowfunctions.html#built_in_window_functions
+     */
+    inline internal::built_in_window_function_t<int, internal::row_number_string> row_number() {
+        return {{}};
+    }
+
+    /**
+     *  DENSE_RANK() window function. RANK() is `rank().over(...)`.
+     */
+    inline internal::built_in_window_function_t<int, internal::dense_rank_string> dense_rank() {
+        return {{}};
+    }
+
+    /**
+     *  PERCENT_RANK() window function.
+     */
+    inline internal::built_in_window_function_t<double, internal::percent_rank_string> percent_rank() {
+        return {{}};
+    }
+
+    /**
+     *  CUME_DIST() window function.
+     */
+    inline internal::built_in_window_function_t<double, internal::cume_dist_string> cume_dist() {
+        return {{}};
+    }
+
+    /**
+     *  NTILE(N) window function.
+     */
+    template<class N>
+    internal::built_in_window_function_t<int, internal::ntile_string, N> ntile(N n) {
+        return {std::tuple<N>{std::forward<N>(n)}};
+    }
+
+    /**
+     *  LAG(X, ...) window function. Optional arguments are the offset (1 by default) and
+     *  the default value returned if there is no such row (NULL by default).
+     *  The return type is the type of the first argument.
+     */
+    template<class X, class... Args>
+    internal::built_in_window_function_t<internal::unique_ptr_result_of<X>, internal::lag_string, X, Args...>
+    lag(X x, Args... args) {
+        static_assert(sizeof...(Args) <= 2, "lag accepts an offset and a default value besides the expression");
+        return {std::tuple<X, Args...>{std::forward<X>(x), std::forward<Args>(args)...}};
+    }
+
+    /**
+     *  LEAD(X, ...) window function. Optional arguments are the offset (1 by default) and
+     *  the default value returned if there is no such row (NULL by default).
+     *  The return type is the type of the first argument.
+     */
+    template<class X, class... Args>
+    internal::built_in_window_function_t<internal::unique_ptr_result_of<X>, internal::lead_string, X, Args...>
+    lead(X x, Args... args) {
+        static_assert(sizeof...(Args) <= 2, "lead accepts an offset and a default value besides the expression");
+        return {std::tuple<X, Args...>{std::forward<X>(x), std::forward<Args>(args)...}};
+    }
+
+    /**
+     *  FIRST_VALUE(X) window function.
+     */
+    template<class X>
+    internal::built_in_window_function_t<internal::unique_ptr_result_of<X>, internal::first_value_string, X>
+    first_value(X x) {
+        return {std::tuple<X>{std::forward<X>(x)}};
+    }
+
+    /**
+     *  LAST_VALUE(X) window function.
+     */
+    template<class X>
+    internal::built_in_window_function_t<internal::unique_ptr_result_of<X>, internal::last_value_string, X>
+    last_value(X x) {
+        return {std::tuple<X>{std::forward<X>(x)}};
+    }
+
+    /**
+     *  NTH_VALUE(X, N) window function.
+     */
+    template<class X, class N>
+    internal::built_in_window_function_t<internal::unique_ptr_result_of<X>, internal::nth_value_string, X, N>
+    nth_value(X x, N n) {
+        return {std::tuple<X, N>{std::forward<X>(x), std::forward<N>(n)}};
+    }
 #ifdef SQLITE_ENABLE_JSON1
     template<class X>
     internal::built_in_function_t<std::string, internal::json_string, X> json(X x) {
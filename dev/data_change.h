@@ -0,0 +1,24 @@
+#pragma once
+
+#include <memory>  //  std::unique_ptr
+
+#include "functional/cxx_universal.h"  //  ::int64
+
+namespace sqlite_orm {
+
+#ifdef SQLITE_ENABLE_PREUPDATE_HOOK
+    /**
+     *  A row change of a table mapped to `O`, reported by `storage.on_preupdate<O>()` before it is applied.
+     *  `operation` is SQLITE_INSERT, SQLITE_UPDATE or SQLITE_DELETE.
+     *  `old_object` is set for updates and deletes, `new_object` for inserts and updates.
+     */
+    template<class O>
+    struct preupdate_change {
+        int operation = 0;
+        int64 old_rowid = 0;
+        int64 new_rowid = 0;
+        std::unique_ptr<O> old_object;
+        std::unique_ptr<O> new_object;
+    };
+#endif
+}
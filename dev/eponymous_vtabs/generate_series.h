@@ -0,0 +1,38 @@
+#pragma once
+
+#include "../functional/cxx_universal.h"  //  ::int64
+#include "../schema/column.h"
+#include "../schema/table.h"
+
+namespace sqlite_orm {
+    /**
+     *  Row of the `generate_series` table-valued function https://www.sqlite.org/series.html
+     *  which yields the integers from `start` to `stop` by `step`.
+     *  It comes with the `series` extension rather than with every build of SQLite,
+     *  so it is mapped unconditionally and queries fail with "no such table" if it isn't available.
+     *
+     *  `start`, `stop` and `step` are the hidden columns which take the function arguments:
+     *  `generate_series(1, 10, 2)` is the same as the constraints
+     *  `generate_series.start = 1 AND generate_series.stop = 10 AND generate_series.step = 2`.
+     *  E.g. filling the gaps of daily totals:
+     *  storage.select(columns(&generate_series::value, coalesce<double>(sum(&Sale::amount), 0)),
+     *                 from<generate_series>(),
+     *                 left_join<Sale>(on(c(&Sale::day) == &generate_series::value)),
+     *                 where(c(&generate_series::start) == firstDay and c(&generate_series::stop) == lastDay),
+     *                 group_by(&generate_series::value));
+     */
+    struct generate_series {
+        int64 value = 0;
+        int64 start = 0;
+        int64 stop = 0;
+        int64 step = 0;
+    };
+
+    inline auto make_generate_series_table() {
+        return make_table("generate_series",
+                          make_column("value", &generate_series::value),
+                          make_column("start", &generate_series::start),
+                          make_column("stop", &generate_series::stop),
+                          make_column("step", &generate_series::step));
+    }
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#ifdef SQLITE_ENABLE_JSON1
+#include <string>  //  std::string
+#include <memory>  //  std::unique_ptr
+#endif
+
+#include "../schema/column.h"
+#include "../schema/table.h"
+
+namespace sqlite_orm {
+#ifdef SQLITE_ENABLE_JSON1
+    /**
+     *  Row of the `json_each` table-valued function https://www.sqlite.org/json1.html#jeach
+     *  which walks the immediate children of the top-level array or object of a JSON document.
+     *
+     *  `json` and `root` are the hidden columns which take the function arguments:
+     *  `json_each(X)` is the same as the constraint `json_each.json = X`. E.g. unnesting the tags of users:
+     *  storage.select(columns(&User::id, &json_each::value),
+     *                 from<User>(),
+     *                 cross_join<json_each>(),
+     *                 where(c(&json_each::json) == &User::tags));
+     *  `key` is null for the top-level element, `value` for JSON nulls and `atom` for arrays and objects.
+     */
+    struct json_each {
+        std::unique_ptr<std::string> key;
+        std::unique_ptr<std::string> value;
+        std::string type;
+        std::unique_ptr<std::string> atom;
+        int id = 0;
+        std::unique_ptr<int> parent;
+        std::string fullkey;
+        std::string path;
+        std::string json;
+        std::string root;
+    };
+
+    inline auto make_json_each_table() {
+        return make_table("json_each",
+                          make_column("key", &json_each::key),
+                          make_column("value", &json_each::value),
+                          make_column("type", &json_each::type),
+                          make_column("atom", &json_each::atom),
+                          make_column("id", &json_each::id),
+                          make_column("parent", &json_each::parent),
+                          make_column("fullkey", &json_each::fullkey),
+                          make_column("path", &json_each::path),
+                          make_column("json", &json_each::json),
+                          make_column("root", &json_each::root));
+    }
+#endif  //  SQLITE_ENABLE_JSON1
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#ifdef SQLITE_ENABLE_JSON1
+#include <string>  //  std::string
+#include <memory>  //  std::unique_ptr
+#endif
+
+#include "../schema/column.h"
+#include "../schema/table.h"
+
+namespace sqlite_orm {
+#ifdef SQLITE_ENABLE_JSON1
+    /**
+     *  Row of the `json_tree` table-valued function https://www.sqlite.org/json1.html#jtree
+     *  which recursively walks all elements of a JSON document, the top-level element included.
+     *
+     *  `json` and `root` are the hidden columns which take the function arguments:
+     *  `json_tree(X)` is the same as the constraint `json_tree.json = X`. E.g. all leaves of the settings of users:
+     *  storage.select(columns(&User::id, &json_tree::fullkey, &json_tree::value),
+     *                 from<User>(),
+     *                 cross_join<json_tree>(),
+     *                 where(c(&json_tree::json) == &User::settings and is_not_null(&json_tree::atom)));
+     *  `key` is null for the top-level element, `value` for JSON nulls and `atom` for arrays and objects.
+     */
+    struct json_tree {
+        std::unique_ptr<std::string> key;
+        std::unique_ptr<std::string> value;
+        std::string type;
+        std::unique_ptr<std::string> atom;
+        int id = 0;
+        std::unique_ptr<int> parent;
+        std::string fullkey;
+        std::string path;
+        std::string json;
+        std::string root;
+    };
+
+    inline auto make_json_tree_table() {
+        return make_table("json_tree",
+                          make_column("key", &json_tree::key),
+                          make_column("value", &json_tree::value),
+                          make_column("type", &json_tree::type),
+                          make_column("atom", &json_tree::atom),
+                          make_column("id", &json_tree::id),
+                          make_column("parent", &json_tree::parent),
+                          make_column("fullkey", &json_tree::fullkey),
+                          make_column("path", &json_tree::path),
+                          make_column("json", &json_tree::json),
+                          make_column("root", &json_tree::root));
+    }
+#endif  //  SQLITE_ENABLE_JSON1
+}
@@ -0,0 +1,159 @@
+#pragma once
+
+#if SQLITE_VERSION_NUMBER >= 3016000
+#include <string>  //  std::string
+#include <memory>  //  std::unique_ptr
+#include <type_traits>  //  std::is_same
+#endif
+
+#include "../functional/cxx_type_traits_polyfill.h"
+#include "../schema/column.h"
+#include "../schema/table.h"
+
+namespace sqlite_orm {
+#if SQLITE_VERSION_NUMBER >= 3016000
+    /**
+     *  Rows of the table-valued pragma functions https://www.sqlite.org/pragma.html#pragfunc
+     *  which run schema introspection pragmas inside queries.
+     *  `arg` and `schema` are the hidden columns which take the pragma argument and the database name:
+     *  `pragma_table_info('users')` is the same as the constraint `pragma_table_info.arg = 'users'`.
+     *  E.g. all indexed columns of the main database:
+     *  storage.select(columns(&sqlite_master::tbl_name, &pragma_index_info::name),
+     *                 from<sqlite_master>(),
+     *                 cross_join<pragma_index_info>(),
+     *                 where(c(&sqlite_master::type) == "index" and
+     *                       c(&pragma_index_info::arg) == &sqlite_master::name));
+     *  `dflt_value` is null for columns without a default value.
+     */
+
+    struct pragma_table_info {
+        int cid = 0;
+        std::string name;
+        std::string type;
+        bool notnull = false;
+        std::unique_ptr<std::string> dflt_value;
+        int pk = 0;
+        std::string arg;
+        std::string schema;
+    };
+
+    inline auto make_pragma_table_info_table() {
+        return make_table("pragma_table_info",
+                          make_column("cid", &pragma_table_info::cid),
+                          make_column("name", &pragma_table_info::name),
+                          make_column("type", &pragma_table_info::type),
+                          make_column("notnull", &pragma_table_info::notnull),
+                          make_column("dflt_value", &pragma_table_info::dflt_value),
+                          make_column("pk", &pragma_table_info::pk),
+                          make_column("arg", &pragma_table_info::arg),
+                          make_column("schema", &pragma_table_info::schema));
+    }
+
+#if SQLITE_VERSION_NUMBER >= 3026000
+    /**
+     *  Same as `pragma_table_info` plus the hidden columns of virtual tables and generated columns,
+     *  available since SQLite 3.26.0.
+     */
+    struct pragma_table_xinfo {
+        int cid = 0;
+        std::string name;
+        std::string type;
+        bool notnull = false;
+        std::unique_ptr<std::string> dflt_value;
+        int pk = 0;
+        int hidden = 0;
+        std::string arg;
+        std::string schema;
+    };
+
+    inline auto make_pragma_table_xinfo_table() {
+        return make_table("pragma_table_xinfo",
+                          make_column("cid", &pragma_table_xinfo::cid),
+                          make_column("name", &pragma_table_xinfo::name),
+                          make_column("type", &pragma_table_xinfo::type),
+                          make_column("notnull", &pragma_table_xinfo::notnull),
+                          make_column("dflt_value", &pragma_table_xinfo::dflt_value),
+                          make_column("pk", &pragma_table_xinfo::pk),
+                          make_column("hidden", &pragma_table_xinfo::hidden),
+                          make_column("arg", &pragma_table_xinfo::arg),
+                          make_column("schema", &pragma_table_xinfo::schema));
+    }
+#endif
+
+    struct pragma_index_list {
+        int seq = 0;
+        std::string name;
+        bool unique = false;
+        std::string origin;
+        bool partial = false;
+        std::string arg;
+        std::string schema;
+    };
+
+    inline auto make_pragma_index_list_table() {
+        return make_table("pragma_index_list",
+                          make_column("seq", &pragma_index_list::seq),
+                          make_column("name", &pragma_index_list::name),
+                          make_column("unique", &pragma_index_list::unique),
+                          make_column("origin", &pragma_index_list::origin),
+                          make_column("partial", &pragma_index_list::partial),
+                          make_column("arg", &pragma_index_list::arg),
+                          make_column("schema", &pragma_index_list::schema));
+    }
+
+    struct pragma_index_info {
+        int seqno = 0;
+        int cid = 0;
+        std::string name;
+        std::string arg;
+        std::string schema;
+    };
+
+    inline auto make_pragma_index_info_table() {
+        return make_table("pragma_index_info",
+                          make_column("seqno", &pragma_index_info::seqno),
+                          make_column("cid", &pragma_index_info::cid),
+                          make_column("name", &pragma_index_info::name),
+                          make_column("arg", &pragma_index_info::arg),
+                          make_column("schema", &pragma_index_info::schema));
+    }
+
+    struct pragma_foreign_key_list {
+        int id = 0;
+        int seq = 0;
+        std::string table;
+        std::string from;
+        std::string to;
+        std::string on_update;
+        std::string on_delete;
+        std::string match;
+        std::string arg;
+        std::string schema;
+    };
+
+    inline auto make_pragma_foreign_key_list_table() {
+        return make_table("pragma_foreign_key_list",
+                          make_column("id", &pragma_foreign_key_list::id),
+                          make_column("seq", &pragma_foreign_key_list::seq),
+                          make_column("table", &pragma_foreign_key_list::table),
+                          make_column("from", &pragma_foreign_key_list::from),
+                          make_column("to", &pragma_foreign_key_list::to),
+                          make_column("on_update", &pragma_foreign_key_list::on_update),
+                          make_column("on_delete", &pragma_foreign_key_list::on_delete),
+                          make_column("match", &pragma_foreign_key_list::match),
+                          make_column("arg", &pragma_foreign_key_list::arg),
+                          make_column("schema", &pragma_foreign_key_list::schema));
+    }
+
+    namespace internal {
+        template<class O>
+        using is_pragma_function = polyfill::disjunction<std::is_same<O, pragma_table_info>,
+#if SQLITE_VERSION_NUMBER >= 3026000
+                                                         std::is_same<O, pragma_table_xinfo>,
+#endif
+                                                         std::is_same<O, pragma_index_list>,
+                                                         std::is_same<O, pragma_index_info>,
+                                                         std::is_same<O, pragma_foreign_key_list>>;
+    }
+#endif
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#ifdef SQLITE_ENABLE_DBPAGE_VTAB
+#include <string>  //  std::string
+#include <vector>  //  std::vector
+#endif
+
+#include "../schema/column.h"
+#include "../schema/table.h"
+
+namespace sqlite_orm {
+#ifdef SQLITE_ENABLE_DBPAGE_VTAB
+    /**
+     *  Row of the `sqlite_dbpage` virtual table https://www.sqlite.org/dbpage.html
+     *  which exposes the raw pages of a database file.
+     *  `schema` is the hidden column which selects the attached database, "main" by default.
+     */
+    struct sqlite_dbpage {
+        int pgno = 0;
+        std::vector<char> data;
+        std::string schema;
+    };
+
+    inline auto make_sqlite_dbpage_table() {
+        return make_table("sqlite_dbpage",
+                          make_column("pgno", &sqlite_dbpage::pgno),
+                          make_column("data", &sqlite_dbpage::data),
+                          make_column("schema", &sqlite_dbpage::schema));
+    }
+#endif  //  SQLITE_ENABLE_DBPAGE_VTAB
+}
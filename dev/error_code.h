@@ -38,6 +38,10 @@ namespace sqlite_orm {
         index_is_out_of_bounds,
         value_is_null,
         no_tables_specified,
+        deadline_exceeded,
+        query_cancelled,
+        backup_cancelled,
+        no_shards,
     };
 
 }
@@ -98,6 +102,14 @@ namespace sqlite_orm {
                     return "Value is null";
                 case orm_error_code::no_tables_specified:
                     return "No tables specified";
+                case orm_error_code::deadline_exceeded:
+                    return "Deadline exceeded";
+                case orm_error_code::query_cancelled:
+                    return "Query cancelled";
+                case orm_error_code::backup_cancelled:
+                    return "Backup cancelled";
+                case orm_error_code::no_shards:
+                    return "Sharded storage needs at least one shard";
                 default:
                     return "unknown error";
             }
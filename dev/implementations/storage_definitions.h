@@ -7,12 +7,22 @@
 #include <sstream>
 #include <functional>  //  std::reference_wrapper, std::cref
 #include <algorithm>  //  std::find_if, std::ranges::find
+#include <chrono>  //  std::chrono::steady_clock
+#include <limits>  //  std::numeric_limits
+#include <vector>  //  std::vector
 
 #include "../sqlite_schema_table.h"
 #include "../eponymous_vtabs/dbstat.h"
+#include "../eponymous_vtabs/json_each.h"
+#include "../eponymous_vtabs/json_tree.h"
+#include "../eponymous_vtabs/generate_series.h"
+#include "../eponymous_vtabs/pragma_functions.h"
+#include "../eponymous_vtabs/sqlite_dbpage.h"
 #include "../type_traits.h"
 #include "../util.h"
 #include "../serializing_util.h"
+#include "../statement_finalizer.h"
+#include "../online_migration.h"
 #include "../storage.h"
 
 namespace sqlite_orm {
@@ -29,6 +39,30 @@ namespace sqlite_orm {
                 return sync_schema_result::already_in_sync;
             }
 #endif  //  SQLITE_ENABLE_DBSTAT_VTAB
+#ifdef SQLITE_ENABLE_JSON1
+            if(std::is_same<object_type_t<Table>, json_each>::value ||
+               std::is_same<object_type_t<Table>, json_tree>::value) {
+                return sync_schema_result::already_in_sync;
+            }
+#endif  //  SQLITE_ENABLE_JSON1
+            if(std::is_same<object_type_t<Table>, generate_series>::value) {
+                return sync_schema_result::already_in_sync;
+            }
+#if SQLITE_VERSION_NUMBER >= 3016000
+            if(is_pragma_function<object_type_t<Table>>::value) {
+                return sync_schema_result::already_in_sync;
+            }
+#endif
+#ifdef SQLITE_ENABLE_DBPAGE_VTAB
+            if(std::is_same<object_type_t<Table>, sqlite_dbpage>::value) {
+                return sync_schema_result::already_in_sync;
+            }
+#endif  //  SQLITE_ENABLE_DBPAGE_VTAB
+#if SQLITE_VERSION_NUMBER >= 3020000
+            if(this->rangeTables.count(table.name)) {
+                return sync_schema_result::already_in_sync;
+            }
+#endif
             auto res = sync_schema_result::already_in_sync;
             bool attempt_to_preserve = true;
 
@@ -46,7 +80,8 @@ namespace sqlite_orm {
                         auto storageTableInfo = table.get_table_info();
 
                         //  now get current table info from db using `PRAGMA table_xinfo` query..
-                        auto dbTableInfo = this->pragma.table_xinfo(table.name);  // should include generated columns
+                        //  should include generated columns
+                        auto dbTableInfo = this->pragma.table_xinfo(table.schema_name, table.name);
 
                         //  this vector will contain pointers to columns that gotta be added..
                         std::vector<const table_xinfo*> columnsToAdd;
@@ -56,7 +91,7 @@ namespace sqlite_orm {
                         if(schema_stat == sync_schema_result::old_columns_removed) {
 #if SQLITE_VERSION_NUMBER >= 3035000  //  DROP COLUMN feature exists (v3.35.0)
                             for(auto& tableInfo: dbTableInfo) {
-                                this->drop_column(db, table.name, tableInfo.name);
+                                this->drop_column(db, table.schema_name, table.name, tableInfo.name);
                             }
                             res = sync_schema_result::old_columns_removed;
 #else
@@ -68,11 +103,11 @@ namespace sqlite_orm {
 
                         if(schema_stat == sync_schema_result::new_columns_added) {
                             for(const table_xinfo* colInfo: columnsToAdd) {
-                                table.for_each_column([this, colInfo, &tableName = table.name, db](auto& column) {
+                                table.for_each_column([this, colInfo, &table, db](auto& column) {
                                     if(column.name != colInfo->name) {
                                         return;
                                     }
-                                    this->add_column(db, tableName, column);
+                                    this->add_column(db, table.schema_name, table.name, column);
                                 });
                             }
                             res = sync_schema_result::new_columns_added;
@@ -89,7 +124,8 @@ namespace sqlite_orm {
                         }
                     } else if(schema_stat == sync_schema_result::dropped_and_recreated) {
                         //  now get current table info from db using `PRAGMA table_xinfo` query..
-                        auto dbTableInfo = this->pragma.table_xinfo(table.name);  // should include generated columns
+                        //  should include generated columns
+                        auto dbTableInfo = this->pragma.table_xinfo(table.schema_name, table.name);
                         auto storageTableInfo = table.get_table_info();
 
                         //  this vector will contain pointers to columns that gotta be added..
@@ -111,14 +147,12 @@ namespace sqlite_orm {
             return res;
         }
 
-        template<class... DBO>
+        /**
+         *  Names of the columns of `table` which are copied to a recreated table, generated columns are left out.
+         */
         template<class Table>
-        void storage_t<DBO...>::copy_table(
-            sqlite3* db,
-            const std::string& sourceTableName,
-            const std::string& destinationTableName,
-            const Table& table,
-            const std::vector<const table_xinfo*>& columnsToIgnore) const {  // must ignore generated columns
+        std::vector<std::reference_wrapper<const std::string>>
+        copied_column_names(const Table& table, const std::vector<const table_xinfo*>& columnsToIgnore) {
             std::vector<std::reference_wrapper<const std::string>> columnNames;
             columnNames.reserve(table.template count_of<is_column>());
             table.for_each_column([&columnNames, &columnsToIgnore](const column_identifier& column) {
@@ -136,13 +170,152 @@ namespace sqlite_orm {
                     columnNames.push_back(cref(columnName));
                 }
             });
+            return columnNames;
+        }
+
+        template<class... DBO>
+        template<class Table>
+        void storage_t<DBO...>::copy_table(
+            sqlite3* db,
+            const std::string& sourceTableName,
+            const std::string& destinationTableName,
+            const Table& table,
+            const std::vector<const table_xinfo*>& columnsToIgnore) const {  // must ignore generated columns
+            auto columnNames = copied_column_names(table, columnsToIgnore);
 
             std::stringstream ss;
-            ss << "INSERT INTO " << streaming_identifier(destinationTableName) << " ("
+            ss << "INSERT INTO " << streaming_identifier(table.schema_name, destinationTableName, std::string{}) << " ("
                << streaming_identifiers(columnNames) << ") "
-               << "SELECT " << streaming_identifiers(columnNames) << " FROM " << streaming_identifier(sourceTableName)
-               << std::flush;
+               << "SELECT " << streaming_identifiers(columnNames) << " FROM "
+               << streaming_identifier(table.schema_name, sourceTableName, std::string{}) << std::flush;
             perform_void_exec(db, ss.str());
         }
+
+        template<class... DBO>
+        template<class Table>
+        void storage_t<DBO...>::copy_table_online(sqlite3* db,
+                                                  const std::string& sourceTableName,
+                                                  const std::string& destinationTableName,
+                                                  const Table& table,
+                                                  const std::vector<const table_xinfo*>& columnsToIgnore,
+                                                  const online_migration_options& options) {
+            using clock_type = std::chrono::steady_clock;
+            auto columnNames = copied_column_names(table, columnsToIgnore);
+            auto& schemaName = table.schema_name;
+
+            //  rows keep their rowids in the copy, so the triggers find the rows to update and delete by rowid
+            std::stringstream insertNew;
+            insertNew << "INSERT OR REPLACE INTO " << streaming_identifier(destinationTableName) << " (rowid, "
+                      << streaming_identifiers(columnNames) << ") VALUES (NEW.rowid";
+            for(const std::string& columnName: columnNames) {
+                insertNew << ", NEW." << streaming_identifier(columnName);
+            }
+            insertNew << ");";
+            std::stringstream deleteOld;
+            deleteOld << "DELETE FROM " << streaming_identifier(destinationTableName) << " WHERE rowid = OLD.rowid;";
+            const std::string triggerNames[] = {sourceTableName + "_online_migration_insert",
+                                                sourceTableName + "_online_migration_update",
+                                                sourceTableName + "_online_migration_delete"};
+            auto dropTriggers = [db, &schemaName, &triggerNames] {
+                for(auto& triggerName: triggerNames) {
+                    std::stringstream ss;
+                    ss << "DROP TRIGGER IF EXISTS " << streaming_identifier(schemaName, triggerName, std::string{})
+                       << std::flush;
+                    perform_void_exec(db, ss.str());
+                }
+            };
+
+            try {
+                const char* events[] = {"INSERT", "UPDATE", "DELETE"};
+                const std::string actions[] = {insertNew.str(),
+                                               deleteOld.str() + " " + insertNew.str(),
+                                               deleteOld.str()};
+                for(int i = 0; i < 3; ++i) {
+                    std::stringstream ss;
+                    //  a trigger lives in the database of its table, which also resolves the names in its body
+                    ss << "CREATE TRIGGER " << streaming_identifier(schemaName, triggerNames[i], std::string{})
+                       << " AFTER " << events[i] << " ON " << streaming_identifier(sourceTableName) << " BEGIN "
+                       << actions[i] << " END" << std::flush;
+                    perform_void_exec(db, ss.str());
+                }
+
+                online_migration_progress progress;
+                progress.table = table.name;
+                {
+                    std::stringstream ss;
+                    ss << "SELECT COUNT(*) FROM " << streaming_identifier(schemaName, sourceTableName, std::string{})
+                       << std::flush;
+                    perform_exec(db, ss.str(), extract_single_value<int64>, &progress.total_rows);
+                }
+                std::stringstream chunkEndSql;
+                chunkEndSql << "SELECT rowid FROM " << streaming_identifier(schemaName, sourceTableName, std::string{})
+                            << " WHERE rowid >= ? ORDER BY rowid LIMIT 1 OFFSET ?" << std::flush;
+                statement_finalizer chunkEndStatement{prepare_stmt(db, chunkEndSql.str())};
+                std::stringstream copySql;
+                //  rows which the triggers already mirrored are newer than the ones read here
+                copySql << "INSERT OR IGNORE INTO "
+                        << streaming_identifier(schemaName, destinationTableName, std::string{}) << " (rowid, "
+                        << streaming_identifiers(columnNames) << ") SELECT rowid, "
+                        << streaming_identifiers(columnNames) << " FROM "
+                        << streaming_identifier(schemaName, sourceTableName, std::string{})
+                        << " WHERE rowid >= ? AND rowid <= ? ORDER BY rowid" << std::flush;
+                statement_finalizer copyStatement{prepare_stmt(db, copySql.str())};
+
+                const int64 chunkSize = options.chunk_size > 0 ? options.chunk_size : 1;
+                const auto start = clock_type::now();
+                //  chunks are closed ranges, so that rows at both ends of the rowid domain are copied
+                int64 firstRowid = std::numeric_limits<int64>::min();
+                for(bool lastChunk = false; !lastChunk;) {
+                    perform_void_exec(db, "BEGIN IMMEDIATE");
+                    sqlite3_stmt* stmt = reset_stmt(chunkEndStatement.get());
+                    sqlite3_bind_int64(stmt, 1, firstRowid);
+                    sqlite3_bind_int64(stmt, 2, chunkSize - 1);
+                    int64 chunkEnd = std::numeric_limits<int64>::max();
+                    perform_step(stmt, [&chunkEnd](sqlite3_stmt* stmt) {
+                        chunkEnd = sqlite3_column_int64(stmt, 0);
+                    });
+                    //  an unfinished statement would keep reading the table after the commit
+                    sqlite3_reset(stmt);
+                    lastChunk = chunkEnd == std::numeric_limits<int64>::max();
+                    stmt = reset_stmt(copyStatement.get());
+                    sqlite3_bind_int64(stmt, 1, firstRowid);
+                    sqlite3_bind_int64(stmt, 2, chunkEnd);
+                    perform_step(stmt);
+                    progress.copied_rows += sqlite3_changes(db);
+                    perform_void_exec(db, "COMMIT");
+                    //  the last chunk may end at the largest rowid, which has no successor
+                    if(!lastChunk) {
+                        firstRowid = chunkEnd + 1;
+                    }
+
+                    progress.elapsed = clock_type::now() - start;
+                    if(progress.copied_rows > 0 && progress.total_rows > progress.copied_rows) {
+                        progress.eta = progress.elapsed * (progress.total_rows - progress.copied_rows) /
+                                       progress.copied_rows;
+                    } else {
+                        progress.eta = {};
+                    }
+                    if(options.on_progress) {
+                        options.on_progress(progress);
+                    }
+                }
+
+                perform_void_exec(db, "BEGIN IMMEDIATE");
+                dropTriggers();
+                this->drop_table_internal(db, schemaName, sourceTableName);
+                this->rename_table(db, schemaName, destinationTableName, sourceTableName);
+                perform_void_exec(db, "COMMIT");
+            } catch(...) {
+                if(!sqlite3_get_autocommit(db)) {
+                    sqlite3_exec(db, "ROLLBACK", nullptr, nullptr, nullptr);
+                }
+                try {
+                    dropTriggers();
+                    this->drop_table_internal(db, schemaName, destinationTableName);
+                } catch(const std::system_error&) {
+                }
+                throw;
+            }
+        }
     }
 }
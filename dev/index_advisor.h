@@ -0,0 +1,316 @@
+#pragma once
+
+#include <sqlite3.h>
+#include <algorithm>  //  std::find, std::find_if
+#include <memory>  //  std::unique_ptr
+#include <set>  //  std::set
+#include <string>  //  std::string, std::to_string
+#include <type_traits>  //  std::integral_constant
+#include <utility>  //  std::pair, std::move
+#include <vector>  //  std::vector
+
+#include "error_code.h"
+#include "util.h"
+#include "statement_finalizer.h"
+
+namespace sqlite_orm {
+
+    /**
+     *  An index recommended by `storage.advise_indexes()`.
+     */
+    struct index_advice {
+        std::string table;
+        std::vector<std::string> columns;
+
+        /**
+         *  `CREATE INDEX` statement.
+         */
+        std::string sql;
+
+        /**
+         *  The same index as a `make_index()` call, e.g. `make_index("idx_users_name", &T::name)`,
+         *  where `T` stands for the type mapped to `table` and members are named after the columns.
+         */
+        std::string definition;
+
+        /**
+         *  Recorded statements which scan `table` without the index.
+         */
+        std::vector<std::string> queries;
+    };
+
+    namespace internal {
+
+        /**
+         *  Recommends indexes for queries the way the `.expert` command of the sqlite3 shell does:
+         *  the schema of the database is copied into an empty in-memory database where candidate indexes
+         *  on the columns each query reads are tried with `EXPLAIN QUERY PLAN`. Without data and statistics
+         *  the planner uses an index whenever it can constrain the lookup, so an index is recommended if it
+         *  turns a full table scan or an automatic index into a search. Candidates are extended column by column
+         *  as long as the planner uses more of them, which yields composite indexes.
+         */
+        struct index_advisor {
+
+            explicit index_advisor(sqlite3* db) {
+                sqlite3* scratchDb = nullptr;
+                int rc = sqlite3_open(":memory:", &scratchDb);
+                this->scratch.reset(scratchDb);
+                if(rc != SQLITE_OK) {
+                    throw_translated_sqlite_error(scratchDb);
+                }
+                sqlite3_stmt* stmt = prepare_stmt(db,
+                                                  "SELECT sql FROM sqlite_master WHERE sql IS NOT NULL ORDER BY CASE "
+                                                  "type WHEN 'table' THEN 0 WHEN 'index' THEN 1 ELSE 2 END");
+                statement_finalizer finalizer{stmt};
+                while(sqlite3_step(stmt) == SQLITE_ROW) {
+                    //  objects which can't be copied (internal tables, virtual tables of unknown modules) are
+                    //  skipped, queries using them are skipped later
+                    sqlite3_exec(this->scratch.get(),
+                                 reinterpret_cast<const char*>(sqlite3_column_text(stmt, 0)),
+                                 nullptr,
+                                 nullptr,
+                                 nullptr);
+                }
+            }
+
+            std::vector<index_advice> advise(const std::vector<std::string>& queries) {
+                std::vector<index_advice> result;
+                for(auto& query: queries) {
+                    for(auto& index: this->advise(query)) {
+                        auto it = std::find_if(result.begin(), result.end(), [&index](const index_advice& advice) {
+                            return advice.table == index.first && advice.columns == index.second;
+                        });
+                        if(it == result.end()) {
+                            result.push_back(make_advice(index.first, index.second));
+                            it = result.end() - 1;
+                        }
+                        it->queries.push_back(query);
+                    }
+                }
+                return result;
+            }
+
+          private:
+            using table_column = std::pair<std::string, std::string>;
+            using index_columns = std::pair<std::string, std::vector<std::string>>;
+
+            struct plan_t {
+                bool valid = false;
+                std::vector<std::string> details;
+            };
+
+            /**
+             *  Indexes needed by `query`, picked greedily: every round keeps the candidate removing the most full
+             *  scans until no candidate helps anymore.
+             */
+            std::vector<index_columns> advise(const std::string& query) {
+                std::vector<index_columns> result;
+                auto plan = this->explain(query);
+                if(!plan.valid) {
+                    return result;
+                }
+                int score = scan_score(plan);
+                if(!score) {
+                    return result;
+                }
+                auto readColumns = this->read_columns(query);
+                std::vector<std::string> keptIndexes;
+                while(score) {
+                    const table_column* best = nullptr;
+                    int bestScore = score;
+                    int terms = 0;
+                    for(auto& readColumn: readColumns) {
+                        auto alreadyIndexed = [&readColumn](const index_columns& index) {
+                            return index.first == readColumn.first;
+                        };
+                        if(std::find_if(result.begin(), result.end(), alreadyIndexed) != result.end()) {
+                            continue;
+                        }
+                        int trialScore = 0;
+                        int trialTerms = this->try_index(query, readColumn.first, {readColumn.second}, &trialScore);
+                        //  equality columns go first
+                        if(trialTerms &&
+                           (trialScore < bestScore || (best && trialScore == bestScore && trialTerms > terms))) {
+                            best = &readColumn;
+                            bestScore = trialScore;
+                            terms = trialTerms;
+                        }
+                    }
+                    if(!best) {
+                        break;
+                    }
+                    std::vector<std::string> columns{best->second};
+                    for(bool extended = true; extended;) {
+                        extended = false;
+                        for(auto& readColumn: readColumns) {
+                            if(readColumn.first != best->first ||
+                               std::find(columns.begin(), columns.end(), readColumn.second) != columns.end()) {
+                                continue;
+                            }
+                            auto candidate = columns;
+                            candidate.push_back(readColumn.second);
+                            int trialScore = 0;
+                            int candidateTerms = this->try_index(query, best->first, candidate, &trialScore);
+                            if(candidateTerms > terms && trialScore <= bestScore) {
+                                columns = std::move(candidate);
+                                terms = candidateTerms;
+                                extended = true;
+                            }
+                        }
+                    }
+                    //  kept while looking for indexes on the other tables of the query
+                    keptIndexes.push_back("advised_index_" + std::to_string(keptIndexes.size()));
+                    this->create_index(keptIndexes.back(), best->first, columns);
+                    result.emplace_back(best->first, std::move(columns));
+                    score = bestScore;
+                }
+                for(auto& indexName: keptIndexes) {
+                    this->drop_index(indexName);
+                }
+                return result;
+            }
+
+            plan_t explain(const std::string& query) {
+                plan_t result;
+                sqlite3_stmt* stmt = nullptr;
+                std::string sql = "EXPLAIN QUERY PLAN " + query;
+                if(sqlite3_prepare_v2(this->scratch.get(), sql.c_str(), -1, &stmt, nullptr) != SQLITE_OK) {
+                    return result;
+                }
+                statement_finalizer finalizer{stmt};
+                while(sqlite3_step(stmt) == SQLITE_ROW) {
+                    result.details.emplace_back(reinterpret_cast<const char*>(sqlite3_column_text(stmt, 3)));
+                }
+                result.valid = true;
+                return result;
+            }
+
+            /**
+             *  Number of full table scans and automatic indexes in `plan`.
+             */
+            static int scan_score(const plan_t& plan) {
+                int result = 0;
+                for(auto& detail: plan.details) {
+                    bool fullScan = detail.compare(0, 5, "SCAN ") == 0 && detail.find(" INDEX") == detail.npos;
+                    if(fullScan || detail.find(" AUTOMATIC ") != detail.npos) {
+                        ++result;
+                    }
+                }
+                return result;
+            }
+
+            /**
+             *  How much of the index named `indexName` `plan` uses to constrain a lookup: every equality term
+             *  counts 2 and every range term 1, e.g. 3 for `SEARCH users USING INDEX idx (name=? AND age>?)`.
+             *  0 if the index isn't used as a constraint.
+             */
+            static int used_terms(const plan_t& plan, const std::string& indexName) {
+                for(auto& detail: plan.details) {
+                    auto begin = detail.find("INDEX " + indexName + " (");
+                    if(begin == detail.npos) {
+                        continue;
+                    }
+                    begin = detail.find('(', begin) + 1;
+                    auto terms = detail.substr(begin, detail.find(')', begin) - begin);
+                    int result = 0;
+                    for(size_t pos = 0; pos != terms.npos;) {
+                        auto end = terms.find(" AND ", pos);
+                        auto term = terms.substr(pos, end == terms.npos ? terms.npos : end - pos);
+                        bool equality = term.find("=?") != term.npos && term.find(">=?") == term.npos &&
+                                        term.find("<=?") == term.npos;
+                        result += equality ? 2 : 1;
+                        pos = end == terms.npos ? end : end + 5;
+                    }
+                    return result;
+                }
+                return 0;
+            }
+
+            /**
+             *  Creates a trial index and returns the number of its terms `query` uses as constraints. 0 if it
+             *  can't be created or isn't used.
+             */
+            int try_index(const std::string& query,
+                          const std::string& table,
+                          const std::vector<std::string>& columns,
+                          int* score) {
+                static const std::string trialIndexName = "advised_index_trial";
+                if(!this->create_index(trialIndexName, table, columns)) {
+                    return 0;
+                }
+                auto plan = this->explain(query);
+                this->drop_index(trialIndexName);
+                if(score) {
+                    *score = scan_score(plan);
+                }
+                return used_terms(plan, trialIndexName);
+            }
+
+            bool create_index(const std::string& indexName,
+                              const std::string& table,
+                              const std::vector<std::string>& columns) {
+                std::string sql = index_sql(indexName, table, columns);
+                return sqlite3_exec(this->scratch.get(), sql.c_str(), nullptr, nullptr, nullptr) == SQLITE_OK;
+            }
+
+            void drop_index(const std::string& indexName) {
+                perform_void_exec(this->scratch.get(), "DROP INDEX IF EXISTS " + quote_identifier(indexName));
+            }
+
+            /**
+             *  Table columns read by `query`, collected with an authorizer while it is being prepared.
+             */
+            std::set<table_column> read_columns(const std::string& query) {
+                std::set<table_column> result;
+                sqlite3_set_authorizer(
+                    this->scratch.get(),
+                    [](void* data, int action, const char* table, const char* column, const char*, const char*) {
+                        if(action == SQLITE_READ && table && column && *column) {
+                            static_cast<std::set<table_column>*>(data)->emplace(table, column);
+                        }
+                        return SQLITE_OK;
+                    },
+                    &result);
+                sqlite3_stmt* stmt = nullptr;
+                sqlite3_prepare_v2(this->scratch.get(), query.c_str(), -1, &stmt, nullptr);
+                sqlite3_finalize(stmt);
+                sqlite3_set_authorizer(this->scratch.get(), nullptr, nullptr);
+                return result;
+            }
+
+            static std::string
+            index_sql(const std::string& indexName, const std::string& table, const std::vector<std::string>& columns) {
+                std::string result = "CREATE INDEX " + quote_identifier(indexName) + " ON " + quote_identifier(table);
+                result += " (";
+                for(size_t i = 0; i < columns.size(); ++i) {
+                    if(i) {
+                        result += ", ";
+                    }
+                    result += quote_identifier(columns[i]);
+                }
+                result += ")";
+                return result;
+            }
+
+            static index_advice make_advice(const std::string& table, const std::vector<std::string>& columns) {
+                index_advice result;
+                result.table = table;
+                result.columns = columns;
+                std::string indexName = "idx_" + table;
+                for(auto& column: columns) {
+                    indexName += "_" + column;
+                }
+                result.sql = index_sql(indexName, table, columns);
+                result.definition = "make_index(\"" + indexName + "\"";
+                for(auto& column: columns) {
+                    result.definition += ", &T::" + column;
+                }
+                result.definition += ")";
+                return result;
+            }
+
+            using scratch_closer = std::integral_constant<decltype(&sqlite3_close), sqlite3_close>;
+            std::unique_ptr<sqlite3, scratch_closer> scratch;
+        };
+    }
+}
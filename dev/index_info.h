@@ -0,0 +1,212 @@
+#pragma once
+
+#include <cctype>  //  std::isalnum, std::isspace, std::tolower
+#include <string>  //  std::string, std::char_traits
+#include <vector>  //  std::vector
+
+#include "functional/cxx_universal.h"  //  ::size_t
+
+namespace sqlite_orm {
+
+    namespace internal {
+
+        /**
+         *  Key column of an index like `PRAGMA index_xinfo` reports it.
+         */
+        struct index_key_column {
+            //  empty for an expression
+            std::string name;
+            bool desc = false;
+            std::string collation;
+
+            /**
+             *  An indexed expression normalized with `normalized_sql_expression()`, empty for a column.
+             */
+            std::string expression;
+        };
+
+        /**
+         *  Structure of an index which `sync_schema` compares to decide whether it has to be rebuilt.
+         */
+        struct index_structure {
+            bool unique = false;
+            std::vector<index_key_column> columns;
+
+            /**
+             *  Condition of a partial index normalized with `normalized_index_condition()`, empty for a full index.
+             */
+            std::string condition;
+        };
+
+        inline bool equal_ignoring_case(const std::string& lhs, const std::string& rhs) {
+            if(lhs.size() != rhs.size()) {
+                return false;
+            }
+            for(size_t i = 0; i < lhs.size(); ++i) {
+                if(std::tolower(static_cast<unsigned char>(lhs[i])) !=
+                   std::tolower(static_cast<unsigned char>(rhs[i]))) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        inline bool operator==(const index_key_column& lhs, const index_key_column& rhs) {
+            return equal_ignoring_case(lhs.name, rhs.name) && lhs.desc == rhs.desc &&
+                   equal_ignoring_case(lhs.collation, rhs.collation) && lhs.expression == rhs.expression;
+        }
+
+        inline bool operator==(const index_structure& lhs, const index_structure& rhs) {
+            return lhs.unique == rhs.unique && lhs.columns == rhs.columns && lhs.condition == rhs.condition;
+        }
+
+        inline bool operator!=(const index_structure& lhs, const index_structure& rhs) {
+            return !(lhs == rhs);
+        }
+
+        /**
+         *  Position right after the first occurrence of the keyword `keyword` (lowercase) in `sql` at parenthesis
+         *  depth `depth`, outside of string literals and quoted identifiers. `std::string::npos` if there is none.
+         */
+        inline size_t find_sql_keyword(const std::string& sql, const std::string& keyword, int depth = 0) {
+            char closingQuote = 0;
+            int currentDepth = 0;
+            std::string word;
+            for(size_t i = 0; i <= sql.size(); ++i) {
+                const char ch = i < sql.size() ? sql[i] : ' ';
+                if(closingQuote) {
+                    if(ch == closingQuote) {
+                        closingQuote = 0;
+                    }
+                    continue;
+                }
+                if(std::isalnum(static_cast<unsigned char>(ch)) || ch == '_') {
+                    word += char(std::tolower(static_cast<unsigned char>(ch)));
+                    continue;
+                }
+                if(word == keyword && currentDepth == depth) {
+                    return i;
+                }
+                word.clear();
+                switch(ch) {
+                    case '\'':
+                    case '"':
+                    case '`':
+                        closingQuote = ch;
+                        break;
+                    case '[':
+                        closingQuote = ']';
+                        break;
+                    case '(':
+                        ++currentDepth;
+                        break;
+                    case ')':
+                        --currentDepth;
+                        break;
+                }
+            }
+            return std::string::npos;
+        }
+
+        /**
+         *  `expression` in a form independent of formatting: whitespace and identifier quotes are removed and
+         *  keywords lowercased outside of string literals, and parentheses enclosing the whole expression are
+         *  dropped.
+         */
+        inline std::string normalized_sql_expression(const std::string& expression) {
+            std::string res;
+            bool inLiteral = false;
+            for(char ch: expression) {
+                if(ch == '\'') {
+                    inLiteral = !inLiteral;
+                }
+                if(inLiteral || ch == '\'') {
+                    res += ch;
+                } else if(!std::isspace(static_cast<unsigned char>(ch)) && ch != '"' && ch != '`' && ch != '[' &&
+                          ch != ']') {
+                    res += char(std::tolower(static_cast<unsigned char>(ch)));
+                }
+            }
+            //  drop parentheses around the whole expression, but not those of e.g. `(a) or (b)`
+            while(res.size() >= 2 && res.front() == '(' && res.back() == ')') {
+                int depth = 0;
+                bool enclosing = true;
+                bool literal = false;
+                for(size_t i = 0; i + 1 < res.size() && enclosing; ++i) {
+                    if(res[i] == '\'') {
+                        literal = !literal;
+                    } else if(!literal && res[i] == '(') {
+                        ++depth;
+                    } else if(!literal && res[i] == ')') {
+                        enclosing = --depth > 0;
+                    }
+                }
+                if(!enclosing) {
+                    break;
+                }
+                res = res.substr(1, res.size() - 2);
+            }
+            return res;
+        }
+
+        /**
+         *  Condition of the WHERE clause of a CREATE INDEX statement normalized with `normalized_sql_expression()`.
+         *  Empty if there is no WHERE clause.
+         */
+        inline std::string normalized_index_condition(const std::string& sql) {
+            const size_t wherePosition = find_sql_keyword(sql, "where");
+            if(wherePosition == std::string::npos) {
+                return {};
+            }
+            return normalized_sql_expression(sql.substr(wherePosition));
+        }
+
+        /**
+         *  Key columns and expressions listed by a CREATE INDEX statement, without their COLLATE and ASC/DESC
+         *  suffixes and normalized with `normalized_sql_expression()`.
+         */
+        inline std::vector<std::string> normalized_index_keys(const std::string& sql) {
+            std::vector<std::string> res;
+            const size_t onPosition = find_sql_keyword(sql, "on");
+            if(onPosition == std::string::npos) {
+                return res;
+            }
+            const size_t listStart = sql.find('(', onPosition);
+            if(listStart == std::string::npos) {
+                return res;
+            }
+            //  split the list at the commas between its elements
+            std::vector<std::string> elements(1);
+            char closingQuote = 0;
+            int depth = 1;
+            for(size_t i = listStart + 1; i < sql.size() && depth; ++i) {
+                const char ch = sql[i];
+                if(closingQuote) {
+                    closingQuote = ch == closingQuote ? 0 : closingQuote;
+                } else if(ch == '\'' || ch == '"' || ch == '`') {
+                    closingQuote = ch;
+                } else if(ch == '[') {
+                    closingQuote = ']';
+                } else if(ch == '(') {
+                    ++depth;
+                } else if(ch == ')' && --depth == 0) {
+                    break;
+                } else if(ch == ',' && depth == 1) {
+                    elements.emplace_back();
+                    continue;
+                }
+                elements.back() += ch;
+            }
+            for(auto& element: elements) {
+                for(const char* suffix: {"collate", "asc", "desc"}) {
+                    const size_t suffixEnd = find_sql_keyword(element, suffix);
+                    if(suffixEnd != std::string::npos) {
+                        element.resize(suffixEnd - std::char_traits<char>::length(suffix));
+                    }
+                }
+                res.push_back(normalized_sql_expression(element));
+            }
+            return res;
+        }
+    }
+}
@@ -208,6 +208,30 @@ namespace sqlite_orm {
         template<class F, class W>
         struct node_tuple<filtered_aggregate_function<F, W>, void> : node_tuple_for<F, W> {};
 
+        template<class R, class S, class... Args>
+        struct node_tuple<built_in_window_function_t<R, S, Args...>, void> : node_tuple_for<Args...> {};
+
+        template<class F, class W>
+        struct node_tuple<over_t<F, W>, void> : node_tuple_for<F, W> {};
+
+        template<class... Args>
+        struct node_tuple<window_defn_t<Args...>, void> : node_tuple_for<Args...> {};
+
+        template<class... Args>
+        struct node_tuple<window_t<Args...>, void> : node_tuple_for<Args...> {};
+
+        template<class... Args>
+        struct node_tuple<partition_by_t<Args...>, void> : node_tuple_for<Args...> {};
+
+        template<class B, class E>
+        struct node_tuple<frame_t<B, E>, void> : node_tuple_for<B, E> {};
+
+        template<class T>
+        struct node_tuple<preceding_t<T>, void> : node_tuple<T> {};
+
+        template<class T>
+        struct node_tuple<following_t<T>, void> : node_tuple<T> {};
+
         template<class F, class... Args>
         struct node_tuple<function_call<F, Args...>, void> : node_tuple_for<Args...> {};
 
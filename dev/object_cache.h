@@ -0,0 +1,125 @@
+#pragma once
+
+#include <list>  //  std::list
+#include <memory>  //  std::shared_ptr
+#include <unordered_map>  //  std::unordered_map
+#include <utility>  //  std::move, std::pair
+
+#include "functional/cxx_universal.h"  //  ::size_t, ::int64
+
+namespace sqlite_orm {
+
+    /**
+     *  Counters of an object cache, see `storage.object_cache_stats<O>()`.
+     */
+    struct object_cache_stats {
+        int64 hits = 0;
+        int64 misses = 0;
+
+        /**
+         *  Number of objects dropped because the cache was full.
+         */
+        int64 evictions = 0;
+
+        /**
+         *  Number of objects dropped because the database changed.
+         */
+        int64 invalidations = 0;
+    };
+
+    namespace internal {
+
+        struct basic_object_cache {
+            basic_object_cache(size_t capacity, bool keyIsRowid, bool uniqueKeys) :
+                capacity(capacity), keyIsRowid(keyIsRowid), uniqueKeys(uniqueKeys) {}
+
+            virtual ~basic_object_cache() = default;
+
+            /**
+             *  Called when a row of the cached table changed.
+             *  Drops just that row if objects are keyed by rowid and everything otherwise.
+             */
+            virtual void invalidate(int64 rowid) = 0;
+
+            virtual void clear() = 0;
+
+            /**
+             *  Called after a REPLACE into the cached table. Rows it deletes because they conflict on a UNIQUE
+             *  constraint are not reported to the update hook, so they can only be dropped along with everything.
+             */
+            void rows_replaced() {
+                if(this->uniqueKeys) {
+                    this->clear();
+                }
+            }
+
+            object_cache_stats stats;
+
+          protected:
+            const size_t capacity;
+            const bool keyIsRowid;
+            //  whether the table has UNIQUE constraints or indexes besides its primary key
+            const bool uniqueKeys;
+        };
+
+        /**
+         *  LRU cache of objects of type `O` keyed by their integral primary key.
+         */
+        template<class O>
+        struct object_cache : basic_object_cache {
+            using basic_object_cache::basic_object_cache;
+
+            std::shared_ptr<const O> find(int64 key) {
+                auto it = this->index.find(key);
+                if(it == this->index.end()) {
+                    ++this->stats.misses;
+                    return nullptr;
+                }
+                ++this->stats.hits;
+                this->entries.splice(this->entries.begin(), this->entries, it->second);
+                return it->second->second;
+            }
+
+            void insert(int64 key, std::shared_ptr<const O> object) {
+                auto it = this->index.find(key);
+                if(it != this->index.end()) {
+                    it->second->second = std::move(object);
+                    this->entries.splice(this->entries.begin(), this->entries, it->second);
+                    return;
+                }
+                this->entries.emplace_front(key, std::move(object));
+                this->index.emplace(key, this->entries.begin());
+                if(this->entries.size() > this->capacity) {
+                    this->index.erase(this->entries.back().first);
+                    this->entries.pop_back();
+                    ++this->stats.evictions;
+                }
+            }
+
+            void invalidate(int64 rowid) override {
+                if(!this->keyIsRowid) {
+                    this->clear();
+                    return;
+                }
+                auto it = this->index.find(rowid);
+                if(it != this->index.end()) {
+                    this->entries.erase(it->second);
+                    this->index.erase(it);
+                    ++this->stats.invalidations;
+                }
+            }
+
+            void clear() override {
+                this->stats.invalidations += int64(this->entries.size());
+                this->index.clear();
+                this->entries.clear();
+            }
+
+          private:
+            using entry_type = std::pair<int64, std::shared_ptr<const O>>;
+
+            std::list<entry_type> entries;
+            std::unordered_map<int64, typename std::list<entry_type>::iterator> index;
+        };
+    }
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <chrono>  //  std::chrono::steady_clock
+#include <functional>  //  std::function
+#include <string>  //  std::string
+
+#include "functional/cxx_universal.h"  //  ::int64
+
+namespace sqlite_orm {
+
+    /**
+     *  State of a table copy made by `storage.sync_schema_online()`, reported after each chunk.
+     */
+    struct online_migration_progress {
+        std::string table;
+        int64 copied_rows = 0;
+
+        /**
+         *  Number of rows when the copy started, rows written meanwhile aren't included.
+         */
+        int64 total_rows = 0;
+        std::chrono::steady_clock::duration elapsed{};
+
+        /**
+         *  Estimated remaining time extrapolated from the copy speed so far.
+         */
+        std::chrono::steady_clock::duration eta{};
+    };
+
+    struct online_migration_options {
+
+        /**
+         *  Maximum number of rows copied in one transaction.
+         */
+        int64 chunk_size = 10000;
+        std::function<void(const online_migration_progress&)> on_progress;
+    };
+}
@@ -0,0 +1,239 @@
+#pragma once
+
+#include <algorithm>  //  std::max
+#include <condition_variable>  //  std::condition_variable
+#include <exception>  //  std::exception_ptr, std::current_exception, std::rethrow_exception
+#include <iterator>  //  std::input_iterator_tag
+#include <memory>  //  std::shared_ptr, std::unique_ptr, std::make_unique
+#include <mutex>  //  std::mutex, std::unique_lock, std::lock_guard
+#include <new>  //  placement new
+#include <thread>  //  std::thread
+#include <utility>  //  std::move, std::exchange
+
+#include "functional/cxx_universal.h"  //  ::size_t, ::ptrdiff_t
+
+namespace sqlite_orm {
+    namespace internal {
+
+        /**
+         *  Bounded single-producer/single-consumer queue of rows: a ring buffer between the thread stepping a
+         *  statement and the thread iterating over its rows. A side only waits if the buffer is full (producer)
+         *  or empty (consumer), and is only notified when the buffer stops being full or empty.
+         *  Rows are constructed in place in the slots and the consumer reads the row it popped from its slot, so `R`
+         *  needs to be move constructible only.
+         */
+        template<class R>
+        class row_queue {
+          public:
+            explicit row_queue(size_t capacity) :
+                capacity{std::max<size_t>(capacity, 1)}, slots{std::make_unique<slot[]>(this->capacity)} {}
+
+            row_queue(const row_queue&) = delete;
+            row_queue& operator=(const row_queue&) = delete;
+
+            ~row_queue() {
+                for(; this->count; --this->count) {
+                    this->row_at(this->head)->~R();
+                    this->head = (this->head + 1) % this->capacity;
+                }
+            }
+
+            /**
+             *  Waits for a free slot and moves `row` into it. Returns false if the consumer cancelled.
+             */
+            bool push(R row) {
+                std::unique_lock<std::mutex> lock{this->mutex};
+                this->notFull.wait(lock, [this] {
+                    return this->count < this->capacity || this->cancelled;
+                });
+                if(this->cancelled) {
+                    return false;
+                }
+                ::new(static_cast<void*>(&this->slots[(this->head + this->count) % this->capacity])) R(std::move(row));
+                if(this->count++ == 0) {
+                    lock.unlock();
+                    this->notEmpty.notify_one();
+                }
+                return true;
+            }
+
+            /**
+             *  Called by the producer after the last row, with the exception which stopped it if any.
+             */
+            void finish(std::exception_ptr exception = nullptr) {
+                {
+                    std::lock_guard<std::mutex> lock{this->mutex};
+                    this->finished = true;
+                    this->error = std::move(exception);
+                }
+                this->notEmpty.notify_one();
+            }
+
+            /**
+             *  Frees the slot of the previously popped row and waits for the next row. Returns the next row, which
+             *  stays in its slot until the following `pop`, or nullptr after the last row. Rethrows the exception
+             *  which stopped the producer once the rows before it are consumed.
+             */
+            R* pop() {
+                std::unique_lock<std::mutex> lock{this->mutex};
+                if(this->popped) {
+                    this->popped = false;
+                    this->row_at(this->head)->~R();
+                    this->head = (this->head + 1) % this->capacity;
+                    if(this->count-- == this->capacity) {
+                        this->notFull.notify_one();
+                    }
+                }
+                this->notEmpty.wait(lock, [this] {
+                    return this->count || this->finished;
+                });
+                if(!this->count) {
+                    if(this->error) {
+                        std::rethrow_exception(std::exchange(this->error, nullptr));
+                    }
+                    return nullptr;
+                }
+                //  the producer doesn't touch the head slot until it is freed
+                this->popped = true;
+                return this->row_at(this->head);
+            }
+
+            /**
+             *  Called by the consumer if it stops before the last row: a waiting producer gives up.
+             */
+            void cancel() {
+                {
+                    std::lock_guard<std::mutex> lock{this->mutex};
+                    this->cancelled = true;
+                }
+                this->notFull.notify_one();
+            }
+
+          private:
+            struct alignas(R) slot {
+                unsigned char bytes[sizeof(R)];
+            };
+
+            R* row_at(size_t index) {
+                return reinterpret_cast<R*>(&this->slots[index]);
+            }
+
+            const size_t capacity;
+            std::unique_ptr<slot[]> slots;
+            size_t head = 0;
+            size_t count = 0;
+            bool popped = false;
+            bool finished = false;
+            bool cancelled = false;
+            std::exception_ptr error;
+            std::mutex mutex;
+            std::condition_variable notEmpty;
+            std::condition_variable notFull;
+        };
+
+        /**
+         *  A single-pass view returned by `storage_t::iterate_pipelined()`. A producer thread steps the statement and
+         *  extracts rows into a `row_queue` while the caller consumes the previous ones. Destroying the view stops the
+         *  producer and waits for it, so the view must not outlive the storage.
+         *  Note: iterators point to the view, they are invalidated if the view is moved.
+         */
+        template<class R>
+        class pipelined_view {
+          public:
+            class iterator {
+              public:
+                using iterator_category = std::input_iterator_tag;
+                using difference_type = ptrdiff_t;
+                using value_type = R;
+                using reference = R&;
+                using pointer = R*;
+
+                iterator() = default;
+
+                explicit iterator(pipelined_view* view) : view{view} {}
+
+                R& operator*() const {
+                    return *this->view->current;
+                }
+
+                R* operator->() const {
+                    return this->view->current;
+                }
+
+                iterator& operator++() {
+                    this->view->next();
+                    return *this;
+                }
+
+                void operator++(int) {
+                    this->operator++();
+                }
+
+                friend bool operator==(const iterator& lhs, const iterator& rhs) {
+                    return lhs.at_end() == rhs.at_end();
+                }
+
+                friend bool operator!=(const iterator& lhs, const iterator& rhs) {
+                    return !(lhs == rhs);
+                }
+
+              private:
+                bool at_end() const {
+                    return !this->view || !this->view->current;
+                }
+
+                pipelined_view* view = nullptr;
+            };
+
+            /**
+             *  Starts `producer(queue)` on a new thread. `statement` keeps whatever the producer steps alive until
+             *  the producer is stopped.
+             */
+            template<class P>
+            pipelined_view(std::shared_ptr<void> statement, size_t queueDepth, P producer) :
+                statement{std::move(statement)}, queue{std::make_unique<row_queue<R>>(queueDepth)} {
+                this->producer = std::thread{[producer = std::move(producer), &queue = *this->queue]() mutable {
+                    try {
+                        producer(queue);
+                        queue.finish();
+                    } catch(...) {
+                        queue.finish(std::current_exception());
+                    }
+                }};
+            }
+
+            pipelined_view(pipelined_view&&) = default;
+
+            ~pipelined_view() {
+                if(this->producer.joinable()) {
+                    this->queue->cancel();
+                    this->producer.join();
+                }
+            }
+
+            iterator begin() {
+                if(!this->started) {
+                    this->started = true;
+                    this->next();
+                }
+                return iterator{this};
+            }
+
+            iterator end() {
+                return {};
+            }
+
+          private:
+            void next() {
+                this->current = this->queue->pop();
+            }
+
+            std::shared_ptr<void> statement;
+            std::unique_ptr<row_queue<R>> queue;
+            std::thread producer;
+            //  the row in the queue slot the iterators point to, nullptr at the end
+            R* current = nullptr;
+            bool started = false;
+        };
+    }
+}
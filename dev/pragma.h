@@ -134,13 +134,23 @@ namespace sqlite_orm {
 
             // will include generated columns in response as opposed to table_info
             std::vector<sqlite_orm::table_xinfo> table_xinfo(const std::string& tableName) const {
+                return this->table_xinfo(std::string{}, tableName);
+            }
+
+            /**
+             *  Columns of table `tableName` in the database attached as `schemaName`, the main database if it is empty.
+             */
+            std::vector<sqlite_orm::table_xinfo> table_xinfo(const std::string& schemaName,
+                                                             const std::string& tableName) const {
                 auto connection = this->get_connection();
 
                 std::vector<sqlite_orm::table_xinfo> result;
                 std::ostringstream ss;
-                ss << "PRAGMA "
-                      "table_xinfo("
-                   << streaming_identifier(tableName) << ")" << std::flush;
+                ss << "PRAGMA ";
+                if(!schemaName.empty()) {
+                    ss << streaming_identifier(schemaName) << ".";
+                }
+                ss << "table_xinfo(" << streaming_identifier(tableName) << ")" << std::flush;
                 perform_exec(
                     connection.get(),
                     ss.str(),
@@ -287,6 +287,32 @@ namespace sqlite_orm {
         template<class T>
         struct is_replace_raw : polyfill::bool_constant<is_replace_raw_v<T>> {};
 
+#if SQLITE_VERSION_NUMBER >= 3035000
+        /**
+         *  A data modification statement with a RETURNING clause.
+         *  `C` is a single column expression or `columns_t`, just like the columns of a SELECT.
+         */
+        template<class S, class C>
+        struct returning_t {
+            using statement_type = S;
+            using columns_type = C;
+
+            statement_type statement;
+            columns_type columns;
+        };
+#endif
+
+        template<class T>
+        SQLITE_ORM_INLINE_VAR constexpr bool is_returning_v =
+#if SQLITE_VERSION_NUMBER >= 3035000
+            polyfill::is_specialization_of<T, returning_t>::value;
+#else
+            false;
+#endif
+
+        template<class T>
+        struct is_returning : polyfill::bool_constant<is_returning_v<T>> {};
+
         struct default_values_t {};
 
         template<class T>
@@ -747,12 +773,21 @@ namespace sqlite_orm {
     /**
      *  Create an update all statement.
      *  Usage: storage.update_all(set(...), ...);
+     *
+     *  Values can be taken from other tables with a FROM clause and joins (`UPDATE ... FROM`, SQLite 3.33.0),
+     *  which replaces a correlated subquery evaluated for every updated row with a single join:
+     *  storage.update_all(set(c(&Inventory::quantity) = c(&Inventory::quantity) - c(&Sale::quantity)),
+     *                     from<Sale>(),
+     *                     where(c(&Inventory::itemId) == &Sale::itemId));
      */
     template<class S, class... Wargs>
     internal::update_all_t<S, Wargs...> update_all(S set, Wargs... wh) {
         static_assert(internal::is_set<S>::value, "first argument in update_all can be either set or dynamic_set");
         using args_tuple = std::tuple<Wargs...>;
         internal::validate_conditions<args_tuple>();
+        static_assert(internal::count_tuple<args_tuple, internal::is_constrained_join>::value == 0 ||
+                          internal::count_tuple<args_tuple, internal::is_from>::value == 1,
+                      "joins in update_all require a FROM clause");
         return {std::move(set), {std::forward<Wargs>(wh)...}};
     }
 
@@ -813,4 +848,29 @@ namespace sqlite_orm {
         return get_all_optional<internal::auto_decay_table_ref_t<table>, R>(std::forward<Args>(conditions)...);
     }
 #endif
+
+#if SQLITE_VERSION_NUMBER >= 3035000
+    /**
+     *  Adds a RETURNING clause to an insert, insert range, replace, replace range, update all or remove all statement.
+     *  Executing the prepared statement yields the returned rows the same way `select()` does:
+     *  a single column yields `std::vector<T>`, `columns(...)` yields `std::vector<std::tuple<...>>`
+     *  and `object<T>()` yields `std::vector<T>`.
+     *  Example:
+     *  auto statement = storage.prepare(returning(insert(user), columns(&User::id, &User::createdAt)));
+     *  auto rows = storage.execute(statement);
+     *  More info: https://www.sqlite.org/lang_returning.html
+     */
+    template<class S, class C>
+    internal::returning_t<S, C> returning(S statement, C columns) {
+        static_assert(polyfill::disjunction<internal::is_insert<S>,
+                                            internal::is_insert_range<S>,
+                                            internal::is_replace<S>,
+                                            internal::is_replace_range<S>,
+                                            polyfill::is_specialization_of<S, internal::update_all_t>,
+                                            polyfill::is_specialization_of<S, internal::remove_all_t>>::value,
+                      "RETURNING is supported for insert, insert_range, replace, replace_range, update_all and "
+                      "remove_all statements");
+        return {std::move(statement), std::move(columns)};
+    }
+#endif
 }
@@ -0,0 +1,277 @@
+#pragma once
+
+#include <chrono>  //  std::chrono::steady_clock
+#include <cstring>  //  std::memcpy
+#include <list>  //  std::list
+#include <memory>  //  std::shared_ptr
+#include <string>  //  std::string, std::to_string
+#include <tuple>  //  std::tuple
+#include <type_traits>  //  std::is_arithmetic, std::is_floating_point, std::is_signed, std::remove_pointer_t
+#include <unordered_map>  //  std::unordered_map
+#include <utility>  //  std::move, std::pair
+#include <vector>  //  std::vector
+
+#include "functional/cxx_universal.h"  //  ::size_t, ::int64
+#include "functional/cxx_type_traits_polyfill.h"
+#include "type_traits.h"
+#include "mapped_type_proxy.h"
+#include "conditions.h"
+#include "storage_lookup.h"
+#include "table_name_collector.h"
+#include "tuple_helper/tuple_iteration.h"
+#include "statement_binder.h"
+#include "field_printer.h"
+
+namespace sqlite_orm {
+
+    /**
+     *  Counters of the query result cache, see `storage.query_cache_stats()`.
+     */
+    struct query_cache_stats {
+        int64 hits = 0;
+        int64 misses = 0;
+
+        /**
+         *  Number of results dropped because the cache was full.
+         */
+        int64 evictions = 0;
+
+        /**
+         *  Number of results dropped because they expired or a table they were read from changed.
+         */
+        int64 invalidations = 0;
+    };
+
+    namespace internal {
+
+        /**
+         *  Builds the part of a query cache key made of the values bound to a statement.
+         *  Values that can't be represented disable caching of the statement.
+         */
+        struct bindings_key_builder {
+            std::string key;
+            bool representable = true;
+
+            /**
+             *  Numbers are tagged with their kind and size, the same bytes of different types are different values.
+             */
+            template<class T, satisfies<std::is_arithmetic, T> = true>
+            void operator()(const T& value) {
+                char bytes[sizeof(T)];
+                std::memcpy(bytes, &value, sizeof(T));
+                this->key += std::is_floating_point<T>::value ? 'f' : std::is_signed<T>::value ? 'i' : 'u';
+                this->key += char(sizeof(T));
+                this->key.append(bytes, sizeof(T));
+            }
+
+            template<class T,
+                     std::enable_if_t<!std::is_arithmetic<T>::value && is_bindable<T>::value && is_printable<T>::value,
+                                      bool> = true>
+            void operator()(const T& value) {
+                auto text = field_printer<T>{}(value);
+                this->key += 's';
+                this->key += std::to_string(text.size());
+                this->key += ':';
+                this->key += text;
+            }
+
+            template<class T,
+                     std::enable_if_t<!std::is_arithmetic<T>::value && is_bindable<T>::value && !is_printable<T>::value,
+                                      bool> = true>
+            void operator()(const T&) {
+                this->representable = false;
+            }
+
+            template<class T, satisfies_not<is_bindable, T> = true>
+            void operator()(const T&) const {}
+        };
+
+        /**
+         *  Collects all tables a query reads from, including those only mentioned in FROM and JOIN clauses.
+         */
+        template<class DBOs>
+        struct referenced_tables_collector : table_name_collector<DBOs> {
+            using table_name_collector<DBOs>::table_name_collector;
+            using table_name_collector<DBOs>::operator();
+
+            template<class... Args>
+            void operator()(const from_t<Args...>&) {
+                iterate_tuple<std::tuple<Args...>>([this](auto* dummyItem) {
+                    using table_type = std::remove_pointer_t<decltype(dummyItem)>;
+                    this->add_table<table_type>();
+                });
+            }
+
+            template<class T>
+            void operator()(const cross_join_t<T>&) {
+                this->add_table<T>();
+            }
+
+            template<class T>
+            void operator()(const natural_join_t<T>&) {
+                this->add_table<T>();
+            }
+
+            template<class T, class O>
+            void operator()(const left_join_t<T, O>&) {
+                this->add_table<T>();
+            }
+
+            template<class T, class O>
+            void operator()(const join_t<T, O>&) {
+                this->add_table<T>();
+            }
+
+            template<class T, class O>
+            void operator()(const left_outer_join_t<T, O>&) {
+                this->add_table<T>();
+            }
+
+            template<class T, class O>
+            void operator()(const inner_join_t<T, O>&) {
+                this->add_table<T>();
+            }
+
+          private:
+            template<class T>
+            void add_table() {
+                this->template collect_table<mapped_type_proxy_t<T>>("");
+            }
+        };
+
+        /**
+         *  LRU cache of materialized query results.
+         *  Rather than scanning entries on every change, each table has a generation counter that is bumped
+         *  when the table changes; an entry remembers the generations of the tables it was read from
+         *  and is stale as soon as one of them moved.
+         */
+        struct query_cache {
+            using clock_type = std::chrono::steady_clock;
+
+            std::shared_ptr<const void> find(const std::string& key, clock_type::time_point now) {
+                auto it = this->index.find(key);
+                if(it == this->index.end()) {
+                    ++this->stats.misses;
+                    return nullptr;
+                }
+                auto entryIt = it->second;
+                if(entryIt->expires <= now || !this->is_current(*entryIt)) {
+                    this->index.erase(it);
+                    this->entries.erase(entryIt);
+                    ++this->stats.invalidations;
+                    ++this->stats.misses;
+                    return nullptr;
+                }
+                ++this->stats.hits;
+                this->entries.splice(this->entries.begin(), this->entries, entryIt);
+                return entryIt->result;
+            }
+
+            void insert(std::string key,
+                        std::shared_ptr<const void> result,
+                        clock_type::time_point expires,
+                        const std::vector<std::string>& tableKeys) {
+                auto it = this->index.find(key);
+                if(it != this->index.end()) {
+                    this->entries.erase(it->second);
+                    this->index.erase(it);
+                }
+                entry_type entry;
+                entry.key = std::move(key);
+                entry.result = std::move(result);
+                entry.expires = expires;
+                entry.anyTableGeneration = this->anyTableGeneration;
+                //  an empty set means the tables are unknown, so any change makes the entry stale
+                entry.dependsOnAnyTable = tableKeys.empty();
+                for(auto& tableKey: tableKeys) {
+                    entry.tableGenerations.emplace_back(tableKey, this->tableGenerations[tableKey]);
+                }
+                this->entries.push_front(std::move(entry));
+                this->index.emplace(this->entries.front().key, this->entries.begin());
+                if(this->entries.size() > this->capacity) {
+                    this->index.erase(this->entries.back().key);
+                    this->entries.pop_back();
+                    ++this->stats.evictions;
+                }
+            }
+
+            void table_changed(const std::string& tableKey) {
+                ++this->anyTableGeneration;
+                ++this->tableGenerations[tableKey];
+            }
+
+            void clear() {
+                this->stats.invalidations += int64(this->entries.size());
+                this->index.clear();
+                this->entries.clear();
+            }
+
+            void set_capacity(size_t value) {
+                this->capacity = value;
+                while(this->entries.size() > this->capacity) {
+                    this->index.erase(this->entries.back().key);
+                    this->entries.pop_back();
+                    ++this->stats.evictions;
+                }
+            }
+
+            /**
+             *  Whether results are cached at all, the update hook is needed only if they are.
+             */
+            bool enabled = false;
+            query_cache_stats stats;
+
+          private:
+            struct entry_type {
+                std::string key;
+                std::shared_ptr<const void> result;
+                clock_type::time_point expires;
+                std::vector<std::pair<std::string, int64>> tableGenerations;
+                int64 anyTableGeneration = 0;
+                bool dependsOnAnyTable = false;
+            };
+
+            bool is_current(const entry_type& entry) const {
+                if(entry.dependsOnAnyTable) {
+                    return entry.anyTableGeneration == this->anyTableGeneration;
+                }
+                for(auto& tableGeneration: entry.tableGenerations) {
+                    auto it = this->tableGenerations.find(tableGeneration.first);
+                    if(it != this->tableGenerations.end() && it->second != tableGeneration.second) {
+                        return false;
+                    }
+                }
+                return true;
+            }
+
+            size_t capacity = 256;
+            std::list<entry_type> entries;
+            std::unordered_map<std::string, std::list<entry_type>::iterator> index;
+            std::unordered_map<std::string, int64> tableGenerations;
+            int64 anyTableGeneration = 0;
+        };
+
+        /**
+         *  Returned by `storage.cached(ttl)`, memoizes the results of `select()`.
+         */
+        template<class S>
+        struct cached_select {
+            S& storage;
+            std::chrono::steady_clock::duration ttl;
+
+            template<class T, class... Args>
+            auto select(T m, Args... args) {
+                return this->storage.select_cached(this->ttl, std::move(m), std::forward<Args>(args)...);
+            }
+        };
+
+        /**
+         *  Unique key of a type without relying on RTTI.
+         */
+        template<class T>
+        const void* type_key() {
+            static const char key = 0;
+            return &key;
+        }
+    }
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+#if SQLITE_VERSION_NUMBER >= 3020000
+#include <vector>  //  std::vector
+#ifdef SQLITE_ORM_CPP20_RANGES_SUPPORTED
+#include <ranges>  //  std::ranges::contiguous_range, std::ranges::sized_range, std::ranges::data, std::ranges::size
+#include <type_traits>  //  std::remove_cvref_t
+#endif
+#endif
+
+#include "functional/cxx_universal.h"  //  ::size_t
+#include "pointer_value.h"
+
+#if SQLITE_VERSION_NUMBER >= 3020000
+namespace sqlite_orm {
+    namespace internal {
+
+        /**
+         *  Pointer type (tag) of the range passed to a range table.
+         */
+        struct range_pointer_type {
+            using value_type = const char*;
+            static constexpr const char* value = "sqlite_orm_range";
+        };
+
+        /**
+         *  Name of the hidden column of a range table which receives the range.
+         */
+        inline const char* range_source_column_name() {
+            return "sqlite_orm_source";
+        }
+
+        /**
+         *  Contiguous sequence of objects exposed by a range table, the objects aren't copied.
+         */
+        template<class O>
+        struct range_view {
+            const O* data = nullptr;
+            size_t size = 0;
+        };
+
+        /**
+         *  Condition binding a range to the range table of `O`: `"table"."sqlite_orm_source" = ?`.
+         *  Don't construct it manually, call `range_source(...)` function instead.
+         */
+        template<class O>
+        struct range_source_t {
+            using mapped_type = O;
+
+            range_view<O> view;
+        };
+    }
+
+#ifdef SQLITE_ORM_CPP20_RANGES_SUPPORTED
+    /**
+     *  Binds a contiguous range (`std::vector`, `std::array`, `std::span`, ...) to the range table of its element type
+     *  registered with `storage.create_range_table<O>()`.
+     *  The range is passed by pointer and must outlive the execution of the statement.
+     *  Example:
+     *  std::vector<Weight> weights = ...;
+     *  storage.select(columns(&Item::name, &Weight::weight),
+     *                 join<Weight>(on(c(&Weight::itemId) == &Item::id)),
+     *                 where(range_source(weights)));
+     */
+    template<std::ranges::contiguous_range R>
+        requires(std::ranges::sized_range<R>)
+    auto range_source(const R& range) {
+        using object_type = std::remove_cvref_t<std::ranges::range_value_t<R>>;
+        return internal::range_source_t<object_type>{{std::ranges::data(range), size_t(std::ranges::size(range))}};
+    }
+#else
+    /**
+     *  Binds a vector to the range table of its element type registered with `storage.create_range_table<O>()`.
+     *  The vector is passed by pointer and must outlive the execution of the statement.
+     *  Example:
+     *  std::vector<Weight> weights = ...;
+     *  storage.select(columns(&Item::name, &Weight::weight),
+     *                 join<Weight>(on(c(&Weight::itemId) == &Item::id)),
+     *                 where(range_source(weights)));
+     */
+    template<class O>
+    internal::range_source_t<O> range_source(const std::vector<O>& range) {
+        return {{range.data(), range.size()}};
+    }
+#endif
+
+    /**
+     *  Binds `size` objects starting at `data` to the range table of `O`.
+     */
+    template<class O>
+    internal::range_source_t<O> range_source(const O* data, size_t size) {
+        return {{data, size}};
+    }
+}
+#endif
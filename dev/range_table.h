@@ -0,0 +1,364 @@
+#pragma once
+
+#include <sqlite3.h>
+#if SQLITE_VERSION_NUMBER >= 3020000
+#include <algorithm>  //  std::sort, std::equal_range
+#include <map>  //  std::map
+#include <memory>  //  std::shared_ptr, std::make_shared
+#include <new>  //  std::bad_alloc
+#include <numeric>  //  std::iota
+#include <string>  //  std::string
+#include <tuple>  //  std::tuple_element_t, std::get
+#include <type_traits>  //  std::decay_t, std::true_type, std::false_type
+#include <utility>  //  std::index_sequence, std::pair
+#include <vector>  //  std::vector
+#endif
+
+#include "functional/cxx_universal.h"  //  ::size_t
+#include "functional/cxx_functional_polyfill.h"
+#include "tuple_helper/tuple_filter.h"
+#include "type_traits.h"
+#include "schema/column.h"
+#include "type_printer.h"
+#include "statement_binder.h"
+#include "row_extractor.h"
+#include "util.h"
+#include "range_source.h"
+
+#if SQLITE_VERSION_NUMBER >= 3020000
+namespace sqlite_orm {
+    namespace internal {
+
+        /**
+         *  Virtual table module registered with a connection, see `storage.create_range_table<O>()`.
+         */
+        struct basic_range_table {
+            virtual ~basic_range_table() = default;
+
+            sqlite3_module module{};
+        };
+
+        /**
+         *  The key of a range table is its single primary key column, equality on it is answered
+         *  by a binary search instead of a scan.
+         */
+        template<class Table, class PkIndices = col_index_sequence_with<elements_type_t<Table>, is_primary_key>>
+        struct range_table_key {
+            static constexpr bool is_declared = false;
+        };
+
+        template<class Table, size_t I>
+        struct range_table_key<Table, std::index_sequence<I>> {
+            static constexpr bool is_declared = true;
+
+            using column_type = std::tuple_element_t<I, elements_type_t<Table>>;
+            using field_type = field_type_t<column_type>;
+
+            static const column_type& column(const Table& table) {
+                return std::get<I>(table.elements);
+            }
+        };
+
+        /**
+         *  Eponymous-only virtual table module exposing a range of objects of a mapped type
+         *  as a table with the mapped columns.
+         *  The range is bound to the hidden column `sqlite_orm_source` with the pointer-passing interface,
+         *  so objects are read in place and never copied into the database.
+         */
+        template<class Table>
+        struct range_table : basic_range_table {
+            using table_type = Table;
+            using object_type = object_type_t<Table>;
+            using key_type = range_table_key<Table>;
+            using column_index_sequence = filter_tuple_sequence_t<elements_type_t<Table>, is_column>;
+
+            range_table(const table_type& table) :
+                table(table), columnResults{make_column_results(column_index_sequence{})} {
+                int index = 0;
+                this->table.for_each_column([this, &index](auto& column) {
+                    this->columnsCount = ++index;
+                    if(this->is_key_column(column)) {
+                        this->keyColumn = index - 1;
+                    }
+                });
+                this->module.iVersion = 0;
+                this->module.xCreate = nullptr;
+                this->module.xConnect = connect;
+                this->module.xBestIndex = best_index;
+                this->module.xDisconnect = disconnect;
+                this->module.xDestroy = disconnect;
+                this->module.xOpen = open;
+                this->module.xClose = close;
+                this->module.xFilter = filter;
+                this->module.xNext = next;
+                this->module.xEof = eof;
+                this->module.xColumn = column_value;
+                this->module.xRowid = row_id;
+            }
+
+            const table_type table;
+
+          private:
+            struct vtab_type : sqlite3_vtab {
+                range_table* rangeTable = nullptr;
+            };
+
+            using key_order_type = std::vector<size_t>;
+
+            struct cursor_type : sqlite3_vtab_cursor {
+                range_view<object_type> view;
+                //  held by the cursor so that lookups into other ranges can't invalidate it
+                std::shared_ptr<const key_order_type> keyOrder;
+                size_t orderBegin = 0;
+                bool byKey = false;
+                size_t position = 0;
+                size_t end = 0;
+
+                size_t current() const {
+                    return this->byKey ? (*this->keyOrder)[this->orderBegin + this->position] : this->position;
+                }
+            };
+
+            enum idx_flags {
+                key_lookup = 1,
+            };
+
+            template<class C>
+            bool is_key_column(const C& column) const {
+                return this->is_key_column(column, polyfill::bool_constant<key_type::is_declared>{});
+            }
+
+            template<class C>
+            bool is_key_column(const C& column, std::true_type) const {
+                return static_cast<const void*>(&column) == static_cast<const void*>(&key_type::column(this->table));
+            }
+
+            template<class C>
+            bool is_key_column(const C&, std::false_type) const {
+                return false;
+            }
+
+            std::string declaration() const {
+                std::string sql = "CREATE TABLE x(";
+                this->table.for_each_column([&sql](auto& column) {
+                    using field_type = field_type_t<std::decay_t<decltype(column)>>;
+                    sql += quote_identifier(column.name);
+                    sql += ' ';
+                    sql += type_printer<field_type>().print();
+                    sql += ", ";
+                });
+                sql += quote_identifier(range_source_column_name());
+                sql += " HIDDEN)";
+                return sql;
+            }
+
+            static int connect(sqlite3* db, void* aux, int, const char* const*, sqlite3_vtab** vtab, char**) {
+                auto& rangeTable = *static_cast<range_table*>(aux);
+                try {
+                    int rc = sqlite3_declare_vtab(db, rangeTable.declaration().c_str());
+                    if(rc != SQLITE_OK) {
+                        return rc;
+                    }
+                    auto result = new vtab_type{};
+                    result->rangeTable = &rangeTable;
+                    *vtab = result;
+                } catch(const std::bad_alloc&) {
+                    return SQLITE_NOMEM;
+                }
+                return SQLITE_OK;
+            }
+
+            static int disconnect(sqlite3_vtab* vtab) {
+                delete static_cast<vtab_type*>(vtab);
+                return SQLITE_OK;
+            }
+
+            static int best_index(sqlite3_vtab* vtab, sqlite3_index_info* info) {
+                auto& rangeTable = *static_cast<vtab_type*>(vtab)->rangeTable;
+                int sourceConstraint = -1;
+                int keyConstraint = -1;
+                for(int i = 0; i < info->nConstraint; ++i) {
+                    auto& constraint = info->aConstraint[i];
+                    if(!constraint.usable || constraint.op != SQLITE_INDEX_CONSTRAINT_EQ) {
+                        continue;
+                    }
+                    if(constraint.iColumn == rangeTable.columnsCount) {
+                        sourceConstraint = i;
+                    } else if(constraint.iColumn == rangeTable.keyColumn) {
+                        keyConstraint = i;
+                    }
+                }
+                //  a plan without the range is unusable rather than empty
+                if(sourceConstraint == -1) {
+#if SQLITE_VERSION_NUMBER >= 3026000
+                    return SQLITE_CONSTRAINT;
+#else
+                    //  SQLITE_CONSTRAINT rejects a plan only since 3.26.0, before that a prohibitive cost has to do
+                    info->estimatedCost = 1e300;
+                    info->estimatedRows = 1000000000;
+                    return SQLITE_OK;
+#endif
+                }
+                info->aConstraintUsage[sourceConstraint].argvIndex = 1;
+                info->aConstraintUsage[sourceConstraint].omit = 1;
+                if(keyConstraint != -1) {
+                    info->aConstraintUsage[keyConstraint].argvIndex = 2;
+                    //  the lookup converts the value to the key's type, e.g. 4.5 to 4, so SQLite checks the
+                    //  equality of the rows found once more
+                    info->idxNum = key_lookup;
+                    info->estimatedCost = 10;
+                    info->estimatedRows = 1;
+                } else {
+                    info->estimatedCost = 100000;
+                    info->estimatedRows = 100000;
+                }
+                return SQLITE_OK;
+            }
+
+            static int open(sqlite3_vtab* vtab, sqlite3_vtab_cursor** cursor) {
+                try {
+                    *cursor = new cursor_type{};
+                } catch(const std::bad_alloc&) {
+                    return SQLITE_NOMEM;
+                }
+                ++static_cast<vtab_type*>(vtab)->rangeTable->openCursorsCount;
+                return SQLITE_OK;
+            }
+
+            static int close(sqlite3_vtab_cursor* cursor) {
+                auto& rangeTable = *static_cast<vtab_type*>(cursor->pVtab)->rangeTable;
+                //  a range may change between statements, so key orders are kept only while they are scanned
+                if(--rangeTable.openCursorsCount == 0) {
+                    rangeTable.keyOrders.clear();
+                }
+                delete static_cast<cursor_type*>(cursor);
+                return SQLITE_OK;
+            }
+
+            static int filter(sqlite3_vtab_cursor* cursor, int idxNum, const char*, int argc, sqlite3_value** argv) {
+                auto& c = *static_cast<cursor_type*>(cursor);
+                auto view = argc > 0 ? static_cast<const range_view<object_type>*>(
+                                           sqlite3_value_pointer(argv[0], range_pointer_type::value))
+                                     : nullptr;
+                c.view = view ? *view : range_view<object_type>{};
+                c.keyOrder = nullptr;
+                c.byKey = false;
+                c.position = 0;
+                c.end = c.view.size;
+                if((idxNum & key_lookup) && argc > 1) {
+                    c.byKey = true;
+                    c.end = 0;
+                    if(view && sqlite3_value_type(argv[1]) != SQLITE_NULL) {
+                        try {
+                            filter_by_key(c, argv[1], polyfill::bool_constant<key_type::is_declared>{});
+                        } catch(const std::bad_alloc&) {
+                            return SQLITE_NOMEM;
+                        }
+                    }
+                }
+                return SQLITE_OK;
+            }
+
+            /**
+             *  Key lookups binary search positions of the objects ordered by key, which are sorted on the first
+             *  lookup into a range and shared by all cursors scanning the same range, even in nested statements
+             *  scanning different ranges.
+             */
+            static void filter_by_key(cursor_type& c, sqlite3_value* value, std::true_type) {
+                using field_type = typename key_type::field_type;
+                auto& rangeTable = *static_cast<vtab_type*>(c.pVtab)->rangeTable;
+                auto& keyColumn = key_type::column(rangeTable.table);
+                auto keyOf = [&c, &keyColumn](size_t position) -> decltype(auto) {
+                    return polyfill::invoke(keyColumn.member_pointer, c.view.data[position]);
+                };
+                auto& sharedOrder = rangeTable.keyOrders[{c.view.data, c.view.size}];
+                if(!sharedOrder) {
+                    auto keyOrder = std::make_shared<key_order_type>(c.view.size);
+                    std::iota(keyOrder->begin(), keyOrder->end(), size_t(0));
+                    std::sort(keyOrder->begin(), keyOrder->end(), [&keyOf](size_t lhs, size_t rhs) {
+                        return keyOf(lhs) < keyOf(rhs);
+                    });
+                    sharedOrder = std::move(keyOrder);
+                }
+                c.keyOrder = sharedOrder;
+                const field_type key = row_extractor<field_type>().extract(value);
+                auto range = std::equal_range(c.keyOrder->cbegin(),
+                                              c.keyOrder->cend(),
+                                              key,
+                                              key_less<decltype(keyOf), field_type>{keyOf});
+                c.orderBegin = size_t(range.first - c.keyOrder->cbegin());
+                c.end = size_t(range.second - range.first);
+            }
+
+            static void filter_by_key(cursor_type&, sqlite3_value*, std::false_type) {}
+
+            /**
+             *  Compares positions in the range with a key value for `std::equal_range`.
+             */
+            template<class F, class K>
+            struct key_less {
+                F& keyOf;
+
+                bool operator()(size_t position, const K& key) const {
+                    return this->keyOf(position) < key;
+                }
+
+                bool operator()(const K& key, size_t position) const {
+                    return key < this->keyOf(position);
+                }
+            };
+
+            static int next(sqlite3_vtab_cursor* cursor) {
+                ++static_cast<cursor_type*>(cursor)->position;
+                return SQLITE_OK;
+            }
+
+            static int eof(sqlite3_vtab_cursor* cursor) {
+                auto& c = *static_cast<cursor_type*>(cursor);
+                return c.position >= c.end;
+            }
+
+            static int column_value(sqlite3_vtab_cursor* cursor, sqlite3_context* context, int columnIndex) {
+                auto& c = *static_cast<cursor_type*>(cursor);
+                auto& rangeTable = *static_cast<vtab_type*>(c.pVtab)->rangeTable;
+                if(size_t(columnIndex) < rangeTable.columnResults.size()) {
+                    rangeTable.columnResults[columnIndex](rangeTable.table, context, c.view.data[c.current()]);
+                } else {
+                    //  the hidden column of the range
+                    sqlite3_result_null(context);
+                }
+                return SQLITE_OK;
+            }
+
+            using column_result_fn = void (*)(const table_type& table, sqlite3_context* context, const object_type&);
+
+            template<size_t I>
+            static void column_result(const table_type& table, sqlite3_context* context, const object_type& object) {
+                auto& column = std::get<I>(table.elements);
+                using field_type = field_type_t<std::decay_t<decltype(column)>>;
+                statement_binder<field_type>().result(context, polyfill::invoke(column.member_pointer, object));
+            }
+
+            /**
+             *  Functions returning the value of a column, indexed by the column's number in the virtual table.
+             */
+            template<size_t... Idx>
+            static std::vector<column_result_fn> make_column_results(std::index_sequence<Idx...>) {
+                return {&column_result<Idx>...};
+            }
+
+            static int row_id(sqlite3_vtab_cursor* cursor, sqlite3_int64* rowid) {
+                *rowid = sqlite3_int64(static_cast<cursor_type*>(cursor)->current());
+                return SQLITE_OK;
+            }
+
+            const std::vector<column_result_fn> columnResults;
+            int columnsCount = 0;
+            int keyColumn = -1;
+            int openCursorsCount = 0;
+            //  positions of the objects of each range (data and size) ordered by key, built on the first key lookup
+            std::map<std::pair<const object_type*, size_t>, std::shared_ptr<const key_order_type>> keyOrders;
+        };
+    }
+}
+#endif
@@ -86,13 +86,29 @@ namespace sqlite_orm {
 
             elements_type elements;
 
+            /**
+             *  Name of the attached database the table lives in, empty for the main database.
+             */
+            std::string schema_name;
+
 #ifndef SQLITE_ORM_AGGREGATE_BASES_SUPPORTED
-            table_t(std::string name_, elements_type elements_) :
-                basic_table{std::move(name_)}, elements{std::move(elements_)} {}
+            table_t(std::string name_, elements_type elements_, std::string schemaName = {}) :
+                basic_table{std::move(name_)}, elements{std::move(elements_)}, schema_name{std::move(schemaName)} {}
 #endif
 
             table_t<O, true, Cs...> without_rowid() const {
-                return {this->name, this->elements};
+                return {this->name, this->elements, this->schema_name};
+            }
+
+            /**
+             *  Returns a copy of this table definition which lives in the database attached as `schemaName`
+             *  with `storage.attach()`, e.g. `make_table("orders", ...).in_schema("archive")`.
+             *  Statements then refer to the table as `"archive"."orders"`.
+             */
+            table_t in_schema(std::string schemaName) const {
+                table_t result = *this;
+                result.schema_name = std::move(schemaName);
+                return result;
             }
 
             /*
@@ -444,7 +460,7 @@ namespace sqlite_orm {
                       "Incorrect table elements or constraints");
 
         SQLITE_ORM_CLANG_SUPPRESS_MISSING_BRACES(
-            return {std::move(name), std::make_tuple<Cs...>(std::forward<Cs>(args)...)});
+            return {std::move(name), std::make_tuple<Cs...>(std::forward<Cs>(args)...), {}});
     }
 
     /**
@@ -458,7 +474,7 @@ namespace sqlite_orm {
                       "Incorrect table elements or constraints");
 
         SQLITE_ORM_CLANG_SUPPRESS_MISSING_BRACES(
-            return {std::move(name), std::make_tuple<Cs...>(std::forward<Cs>(args)...)});
+            return {std::move(name), std::make_tuple<Cs...>(std::forward<Cs>(args)...), {}});
     }
 
 #ifdef SQLITE_ORM_WITH_CPP20_ALIASES
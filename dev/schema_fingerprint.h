@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstdint>  //  std::uint64_t
+#include <string>  //  std::string
+
+namespace sqlite_orm {
+    namespace internal {
+
+        /**
+         *  Name of the table in which `storage.sync_schema_if_changed()` stores the schema fingerprint.
+         */
+        inline const char* schema_fingerprint_table_name() {
+            return "_sqlite_orm_schema";
+        }
+
+        /**
+         *  64-bit FNV-1a hash, the same on every platform.
+         */
+        inline std::uint64_t fnv1a_hash(const std::string& bytes) {
+            std::uint64_t hash = 14695981039346656037ull;
+            for(unsigned char c: bytes) {
+                hash ^= c;
+                hash *= 1099511628211ull;
+            }
+            return hash;
+        }
+
+        /**
+         *  64-bit FNV-1a hash of `definitions` as 16 hex digits.
+         */
+        inline std::string schema_fingerprint_hash(const std::string& definitions) {
+            std::uint64_t hash = fnv1a_hash(definitions);
+            static constexpr const char digits[] = "0123456789abcdef";
+            std::string result(16, '0');
+            for(int i = 15; i >= 0; --i, hash >>= 4) {
+                result[i] = digits[hash & 0xf];
+            }
+            return result;
+        }
+    }
+}
@@ -19,6 +19,7 @@
 #include "ast/where.h"
 #include "ast/group_by.h"
 #include "core_functions.h"
+#include "conditions.h"
 #include "alias_traits.h"
 #include "cte_moniker.h"
 
@@ -137,6 +138,18 @@ namespace sqlite_orm {
         template<class T>
         using is_select = polyfill::bool_constant<is_select_v<T>>;
 
+        /**
+         *  Conditions a WINDOW clause has to precede.
+         */
+        template<class T>
+        using is_window_successor = polyfill::disjunction<is_order_by<T>, is_limit<T>>;
+
+        /**
+         *  Conditions a WINDOW clause has to follow (FROM, JOIN, WHERE, GROUP BY and HAVING).
+         */
+        template<class T>
+        using is_window_predecessor = polyfill::negation<polyfill::disjunction<is_window<T>, is_window_successor<T>>>;
+
         /**
          *  Base for UNION, UNION ALL, EXCEPT and INTERSECT
          */
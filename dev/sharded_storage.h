@@ -0,0 +1,298 @@
+#pragma once
+
+#include <algorithm>  //  std::make_heap, std::push_heap, std::pop_heap
+#include <cstdint>  //  std::uint64_t
+#include <iterator>  //  std::make_move_iterator
+#include <future>  //  std::future, std::async
+#include <map>  //  std::map
+#include <memory>  //  std::unique_ptr
+#include <string>  //  std::string
+#include <system_error>  //  std::system_error
+#include <type_traits>  //  std::decay_t, std::enable_if_t, std::is_integral
+#include <utility>  //  std::declval, std::move, std::pair, std::index_sequence
+#include <vector>  //  std::vector
+
+#include "functional/cxx_universal.h"  //  ::size_t
+#include "error_code.h"
+#include "constraints.h"
+#include "schema/column.h"
+#include "select_constraints.h"
+#include "schema_fingerprint.h"
+#include "storage_lookup.h"
+#include "sync_schema_result.h"
+
+namespace sqlite_orm {
+
+    namespace internal {
+
+        /**
+         *  Maps a shard key to its shard. Unlike `std::hash` it's the same with every standard library, so shards
+         *  written by one build are read correctly by another.
+         */
+        template<class K, std::enable_if_t<std::is_integral<K>::value, bool> = true>
+        std::uint64_t shard_hash(K key) {
+            return std::uint64_t(key);
+        }
+
+        inline std::uint64_t shard_hash(const std::string& key) {
+            return fnv1a_hash(key);
+        }
+
+        /**
+         *  Storages with the same schema on separate database files (shards). Objects are distributed over the
+         *  shards by a shard key, so writes to different shards don't wait for each other's write lock.
+         *
+         *  Object operations go to the shard of the object's key, which `shardKey(object)` returns. Operations
+         *  taking primary key values (`get`, `get_pointer`, `remove`) use the first one as the key, so the shard
+         *  key has to be the (first) primary key column for them to find their objects. Note that objects must
+         *  carry their key when they are inserted: rowids generated by the shards are unique only within a shard, so
+         *  `insert` stores the primary key of the object too rather than letting the shard generate one.
+         *
+         *  Queries (`get_all`, `select`, `count`, `remove_all`) run on all shards in parallel, one thread per shard,
+         *  and their results are concatenated in the order of the shards. `get_all_merged` and `select_merged` merge
+         *  results which every shard returns sorted (by an `order_by` condition) into one sorted result.
+         *
+         *  S - storage type (`storage_t`)
+         *  KeyFn - shard key extractor, called with a mapped object
+         */
+        template<class S, class KeyFn>
+        struct sharded_storage {
+            using storage_type = S;
+
+            sharded_storage(std::vector<std::unique_ptr<storage_type>> shards, KeyFn shardKey) :
+                shards{std::move(shards)}, shardKey{std::move(shardKey)} {}
+
+            size_t shards_count() const {
+                return this->shards.size();
+            }
+
+            storage_type& shard(size_t index) {
+                return *this->shards.at(index);
+            }
+
+            /**
+             *  Index of the shard objects with the given shard key live in. The mapping doesn't depend on the
+             *  standard library or the platform, so database files written by one build are read by another:
+             *  integral keys are taken modulo the number of shards (negative ones as their 64-bit two's complement),
+             *  strings are hashed with 64-bit FNV-1a first.
+             */
+            template<class K>
+            size_t shard_index(const K& key) const {
+                return size_t(shard_hash(key) % this->shards.size());
+            }
+
+            template<class K>
+            storage_type& shard_for(const K& key) {
+                return *this->shards[this->shard_index(key)];
+            }
+
+            /**
+             *  Syncs the schema of all shards, returns the result of the first one.
+             */
+            std::map<std::string, sync_schema_result> sync_schema(bool preserve = false) {
+                auto results = this->fan_out([preserve](storage_type& storage) {
+                    return storage.sync_schema(preserve);
+                });
+                return std::move(results.front());
+            }
+
+            /**
+             *  Inserts the object with all its columns including the primary key, which chooses the shard.
+             *  @return rowid of the inserted row, which equals an integer primary key.
+             */
+            template<class O>
+            int insert(const O& object) {
+                auto& storage = this->shard_of(object);
+                auto& table = pick_table<O>(obtain_db_objects(storage));
+                using elements_type = typename std::decay_t<decltype(table)>::elements_type;
+                return storage.insert(
+                    object,
+                    insertable_columns(table, col_index_sequence_excluding<elements_type, is_generated_always>{}));
+            }
+
+            template<class O>
+            void replace(const O& object) {
+                this->shard_of(object).replace(object);
+            }
+
+            template<class O>
+            void update(const O& object) {
+                this->shard_of(object).update(object);
+            }
+
+            template<class O, class K, class... Ids>
+            O get(const K& key, Ids... ids) {
+                return this->shard_for(key).template get<O>(key, std::forward<Ids>(ids)...);
+            }
+
+            template<class O, class K, class... Ids>
+            std::unique_ptr<O> get_pointer(const K& key, Ids... ids) {
+                return this->shard_for(key).template get_pointer<O>(key, std::forward<Ids>(ids)...);
+            }
+
+            template<class O, class K, class... Ids>
+            void remove(const K& key, Ids... ids) {
+                this->shard_for(key).template remove<O>(key, std::forward<Ids>(ids)...);
+            }
+
+            template<class O, class... Args>
+            std::vector<O> get_all(Args... args) {
+                return concatenate(this->fan_out([&args...](storage_type& storage) {
+                    return storage.template get_all<O>(args...);
+                }));
+            }
+
+            /**
+             *  Like `get_all` but merges the sorted results of the shards with `compare`, which has to order objects
+             *  the way the `order_by` passed with `args` does.
+             */
+            template<class O, class Compare, class... Args>
+            std::vector<O> get_all_merged(Compare compare, Args... args) {
+                return merge(this->fan_out([&args...](storage_type& storage) {
+                                 return storage.template get_all<O>(args...);
+                             }),
+                             compare);
+            }
+
+            template<class T, class... Args>
+            auto select(T expression, Args... args) {
+                return concatenate(this->fan_out([&expression, &args...](storage_type& storage) {
+                    return storage.select(expression, args...);
+                }));
+            }
+
+            /**
+             *  Like `select` but merges the sorted results of the shards with `compare`, which has to order rows
+             *  the way the `order_by` passed with `args` does.
+             */
+            template<class Compare, class T, class... Args>
+            auto select_merged(Compare compare, T expression, Args... args) {
+                return merge(this->fan_out([&expression, &args...](storage_type& storage) {
+                                 return storage.select(expression, args...);
+                             }),
+                             compare);
+            }
+
+            template<class O, class... Args>
+            int count(Args... args) {
+                int result = 0;
+                for(int shardCount: this->fan_out([&args...](storage_type& storage) {
+                        return storage.template count<O>(args...);
+                    })) {
+                    result += shardCount;
+                }
+                return result;
+            }
+
+            template<class O, class... Args>
+            void remove_all(Args... args) {
+                this->fan_out([&args...](storage_type& storage) {
+                    storage.template remove_all<O>(args...);
+                    return true;
+                });
+            }
+
+          private:
+            template<class O>
+            storage_type& shard_of(const O& object) {
+                return this->shard_for(this->shardKey(object));
+            }
+
+            /**
+             *  Calls `f` with every shard, the first shard on the calling thread and every other one on its own
+             *  thread, and returns the results in the order of the shards.
+             */
+            template<class F>
+            auto fan_out(const F& f) -> std::vector<decltype(f(std::declval<storage_type&>()))> {
+                using result_type = decltype(f(std::declval<storage_type&>()));
+                std::vector<std::future<result_type>> futures;
+                futures.reserve(this->shards.size() - 1);
+                for(size_t i = 1; i < this->shards.size(); ++i) {
+                    futures.push_back(std::async(std::launch::async, [&f, &storage = *this->shards[i]] {
+                        return f(storage);
+                    }));
+                }
+                std::vector<result_type> results;
+                results.reserve(this->shards.size());
+                results.push_back(f(*this->shards.front()));
+                for(auto& future: futures) {
+                    results.push_back(future.get());
+                }
+                return results;
+            }
+
+            template<class Table, size_t... Idx>
+            static auto insertable_columns(const Table& table, std::index_sequence<Idx...>) {
+                return columns(std::get<Idx>(table.elements).member_pointer...);
+            }
+
+            template<class R>
+            static R concatenate(std::vector<R> results) {
+                R result = std::move(results.front());
+                for(size_t i = 1; i < results.size(); ++i) {
+                    result.insert(result.end(),
+                                  std::make_move_iterator(results[i].begin()),
+                                  std::make_move_iterator(results[i].end()));
+                }
+                return result;
+            }
+
+            /**
+             *  k-way merge of sorted results using a heap of the current positions in the results.
+             */
+            template<class R, class Compare>
+            static R merge(std::vector<R> results, Compare& compare) {
+                using position = std::pair<typename R::iterator, typename R::iterator>;
+                std::vector<position> heap;
+                size_t size = 0;
+                for(auto& result: results) {
+                    size += result.size();
+                    if(!result.empty()) {
+                        heap.emplace_back(result.begin(), result.end());
+                    }
+                }
+                //  std heaps are max heaps, the top is the position with the smallest value
+                auto greater = [&compare](const position& lhs, const position& rhs) {
+                    return compare(*rhs.first, *lhs.first);
+                };
+                std::make_heap(heap.begin(), heap.end(), greater);
+                R merged;
+                merged.reserve(size);
+                while(!heap.empty()) {
+                    std::pop_heap(heap.begin(), heap.end(), greater);
+                    auto& top = heap.back();
+                    merged.push_back(std::move(*top.first));
+                    if(++top.first == top.second) {
+                        heap.pop_back();
+                    } else {
+                        std::push_heap(heap.begin(), heap.end(), greater);
+                    }
+                }
+                return merged;
+            }
+
+            std::vector<std::unique_ptr<storage_type>> shards;
+            KeyFn shardKey;
+        };
+    }
+
+    /**
+     *  Factory function for a sharded storage made of one storage per database file. `makeStorage(filename)` creates
+     *  the storage of a shard and `shardKey(object)` returns the shard key of a mapped object, e.g.
+     *  `make_sharded_storage(filenames, makeStorage, [](const auto& object) { return object.id; })`.
+     */
+    template<class MakeStorage, class KeyFn>
+    internal::sharded_storage<decltype(std::declval<MakeStorage&>()(std::string{})), KeyFn>
+    make_sharded_storage(const std::vector<std::string>& filenames, MakeStorage makeStorage, KeyFn shardKey) {
+        using storage_type = decltype(makeStorage(std::string{}));
+        if(filenames.empty()) {
+            throw std::system_error{orm_error_code::no_shards};
+        }
+        std::vector<std::unique_ptr<storage_type>> shards;
+        shards.reserve(filenames.size());
+        for(auto& filename: filenames) {
+            shards.emplace_back(new storage_type(makeStorage(filename)));
+        }
+        return {std::move(shards), std::move(shardKey)};
+    }
+}
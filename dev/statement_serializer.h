@@ -34,6 +34,7 @@
 #include "prepared_statement.h"
 #include "rowid.h"
 #include "pointer_value.h"
+#include "range_source.h"
 #include "type_printer.h"
 #include "field_printer.h"
 #include "literal.h"
@@ -154,7 +155,7 @@ namespace sqlite_orm {
             template<class Ctx>
             auto serialize(const statement_type& statement, const Ctx& context, const std::string& tableName) {
                 std::stringstream ss;
-                ss << "CREATE TABLE " << streaming_identifier(tableName) << " ("
+                ss << "CREATE TABLE " << streaming_identifier(statement.schema_name, tableName, std::string{}) << " ("
                    << streaming_expressions_tuple(statement.elements, context) << ")";
                 if(statement_type::is_without_rowid_v) {
                     ss << " WITHOUT ROWID";
@@ -240,6 +241,148 @@ namespace sqlite_orm {
             }
         };
 
+        template<class F, class W>
+        struct statement_serializer<over_t<F, W>, void> {
+            using statement_type = over_t<F, W>;
+
+            template<class Ctx>
+            std::string operator()(const statement_type& statement, const Ctx& context) const {
+                std::stringstream ss;
+                ss << serialize(statement.function, context) << " OVER " << serialize(statement.window, context);
+                return ss.str();
+            }
+        };
+
+        template<>
+        struct statement_serializer<window_ref_t, void> {
+            using statement_type = window_ref_t;
+
+            template<class Ctx>
+            std::string operator()(const statement_type& statement, const Ctx&) const {
+                std::stringstream ss;
+                ss << streaming_identifier(statement.name);
+                return ss.str();
+            }
+        };
+
+        template<class... Args>
+        struct statement_serializer<window_defn_t<Args...>, void> {
+            using statement_type = window_defn_t<Args...>;
+
+            template<class Ctx>
+            std::string operator()(const statement_type& statement, const Ctx& context) const {
+                std::stringstream ss;
+                ss << "(";
+                iterate_tuple(statement.args, [&ss, &context, first = true](auto& arg) mutable {
+                    constexpr std::array<const char*, 2> sep = {" ", ""};
+                    ss << sep[std::exchange(first, false)] << serialize(arg, context);
+                });
+                ss << ")";
+                return ss.str();
+            }
+        };
+
+        template<class... Args>
+        struct statement_serializer<window_t<Args...>, void> {
+            using statement_type = window_t<Args...>;
+
+            template<class Ctx>
+            std::string operator()(const statement_type& statement, const Ctx& context) const {
+                std::stringstream ss;
+                ss << "WINDOW " << streaming_identifier(statement.name) << " AS "
+                   << serialize(statement.definition, context);
+                return ss.str();
+            }
+        };
+
+        template<class... Args>
+        struct statement_serializer<partition_by_t<Args...>, void> {
+            using statement_type = partition_by_t<Args...>;
+
+            template<class Ctx>
+            std::string operator()(const statement_type& statement, const Ctx& context) const {
+                std::stringstream ss;
+                auto newContext = context;
+                newContext.skip_table_name = false;
+                ss << "PARTITION BY " << streaming_expressions_tuple(statement.args, newContext);
+                return ss.str();
+            }
+        };
+
+        template<class B, class E>
+        struct statement_serializer<frame_t<B, E>, void> {
+            using statement_type = frame_t<B, E>;
+
+            template<class Ctx>
+            std::string operator()(const statement_type& statement, const Ctx& context) const {
+                std::stringstream ss;
+                switch(statement.units) {
+                    case frame_units::rows:
+                        ss << "ROWS";
+                        break;
+                    case frame_units::range:
+                        ss << "RANGE";
+                        break;
+                    case frame_units::groups:
+                        ss << "GROUPS";
+                        break;
+                }
+                ss << " BETWEEN " << serialize(statement.start, context) << " AND "
+                   << serialize(statement.end, context);
+                return ss.str();
+            }
+        };
+
+        template<>
+        struct statement_serializer<unbounded_preceding_t, void> {
+            using statement_type = unbounded_preceding_t;
+
+            template<class Ctx>
+            std::string operator()(const statement_type&, const Ctx&) const {
+                return "UNBOUNDED PRECEDING";
+            }
+        };
+
+        template<>
+        struct statement_serializer<current_row_t, void> {
+            using statement_type = current_row_t;
+
+            template<class Ctx>
+            std::string operator()(const statement_type&, const Ctx&) const {
+                return "CURRENT ROW";
+            }
+        };
+
+        template<>
+        struct statement_serializer<unbounded_following_t, void> {
+            using statement_type = unbounded_following_t;
+
+            template<class Ctx>
+            std::string operator()(const statement_type&, const Ctx&) const {
+                return "UNBOUNDED FOLLOWING";
+            }
+        };
+
+        template<class T>
+        struct statement_serializer<preceding_t<T>, void> {
+            using statement_type = preceding_t<T>;
+
+            template<class Ctx>
+            std::string operator()(const statement_type& statement, const Ctx& context) const {
+                return serialize(statement.expression, context) + " PRECEDING";
+            }
+        };
+
+        template<class T>
+        struct statement_serializer<following_t<T>, void> {
+            using statement_type = following_t<T>;
+
+            template<class Ctx>
+            std::string operator()(const statement_type& statement, const Ctx& context) const {
+                return serialize(statement.expression, context) + " FOLLOWING";
+            }
+        };
+
         template<class T>
         struct statement_serializer<excluded_t<T>, void> {
             using statement_type = excluded_t<T>;
@@ -302,6 +445,22 @@ namespace sqlite_orm {
             }
         };
 
+#if SQLITE_VERSION_NUMBER >= 3020000
+        template<class O>
+        struct statement_serializer<range_source_t<O>, void> {
+            using statement_type = range_source_t<O>;
+
+            template<class Ctx>
+            std::string operator()(const statement_type&, const Ctx& context) const {
+                std::stringstream ss;
+                ss << streaming_identifier(lookup_table_name<O>(context.db_objects)) << "."
+                   << streaming_identifier(range_source_column_name()) << " = "
+                   << (context.replace_bindable_with_question ? "?" : "NULL");
+                return ss.str();
+            }
+        };
+#endif
+
         template<char... C>
         struct statement_serializer<column_alias<C...>, void> {
             using statement_type = column_alias<C...>;
@@ -362,6 +521,10 @@ namespace sqlite_orm {
         struct statement_serializer<built_in_aggregate_function_t<R, S, Args...>, void>
             : statement_serializer<built_in_function_t<R, S, Args...>, void> {};
 
+        template<class R, class S, class... Args>
+        struct statement_serializer<built_in_window_function_t<R, S, Args...>, void>
+            : statement_serializer<built_in_function_t<R, S, Args...>, void> {};
+
         template<class F, class... CallArgs>
         struct statement_serializer<function_call<F, CallArgs...>, void> {
             using statement_type = function_call<F, CallArgs...>;
@@ -1229,7 +1392,7 @@ namespace sqlite_orm {
                 auto& table = pick_table<T>(context.db_objects);
 
                 std::stringstream ss;
-                ss << "DELETE FROM " << streaming_identifier(table.name)
+                ss << "DELETE FROM " << streaming_identifier(table_schema_name(table), table.name, std::string{})
                    << streaming_conditions_tuple(rem.conditions, context);
                 return ss.str();
             }
@@ -1244,8 +1407,8 @@ namespace sqlite_orm {
                 using object_type = expression_object_type_t<statement_type>;
                 auto& table = pick_table<object_type>(context.db_objects);
                 std::stringstream ss;
-                ss << "REPLACE INTO " << streaming_identifier(table.name) << " ("
-                   << streaming_non_generated_column_names(table) << ")"
+                ss << "REPLACE INTO " << streaming_identifier(table_schema_name(table), table.name, std::string{})
+                   << " (" << streaming_non_generated_column_names(table) << ")"
                    << " VALUES ("
                    << streaming_field_values_excluding(check_if<is_generated_always>{},
                                                        empty_callable<std::false_type>,  //  don't exclude
@@ -1267,7 +1430,8 @@ namespace sqlite_orm {
                 using object_type = expression_object_type_t<statement_type>;
                 auto& table = pick_table<object_type>(context.db_objects);
                 std::stringstream ss;
-                ss << "INSERT INTO " << streaming_identifier(table.name) << " ";
+                ss << "INSERT INTO " << streaming_identifier(table_schema_name(table), table.name, std::string{})
+                   << " ";
                 ss << "(" << streaming_mapped_columns_expressions(ins.columns.columns, context) << ") "
                    << "VALUES (";
                 iterate_tuple(ins.columns.columns,
@@ -1295,7 +1459,7 @@ namespace sqlite_orm {
                 auto& table = pick_table<object_type>(context.db_objects);
 
                 std::stringstream ss;
-                ss << "UPDATE " << streaming_identifier(table.name) << " SET ";
+                ss << "UPDATE " << streaming_identifier(table_schema_name(table), table.name, std::string{}) << " SET ";
                 table.template for_each_column_excluding<mpl::disjunction_fn<is_primary_key, is_generated_always>>(
                     [&table, &ss, &context, &object = get_ref(statement.object), first = true](auto& column) mutable {
                         if(exists_in_composite_primary_key(table, column)) {
@@ -1360,25 +1524,30 @@ namespace sqlite_orm {
             }
         };
 
+        /**
+         *  Collects the tables of the assigned columns, i.e. the table being updated.
+         *  The assigned values may refer to other tables by means of subqueries or `UPDATE ... FROM`.
+         */
         template<class Ctx, class... Args>
-        std::set<std::pair<std::string, std::string>> collect_table_names(const set_t<Args...>& set, const Ctx& ctx) {
+        table_name_collector_base collect_table_names(const set_t<Args...>& set, const Ctx& ctx) {
             auto collector = make_table_name_collector(ctx.db_objects);
-            iterate_ast(set, collector);
-            return std::move(collector.table_names);
+            iterate_tuple(set.assigns, [&collector](auto& assign) {
+                iterate_ast(assign.lhs, collector);
+            });
+            return std::move(collector);
         }
 
         template<class Ctx, class C>
-        const std::set<std::pair<std::string, std::string>>& collect_table_names(const dynamic_set_t<C>& set,
-                                                                                 const Ctx&) {
-            return set.collector.table_names;
+        const table_name_collector_base& collect_table_names(const dynamic_set_t<C>& set, const Ctx&) {
+            return set.collector;
         }
 
         template<class Ctx, class T, satisfies<is_select, T> = true>
-        std::set<std::pair<std::string, std::string>> collect_table_names(const T& sel, const Ctx& ctx) {
+        table_name_collector_base collect_table_names(const T& sel, const Ctx& ctx) {
             auto collector = make_table_name_collector(ctx.db_objects);
             iterate_ast(sel.col, collector);
             iterate_ast(sel.conditions, collector);
-            return std::move(collector.table_names);
+            return std::move(collector);
         }
 
         template<class S, class... Wargs>
@@ -1386,20 +1555,43 @@ namespace sqlite_orm {
             using statement_type = update_all_t<S, Wargs...>;
 
             template<class Ctx>
-            std::string operator()(const statement_type& statement, const Ctx& context) const {
-                const auto& tableNames = collect_table_names(statement.set, context);
-                if(tableNames.empty()) {
+            std::string operator()(const statement_type& statement, Ctx context) const {
+                const auto& tables = collect_table_names(statement.set, context);
+                if(tables.table_names.empty()) {
                     throw std::system_error{orm_error_code::no_tables_specified};
                 }
-                const std::string& tableName = tableNames.begin()->first;
+                const std::string& tableName = tables.table_names.begin()->first;
+                const std::string& schemaName = tables.table_schemas.at(*tables.table_names.begin());
+                // UPDATE ... FROM: columns of the updated table and of the joined tables must be told apart
+                if(tuple_has<typename statement_type::conditions_type, is_from>::value) {
+                    context.skip_table_name = false;
+                }
 
                 std::stringstream ss;
-                ss << "UPDATE " << streaming_identifier(tableName) << ' ' << serialize(statement.set, context)
+                ss << "UPDATE " << streaming_identifier(schemaName, tableName, std::string{}) << ' '
+                   << serialize(statement.set, context)
                    << streaming_conditions_tuple(statement.conditions, context);
                 return ss.str();
             }
         };
 
+#if SQLITE_VERSION_NUMBER >= 3035000
+        template<class S, class C>
+        struct statement_serializer<returning_t<S, C>, void> {
+            using statement_type = returning_t<S, C>;
+
+            template<class Ctx>
+            std::string operator()(const statement_type& statement, Ctx context) const {
+                std::stringstream ss;
+                ss << serialize(statement.statement, context);
+                // columns can only refer to the modified table, qualified names are not allowed
+                context.skip_table_name = true;
+                ss << " RETURNING " << streaming_serialized(get_column_names(statement.columns, context));
+                return ss.str();
+            }
+        };
+#endif
+
         template<class T>
         struct statement_serializer<insert_t<T>, void> {
             using statement_type = insert_t<T>;
@@ -1424,7 +1616,8 @@ namespace sqlite_orm {
                 const size_t columnNamesCount = columnNames.size();
 
                 std::stringstream ss;
-                ss << "INSERT INTO " << streaming_identifier(table.name) << " ";
+                ss << "INSERT INTO " << streaming_identifier(table_schema_name(table), table.name, std::string{})
+                   << " ";
                 if(columnNamesCount) {
                     ss << "(" << streaming_identifiers(columnNames) << ")";
                 } else {
@@ -1457,7 +1650,7 @@ namespace sqlite_orm {
                 auto& table = pick_table<T>(context.db_objects);
 
                 std::stringstream ss;
-                ss << "INTO " << streaming_identifier(table.name);
+                ss << "INTO " << streaming_identifier(table_schema_name(table), table.name, std::string{});
                 return ss.str();
             }
         };
@@ -1526,7 +1719,7 @@ namespace sqlite_orm {
             std::string operator()(const statement_type& statement, const Ctx& context) const {
                 auto& table = pick_table<T>(context.db_objects);
                 std::stringstream ss;
-                ss << "DELETE FROM " << streaming_identifier(table.name) << " "
+                ss << "DELETE FROM " << streaming_identifier(table_schema_name(table), table.name, std::string{}) << " "
                    << "WHERE ";
                 std::vector<std::string> idsStrings;
                 idsStrings.reserve(std::tuple_size<typename statement_type::ids_type>::value);
@@ -1557,8 +1750,8 @@ namespace sqlite_orm {
                 auto& table = pick_table<object_type>(context.db_objects);
 
                 std::stringstream ss;
-                ss << "REPLACE INTO " << streaming_identifier(table.name) << " ("
-                   << streaming_non_generated_column_names(table) << ")";
+                ss << "REPLACE INTO " << streaming_identifier(table_schema_name(table), table.name, std::string{})
+                   << " (" << streaming_non_generated_column_names(table) << ")";
                 const auto valuesCount = std::distance(rep.range.first, rep.range.second);
                 const auto columnsCount = table.template count_of_columns_excluding<is_generated_always>();
                 ss << " VALUES " << streaming_values_placeholders(columnsCount, valuesCount);
@@ -1591,7 +1784,8 @@ namespace sqlite_orm {
                 const size_t columnNamesCount = columnNames.size();
 
                 std::stringstream ss;
-                ss << "INSERT INTO " << streaming_identifier(table.name) << " ";
+                ss << "INSERT INTO " << streaming_identifier(table_schema_name(table), table.name, std::string{})
+                   << " ";
                 if(columnNamesCount) {
                     ss << "(" << streaming_identifiers(columnNames) << ")";
                 } else {
@@ -1616,7 +1810,8 @@ namespace sqlite_orm {
 
             std::stringstream ss;
             ss << "SELECT " << streaming_table_column_names(table, alias_extractor<table_type>::as_qualifier(table))
-               << " FROM " << streaming_identifier(table.name, alias_extractor<table_type>::as_alias())
+               << " FROM "
+               << streaming_identifier(table_schema_name(table), table.name, alias_extractor<table_type>::as_alias())
                << streaming_conditions_tuple(getAll.conditions, context);
             return ss.str();
         }
@@ -1659,7 +1854,7 @@ namespace sqlite_orm {
             auto& table = pick_table<primary_type>(context.db_objects);
             std::stringstream ss;
             ss << "SELECT " << streaming_table_column_names(table, std::string{}) << " FROM "
-               << streaming_identifier(table.name) << " WHERE ";
+               << streaming_identifier(table_schema_name(table), table.name, std::string{}) << " WHERE ";
 
             auto primaryKeyColumnNames = table.primary_key_column_names();
             if(primaryKeyColumnNames.empty()) {
@@ -1766,7 +1961,8 @@ namespace sqlite_orm {
                 using conditions_tuple = typename statement_type::conditions_type;
                 constexpr bool hasExplicitFrom = tuple_has<conditions_tuple, is_from>::value;
                 if(!hasExplicitFrom) {
-                    auto tableNames = collect_table_names(sel, context);
+                    auto tables = collect_table_names(sel, context);
+                    auto& tableNames = tables.table_names;
                     using joins_index_sequence = filter_tuple_sequence_t<conditions_tuple, is_constrained_join>;
                     // deduplicate table names of constrained join statements
                     iterate_tuple(sel.conditions, joins_index_sequence{}, [&tableNames, &context](auto& join) {
@@ -1778,10 +1974,40 @@ namespace sqlite_orm {
                         tableNames.erase(tableNameWithAlias);
                     });
                     if(!tableNames.empty() && !is_compound_operator<T>::value) {
-                        ss << " FROM " << streaming_identifiers(tableNames);
+                        // tables of attached databases are qualified with their schema
+                        std::vector<std::tuple<std::string, const std::string&, const std::string&>> identifiers;
+                        identifiers.reserve(tableNames.size());
+                        for(auto& tableName: tableNames) {
+                            identifiers.emplace_back(tables.table_schemas.at(tableName),
+                                                     tableName.first,
+                                                     tableName.second);
+                        }
+                        ss << " FROM " << streaming_identifiers(identifiers);
                     }
                 }
-                ss << streaming_conditions_tuple(sel.conditions, context);
+                if(tuple_has<conditions_tuple, is_window>::value) {
+                    //  the WINDOW clause goes between HAVING and ORDER BY, wherever the windows were passed
+                    auto serializeCondition = [&ss, &context](auto& condition) {
+                        ss << " " << serialize(condition, context);
+                    };
+                    iterate_tuple(sel.conditions,
+                                  filter_tuple_sequence_t<conditions_tuple, is_window_predecessor>{},
+                                  serializeCondition);
+                    //  all named windows make up one clause
+                    ss << " WINDOW ";
+                    iterate_tuple(sel.conditions,
+                                  filter_tuple_sequence_t<conditions_tuple, is_window>{},
+                                  [&ss, &context, first = true](auto& window) mutable {
+                                      constexpr std::array<const char*, 2> sep = {", ", ""};
+                                      ss << sep[std::exchange(first, false)] << streaming_identifier(window.name)
+                                         << " AS " << serialize(window.definition, context);
+                                  });
+                    iterate_tuple(sel.conditions,
+                                  filter_tuple_sequence_t<conditions_tuple, is_window_successor>{},
+                                  serializeCondition);
+                } else {
+                    ss << streaming_conditions_tuple(sel.conditions, context);
+                }
                 if(!is_compound_operator<T>::value) {
                     if(!sel.highest_level && context.use_parentheses) {
                         ss << ")";
@@ -1861,8 +2087,12 @@ namespace sqlite_orm {
                     ss << "UNIQUE ";
                 }
                 using indexed_type = typename std::decay_t<decltype(statement)>::table_mapped_type;
-                ss << "INDEX IF NOT EXISTS " << streaming_identifier(statement.name) << " ON "
-                   << streaming_identifier(lookup_table_name<indexed_type>(context.db_objects));
+                // an index lives in the schema of its table
+                ss << "INDEX IF NOT EXISTS "
+                   << streaming_identifier(lookup_table_schema<indexed_type>(context.db_objects),
+                                           statement.name,
+                                           std::string{})
+                   << " ON " << streaming_identifier(lookup_table_name<indexed_type>(context.db_objects));
                 std::vector<std::string> columnNames;
                 std::string whereString;
                 iterate_tuple(statement.elements, [&columnNames, &context, &whereString](auto& value) {
@@ -1897,8 +2127,10 @@ namespace sqlite_orm {
                     using table_type = std::remove_pointer_t<decltype(dummyItem)>;
 
                     constexpr std::array<const char*, 2> sep = {", ", ""};
+                    using mapped_type = mapped_type_proxy_t<table_type>;
                     ss << sep[std::exchange(first, false)]
-                       << streaming_identifier(lookup_table_name<mapped_type_proxy_t<table_type>>(context.db_objects),
+                       << streaming_identifier(lookup_table_schema<mapped_type>(context.db_objects),
+                                               lookup_table_name<mapped_type>(context.db_objects),
                                                alias_extractor<table_type>::as_alias());
                 });
                 return ss.str();
@@ -2130,7 +2362,9 @@ namespace sqlite_orm {
             std::string operator()(const statement_type& join, const Ctx& context) const {
                 std::stringstream ss;
                 ss << static_cast<std::string>(join) << " "
-                   << streaming_identifier(lookup_table_name<type_t<Join>>(context.db_objects));
+                   << streaming_identifier(lookup_table_schema<type_t<Join>>(context.db_objects),
+                                           lookup_table_name<type_t<Join>>(context.db_objects),
+                                           std::string{});
                 return ss.str();
             }
         };
@@ -2142,8 +2376,10 @@ namespace sqlite_orm {
             template<class Ctx>
             std::string operator()(const statement_type& join, const Ctx& context) const {
                 std::stringstream ss;
+                using mapped_type = mapped_type_proxy_t<type_t<Join>>;
                 ss << static_cast<std::string>(join) << " "
-                   << streaming_identifier(lookup_table_name<mapped_type_proxy_t<type_t<Join>>>(context.db_objects),
+                   << streaming_identifier(lookup_table_schema<mapped_type>(context.db_objects),
+                                           lookup_table_name<mapped_type>(context.db_objects),
                                            alias_extractor<type_t<Join>>::as_alias())
                    << " " << serialize(join.constraint, context);
                 return ss.str();
@@ -8,10 +8,14 @@
 #include <functional>  //   std::identity
 #include <sstream>  //  std::stringstream
 #include <map>  //  std::map
+#include <set>  //  std::set
 #include <vector>  //  std::vector
 #include <tuple>  //  std::tuple_size, std::tuple, std::make_tuple, std::tie
 #include <utility>  //  std::forward, std::pair
-#include <algorithm>  //  std::for_each, std::ranges::for_each
+#include <algorithm>  //  std::for_each, std::ranges::for_each, std::max, std::find
+#include <cstdint>  //  std::uint64_t
+#include <future>  //  std::future, std::async
+#include <iterator>  //  std::make_move_iterator
 #include "functional/cxx_optional.h"
 
 #include "functional/cxx_universal.h"
@@ -37,11 +41,14 @@
 #include "column_result.h"
 #include "mapped_type_proxy.h"
 #include "sync_schema_result.h"
+#include "online_migration.h"
+#include "schema_fingerprint.h"
 #include "table_info.h"
 #include "storage_impl.h"
 #include "journal_mode.h"
 #include "mapped_view.h"
 #include "result_set_view.h"
+#include "pipelined_view.h"
 #include "ast_iterator.h"
 #include "storage_base.h"
 #include "prepared_statement.h"
@@ -96,8 +103,40 @@ namespace sqlite_orm {
 
             storage_t(const storage_t&) = default;
 
+            /**
+             *  Returns an independent in-memory storage with the schema objects of this storage and a copy of its
+             *  database, which makes it cheap to create many fixtures from one prepared template.
+             *  The database is copied in one step: an image deserialized into memory is copied directly
+             *  from the contiguous memory holding it, any other database page by page with the backup API.
+             *  The clone is configured like a copy of this storage, except that only the main database is cloned:
+             *  databases attached with `attach()` are neither copied nor attached to the clone, so that writing to it
+             *  never changes the files of the template.
+             */
+            storage_t clone_in_memory() {
+                //  constructed in place, a copy of an in-memory storage would connect to a new empty database
+                return {*this, ":memory:"};
+            }
+
           private:
+            /**
+             *  Copy of `source` together with its database, connected to `filename`.
+             */
+            storage_t(storage_t& source, std::string filename) :
+                storage_base{source, std::move(filename), {}}, db_objects{source.db_objects} {
+#if SQLITE_VERSION_NUMBER >= 3036000 && !defined(SQLITE_OMIT_DESERIALIZE)
+                auto con = source.get_connection();
+                sqlite3_int64 size = 0;
+                if(auto data = sqlite3_serialize(con.get(), "main", &size, SQLITE_SERIALIZE_NOCOPY)) {
+                    this->deserialize_internal(reinterpret_cast<const char*>(data), size, false);
+                    return;
+                }
+#endif
+                source.backup_to(*this);
+            }
+
             db_objects_type db_objects;
+            //  set while `sync_schema_online()` runs
+            const online_migration_options* onlineMigration = nullptr;
 
             /**
              *  Obtain a storage_t's const db_objects_tuple.
@@ -137,10 +176,115 @@ namespace sqlite_orm {
                             const Table& table,
                             const std::vector<const table_xinfo*>& columnsToIgnore) const;
 
+            /**
+             *  Copies sourceTableName to destinationTableName like `copy_table` but in rowid ordered chunks,
+             *  each in its own transaction, while triggers mirror concurrent writes to the source table.
+             *  Then replaces the source table with the copy in one transaction.
+             */
+            template<class Table>
+            void copy_table_online(sqlite3* db,
+                                   const std::string& sourceTableName,
+                                   const std::string& destinationTableName,
+                                   const Table& table,
+                                   const std::vector<const table_xinfo*>& columnsToIgnore,
+                                   const online_migration_options& options);
+
+            /**
+             *  Whether rows keep their rowids when copied from the existing table, which is required to mirror writes
+             *  by rowid. It is not the case if the INTEGER PRIMARY KEY (rowid alias) of the table changes.
+             */
+            template<class Table>
+            bool keeps_rowids(const Table& table) {
+                auto rowidAlias = [](const auto& tableInfo) {
+                    const std::string* result = nullptr;
+                    int primaryKeyColumnsCount = 0;
+                    for(auto& columnInfo: tableInfo) {
+                        if(columnInfo.pk) {
+                            ++primaryKeyColumnsCount;
+                            if(columnInfo.type == "INTEGER" || columnInfo.type == "integer") {
+                                result = &columnInfo.name;
+                            }
+                        }
+                    }
+                    return primaryKeyColumnsCount == 1 && result ? *result : std::string{};
+                };
+                return rowidAlias(table.get_table_info()) ==
+                       rowidAlias(this->pragma.table_xinfo(table.schema_name, table.name));
+            }
+
+            /**
+             *  Hash of the SQL creating every schema object of the storage, so it changes with any mapping change
+             *  `sync_schema()` would have to apply.
+             */
+            std::string schema_fingerprint() {
+                using context_t = serializer_context<db_objects_type>;
+                context_t context{this->db_objects};
+                std::string definitions;
+                iterate_tuple(this->db_objects, [&definitions, &context](auto& schemaObject) {
+                    definitions += internal::serialize(schemaObject, context);
+                    definitions += ";\n";
+                });
+                //  range tables aren't created by `sync_schema()`
+                for(auto& p: this->rangeTables) {
+                    definitions += p.first;
+                    definitions += ";\n";
+                }
+                return schema_fingerprint_hash(definitions);
+            }
+
+            int schema_version(sqlite3* db) {
+                int result = 0;
+                perform_exec(db, "PRAGMA schema_version", extract_single_value<int>, &result);
+                return result;
+            }
+
+            /**
+             *  Whether `fingerprint` is the one stored by the last `sync_schema_if_changed()` and the schema of
+             *  the database hasn't been changed since then.
+             */
+            bool schema_fingerprint_matches(sqlite3* db, const std::string& fingerprint) {
+                std::stringstream ss;
+                ss << "SELECT \"fingerprint\", \"schema_version\" FROM "
+                   << streaming_identifier(schema_fingerprint_table_name()) << " WHERE \"id\" = 1" << std::flush;
+                sqlite3_stmt* stmt = nullptr;
+                //  fails if no fingerprint has been stored yet
+                if(sqlite3_prepare_v2(db, ss.str().c_str(), -1, &stmt, nullptr) != SQLITE_OK) {
+                    return false;
+                }
+                statement_finalizer finalizer{stmt};
+                if(sqlite3_step(stmt) != SQLITE_ROW) {
+                    return false;
+                }
+                auto storedFingerprint = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 0));
+                return storedFingerprint && fingerprint == storedFingerprint &&
+                       sqlite3_column_int(stmt, 1) == this->schema_version(db);
+            }
+
+            void store_schema_fingerprint(sqlite3* db, const std::string& fingerprint) {
+                const std::string tableName = schema_fingerprint_table_name();
+                {
+                    std::stringstream ss;
+                    ss << "CREATE TABLE IF NOT EXISTS " << streaming_identifier(tableName)
+                       << " (\"id\" INTEGER PRIMARY KEY CHECK (\"id\" = 1), \"fingerprint\" TEXT NOT NULL, "
+                          "\"schema_version\" INTEGER NOT NULL)"
+                       << std::flush;
+                    perform_void_exec(db, ss.str());
+                }
+                //  read after the table is created because creating it changes the schema version
+                std::stringstream ss;
+                ss << "REPLACE INTO " << streaming_identifier(tableName)
+                   << " (\"id\", \"fingerprint\", \"schema_version\") VALUES (1, " << quote_string_literal(fingerprint)
+                   << ", " << this->schema_version(db) << ")" << std::flush;
+                perform_void_exec(db, ss.str());
+            }
+
 #if SQLITE_VERSION_NUMBER >= 3035000  //  DROP COLUMN feature exists (v3.35.0)
-            void drop_column(sqlite3* db, const std::string& tableName, const std::string& columnName) {
+            void drop_column(sqlite3* db,
+                             const std::string& schemaName,
+                             const std::string& tableName,
+                             const std::string& columnName) {
                 std::stringstream ss;
-                ss << "ALTER TABLE " << streaming_identifier(tableName) << " DROP COLUMN "
+                ss << "ALTER TABLE " << streaming_identifier(schemaName, tableName, std::string{}) << " DROP COLUMN "
                    << streaming_identifier(columnName) << std::flush;
                 perform_void_exec(db, ss.str());
             }
@@ -149,7 +293,7 @@ namespace sqlite_orm {
             template<class Table>
             void drop_create_with_loss(sqlite3* db, const Table& table) {
                 // eliminated all transaction handling
-                this->drop_table_internal(db, table.name);
+                this->drop_table_internal(db, table.schema_name, table.name);
                 this->create_table(db, table.name, table);
             }
 
@@ -159,13 +303,13 @@ namespace sqlite_orm {
                 //  here we copy source table to another with a name with '_backup' suffix, but in case table with such
                 //  a name already exists we append suffix 1, then 2, etc until we find a free name..
                 auto backupTableName = table.name + "_backup";
-                if(this->table_exists(db, backupTableName)) {
+                if(this->table_exists(db, table.schema_name, backupTableName)) {
                     int suffix = 1;
                     do {
                         std::stringstream ss;
                         ss << suffix << std::flush;
                         auto anotherBackupTableName = backupTableName + ss.str();
-                        if(!this->table_exists(db, anotherBackupTableName)) {
+                        if(!this->table_exists(db, table.schema_name, anotherBackupTableName)) {
                             backupTableName = std::move(anotherBackupTableName);
                             break;
                         }
@@ -174,11 +318,23 @@ namespace sqlite_orm {
                 }
                 this->create_table(db, backupTableName, table);
 
+                //  chunks are committed separately, so the copy can't be online inside of a transaction
+                if(this->onlineMigration && !Table::is_without_rowid_v && sqlite3_get_autocommit(db) &&
+                   this->keeps_rowids(table)) {
+                    this->copy_table_online(db,
+                                            table.name,
+                                            backupTableName,
+                                            table,
+                                            columnsToIgnore,
+                                            *this->onlineMigration);
+                    return;
+                }
+
                 this->copy_table(db, table.name, backupTableName, table, columnsToIgnore);
 
-                this->drop_table_internal(db, table.name);
+                this->drop_table_internal(db, table.schema_name, table.name);
 
-                this->rename_table(db, backupTableName, table.name);
+                this->rename_table(db, table.schema_name, backupTableName, table.name);
             }
 
             template<class O>
@@ -242,6 +398,43 @@ namespace sqlite_orm {
                 return pick_table<O>(this->db_objects);
             }
 
+            /**
+             *  Splits the span between the smallest and the largest rowid of the table of `O` into at most
+             *  `partitions` inclusive ranges of the same size; no range if the table is empty.
+             */
+            template<class O>
+            std::vector<std::pair<int64, int64>> rowid_ranges(int partitions) {
+                std::vector<std::pair<int64, int64>> res;
+                auto bounds = this->select(columns(sqlite_orm::min(rowid<O>()), sqlite_orm::max(rowid<O>())));
+                if(bounds.empty() || !std::get<0>(bounds.front())) {
+                    return res;
+                }
+                const int64 first = *std::get<0>(bounds.front());
+                const int64 last = *std::get<1>(bounds.front());
+                //  unsigned arithmetic on offsets from `first` doesn't overflow even for the full int64 range
+                const auto span = std::uint64_t(last) - std::uint64_t(first);
+                const auto count = std::uint64_t(std::max(partitions, 1));
+                const auto size = span / count + 1;
+                for(std::uint64_t offset = 0;; offset += size) {
+                    bool isLast = res.size() + 1 == count || span - offset < size;
+                    res.emplace_back(int64(std::uint64_t(first) + offset),
+                                     isLast ? last : int64(std::uint64_t(first) + offset + size - 1));
+                    if(isLast) {
+                        return res;
+                    }
+                }
+            }
+
+            template<class O>
+            static auto partition_where(std::pair<int64, int64> range) {
+                return where(between(rowid<O>(), range.first, range.second));
+            }
+
+            template<class O, class C>
+            static auto partition_where(std::pair<int64, int64> range, const where_t<C>& condition) {
+                return where(and_(between(rowid<O>(), range.first, range.second), condition.expression));
+            }
+
           public:
             template<class T, class O = mapped_type_proxy_t<T>, class... Args>
             mapped_view<O, self, Args...> iterate(Args&&... args) {
@@ -281,6 +474,118 @@ namespace sqlite_orm {
 #endif
 #endif
 
+            /**
+             *  Iterates over the rows of `expression` while a background thread steps the statement and extracts the
+             *  next rows into a queue of up to `queueDepth` rows. So stepping overlaps with the processing of the
+             *  rows, which pays off if the caller does more than a trivial amount of work per row.
+             *  The background thread uses the storage's connection until the returned view is destroyed, don't use
+             *  the storage meanwhile. Destroying the view before the last row stops the background thread.
+             *  @example for(auto& row: storage.iterate_pipelined(select(columns(&User::id, &User::name)))) {...}
+             */
+            template<class T, class... Args>
+            auto iterate_pipelined(select_t<T, Args...> expression, size_t queueDepth = 256) {
+                using ColResult = column_result_of_t<db_objects_type, T>;
+                using row_extractor_type = decltype(make_row_extractor<ColResult>(this->db_objects));
+                using R = decltype(std::declval<row_extractor_type>().extract(nullptr, 0));
+                auto statement =
+                    std::make_shared<prepared_statement_t<select_t<T, Args...>>>(this->prepare(std::move(expression)));
+                iterate_ast(statement->expression, conditional_binder{statement->stmt});
+                return pipelined_view<R>{
+                    statement,
+                    queueDepth,
+                    [stmt = statement->stmt,
+                     rowExtractor = make_row_extractor<ColResult>(this->db_objects)](row_queue<R>& queue) {
+                        int rc;
+                        while((rc = sqlite3_step(stmt)) == SQLITE_ROW) {
+                            if(!queue.push(rowExtractor.extract(stmt, 0))) {
+                                return;
+                            }
+                        }
+                        if(rc != SQLITE_DONE) {
+                            throw_translated_sqlite_error(stmt);
+                        }
+                    }};
+            }
+
+            /**
+             *  Calls `callback(object, partition)` for every object of type `O` (matching an optional `where`
+             *  condition), scanning the table in up to `partitions` rowid ranges in parallel. The ranges split the span
+             *  between the smallest and the largest rowid evenly. Every range is read on its own connection and thread,
+             *  the first one on the calling thread. So `callback` is called concurrently for different partitions but
+             *  sequentially and in rowid order within a partition, e.g. to fill per partition accumulators.
+             *  Note: partitions are read in separate read transactions, they don't see changes not committed yet on
+             *  the storage's connection. The other partitions are read by copies of the storage, whose connections get
+             *  the `on_open` callback and attached databases but no functions, collations, busy handler, retry policy,
+             *  limits or pragmas registered on this storage, so `conditions` must not depend on them.
+             *  An in-memory database is scanned partition by partition on the calling thread.
+             *  The number of partitions isn't limited to the number of hardware threads since scans are often
+             *  bound by I/O rather than by CPU, choose it according to the workload.
+             *  @example storage.parallel_for_each<User>(8, [&counts](const User& user, int partition) {
+             *               ++counts[partition];
+             *           }, where(c(&User::age) > 18));
+             */
+            template<class O, class F, class... Args>
+            void parallel_for_each(int partitions, F callback, Args... conditions) {
+                static_assert(sizeof...(Args) <= 1 && polyfill::conjunction_v<is_where<Args>...>,
+                              "parallel_for_each accepts a single `where` condition");
+                static_assert(!storage_pick_table_t<O, db_objects_type>::is_without_rowid_v,
+                              "parallel_for_each needs a table with rowids");
+                this->assert_mapped_type<O>();
+                auto ranges = this->rowid_ranges<O>(partitions);
+                if(ranges.empty()) {
+                    return;
+                }
+                auto scan = [&callback, &conditions...](self& storage, int partition, std::pair<int64, int64> range) {
+                    for(auto& object: storage.template iterate<O>(partition_where<O>(range, conditions...))) {
+                        callback(object, partition);
+                    }
+                };
+                if(this->inMemory) {
+                    for(size_t i = 0; i < ranges.size(); ++i) {
+                        scan(*this, int(i), ranges[i]);
+                    }
+                    return;
+                }
+                //  copies of a storage connect to the same database file on their own
+                std::vector<std::unique_ptr<self>> readers;
+                std::vector<std::future<void>> futures;
+                readers.reserve(ranges.size() - 1);
+                futures.reserve(ranges.size() - 1);
+                for(size_t i = 1; i < ranges.size(); ++i) {
+                    readers.emplace_back(new self(*this));
+                    futures.push_back(
+                        std::async(std::launch::async, [&scan, &reader = *readers.back(), i, range = ranges[i]] {
+                            scan(reader, int(i), range);
+                        }));
+                }
+                scan(*this, 0, ranges.front());
+                for(auto& future: futures) {
+                    future.get();
+                }
+            }
+
+            /**
+             *  Like `get_all<O>(where(...))` but reads the table with `parallel_for_each`. Partitions are
+             *  concatenated in their order, so objects are ordered by rowid.
+             */
+            template<class O, class... Args>
+            std::vector<O> parallel_get_all(int partitions, Args... conditions) {
+                std::vector<std::vector<O>> partitionObjects(std::max(partitions, 1));
+                this->parallel_for_each<O>(
+                    partitions,
+                    [&partitionObjects](O& object, int partition) {
+                        partitionObjects[partition].push_back(std::move(object));
+                    },
+                    std::move(conditions)...);
+                std::vector<O> res;
+                for(auto& objects: partitionObjects) {
+                    res.insert(res.end(),
+                               std::make_move_iterator(objects.begin()),
+                               std::make_move_iterator(objects.end()));
+                }
+                return res;
+            }
+
             /**
              * Delete from routine.
              * O is an object's type. Must be specified explicitly.
@@ -454,6 +759,13 @@ namespace sqlite_orm {
             template<class O, class... Ids>
             O get(Ids... ids) {
                 this->assert_mapped_type<O>();
+                std::shared_ptr<const O> object;
+                if(this->get_through_cache<O>(object, ids...)) {
+                    if(object) {
+                        return *object;
+                    }
+                    throw std::system_error{orm_error_code::not_found};
+                }
                 auto statement = this->prepare(sqlite_orm::get<O>(std::forward<Ids>(ids)...));
                 return this->execute(statement);
             }
@@ -472,6 +784,10 @@ namespace sqlite_orm {
             template<class O, class... Ids>
             std::unique_ptr<O> get_pointer(Ids... ids) {
                 this->assert_mapped_type<O>();
+                std::shared_ptr<const O> object;
+                if(this->get_through_cache<O>(object, ids...)) {
+                    return object ? std::make_unique<O>(*object) : nullptr;
+                }
                 auto statement = this->prepare(sqlite_orm::get_pointer<O>(std::forward<Ids>(ids)...));
                 return this->execute(statement);
             }
@@ -501,6 +817,89 @@ namespace sqlite_orm {
                 return std::shared_ptr<O>(this->get_pointer<O>(std::forward<Ids>(ids)...));
             }
 
+            /**
+             *  The same as `get_pointer` but returns a shared handle to an immutable object.
+             *  If an object cache is enabled for `O` the handle to the cached object is returned without copying it.
+             */
+            template<class O, class... Ids>
+            std::shared_ptr<const O> get_shared(Ids... ids) {
+                this->assert_mapped_type<O>();
+                std::shared_ptr<const O> object;
+                if(this->get_through_cache<O>(object, ids...)) {
+                    return object;
+                }
+                return std::shared_ptr<const O>(this->get_pointer<O>(std::forward<Ids>(ids)...));
+            }
+
+            /**
+             *  Enables a read-through LRU cache used by `get`, `get_pointer`, `get_optional` and `get_shared`
+             *  when they are called with a single integral id. Passing 0 disables the cache.
+             *  Cached objects are invalidated per rowid when the table changes through this storage's connection
+             *  and all at once when `PRAGMA data_version` shows that another connection committed changes.
+             *  A REPLACE into a table with UNIQUE constraints or unique indexes drops all cached objects of the table
+             *  because rows it deletes to resolve a conflict aren't reported to the update hook. For the same reason
+             *  `update_all()` assigning the primary key or the rowid, dropping a table and `backup_from()` drop all
+             *  cached objects.
+             *  Only a primary key that is an alias for the rowid allows dropping single objects, for other keys
+             *  any change drops all cached objects of the table.
+             *  Objects are neither looked up in nor added to the cache when the connection isn't kept open
+             *  (see `open_forever()`), and objects read inside a transaction are not added.
+             *  @param maxObjects maximum number of cached objects of type `O`
+             */
+            template<class O>
+            void enable_object_cache(size_t maxObjects) {
+                this->assert_mapped_type<O>();
+                using table_type = storage_pick_table_t<O, db_objects_type>;
+                static_assert(!table_type::is_without_rowid_v,
+                              "Changes to WITHOUT ROWID tables can't be observed, so their objects can't be cached");
+                auto& table = this->get_table<O>();
+                auto key = this->change_key<O>();
+                if(maxObjects) {
+                    this->objectCaches[key] =
+                        std::make_unique<object_cache<O>>(maxObjects, key_is_rowid(table), this->has_unique_keys<O>());
+                } else {
+                    this->objectCaches.erase(key);
+                }
+                if(this->is_opened()) {
+                    this->register_change_hooks(this->connection->get());
+                }
+            }
+
+            template<class O>
+            sqlite_orm::object_cache_stats object_cache_stats() const {
+                this->assert_mapped_type<O>();
+                auto it = this->objectCaches.find(this->change_key<O>());
+                if(it != this->objectCaches.end()) {
+                    return it->second->stats;
+                }
+                return {};
+            }
+
+#if SQLITE_VERSION_NUMBER >= 3020000
+            /**
+             *  Registers an eponymous virtual table named like the table of `O` which exposes a range of `O` objects
+             *  bound with `range_source(...)`, e.g. to join in-memory data without a temporary table.
+             *  The objects are read in place, equality on a single primary key column is answered by a binary search.
+             *  Range tables are read-only and skipped by `sync_schema()`.
+             *  Example:
+             *  storage.create_range_table<Weight>();
+             *  storage.select(columns(&Item::name, &Weight::weight),
+             *                 join<Weight>(on(c(&Weight::itemId) == &Item::id)),
+             *                 where(range_source(weights)));
+             */
+            template<class O>
+            void create_range_table() {
+                this->assert_mapped_type<O>();
+                using table_type = storage_pick_table_t<O, db_objects_type>;
+                auto& table = this->get_table<O>();
+                auto rangeTable = std::make_unique<range_table<table_type>>(table);
+                if(this->is_opened()) {
+                    register_range_table(this->connection->get(), table.name, *rangeTable);
+                }
+                this->rangeTables[table.name] = std::move(rangeTable);
+            }
+#endif
+
 #ifdef SQLITE_ORM_OPTIONAL_SUPPORTED
             /**
              *  The same as `get` function but doesn't throw an exception if noting found but
@@ -509,6 +908,10 @@ namespace sqlite_orm {
             template<class O, class... Ids>
             std::optional<O> get_optional(Ids... ids) {
                 this->assert_mapped_type<O>();
+                std::shared_ptr<const O> object;
+                if(this->get_through_cache<O>(object, ids...)) {
+                    return object ? std::optional<O>(*object) : std::nullopt;
+                }
                 auto statement = this->prepare(sqlite_orm::get_optional<O>(std::forward<Ids>(ids)...));
                 return this->execute(statement);
             }
@@ -731,6 +1134,21 @@ namespace sqlite_orm {
                 return this->execute(statement);
             }
 
+            /**
+             *  Returns a proxy whose `select()` memoizes results for `ttl`:
+             *  `auto rows = storage.cached(std::chrono::seconds{1}).select(count(&User::id), group_by(&User::type));`
+             *  Results are keyed by the statement's SQL and bound values. They are dropped when a table
+             *  the statement reads from changes through this storage's connection, or when `PRAGMA data_version`
+             *  shows that another connection committed changes. All results are dropped when a table is dropped
+             *  or the database is overwritten by `backup_from()`.
+             *  Results are neither looked up nor stored when the connection isn't kept open (see `open_forever()`)
+             *  or when a bound value can't be printed with `field_printer`; results read inside a transaction
+             *  or from a WITHOUT ROWID table (whose changes can't be observed) are not stored.
+             */
+            cached_select<self> cached(std::chrono::steady_clock::duration ttl) {
+                return {*this, ttl};
+            }
+
 #if(SQLITE_VERSION_NUMBER >= 3008003) && defined(SQLITE_ORM_WITH_CTE)
             /**
              *  Using a CTE, select a single column into std::vector<T> or multiple columns into std::vector<std::tuple<...>>.
@@ -979,11 +1397,68 @@ namespace sqlite_orm {
             void rename_table(std::string name) {
                 this->assert_mapped_type<O>();
                 auto& table = this->get_table<O>();
+                this->rename_change_callbacks(this->change_key<O>(), storage_base::change_key(table.schema_name, name));
                 table.name = std::move(name);
             }
 
             using storage_base::rename_table;
 
+            /**
+             *  Registers a callback invoked after a row of the table mapped to `O` is inserted, updated or deleted
+             *  on this storage's connection. Useful for invalidating caches.
+             *  `operation` is SQLITE_INSERT, SQLITE_UPDATE or SQLITE_DELETE, `rowid` is the rowid of the affected row.
+             *  Passing an empty function removes the callback.
+             *  Tables are told apart by schema, so a table in an attached database (see `attach()`) doesn't trigger
+             *  the callback of a table with the same name in the main database.
+             *  An exception thrown by the callback is rethrown by the storage call which made the change once its
+             *  statement is done, the change isn't undone.
+             *  Notes (from https://www.sqlite.org/c3ref/update_hook.html):
+             *  * not invoked for WITHOUT ROWID tables;
+             *  * not invoked when rows are deleted by the truncate optimization (`remove_all<O>()` without conditions)
+             *    or due to an ON CONFLICT REPLACE resolution;
+             *  * the callback must not modify the database.
+             */
+            template<class O>
+            void on_change(std::function<void(int operation, int64 rowid)> callback) {
+                this->assert_mapped_type<O>();
+                this->set_change_callback(this->changeCallbacks, this->change_key<O>(), std::move(callback));
+            }
+
+#ifdef SQLITE_ENABLE_PREUPDATE_HOOK
+            /**
+             *  Registers a callback invoked before a row of the table mapped to `O` is inserted, updated or deleted,
+             *  with the old and new row values materialized as objects.
+             *  Unlike `on_change()` it also reports WITHOUT ROWID tables and rows deleted by the truncate optimization.
+             *  Exceptions are rethrown like the ones of `on_change()` callbacks.
+             *  Passing an empty function removes the callback.
+             *  Requires SQLite compiled with SQLITE_ENABLE_PREUPDATE_HOOK.
+             */
+            template<class O>
+            void on_preupdate(std::function<void(const preupdate_change<O>&)> callback) {
+                this->assert_mapped_type<O>();
+                preupdate_callback hook;
+                if(callback) {
+                    hook = [this, callback = std::move(callback)](sqlite3* db,
+                                                                  int operation,
+                                                                  int64 oldRowid,
+                                                                  int64 newRowid) {
+                        preupdate_change<O> change;
+                        change.operation = operation;
+                        change.old_rowid = oldRowid;
+                        change.new_rowid = newRowid;
+                        if(operation != SQLITE_INSERT) {
+                            change.old_object = this->make_preupdate_object<O>(db, sqlite3_preupdate_old);
+                        }
+                        if(operation != SQLITE_DELETE) {
+                            change.new_object = this->make_preupdate_object<O>(db, sqlite3_preupdate_new);
+                        }
+                        callback(change);
+                    };
+                }
+                this->set_change_callback(this->preupdateCallbacks, this->change_key<O>(), std::move(hook));
+            }
+#endif
+
             /**
              * Get table's name stored in storage's schema info. This function does not call
              * any SQLite queries
@@ -1007,6 +1482,373 @@ namespace sqlite_orm {
             }
 
           protected:
+            friend struct cached_select<self>;
+
+            template<class T, class... Args>
+            auto select_cached(std::chrono::steady_clock::duration ttl, T m, Args... args) {
+                static_assert(!is_compound_operator_v<T> || sizeof...(Args) == 0,
+                              "Cannot use args with a compound operator");
+                auto expression = sqlite_orm::select(std::move(m), std::forward<Args>(args)...);
+                using result_type = decltype(this->execute(this->prepare(expression)));
+                if(!this->connection_kept_open()) {
+                    return this->execute(this->prepare(std::move(expression)));
+                }
+                bindings_key_builder keyBuilder;
+                iterate_ast(expression, keyBuilder);
+                if(!keyBuilder.representable) {
+                    return this->execute(this->prepare(std::move(expression)));
+                }
+                if(!this->queryCache.enabled) {
+                    this->queryCache.enabled = true;
+                    this->register_change_hooks(this->connection->get());
+                }
+
+                //  the type is part of the key because different result types can share the same SQL
+                const void* typeKey = type_key<result_type>();
+                std::string key(reinterpret_cast<const char*>(&typeKey), sizeof(typeKey));
+                expression.highest_level = true;
+                key += this->dump_highest_level(expression, true);
+                key += '\0';
+                key += keyBuilder.key;
+
+                auto connection = this->get_connection();
+                sqlite3* db = connection.get();
+                this->validate_caches(db);
+                auto now = std::chrono::steady_clock::now();
+                if(auto result = this->queryCache.find(key, now)) {
+                    return *static_cast<const result_type*>(result.get());
+                }
+                auto statement = this->prepare(expression);
+                auto result = std::make_shared<result_type>(this->execute(statement));
+                //  uncommitted results must not outlive a rollback
+                if(sqlite3_get_autocommit(db)) {
+                    referenced_tables_collector<db_objects_type> collector{this->db_objects};
+                    iterate_ast(expression, collector);
+                    std::vector<std::string> tableKeys;
+                    tableKeys.reserve(collector.table_names.size());
+                    bool observable = true;
+                    for(auto& tableName: collector.table_names) {
+                        const std::string& schemaName = collector.table_schemas.at(tableName);
+                        //  the update hook isn't invoked for WITHOUT ROWID tables, so changes to them go unnoticed
+                        if(table_is_without_rowid(this->db_objects, schemaName, tableName.first)) {
+                            observable = false;
+                            break;
+                        }
+                        tableKeys.push_back(storage_base::change_key(schemaName, tableName.first));
+                    }
+                    if(observable) {
+                        this->queryCache.insert(std::move(key), result, now + ttl, tableKeys);
+                    }
+                }
+                return *result;
+            }
+
+            template<class T,
+                     std::enable_if_t<polyfill::disjunction<is_replace<T>, is_replace_range<T>>::value, bool> = true>
+            void bind_statement(sqlite3_stmt* stmt, const T& expression) {
+                using object_type = expression_object_type_t<T>;
+
+                auto processObject = [&table = this->get_table<object_type>(),
+                                      bindValue = field_value_binder{stmt}](auto& object) mutable {
+                    table.template for_each_column_excluding<is_generated_always>(
+                        call_as_template_base<column_field>([&bindValue, &object](auto& column) {
+                            bindValue(polyfill::invoke(column.member_pointer, object));
+                        }));
+                };
+
+                static_if<is_replace_range<T>::value>(
+                    [&processObject](auto& expression) {
+#if __cpp_lib_ranges >= 201911L
+                        std::ranges::for_each(expression.range.first,
+                                              expression.range.second,
+                                              std::ref(processObject),
+                                              std::ref(expression.transformer));
+#else
+                        auto& transformer = expression.transformer;
+                        std::for_each(expression.range.first,
+                                      expression.range.second,
+                                      [&processObject, &transformer](auto& item) {
+                                          const object_type& object = polyfill::invoke(transformer, item);
+                                          processObject(object);
+                                      });
+#endif
+                    },
+                    [&processObject](auto& expression) {
+                        const object_type& o = get_object(expression);
+                        processObject(o);
+                    })(expression);
+            }
+
+            template<class T,
+                     std::enable_if_t<polyfill::disjunction<is_insert<T>, is_insert_range<T>>::value, bool> = true>
+            void bind_statement(sqlite3_stmt* stmt, const T& expression) {
+                using object_type = expression_object_type_t<T>;
+
+                auto processObject = [&table = this->get_table<object_type>(),
+                                      bindValue = field_value_binder{stmt}](auto& object) mutable {
+                    using is_without_rowid = typename std::decay_t<decltype(table)>::is_without_rowid;
+                    table.template for_each_column_excluding<
+                        mpl::conjunction<mpl::not_<mpl::always<is_without_rowid>>,
+                                         mpl::disjunction_fn<is_primary_key, is_generated_always>>>(
+                        call_as_template_base<column_field>([&table, &bindValue, &object](auto& column) {
+                            if(!exists_in_composite_primary_key(table, column)) {
+                                bindValue(polyfill::invoke(column.member_pointer, object));
+                            }
+                        }));
+                };
+
+                static_if<is_insert_range<T>::value>(
+                    [&processObject](auto& expression) {
+#if __cpp_lib_ranges >= 201911L
+                        std::ranges::for_each(expression.range.first,
+                                              expression.range.second,
+                                              std::ref(processObject),
+                                              std::ref(expression.transformer));
+#else
+                        auto& transformer = expression.transformer;
+                        std::for_each(expression.range.first,
+                                      expression.range.second,
+                                      [&processObject, &transformer](auto& item) {
+                                          const object_type& object = polyfill::invoke(transformer, item);
+                                          processObject(object);
+                                      });
+#endif
+                    },
+                    [&processObject](auto& expression) {
+                        const object_type& o = get_object(expression);
+                        processObject(o);
+                    })(expression);
+            }
+
+            template<class T, class... Args>
+            void bind_statement(sqlite3_stmt* stmt, const remove_all_t<T, Args...>& expression) {
+                iterate_ast(expression.conditions, conditional_binder{stmt});
+            }
+
+            template<class S, class... Wargs>
+            void bind_statement(sqlite3_stmt* stmt, const update_all_t<S, Wargs...>& expression) {
+                conditional_binder bindNode{stmt};
+                iterate_ast(expression.set, bindNode);
+                iterate_ast(expression.conditions, bindNode);
+            }
+
+            /**
+             *  Whether the primary key of `table` is an alias for the rowid: a single integral column declared
+             *  INTEGER which isn't declared `PRIMARY KEY DESC` in its column definition.
+             */
+            template<class Table>
+            static bool key_is_rowid(const Table& table) {
+                int primaryKeyColumnsCount = 0;
+                bool integerPrimaryKey = false;
+                table.for_each_primary_key_column([&primaryKeyColumnsCount, &integerPrimaryKey](auto memberPointer) {
+                    using field_type = member_field_type_t<decltype(memberPointer)>;
+                    ++primaryKeyColumnsCount;
+                    integerPrimaryKey =
+                        std::is_integral<field_type>::value && type_printer<field_type>().print() == "INTEGER";
+                });
+                bool descendingColumnKey = false;
+                table.for_each_column([&descendingColumnKey](auto& column) {
+                    iterate_tuple(column.constraints, [&descendingColumnKey](auto& constraint) {
+                        descendingColumnKey = descendingColumnKey || is_descending_primary_key(constraint);
+                    });
+                });
+                return primaryKeyColumnsCount == 1 && integerPrimaryKey && !descendingColumnKey;
+            }
+
+            template<class C, satisfies<is_primary_key, C> = true>
+            static bool is_descending_primary_key(const C& primaryKey) {
+                return primaryKey.options.asc_option == primary_key_base::order_by::descending;
+            }
+
+            template<class C, satisfies_not<is_primary_key, C> = true>
+            static bool is_descending_primary_key(const C&) {
+                return false;
+            }
+
+            /**
+             *  Whether the table of `O` has UNIQUE constraints or unique indexes, on which a REPLACE can conflict
+             *  with rows other than the one having the same primary key.
+             */
+            template<class O>
+            bool has_unique_keys() const {
+                using table_type = storage_pick_table_t<O, db_objects_type>;
+                bool result = table_type::template count_of<is_unique>() > 0 ||
+                              table_type::template count_of_columns_with<is_unique>() > 0;
+                iterate_tuple(this->db_objects, [&result](auto& schemaObject) {
+                    result = result || is_unique_index_of<O>(schemaObject);
+                });
+                return result;
+            }
+
+            template<class O, class T, class... Els>
+            static bool is_unique_index_of(const index_t<T, Els...>& index) {
+                return std::is_same<T, O>::value && index.unique;
+            }
+
+            template<class O, class E>
+            static bool is_unique_index_of(const E&) {
+                return false;
+            }
+
+            template<class O>
+            std::string change_key() const {
+                auto& table = this->get_table<O>();
+                return storage_base::change_key(table_schema_name(table), table.name);
+            }
+
+            /**
+             *  Maintains the caches after a data modification statement, with or without a RETURNING clause,
+             *  for the changes the update hook doesn't report.
+             */
+            template<class T,
+                     std::enable_if_t<polyfill::disjunction<is_replace<T>, is_replace_range<T>>::value, bool> = true>
+            void statement_performed(const T&) {
+                if(!this->objectCaches.empty()) {
+                    this->rows_replaced(this->change_key<expression_object_type_t<T>>());
+                }
+            }
+
+            template<class T,
+                     std::enable_if_t<polyfill::disjunction<is_insert<T>, is_insert_range<T>>::value, bool> = true>
+            void statement_performed(const T&) {}
+
+            template<class T, class... Args>
+            void statement_performed(const remove_all_t<T, Args...>&) {
+                //  only a DELETE without conditions is eligible for the truncate optimization,
+                //  rows deleted otherwise are reported by the update hook
+                if(sizeof...(Args) == 0) {
+                    this->table_truncated(this->change_key<T>());
+                }
+            }
+
+            template<class S, class... Wargs>
+            void statement_performed(const update_all_t<S, Wargs...>& statement) {
+                if(!this->objectCaches.empty()) {
+                    this->keys_assigned(statement.set);
+                }
+            }
+
+            /**
+             *  The update hook reports an UPDATE by the new rowid only, so once a primary key column or the rowid
+             *  is assigned, objects cached under their old keys can't be found and the caches of the updated tables
+             *  are dropped.
+             */
+            template<class... Args>
+            void keys_assigned(const set_t<Args...>& set) {
+                bool keyAssigned = false;
+                auto collector = make_table_name_collector(this->db_objects);
+                iterate_tuple(set.assigns, [this, &keyAssigned, &collector](auto& assign) {
+                    keyAssigned = keyAssigned || this->is_key(assign.lhs);
+                    iterate_ast(assign.lhs, collector);
+                });
+                if(keyAssigned) {
+                    this->clear_caches_of(collector);
+                }
+            }
+
+            template<class C>
+            void keys_assigned(const dynamic_set_t<C>& set) {
+                //  the assignments are serialized already, any of them might assign a key
+                this->clear_caches_of(set.collector);
+            }
+
+            void clear_caches_of(const table_name_collector_base& tables) {
+                for(auto& table: tables.table_schemas) {
+                    auto it = this->objectCaches.find(storage_base::change_key(table.second, table.first.first));
+                    if(it != this->objectCaches.end()) {
+                        it->second->clear();
+                    }
+                }
+            }
+
+            template<class F, class O>
+            bool is_key(F O::*memberPointer) const {
+                return this->is_key_of<O>(memberPointer);
+            }
+
+            template<class T, class F>
+            bool is_key(const column_pointer<T, F>& column) const {
+                return this->is_key_of<mapped_type_proxy_t<T>>(column.field);
+            }
+
+            template<class T>
+            bool is_key(const T&) const {
+                return std::is_base_of<rowid_t, T>::value || std::is_base_of<oid_t, T>::value ||
+                       std::is_base_of<_rowid_t, T>::value;
+            }
+
+            template<class O, class M>
+            bool is_key_of(M memberPointer) const {
+                auto& table = this->get_table<O>();
+                const std::string* columnName = table.find_column_name(memberPointer);
+                if(!columnName) {
+                    return false;
+                }
+                auto keyColumnNames = table.primary_key_column_names();
+                return std::find(keyColumnNames.begin(), keyColumnNames.end(), *columnName) != keyColumnNames.end();
+            }
+
+            /**
+             *  Looks up an object in the cache enabled with `enable_object_cache<O>()`, loading and caching it
+             *  on a miss.
+             *  @return false if the object cache doesn't apply, in which case `result` is left untouched
+             */
+            template<class O, class... Ids>
+            bool get_through_cache(std::shared_ptr<const O>&, const Ids&...) {
+                return false;
+            }
+
+            template<class O, class Id, satisfies<std::is_integral, Id> = true>
+            bool get_through_cache(std::shared_ptr<const O>& result, const Id& id) {
+                if(this->objectCaches.empty() || !this->connection_kept_open()) {
+                    return false;
+                }
+                auto it = this->objectCaches.find(this->change_key<O>());
+                if(it == this->objectCaches.end()) {
+                    return false;
+                }
+                auto& cache = static_cast<object_cache<O>&>(*it->second);
+                auto connection = this->get_connection();
+                sqlite3* db = connection.get();
+                this->validate_caches(db);
+                result = cache.find(int64(id));
+                if(result) {
+                    return true;
+                }
+                auto statement = this->prepare(sqlite_orm::get_pointer<O>(id));
+                result = this->execute(statement);
+                //  uncommitted objects must not outlive a rollback
+                if(result && sqlite3_get_autocommit(db)) {
+                    cache.insert(int64(id), result);
+                }
+                return true;
+            }
+
+#ifdef SQLITE_ENABLE_PREUPDATE_HOOK
+            template<class O>
+            std::unique_ptr<O> make_preupdate_object(sqlite3* db, int (*getValue)(sqlite3*, int, sqlite3_value**)) {
+                auto object = std::make_unique<O>();
+                auto& table = this->get_table<O>();
+                int columnIndex = 0;
+                table.for_each_column([db, getValue, &object, &columnIndex](auto& column) {
+                    sqlite3_value* value = nullptr;
+                    if(getValue(db, columnIndex++, &value) != SQLITE_OK) {
+                        throw_translated_sqlite_error(db);
+                    }
+                    using column_type = std::remove_reference_t<decltype(column)>;
+                    auto fieldValue = boxed_value_extractor<typename column_type::field_type>().extract(value);
+                    static_if<std::is_member_object_pointer<typename column_type::member_pointer_t>::value>(
+                        [&fieldValue, &object](const auto& column) {
+                            (*object).*column.member_pointer = std::move(fieldValue);
+                        },
+                        [&fieldValue, &object](const auto& column) {
+                            ((*object).*column.setter)(std::move(fieldValue));
+                        })(column);
+                });
+                return object;
+            }
+#endif
+
             template<class M>
             sync_schema_result schema_status(const virtual_table_t<M>&, sqlite3*, bool, bool*) {
                 return sync_schema_result::already_in_sync;
@@ -1017,11 +1859,101 @@ namespace sqlite_orm {
                 return sync_schema_result::already_in_sync;
             }
 
+            /**
+             *  An existing index whose structure differs from the mapped one has to be dropped and recreated.
+             *  Uniqueness, key columns and expressions with their order and collation and the condition of a
+             *  partial index are compared, so an index created with differently formatted SQL is still in sync.
+             */
             template<class... Cols>
-            sync_schema_result schema_status(const index_t<Cols...>&, sqlite3*, bool, bool*) {
+            sync_schema_result schema_status(const index_t<Cols...>& index, sqlite3* db, bool, bool*) {
+                using indexed_type = typename index_t<Cols...>::table_mapped_type;
+                auto schemaName = lookup_table_schema<indexed_type>(this->db_objects);
+                index_structure dbIndex;
+                if(!this->read_index_structure(db,
+                                               schemaName,
+                                               lookup_table_name<indexed_type>(this->db_objects),
+                                               index.name,
+                                               dbIndex)) {
+                    //  an index with this name on another table has to be moved
+                    return this->index_sql(db, schemaName, index.name).empty()
+                               ? sync_schema_result::already_in_sync
+                               : sync_schema_result::dropped_and_recreated;
+                }
+                if(dbIndex != this->mapped_index_structure(index)) {
+                    return sync_schema_result::dropped_and_recreated;
+                }
                 return sync_schema_result::already_in_sync;
             }
 
+            template<class... Cols>
+            index_structure mapped_index_structure(const index_t<Cols...>& index) {
+                using context_t = serializer_context<db_objects_type>;
+                context_t context{this->db_objects};
+                context.use_parentheses = false;
+                index_structure result;
+                result.unique = index.unique;
+                iterate_tuple(index.elements, [this, &index, &result, &context](auto& element) {
+                    this->add_index_element(index, result, element, context);
+                });
+                return result;
+            }
+
+            template<class I, class C, class Ctx>
+            void add_index_element(const I&, index_structure& result, const where_t<C>& where, const Ctx& context) {
+                result.condition = normalized_index_condition(internal::serialize(where, context));
+            }
+
+            template<class I, class C, class Ctx>
+            void add_index_element(const I&,
+                                   index_structure& result,
+                                   const indexed_column_t<C>& column,
+                                   const Ctx& context) {
+                index_key_column keyColumn;
+                keyColumn.desc = column._order == -1;
+                keyColumn.collation = column._collation_name;
+                this->describe_index_column<typename I::table_mapped_type>(keyColumn,
+                                                                           column.column_or_expression,
+                                                                           context);
+                if(keyColumn.collation.empty()) {
+                    keyColumn.collation = "BINARY";
+                }
+                result.columns.push_back(std::move(keyColumn));
+            }
+
+            /**
+             *  Name of an indexed column and, unless the index specifies one, the collation the column is
+             *  declared with, which the index inherits.
+             */
+            template<class O, class M, class Ctx, satisfies<std::is_member_pointer, M> = true>
+            void describe_index_column(index_key_column& keyColumn, M memberPointer, const Ctx&) {
+                const bool inheritCollation = keyColumn.collation.empty();
+                this->get_table<O>().for_each_column([&keyColumn, memberPointer, inheritCollation](auto& column) {
+                    if(!compare_any(column.member_pointer, memberPointer) &&
+                       !compare_any(column.setter, memberPointer)) {
+                        return;
+                    }
+                    keyColumn.name = column.name;
+                    if(inheritCollation) {
+                        iterate_tuple(column.constraints, [&keyColumn](auto& constraint) {
+                            apply_collation(keyColumn.collation, constraint);
+                        });
+                    }
+                });
+            }
+
+            //  expressions have no name and no collation of their own
+            template<class O, class E, class Ctx, satisfies_not<std::is_member_pointer, E> = true>
+            void describe_index_column(index_key_column& keyColumn, const E& expression, const Ctx& context) {
+                keyColumn.expression = normalized_sql_expression(internal::serialize(expression, context));
+            }
+
+            static void apply_collation(std::string& collation, const collate_constraint_t& constraint) {
+                collation = collate_constraint_t::string_from_collate_argument(constraint.argument);
+            }
+
+            template<class T>
+            static void apply_collation(std::string&, const T&) {}
+
             template<class T, bool WithoutRowId, class... Cs>
             sync_schema_result schema_status(const table_t<T, WithoutRowId, Cs...>& table,
                                              sqlite3* db,
@@ -1031,11 +1963,11 @@ namespace sqlite_orm {
                     *attempt_to_preserve = true;
                 }
 
-                auto dbTableInfo = this->pragma.table_xinfo(table.name);
+                auto dbTableInfo = this->pragma.table_xinfo(table.schema_name, table.name);
                 auto res = sync_schema_result::already_in_sync;
 
                 //  first let's see if table with such name exists..
-                auto gottaCreateTable = !this->table_exists(db, table.name);
+                auto gottaCreateTable = !this->table_exists(db, table.schema_name, table.name);
                 if(!gottaCreateTable) {
 
                     //  get table info provided in `make_table` call..
@@ -1114,19 +2046,84 @@ namespace sqlite_orm {
                 auto res = sync_schema_result::already_in_sync;
                 using context_t = serializer_context<db_objects_type>;
                 context_t context{this->db_objects};
-                auto query = serialize(virtualTable, context);
+                auto query = internal::serialize(virtualTable, context);
                 perform_void_exec(db, query);
                 return res;
             }
 
+            /**
+             *  Creates the index if it doesn't exist. A changed index is only reported here and rebuilt later by
+             *  `rebuild_indexes()` together with all other changed indexes.
+             */
             template<class... Cols>
-            sync_schema_result sync_table(const index_t<Cols...>& index, sqlite3* db, bool) {
-                auto res = sync_schema_result::already_in_sync;
+            sync_schema_result sync_table(const index_t<Cols...>& index, sqlite3* db, bool preserve) {
+                auto res = this->schema_status(index, db, preserve, nullptr);
+                if(res == sync_schema_result::already_in_sync) {
+                    using context_t = serializer_context<db_objects_type>;
+                    context_t context{this->db_objects};
+                    auto query = internal::serialize(index, context);
+                    perform_void_exec(db, query);
+                }
+                return res;
+            }
+
+            /**
+             *  Drops and recreates every index reported as `dropped_and_recreated` in `syncResult` in one
+             *  transaction and runs ANALYZE on the tables they belong to, so the query planner has fresh
+             *  statistics for the new indexes.
+             */
+            void rebuild_indexes(sqlite3* db, const std::map<std::string, sync_schema_result>& syncResult) {
+                std::vector<std::string> statements;
+                //  schema qualified and quoted names of the tables to analyze
+                std::set<std::string> tableIdentifiers;
+                iterate_tuple(this->db_objects,
+                              [this, &syncResult, &statements, &tableIdentifiers](auto& schemaObject) {
+                                  this->collect_index_rebuild(schemaObject, syncResult, statements, tableIdentifiers);
+                              });
+                if(statements.empty()) {
+                    return;
+                }
+                for(auto& tableIdentifier: tableIdentifiers) {
+                    statements.push_back("ANALYZE " + tableIdentifier);
+                }
+                //  a savepoint works both inside and outside of a transaction
+                perform_void_exec(db, "SAVEPOINT sqlite_orm_rebuild_indexes");
+                try {
+                    for(auto& statement: statements) {
+                        perform_void_exec(db, statement);
+                    }
+                } catch(...) {
+                    sqlite3_exec(db, "ROLLBACK TO sqlite_orm_rebuild_indexes", nullptr, nullptr, nullptr);
+                    sqlite3_exec(db, "RELEASE sqlite_orm_rebuild_indexes", nullptr, nullptr, nullptr);
+                    throw;
+                }
+                perform_void_exec(db, "RELEASE sqlite_orm_rebuild_indexes");
+            }
+
+            template<class E>
+            void collect_index_rebuild(const E&,
+                                       const std::map<std::string, sync_schema_result>&,
+                                       std::vector<std::string>&,
+                                       std::set<std::string>&) {}
+
+            template<class... Cols>
+            void collect_index_rebuild(const index_t<Cols...>& index,
+                                       const std::map<std::string, sync_schema_result>& syncResult,
+                                       std::vector<std::string>& statements,
+                                       std::set<std::string>& tableIdentifiers) {
+                auto it = syncResult.find(index.name);
+                if(it == syncResult.end() || it->second != sync_schema_result::dropped_and_recreated) {
+                    return;
+                }
                 using context_t = serializer_context<db_objects_type>;
                 context_t context{this->db_objects};
-                auto query = serialize(index, context);
-                perform_void_exec(db, query);
-                return res;
+                using indexed_type = typename index_t<Cols...>::table_mapped_type;
+                auto schemaName = lookup_table_schema<indexed_type>(this->db_objects);
+                auto qualifier = schemaName.empty() ? std::string{} : quote_identifier(schemaName) + ".";
+                statements.push_back("DROP INDEX IF EXISTS " + qualifier + quote_identifier(index.name));
+                statements.push_back(internal::serialize(index, context));
+                auto& tableName = lookup_table_name<indexed_type>(this->db_objects);
+                tableIdentifiers.insert(qualifier + quote_identifier(tableName));
             }
 
             template<class... Cols>
@@ -1134,7 +2131,7 @@ namespace sqlite_orm {
                 auto res = sync_schema_result::already_in_sync;  // TODO Change accordingly
                 using context_t = serializer_context<db_objects_type>;
                 context_t context{this->db_objects};
-                auto query = serialize(trigger, context);
+                auto query = internal::serialize(trigger, context);
                 perform_void_exec(db, query);
                 return res;
             }
@@ -1143,13 +2140,14 @@ namespace sqlite_orm {
             sync_schema_result sync_table(const Table& table, sqlite3* db, bool preserve);
 
             template<class C>
-            void add_column(sqlite3* db, const std::string& tableName, const C& column) const {
+            void add_column(sqlite3* db, const std::string& schemaName, const std::string& tableName, const C& column)
+                const {
                 using context_t = serializer_context<db_objects_type>;
 
                 context_t context{this->db_objects};
                 std::stringstream ss;
-                ss << "ALTER TABLE " << streaming_identifier(tableName) << " ADD COLUMN " << serialize(column, context)
-                   << std::flush;
+                ss << "ALTER TABLE " << streaming_identifier(schemaName, tableName, std::string{}) << " ADD COLUMN "
+                   << internal::serialize(column, context) << std::flush;
                 perform_void_exec(db, ss.str());
             }
 
@@ -1178,7 +2176,7 @@ namespace sqlite_orm {
                 context.replace_bindable_with_question = parametrized;
                 // just like prepare_impl()
                 context.skip_table_name = false;
-                return serialize(expression, context);
+                return internal::serialize(expression, context);
             }
 
             template<typename S>
@@ -1190,7 +2188,8 @@ namespace sqlite_orm {
                 context.replace_bindable_with_question = true;
 
                 auto con = this->get_connection();
-                std::string sql = serialize(statement, context);
+                std::string sql = internal::serialize(statement, context);
+                this->record_query(sql);
                 sqlite3_stmt* stmt = prepare_stmt(con.get(), std::move(sql));
                 return prepared_statement_t<S>{std::forward<S>(statement), stmt, con};
             }
@@ -1214,6 +2213,12 @@ namespace sqlite_orm {
              * file at all it will be created and all tables also will be created with exact tables and columns you
              * specified in `make_storage`, `make_table` and `make_column` calls. The best practice is to call this
              * function right after storage creation.
+             *  * every index from storage is compared with the structure of the existing index, which `PRAGMA
+             * index_list` and `PRAGMA index_xinfo` report (indexed expressions and the partial `WHERE` are compared
+             * in their normalized SQL), and if it differs (columns or expressions, order, collation, partial `WHERE`
+             * or uniqueness) it is reported as `dropped_and_recreated`. All
+             * changed indexes are rebuilt in one transaction after the tables are synced, followed by `ANALYZE` of
+             * their tables.
              *  @param preserve affects function's behaviour in case it is needed to remove a column. If it is `false`
              * so table will be dropped if there is column to remove if SQLite version is < 3.35.0 and remove column if SQLite version >= 3.35.0,
              * if `true` -  table is being copied into another table, dropped and copied table is renamed with source table name.
@@ -1226,10 +2231,63 @@ namespace sqlite_orm {
             std::map<std::string, sync_schema_result> sync_schema(bool preserve = false) {
                 auto con = this->get_connection();
                 std::map<std::string, sync_schema_result> result;
+                //  copying rows into recreated tables invokes change callbacks
+                this->changeHookError = nullptr;
                 iterate_tuple<true>(this->db_objects, [this, db = con.get(), preserve, &result](auto& schemaObject) {
                     sync_schema_result status = this->sync_table(schemaObject, db, preserve);
                     result.emplace(schemaObject.name, status);
                 });
+                this->rebuild_indexes(con.get(), result);
+                this->rethrow_change_hook_error();
+                return result;
+            }
+
+            /**
+             *  Same as `sync_schema(true)` but tables which have to be recreated are copied online
+             *  rather than with a single `INSERT INTO ... SELECT` which blocks writers for the whole copy:
+             *  * rows are copied in rowid order in chunks of `options.chunk_size` rows, each chunk in its own
+             *    transaction, so other connections can write between chunks
+             *  * triggers on the old table mirror inserts, updates and deletes to the copy while it is being made
+             *  * the old table is dropped and the copy renamed in one last transaction
+             *  `options.on_progress` is called after every chunk with the number of copied rows and an estimate
+             *  of the remaining time. WITHOUT ROWID tables, tables whose INTEGER PRIMARY KEY changes and calls made
+             *  inside of a transaction fall back to the single statement copy.
+             *  If the copy fails the triggers and the partial copy are dropped and the old table is left untouched.
+             */
+            std::map<std::string, sync_schema_result> sync_schema_online(const online_migration_options& options) {
+                this->onlineMigration = &options;
+                try {
+                    auto result = this->sync_schema(true);
+                    this->onlineMigration = nullptr;
+                    return result;
+                } catch(...) {
+                    this->onlineMigration = nullptr;
+                    throw;
+                }
+            }
+
+            /**
+             *  Same as `sync_schema()` but skips comparing the schema with the database when nothing has changed
+             *  since the last call, which saves reading `table_xinfo` of every table on startup.
+             *  A fingerprint of the storage schema (a hash of the SQL creating all tables, indexes, triggers and
+             *  virtual tables) is stored in the "_sqlite_orm_schema" table together with `PRAGMA schema_version`
+             *  after a sync. If both still match the sync is skipped and every object is reported as
+             *  `sync_schema_result::already_in_sync`, otherwise the full `sync_schema(preserve)` is performed.
+             *  Because of the schema version any schema change made outside of the storage forces the full sync too.
+             */
+            std::map<std::string, sync_schema_result> sync_schema_if_changed(bool preserve = false) {
+                auto con = this->get_connection();
+                sqlite3* db = con.get();
+                const std::string fingerprint = this->schema_fingerprint();
+                if(this->schema_fingerprint_matches(db, fingerprint)) {
+                    std::map<std::string, sync_schema_result> result;
+                    iterate_tuple<true>(this->db_objects, [&result](auto& schemaObject) {
+                        result.emplace(schemaObject.name, sync_schema_result::already_in_sync);
+                    });
+                    return result;
+                }
+                auto result = this->sync_schema(preserve);
+                this->store_schema_fingerprint(db, fingerprint);
                 return result;
             }
 
@@ -1303,6 +2361,13 @@ namespace sqlite_orm {
                 return this->prepare_impl(std::move(statement));
             }
 
+#if SQLITE_VERSION_NUMBER >= 3035000
+            template<class S, class C>
+            prepared_statement_t<returning_t<S, C>> prepare(returning_t<S, C> statement) {
+                return this->prepare_impl(std::move(statement));
+            }
+#endif
+
             template<class T, class... Ids>
             prepared_statement_t<get_t<T, Ids...>> prepare(get_t<T, Ids...> statement) {
                 return this->prepare_impl(std::move(statement));
@@ -1376,7 +2441,8 @@ namespace sqlite_orm {
             void execute(const prepared_statement_t<replace_raw_t<Args...>>& statement) {
                 sqlite3_stmt* stmt = reset_stmt(statement.stmt);
                 iterate_ast(statement.expression, conditional_binder{stmt});
-                perform_step(stmt);
+                this->perform_change_step(stmt);
+                this->rows_replaced();
             }
 
 #if(SQLITE_VERSION_NUMBER >= 3008003) && defined(SQLITE_ORM_WITH_CTE)
@@ -1384,7 +2450,7 @@ namespace sqlite_orm {
             void execute(const prepared_statement_t<with_t<E, CTEs...>>& statement) {
                 sqlite3_stmt* stmt = reset_stmt(statement.stmt);
                 iterate_ast(statement.expression, conditional_binder{stmt});
-                perform_step(stmt);
+                this->perform_change_step(stmt);
             }
 #endif
 
@@ -1392,7 +2458,15 @@ namespace sqlite_orm {
             void execute(const prepared_statement_t<insert_raw_t<Args...>>& statement) {
                 sqlite3_stmt* stmt = reset_stmt(statement.stmt);
                 iterate_ast(statement.expression, conditional_binder{stmt});
-                perform_step(stmt);
+                this->perform_change_step(stmt);
+                using args_tuple = typename insert_raw_t<Args...>::args_tuple;
+                iterate_tuple(statement.expression.args,
+                              filter_tuple_sequence_t<args_tuple, is_insert_constraint>{},
+                              [this](const insert_constraint& constraint) {
+                                  if(constraint.action == conflict_action::replace) {
+                                      this->rows_replaced();
+                                  }
+                              });
             }
 
             template<class T, class... Cols>
@@ -1406,93 +2480,25 @@ namespace sqlite_orm {
                     [&table = this->get_table<object_type>(), &object = statement.expression.obj](auto& memberPointer) {
                         return table.object_field_value(object, memberPointer);
                     });
-                perform_step(stmt);
+                this->perform_change_step(stmt);
                 return sqlite3_last_insert_rowid(sqlite3_db_handle(stmt));
             }
 
             template<class T,
                      std::enable_if_t<polyfill::disjunction<is_replace<T>, is_replace_range<T>>::value, bool> = true>
             void execute(const prepared_statement_t<T>& statement) {
-                using object_type = statement_object_type_t<decltype(statement)>;
-
                 sqlite3_stmt* stmt = reset_stmt(statement.stmt);
-
-                auto processObject = [&table = this->get_table<object_type>(),
-                                      bindValue = field_value_binder{stmt}](auto& object) mutable {
-                    table.template for_each_column_excluding<is_generated_always>(
-                        call_as_template_base<column_field>([&bindValue, &object](auto& column) {
-                            bindValue(polyfill::invoke(column.member_pointer, object));
-                        }));
-                };
-
-                static_if<is_replace_range<T>::value>(
-                    [&processObject](auto& expression) {
-#if __cpp_lib_ranges >= 201911L
-                        std::ranges::for_each(expression.range.first,
-                                              expression.range.second,
-                                              std::ref(processObject),
-                                              std::ref(expression.transformer));
-#else
-                        auto& transformer = expression.transformer;
-                        std::for_each(expression.range.first,
-                                      expression.range.second,
-                                      [&processObject, &transformer](auto& item) {
-                                          const object_type& object = polyfill::invoke(transformer, item);
-                                          processObject(object);
-                                      });
-#endif
-                    },
-                    [&processObject](auto& expression) {
-                        const object_type& o = get_object(expression);
-                        processObject(o);
-                    })(statement.expression);
-
-                perform_step(stmt);
+                this->bind_statement(stmt, statement.expression);
+                this->perform_change_step(stmt);
+                this->statement_performed(statement.expression);
             }
 
             template<class T,
                      std::enable_if_t<polyfill::disjunction<is_insert<T>, is_insert_range<T>>::value, bool> = true>
             int64 execute(const prepared_statement_t<T>& statement) {
-                using object_type = statement_object_type_t<decltype(statement)>;
-
                 sqlite3_stmt* stmt = reset_stmt(statement.stmt);
-
-                auto processObject = [&table = this->get_table<object_type>(),
-                                      bindValue = field_value_binder{stmt}](auto& object) mutable {
-                    using is_without_rowid = typename std::decay_t<decltype(table)>::is_without_rowid;
-                    table.template for_each_column_excluding<
-                        mpl::conjunction<mpl::not_<mpl::always<is_without_rowid>>,
-                                         mpl::disjunction_fn<is_primary_key, is_generated_always>>>(
-                        call_as_template_base<column_field>([&table, &bindValue, &object](auto& column) {
-                            if(!exists_in_composite_primary_key(table, column)) {
-                                bindValue(polyfill::invoke(column.member_pointer, object));
-                            }
-                        }));
-                };
-
-                static_if<is_insert_range<T>::value>(
-                    [&processObject](auto& expression) {
-#if __cpp_lib_ranges >= 201911L
-                        std::ranges::for_each(expression.range.first,
-                                              expression.range.second,
-                                              std::ref(processObject),
-                                              std::ref(expression.transformer));
-#else
-                        auto& transformer = expression.transformer;
-                        std::for_each(expression.range.first,
-                                      expression.range.second,
-                                      [&processObject, &transformer](auto& item) {
-                                          const object_type& object = polyfill::invoke(transformer, item);
-                                          processObject(object);
-                                      });
-#endif
-                    },
-                    [&processObject](auto& expression) {
-                        const object_type& o = get_object(expression);
-                        processObject(o);
-                    })(statement.expression);
-
-                perform_step(stmt);
+                this->bind_statement(stmt, statement.expression);
+                this->perform_change_step(stmt);
                 return sqlite3_last_insert_rowid(sqlite3_db_handle(stmt));
             }
 
@@ -1500,7 +2506,7 @@ namespace sqlite_orm {
             void execute(const prepared_statement_t<remove_t<T, Ids...>>& statement) {
                 sqlite3_stmt* stmt = reset_stmt(statement.stmt);
                 iterate_ast(statement.expression.ids, conditional_binder{stmt});
-                perform_step(stmt);
+                this->perform_change_step(stmt);
             }
 
             template<class T>
@@ -1523,7 +2529,7 @@ namespace sqlite_orm {
                         bindValue(polyfill::invoke(column.member_pointer, object));
                     }
                 });
-                perform_step(stmt);
+                this->perform_change_step(stmt);
             }
 
             template<class T, class... Ids>
@@ -1596,18 +2602,50 @@ namespace sqlite_orm {
             template<class T, class... Args>
             void execute(const prepared_statement_t<remove_all_t<T, Args...>>& statement) {
                 sqlite3_stmt* stmt = reset_stmt(statement.stmt);
-                iterate_ast(statement.expression.conditions, conditional_binder{stmt});
-                perform_step(stmt);
+                this->bind_statement(stmt, statement.expression);
+                this->perform_change_step(stmt);
+                this->statement_performed(statement.expression);
             }
 
             template<class S, class... Wargs>
             void execute(const prepared_statement_t<update_all_t<S, Wargs...>>& statement) {
                 sqlite3_stmt* stmt = reset_stmt(statement.stmt);
+                this->bind_statement(stmt, statement.expression);
+                this->perform_change_step(stmt);
+                this->statement_performed(statement.expression);
+            }
+
+#if SQLITE_VERSION_NUMBER >= 3035000
+            template<class S, class C>
+            auto execute(const prepared_statement_t<returning_t<S, C>>& statement) {
+                sqlite3_stmt* stmt = reset_stmt(statement.stmt);
+                this->bind_statement(stmt, statement.expression.statement);
+                // the RETURNING clause comes last, so its parameters are the last ones
+                int columnsParametersCount = 0;
+                iterate_ast(statement.expression.columns, [&columnsParametersCount](auto& node) {
+                    if(is_bindable<std::decay_t<decltype(node)>>::value) {
+                        ++columnsParametersCount;
+                    }
+                });
                 conditional_binder bindNode{stmt};
-                iterate_ast(statement.expression.set, bindNode);
-                iterate_ast(statement.expression.conditions, bindNode);
-                perform_step(stmt);
+                bindNode.index = sqlite3_bind_parameter_count(stmt) - columnsParametersCount + 1;
+                iterate_ast(statement.expression.columns, bindNode);
+
+                using ColResult = column_result_of_t<db_objects_type, C>;
+                using R = decltype(make_row_extractor<ColResult>(this->db_objects).extract(nullptr, 0));
+                std::vector<R> res;
+                this->changeHookError = nullptr;
+                perform_steps(
+                    stmt,
+                    [rowExtractor = make_row_extractor<ColResult>(this->db_objects), &res](sqlite3_stmt* stmt) {
+                        res.push_back(rowExtractor.extract(stmt, 0));
+                    });
+                this->rethrow_change_hook_error();
+                this->statement_performed(statement.expression.statement);
+                res.shrink_to_fit();
+                return res;
             }
+#endif
 
 #if(SQLITE_VERSION_NUMBER >= 3008003) && defined(SQLITE_ORM_WITH_CTE)
             template<class... CTEs, class T, class... Args>
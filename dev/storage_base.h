@@ -5,14 +5,20 @@
 #include <functional>  //  std::function, std::bind, std::bind_front
 #include <string>  //  std::string
 #include <sstream>  //  std::stringstream
-#include <utility>  //  std::move
+#include <utility>  //  std::move, std::pair, std::exchange
 #include <system_error>  //  std::system_error
 #include <vector>  //  std::vector
 #include <list>  //  std::list
 #include <memory>  //  std::make_unique, std::unique_ptr
 #include <map>  //  std::map
-#include <type_traits>  //  std::is_same
-#include <algorithm>  //  std::find_if, std::ranges::find
+#include <unordered_map>  //  std::unordered_map
+#include <type_traits>  //  std::is_same, std::integral_constant
+#include <algorithm>  //  std::find_if, std::ranges::find, std::min, std::any_of, std::copy, std::remove_if
+#include <chrono>  //  std::chrono::steady_clock
+#include <random>  //  std::minstd_rand, std::uniform_real_distribution
+#include <thread>  //  std::this_thread::sleep_for
+#include <future>  //  std::future, std::async, std::promise
+#include <exception>  //  std::exception_ptr, std::current_exception, std::rethrow_exception
 
 #include "functional/cxx_universal.h"  //  ::size_t
 #include "functional/cxx_tuple_polyfill.h"  //  std::apply
@@ -30,6 +36,15 @@
 #include "xdestroy_handling.h"
 #include "udf_proxy.h"
 #include "serializing_util.h"
+#include "trace.h"
+#include "cancellation_token.h"
+#include "busy_retry_policy.h"
+#include "data_change.h"
+#include "object_cache.h"
+#include "query_cache.h"
+#include "range_table.h"
+#include "index_advisor.h"
+#include "index_info.h"
 
 namespace sqlite_orm {
 
@@ -70,6 +85,33 @@ namespace sqlite_orm {
                         std::bind(&storage_base::rollback, this)};
             }
 
+            /**
+             *  Starts a savepoint and returns a guard for it. `commit()` releases the savepoint,
+             *  `rollback()` and the destructor roll back the changes made since the savepoint was started
+             *  and release it. Savepoints nest inside transactions and other savepoints; outside of a transaction
+             *  a savepoint behaves like `BEGIN DEFERRED TRANSACTION`.
+             *  More info: https://www.sqlite.org/lang_savepoint.html
+             */
+            transaction_guard_t savepoint(std::string name) {
+                this->begin_savepoint(name);
+                return {this->get_connection(),
+                        std::bind(&storage_base::release_savepoint, this, name),
+                        std::bind(&storage_base::rollback_to_savepoint, this, name)};
+            }
+
+            /**
+             *  Returns a guard for a unit of work that should be atomic without forcing its own commit:
+             *  inside a transaction it is a savepoint within the outer transaction, so many small units
+             *  share the outer transaction's single commit; otherwise it starts a transaction.
+             */
+            transaction_guard_t batch_scope() {
+                bool inTransaction = this->is_opened() && !sqlite3_get_autocommit(this->connection->get());
+                if(inTransaction) {
+                    return this->savepoint("sqlite_orm_batch");
+                }
+                return this->transaction_guard();
+            }
+
             void drop_index(const std::string& indexName) {
                 std::stringstream ss;
                 ss << "DROP INDEX " << quote_identifier(indexName) << std::flush;
@@ -86,6 +128,56 @@ namespace sqlite_orm {
                 perform_void_exec(this->get_connection().get(), "VACUUM");
             }
 
+#if SQLITE_VERSION_NUMBER >= 3027000
+            /**
+             *  Writes a vacuumed copy of the database into the file `filename`, which must not exist or be empty.
+             *  The database itself is left as is, so it is a way to make compact and defragmented snapshots.
+             *  https://www.sqlite.org/lang_vacuum.html#vacuuminto
+             */
+            void vacuum_into(const std::string& filename) {
+                perform_void_exec(this->get_connection().get(), "VACUUM INTO " + quote_string_literal(filename));
+            }
+#endif
+
+#if SQLITE_VERSION_NUMBER >= 3036000 && !defined(SQLITE_OMIT_DESERIALIZE)
+            /**
+             *  Returns the content of the database as it would be written to a file.
+             *  Only a database loaded with `deserialize()` lives in one contiguous buffer, which is copied directly.
+             *  Any other database, an ordinary in-memory one included, is serialized by SQLite into a temporary
+             *  buffer first, so the call costs two copies of the database.
+             */
+            std::vector<char> serialize() {
+                auto con = this->get_connection();
+                sqlite3_int64 size = 0;
+                auto data = reinterpret_cast<const char*>(
+                    sqlite3_serialize(con.get(), "main", &size, SQLITE_SERIALIZE_NOCOPY));
+                if(data) {
+                    return {data, data + size};
+                }
+                using buffer_ptr =
+                    std::unique_ptr<unsigned char, std::integral_constant<decltype(&sqlite3_free), sqlite3_free>>;
+                buffer_ptr copy{sqlite3_serialize(con.get(), "main", &size, 0)};
+                if(!copy) {
+                    throw_translated_sqlite_error(SQLITE_NOMEM);
+                }
+                auto copyData = reinterpret_cast<const char*>(copy.get());
+                return {copyData, copyData + size};
+            }
+
+            /**
+             *  Replaces the database with the content `data` previously returned by `serialize()` or read from a
+             *  database file. The content is copied once into memory owned by SQLite and the connection works with
+             *  it as with an in-memory database, so the storage keeps its connection open from now on. Cached objects
+             *  and query results are dropped.
+             *  @param readonly whether the deserialized database rejects writes; otherwise it grows as needed.
+             */
+            void deserialize(const std::vector<char>& data, bool readonly = false) {
+                this->open_forever();
+                this->deserialize_internal(data.data(), sqlite3_int64(data.size()), readonly);
+                this->clear_caches();
+            }
+#endif
+
             /**
              *  Drops table with given name.
              */
@@ -102,9 +194,19 @@ namespace sqlite_orm {
 
           protected:
             void rename_table(sqlite3* db, const std::string& oldName, const std::string& newName) const {
+                this->rename_table(db, std::string{}, oldName, newName);
+            }
+
+            /**
+             *  Renames a table of the database attached as `schemaName`, it stays in that database.
+             */
+            void rename_table(sqlite3* db,
+                              const std::string& schemaName,
+                              const std::string& oldName,
+                              const std::string& newName) const {
                 std::stringstream ss;
-                ss << "ALTER TABLE " << streaming_identifier(oldName) << " RENAME TO " << streaming_identifier(newName)
-                   << std::flush;
+                ss << "ALTER TABLE " << streaming_identifier(schemaName, oldName, std::string{}) << " RENAME TO "
+                   << streaming_identifier(newName) << std::flush;
                 perform_void_exec(db, ss.str());
             }
 
@@ -119,9 +221,17 @@ namespace sqlite_orm {
             }
 
             bool table_exists(sqlite3* db, const std::string& tableName) const {
+                return this->table_exists(db, std::string{}, tableName);
+            }
+
+            /**
+             *  Checks whether table exists in the database attached as `schemaName`, the main database if it is empty.
+             */
+            bool table_exists(sqlite3* db, const std::string& schemaName, const std::string& tableName) const {
                 bool result = false;
                 std::stringstream ss;
-                ss << "SELECT COUNT(*) FROM sqlite_master WHERE type = " << quote_string_literal("table")
+                ss << "SELECT COUNT(*) FROM " << streaming_identifier(schemaName, "sqlite_master", std::string{})
+                   << " WHERE type = " << quote_string_literal("table")
                    << " AND name = " << quote_string_literal(tableName) << std::flush;
                 perform_exec(
                     db,
@@ -137,6 +247,111 @@ namespace sqlite_orm {
                 return result;
             }
 
+            void record_query(const std::string& sql) {
+                if(this->recordingQueries &&
+                   std::find(this->recordedQueries.begin(), this->recordedQueries.end(), sql) ==
+                       this->recordedQueries.end()) {
+                    this->recordedQueries.push_back(sql);
+                }
+            }
+
+            /**
+             *  SQL text of the index with name `indexName` from sqlite_master of the database attached as `schemaName`
+             *  (the main database if it is empty) or an empty string if there is no such index.
+             */
+            std::string index_sql(sqlite3* db, const std::string& schemaName, const std::string& indexName) const {
+                std::string result;
+                std::stringstream ss;
+                ss << "SELECT sql FROM " << streaming_identifier(schemaName, "sqlite_master", std::string{})
+                   << " WHERE type = " << quote_string_literal("index")
+                   << " AND name = " << quote_string_literal(indexName) << std::flush;
+                perform_exec(
+                    db,
+                    ss.str(),
+                    [](void* data, int argc, char** argv, char** /*azColName*/) -> int {
+                        auto& res = *(std::string*)data;
+                        if(argc && argv[0]) {
+                            res = argv[0];
+                        }
+                        return 0;
+                    },
+                    &result);
+                return result;
+            }
+
+            /**
+             *  Structure of the index named `indexName` on table `tableName` of the database attached as
+             *  `schemaName` (the main database if it is empty), read with `PRAGMA index_list` and
+             *  `PRAGMA index_xinfo`. Returns false if there is no such index.
+             */
+            bool read_index_structure(sqlite3* db,
+                                      const std::string& schemaName,
+                                      const std::string& tableName,
+                                      const std::string& indexName,
+                                      index_structure& result) const {
+                const std::string pragmaPrefix =
+                    "PRAGMA " + (schemaName.empty() ? std::string{} : quote_identifier(schemaName) + ".");
+                struct index_list_row {
+                    const std::string& indexName;
+                    bool found = false;
+                    bool unique = false;
+                    bool partial = false;
+                } listRow{indexName};
+                perform_exec(
+                    db,
+                    pragmaPrefix + "index_list(" + quote_identifier(tableName) + ")",
+                    [](void* data, int argc, char** argv, char** /*columnName*/) -> int {
+                        auto& row = *static_cast<index_list_row*>(data);
+                        //  seq, name, unique, origin, partial
+                        if(argc >= 3 && argv[1] && row.indexName == argv[1]) {
+                            row.found = true;
+                            row.unique = argv[2] && std::atoi(argv[2]) != 0;
+                            row.partial = argc >= 5 && argv[4] && std::atoi(argv[4]) != 0;
+                        }
+                        return 0;
+                    },
+                    &listRow);
+                if(!listRow.found) {
+                    return false;
+                }
+                result.unique = listRow.unique;
+                result.columns.clear();
+                perform_exec(
+                    db,
+                    pragmaPrefix + "index_xinfo(" + quote_identifier(indexName) + ")",
+                    [](void* data, int argc, char** argv, char** /*columnName*/) -> int {
+                        auto& columns = *static_cast<std::vector<index_key_column>*>(data);
+                        //  seqno, cid, name, desc, coll, key
+                        if(argc >= 6 && argv[5] && std::atoi(argv[5]) != 0) {
+                            index_key_column column;
+                            column.name = argv[2] ? argv[2] : "";
+                            column.desc = argv[3] && std::atoi(argv[3]) != 0;
+                            column.collation = argv[4] ? argv[4] : "";
+                            columns.push_back(std::move(column));
+                        }
+                        return 0;
+                    },
+                    &result.columns);
+                //  no pragma reports indexed expressions or the condition of a partial index, they are taken from
+                //  the index's SQL
+                const bool hasExpressions =
+                    std::any_of(result.columns.begin(), result.columns.end(), [](const index_key_column& column) {
+                        return column.name.empty();
+                    });
+                const std::string sql =
+                    hasExpressions || listRow.partial ? this->index_sql(db, schemaName, indexName) : std::string{};
+                if(hasExpressions) {
+                    auto keys = normalized_index_keys(sql);
+                    for(size_t i = 0; i < result.columns.size() && i < keys.size(); ++i) {
+                        if(result.columns[i].name.empty()) {
+                            result.columns[i].expression = std::move(keys[i]);
+                        }
+                    }
+                }
+                result.condition = listRow.partial ? normalized_index_condition(sql) : "";
+                return true;
+            }
+
             void add_generated_cols(std::vector<const table_xinfo*>& columnsToAdd,
                                     const std::vector<table_xinfo>& storageTableInfo) {
                 //  iterate through storage columns
@@ -181,9 +396,64 @@ namespace sqlite_orm {
                 return sqlite3_libversion();
             }
 
+            /**
+             *  Runs `f` inside a transaction which is committed if `f` returns true and rolled back otherwise.
+             *  If a retry policy is set with `retry_on_busy()`, the whole transaction is started over
+             *  when any of its statements or the commit fails with SQLITE_BUSY (including SQLITE_BUSY_SNAPSHOT in WAL mode).
+             */
             bool transaction(const std::function<bool()>& f) {
-                auto guard = this->transaction_guard();
-                return guard.commit_on_destroy = f();
+                if(this->retryPolicy.max_attempts <= 1) {
+                    auto guard = this->transaction_guard();
+                    return guard.commit_on_destroy = f();
+                }
+                for(int attempt = 1;; ++attempt) {
+                    try {
+                        auto guard = this->transaction_guard();
+                        const bool shouldCommit = f();
+                        if(shouldCommit) {
+                            try {
+                                guard.commit();
+                            } catch(const std::system_error&) {
+                                //  a failed commit leaves the transaction open
+                                this->rollback();
+                                throw;
+                            }
+                        }
+                        return shouldCommit;
+                    } catch(const std::system_error& e) {
+                        if(e.code() != make_error_code(sqlite_errc(SQLITE_BUSY)) ||
+                           attempt >= this->retryPolicy.max_attempts) {
+                            throw;
+                        }
+                        ++this->retryStats.transaction_retries;
+                        this->sleep_before_retry(attempt);
+                    }
+                }
+            }
+
+            /**
+             *  Sets a policy for dealing with SQLITE_BUSY: locks are waited for by a busy handler with exponential
+             *  backoff and jitter, and `transaction(f)` is started over as a whole on busy conflicts.
+             *  The policy is applied every time the connection is opened and replaces `busy_timeout()`;
+             *  a handler set with `busy_handler()` takes precedence over it.
+             *  Pass a policy with `max_attempts = 1` to switch retrying off.
+             */
+            void retry_on_busy(busy_retry_policy policy) {
+                this->retryPolicy = policy;
+                if(this->is_opened() && !this->_busy_handler) {
+                    this->register_retry_policy(this->connection->get());
+                }
+            }
+
+            /**
+             *  Returns counters of retries performed due to the policy set with `retry_on_busy()`.
+             */
+            sqlite_orm::busy_retry_stats busy_retry_stats() const {
+                return this->retryStats;
+            }
+
+            void reset_busy_retry_stats() {
+                this->retryStats = {};
             }
 
             std::string current_time() {
@@ -512,6 +782,49 @@ namespace sqlite_orm {
                 this->create_collation(ss.str(), {});
             }
 
+            /**
+             *  Attaches the database file `filename` under the name `schemaName`. Tables of the attached database are
+             *  mapped with `make_table(...).in_schema(schemaName)` and can be joined with tables of the main database.
+             *  The database is attached right away if the connection is open and to every connection the storage opens
+             *  later on. Attaching another file under the same name replaces the previous attachment.
+             *  Note: ATTACH doesn't work inside of a transaction.
+             */
+            void attach(const std::string& filename, const std::string& schemaName) {
+                auto it = std::find_if(this->attachedDatabases.begin(),
+                                       this->attachedDatabases.end(),
+                                       [&schemaName](const std::pair<std::string, std::string>& attachment) {
+                                           return attachment.first == schemaName;
+                                       });
+                if(this->connection->retain_count() > 0) {
+                    sqlite3* db = this->connection->get();
+                    if(it != this->attachedDatabases.end()) {
+                        detach_database(db, schemaName);
+                    }
+                    attach_database(db, filename, schemaName);
+                }
+                if(it != this->attachedDatabases.end()) {
+                    it->second = filename;
+                } else {
+                    this->attachedDatabases.emplace_back(schemaName, filename);
+                }
+            }
+
+            /**
+             *  Detaches the database attached as `schemaName` and stops attaching it to new connections.
+             */
+            void detach(const std::string& schemaName) {
+                if(this->connection->retain_count() > 0) {
+                    detach_database(this->connection->get(), schemaName);
+                }
+                this->attachedDatabases.erase(
+                    std::remove_if(this->attachedDatabases.begin(),
+                                   this->attachedDatabases.end(),
+                                   [&schemaName](const std::pair<std::string, std::string>& attachment) {
+                                       return attachment.first == schemaName;
+                                   }),
+                    this->attachedDatabases.end());
+            }
+
             void begin_transaction() {
                 this->begin_transaction_internal("BEGIN TRANSACTION");
             }
@@ -546,6 +859,32 @@ namespace sqlite_orm {
                 }
             }
 
+            void begin_savepoint(const std::string& name) {
+                std::stringstream ss;
+                ss << "SAVEPOINT " << streaming_identifier(name) << std::flush;
+                this->begin_transaction_internal(ss.str());
+            }
+
+            /**
+             *  Releases the most recent savepoint with the given name, committing it if it is the outermost one.
+             */
+            void release_savepoint(const std::string& name) {
+                std::stringstream ss;
+                ss << "RELEASE " << streaming_identifier(name) << std::flush;
+                this->end_savepoint_internal(ss.str());
+            }
+
+            /**
+             *  Rolls back the changes made since the most recent savepoint with the given name was started,
+             *  then releases it.
+             */
+            void rollback_to_savepoint(const std::string& name) {
+                std::stringstream ss;
+                ss << "ROLLBACK TO " << streaming_identifier(name) << "; RELEASE " << streaming_identifier(name)
+                   << std::flush;
+                this->end_savepoint_internal(ss.str());
+            }
+
             void backup_to(const std::string& filename) {
                 auto backup = this->make_backup_to(filename);
                 backup.step(-1);
@@ -554,16 +893,19 @@ namespace sqlite_orm {
             void backup_to(storage_base& other) {
                 auto backup = this->make_backup_to(other);
                 backup.step(-1);
+                other.clear_caches();
             }
 
             void backup_from(const std::string& filename) {
                 auto backup = this->make_backup_from(filename);
                 backup.step(-1);
+                this->clear_caches();
             }
 
             void backup_from(storage_base& other) {
                 auto backup = this->make_backup_from(other);
                 backup.step(-1);
+                this->clear_caches();
             }
 
             backup_t make_backup_to(const std::string& filename) {
@@ -590,6 +932,85 @@ namespace sqlite_orm {
                 return this->connection->filename;
             }
 
+            /**
+             *  Copies the database to the file `target` on a background thread while the storage stays usable.
+             *  Pages are copied in batches of `options.pages_per_step` with a pause of `options.sleep` in between,
+             *  so foreground readers and writers only wait for one batch at a time and the I/O bandwidth is capped.
+             *  A file database is read through a separate connection: if it is changed meanwhile the copy starts
+             *  over automatically, which `backup_progress::restarts` counts. An in-memory database is read through
+             *  the storage's connection and changes made through it are applied to the copy in place.
+             *  Threading: the background thread and the storage's users share that connection, which is safe only
+             *  in SQLite's serialized threading mode (the default, see `sqlite3_threadsafe()`) because SQLite then
+             *  serializes calls on the connection. The storage's destructor waits for running backups, so an
+             *  in-memory database stays open until they finish and the returned future may be dropped.
+             *  Busy or locked batches are retried after the pause.
+             *  @return a future which becomes ready when the copy is complete and rethrows its error if it failed.
+             */
+            std::future<void> start_backup(const std::string& target, backup_options options) {
+                //  an in-memory database keeps its connection open as long as the storage exists
+                connection_holder* memoryConnection = this->inMemory ? this->connection.get() : nullptr;
+                auto copy = [target, source = this->filename(), memoryConnection, options = std::move(options)]() {
+                    std::unique_ptr<connection_holder> sourceHolder;
+                    if(!memoryConnection) {
+                        sourceHolder = std::make_unique<connection_holder>(source);
+                    }
+                    connection_ref sourceRef{memoryConnection ? *memoryConnection : *sourceHolder};
+                    auto backup = [&target, &sourceRef] {
+                        auto holder = std::make_unique<connection_holder>(target);
+                        connection_ref conRef{*holder};
+                        return backup_t{conRef, "main", sourceRef, "main", std::move(holder)};
+                    }();
+                    backup_progress progress;
+                    int copiedPages = 0;
+                    while(true) {
+                        if(options.cancellation.is_cancelled()) {
+                            throw std::system_error{orm_error_code::backup_cancelled};
+                        }
+                        int rc = backup.step(options.pages_per_step);
+                        if(rc != SQLITE_OK && rc != SQLITE_DONE && rc != SQLITE_BUSY && rc != SQLITE_LOCKED) {
+                            throw_translated_sqlite_error(rc);
+                        }
+                        progress.remaining = backup.remaining();
+                        progress.pagecount = backup.pagecount();
+                        //  a successful batch always copies pages unless the copy started over
+                        if(rc == SQLITE_OK && progress.pagecount - progress.remaining <= copiedPages) {
+                            ++progress.restarts;
+                        }
+                        if(rc == SQLITE_OK || rc == SQLITE_DONE) {
+                            copiedPages = progress.pagecount - progress.remaining;
+                        }
+                        if(options.on_progress) {
+                            options.on_progress(progress);
+                        }
+                        if(rc == SQLITE_DONE) {
+                            break;
+                        }
+                        std::this_thread::sleep_for(options.sleep);
+                    }
+                };
+                //  the storage holds the task so that its destructor can wait for it and so that dropping the
+                //  returned future doesn't block the caller until the copy is complete
+                this->backups.erase(std::remove_if(this->backups.begin(),
+                                                   this->backups.end(),
+                                                   [](const std::future<void>& task) {
+                                                       return task.wait_for(std::chrono::seconds{0}) ==
+                                                              std::future_status::ready;
+                                                   }),
+                                    this->backups.end());
+                std::promise<void> promise;
+                auto result = promise.get_future();
+                this->backups.push_back(
+                    std::async(std::launch::async, [copy = std::move(copy), promise = std::move(promise)]() mutable {
+                        try {
+                            copy();
+                            promise.set_value();
+                        } catch(...) {
+                            promise.set_exception(std::current_exception());
+                        }
+                    }));
+                return result;
+            }
+
             /**
              * Checks whether connection to database is opened right now.
              * Returns always `true` for in memory databases.
@@ -620,7 +1041,146 @@ namespace sqlite_orm {
                 }
             }
 
+            /**
+             *  Removes all callbacks registered with `on_change()` and `on_preupdate()`.
+             */
+            void clear_change_callbacks() {
+                this->changeCallbacks.clear();
+#ifdef SQLITE_ENABLE_PREUPDATE_HOOK
+                this->preupdateCallbacks.clear();
+#endif
+                if(this->is_opened()) {
+                    this->register_change_hooks(this->connection->get());
+                }
+            }
+
+            sqlite_orm::query_cache_stats query_cache_stats() const {
+                return this->queryCache.stats;
+            }
+
+            /**
+             *  Drops all results memoized by `cached(ttl).select(...)`.
+             */
+            void clear_query_cache() {
+                this->queryCache.clear();
+            }
+
+            /**
+             *  Sets the maximum number of results memoized by `cached(ttl).select(...)`, 256 by default.
+             */
+            void set_query_cache_capacity(size_t value) {
+                this->queryCache.set_capacity(value);
+            }
+
+            /**
+             *  Starts or stops recording the SQL of statements prepared from the DSL for `advise_indexes()`.
+             *  Meant for development and test runs: every distinct statement is kept until
+             *  `clear_recorded_queries()` is called.
+             */
+            void record_queries(bool value) {
+                this->recordingQueries = value;
+            }
+
+            const std::vector<std::string>& recorded_queries() const {
+                return this->recordedQueries;
+            }
+
+            void clear_recorded_queries() {
+                this->recordedQueries.clear();
+            }
+
+            /**
+             *  Recommends indexes for the recorded statements which currently scan whole tables.
+             *  The schema of the database is copied into an in-memory database and candidate indexes are
+             *  tried there with `EXPLAIN QUERY PLAN`, so the database itself isn't modified and the result
+             *  doesn't depend on its data.
+             */
+            std::vector<index_advice> advise_indexes() {
+                auto con = this->get_connection();
+                internal::index_advisor advisor{con.get()};
+                return advisor.advise(this->recordedQueries);
+            }
+
+            /**
+             *  Interrupts the statement currently running on the storage's connection, if any.
+             *  Can be called from another thread; the interrupted statement fails with SQLITE_INTERRUPT.
+             */
+            void interrupt() {
+                if(this->is_opened()) {
+                    sqlite3_interrupt(this->connection->get());
+                }
+            }
+
+            /**
+             *  Calls `f` and interrupts any statement it runs once `timeout` has elapsed.
+             *  Throws `std::system_error{orm_error_code::deadline_exceeded}` in this case, the connection remains usable.
+             *  Nested calls are bounded by the earliest deadline.
+             *  @example: auto users = storage.with_deadline(std::chrono::milliseconds{50}, [&storage] {
+             *      return storage.get_all<User>();
+             *  });
+             */
+            template<class F>
+            auto with_deadline(std::chrono::steady_clock::duration timeout, F&& f) -> decltype(f()) {
+                interrupt_scope scope{*this, std::chrono::steady_clock::now() + timeout, nullptr};
+                return this->call_interruptible(std::forward<F>(f));
+            }
+
+            /**
+             *  Calls `f` and interrupts any statement it runs as soon as `token` gets cancelled from another thread.
+             *  Throws `std::system_error{orm_error_code::query_cancelled}` in this case, the connection remains usable.
+             */
+            template<class F>
+            auto with_cancellation(const cancellation_token& token, F&& f) -> decltype(f()) {
+                interrupt_scope scope{*this, std::chrono::steady_clock::time_point::max(), &token};
+                return this->call_interruptible(std::forward<F>(f));
+            }
+
+#if SQLITE_VERSION_NUMBER >= 3014000
+            /**
+             *  Registers a trace callback using `sqlite3_trace_v2`.
+             *  `mask` is a combination of SQLITE_TRACE_STMT, SQLITE_TRACE_PROFILE, SQLITE_TRACE_ROW and SQLITE_TRACE_CLOSE.
+             *  The callback is kept by the storage and registered again every time the connection is reopened.
+             *  Pass an empty callback or zero mask to remove it.
+             *  The callback must not throw: it runs inside SQLite while statements are stepped, reset or finalized
+             *  and while the connection closes, where an exception can't be propagated, so one escaping the callback
+             *  calls `std::terminate()`.
+             *  Use `slow_query_logger` as a callback to log statements exceeding a duration threshold.
+             */
+            int on_trace(unsigned int mask, std::function<void(const trace_event&)> callback) {
+                this->traceCallback = std::move(callback);
+                this->traceMask = this->traceCallback ? mask : 0;
+                if(this->is_opened()) {
+                    return this->register_trace(this->connection->get());
+                } else {
+                    return SQLITE_OK;
+                }
+            }
+#endif
+
           protected:
+#if SQLITE_VERSION_NUMBER >= 3036000 && !defined(SQLITE_OMIT_DESERIALIZE)
+            void deserialize_internal(const char* data, sqlite3_int64 size, bool readonly) {
+                auto con = this->get_connection();
+                auto buffer = static_cast<char*>(sqlite3_malloc64(sqlite3_uint64(size ? size : 1)));
+                if(!buffer) {
+                    throw_translated_sqlite_error(SQLITE_NOMEM);
+                }
+                std::copy(data, data + size, buffer);
+                unsigned int flags = SQLITE_DESERIALIZE_FREEONCLOSE |
+                                     (readonly ? SQLITE_DESERIALIZE_READONLY : SQLITE_DESERIALIZE_RESIZEABLE);
+                //  the buffer is freed by SQLite even if this fails
+                int rc = sqlite3_deserialize(con.get(),
+                                             "main",
+                                             reinterpret_cast<unsigned char*>(buffer),
+                                             size,
+                                             size,
+                                             flags);
+                if(rc != SQLITE_OK) {
+                    throw_translated_sqlite_error(con.get());
+                }
+            }
+#endif
+
             storage_base(std::string filename, int foreignKeysCount) :
                 pragma(std::bind(&storage_base::get_connection, this)),
                 limit(std::bind(&storage_base::get_connection, this)),
@@ -634,10 +1194,20 @@ namespace sqlite_orm {
             }
 
             storage_base(const storage_base& other) :
+                storage_base{other, other.connection->filename, other.attachedDatabases} {}
+
+            /**
+             *  Copy of `other` connecting to `filename` and attaching `attachedDatabases` instead of the databases
+             *  of `other`.
+             */
+            storage_base(const storage_base& other,
+                         std::string filename,
+                         std::vector<std::pair<std::string, std::string>> attachedDatabases) :
                 on_open(other.on_open), pragma(std::bind(&storage_base::get_connection, this)),
-                limit(std::bind(&storage_base::get_connection, this)), inMemory(other.inMemory),
-                connection(std::make_unique<connection_holder>(other.connection->filename)),
-                cachedForeignKeysCount(other.cachedForeignKeysCount) {
+                limit(std::bind(&storage_base::get_connection, this)),
+                inMemory(filename.empty() || filename == ":memory:"),
+                connection(std::make_unique<connection_holder>(std::move(filename))),
+                cachedForeignKeysCount(other.cachedForeignKeysCount), attachedDatabases(std::move(attachedDatabases)) {
                 if(this->inMemory) {
                     this->connection->retain();
                     this->on_open_internal(this->connection->get());
@@ -645,6 +1215,12 @@ namespace sqlite_orm {
             }
 
             ~storage_base() {
+                for(auto& backup: this->backups) {
+                    backup.wait();
+                }
+                if(this->dataVersionStatement) {
+                    sqlite3_finalize(this->dataVersionStatement);
+                }
                 if(this->isOpenedForever) {
                     this->connection->release();
                 }
@@ -662,6 +1238,15 @@ namespace sqlite_orm {
                 perform_void_exec(db, query);
             }
 
+            void end_savepoint_internal(const std::string& query) {
+                sqlite3* db = this->connection->get();
+                perform_void_exec(db, query);
+                this->connection->release();
+                if(this->connection->retain_count() < 0) {
+                    throw std::system_error{orm_error_code::no_active_transaction};
+                }
+            }
+
             connection_ref get_connection() {
                 connection_ref res{*this->connection};
                 if(1 == this->connection->retain_count()) {
@@ -710,8 +1295,26 @@ namespace sqlite_orm {
                     sqlite3_limit(db, p.first, p.second);
                 }
 
+                for(auto& attachment: this->attachedDatabases) {
+                    attach_database(db, attachment.second, attachment.first);
+                }
+
                 if(_busy_handler) {
                     sqlite3_busy_handler(this->connection->get(), busy_handler_callback, this);
+                } else if(this->retryPolicy.max_attempts > 1) {
+                    this->register_retry_policy(db);
+                }
+
+#if SQLITE_VERSION_NUMBER >= 3014000
+                if(this->traceMask) {
+                    this->register_trace(db);
+                }
+#endif
+
+                this->register_change_hooks(db);
+
+                if(this->interruptScopesCount) {
+                    sqlite3_progress_handler(db, progressHandlerOpcodes, progress_handler_callback, this);
                 }
 
                 for(auto& udfProxy: this->scalarFunctions) {
@@ -722,6 +1325,12 @@ namespace sqlite_orm {
                     try_to_create_aggregate_function(db, udfProxy);
                 }
 
+#if SQLITE_VERSION_NUMBER >= 3020000
+                for(auto& p: this->rangeTables) {
+                    register_range_table(db, p.first, *p.second);
+                }
+#endif
+
                 if(this->on_open) {
                     this->on_open(db);
                 }
@@ -867,6 +1476,15 @@ namespace sqlite_orm {
                 }
             }
 
+#if SQLITE_VERSION_NUMBER >= 3020000
+            static void register_range_table(sqlite3* db, const std::string& name, basic_range_table& rangeTable) {
+                int rc = sqlite3_create_module_v2(db, name.c_str(), &rangeTable.module, &rangeTable, nullptr);
+                if(rc != SQLITE_OK) {
+                    throw_translated_sqlite_error(db);
+                }
+            }
+#endif
+
             std::string current_time(sqlite3* db) {
                 std::string result;
                 perform_exec(db, "SELECT CURRENT_TIME", extract_single_value<std::string>, &result);
@@ -885,10 +1503,29 @@ namespace sqlite_orm {
                 return result;
             }
 
+            static void attach_database(sqlite3* db, const std::string& filename, const std::string& schemaName) {
+                std::stringstream ss;
+                ss << "ATTACH DATABASE " << quote_string_literal(filename) << " AS " << streaming_identifier(schemaName)
+                   << std::flush;
+                perform_void_exec(db, ss.str());
+            }
+
+            static void detach_database(sqlite3* db, const std::string& schemaName) {
+                std::stringstream ss;
+                ss << "DETACH DATABASE " << streaming_identifier(schemaName) << std::flush;
+                perform_void_exec(db, ss.str());
+            }
+
             void drop_table_internal(sqlite3* db, const std::string& tableName) {
+                this->drop_table_internal(db, std::string{}, tableName);
+            }
+
+            void drop_table_internal(sqlite3* db, const std::string& schemaName, const std::string& tableName) {
                 std::stringstream ss;
-                ss << "DROP TABLE " << streaming_identifier(tableName) << std::flush;
+                ss << "DROP TABLE " << streaming_identifier(schemaName, tableName, std::string{}) << std::flush;
                 perform_void_exec(db, ss.str());
+                //  rows of a dropped table aren't reported by the update hook
+                this->clear_caches();
             }
 
             static int collate_callback(void* arg, int leftLen, const void* lhs, int rightLen, const void* rhs) {
@@ -905,6 +1542,370 @@ namespace sqlite_orm {
                 }
             }
 
+            /**
+             *  Activates a deadline and/or a cancellation token for the lifetime of the scope.
+             *  The progress handler is registered only as long as there is an active scope.
+             */
+            struct interrupt_scope {
+                interrupt_scope(storage_base& storage,
+                                std::chrono::steady_clock::time_point deadline,
+                                const cancellation_token* token) :
+                    storage(storage),
+                    previousDeadline(storage.deadline), hasToken(token != nullptr) {
+                    storage.deadline = (std::min)(storage.deadline, deadline);
+                    if(token) {
+                        storage.cancellationTokens.push_back(*token);
+                    }
+                    if(1 == ++storage.interruptScopesCount && storage.is_opened()) {
+                        sqlite3_progress_handler(storage.connection->get(),
+                                                 progressHandlerOpcodes,
+                                                 progress_handler_callback,
+                                                 &storage);
+                    }
+                }
+
+                ~interrupt_scope() {
+                    if(0 == --this->storage.interruptScopesCount && this->storage.is_opened()) {
+                        sqlite3_progress_handler(this->storage.connection->get(), 0, nullptr, nullptr);
+                    }
+                    if(this->hasToken) {
+                        this->storage.cancellationTokens.pop_back();
+                    }
+                    this->storage.deadline = this->previousDeadline;
+                }
+
+                interrupt_scope(const interrupt_scope&) = delete;
+                interrupt_scope& operator=(const interrupt_scope&) = delete;
+
+              private:
+                storage_base& storage;
+                std::chrono::steady_clock::time_point previousDeadline;
+                bool hasToken;
+            };
+
+            template<class F>
+            auto call_interruptible(F&& f) -> decltype(f()) {
+                try {
+                    return f();
+                } catch(const std::system_error& e) {
+                    if(e.code() != make_error_code(sqlite_errc(SQLITE_INTERRUPT))) {
+                        throw;
+                    }
+                    if(this->is_cancelled()) {
+                        throw std::system_error{orm_error_code::query_cancelled};
+                    }
+                    if(std::chrono::steady_clock::now() >= this->deadline) {
+                        throw std::system_error{orm_error_code::deadline_exceeded};
+                    }
+                    throw;
+                }
+            }
+
+            bool is_cancelled() const {
+                return std::any_of(this->cancellationTokens.begin(),
+                                   this->cancellationTokens.end(),
+                                   [](const cancellation_token& token) {
+                                       return token.is_cancelled();
+                                   });
+            }
+
+            static int progress_handler_callback(void* selfPointer) {
+                auto& storage = *static_cast<storage_base*>(selfPointer);
+                return storage.is_cancelled() || std::chrono::steady_clock::now() >= storage.deadline;
+            }
+
+#if SQLITE_VERSION_NUMBER >= 3014000
+            int register_trace(sqlite3* db) {
+                if(this->traceMask) {
+                    return sqlite3_trace_v2(db, this->traceMask, trace_callback, this);
+                } else {
+                    return sqlite3_trace_v2(db, 0, nullptr, nullptr);
+                }
+            }
+
+            //  noexcept: an exception must not unwind through SQLite's frames
+            static int trace_callback(unsigned int type, void* selfPointer, void* p, void* x) noexcept {
+                auto& storage = *static_cast<storage_base*>(selfPointer);
+                trace_event event;
+                event.type = type;
+                switch(type) {
+                    case SQLITE_TRACE_STMT:
+                        event.stmt = static_cast<sqlite3_stmt*>(p);
+                        event.sql = static_cast<const char*>(x);
+                        break;
+                    case SQLITE_TRACE_PROFILE:
+                        event.stmt = static_cast<sqlite3_stmt*>(p);
+                        event.nanoseconds = *static_cast<sqlite3_int64*>(x);
+                        break;
+                    case SQLITE_TRACE_ROW:
+                        event.stmt = static_cast<sqlite3_stmt*>(p);
+                        break;
+                    case SQLITE_TRACE_CLOSE:
+                        event.db = static_cast<sqlite3*>(p);
+                        break;
+                }
+                if(event.stmt) {
+                    event.db = sqlite3_db_handle(event.stmt);
+                }
+                storage.traceCallback(event);
+                return 0;
+            }
+#endif
+
+            using change_callback = std::function<void(int operation, int64 rowid)>;
+            using preupdate_callback = std::function<void(sqlite3* db, int operation, int64 oldRowid, int64 newRowid)>;
+
+            /**
+             *  Key of a table in the maps of change callbacks and object caches and in the query cache:
+             *  `schema.table`, the way the update hook reports tables, so that tables with the same name
+             *  in attached databases are told apart. An empty schema name stands for the main database.
+             */
+            static std::string change_key(const std::string& schemaName, const std::string& tableName) {
+                std::string key = schemaName.empty() ? "main" : schemaName;
+                key += '.';
+                key += tableName;
+                return key;
+            }
+
+            template<class Callbacks, class F>
+            void set_change_callback(Callbacks& callbacks, const std::string& tableKey, F callback) {
+                if(callback) {
+                    callbacks[tableKey] = std::move(callback);
+                } else {
+                    callbacks.erase(tableKey);
+                }
+                if(this->is_opened()) {
+                    this->register_change_hooks(this->connection->get());
+                }
+            }
+
+            void rename_change_callbacks(const std::string& oldKey, const std::string& newKey) {
+                auto it = this->changeCallbacks.find(oldKey);
+                if(it != this->changeCallbacks.end()) {
+                    auto callback = std::move(it->second);
+                    this->changeCallbacks.erase(it);
+                    this->changeCallbacks[newKey] = std::move(callback);
+                }
+                auto cacheIt = this->objectCaches.find(oldKey);
+                if(cacheIt != this->objectCaches.end()) {
+                    auto cache = std::move(cacheIt->second);
+                    this->objectCaches.erase(cacheIt);
+                    this->objectCaches[newKey] = std::move(cache);
+                }
+#ifdef SQLITE_ENABLE_PREUPDATE_HOOK
+                auto preIt = this->preupdateCallbacks.find(oldKey);
+                if(preIt != this->preupdateCallbacks.end()) {
+                    auto callback = std::move(preIt->second);
+                    this->preupdateCallbacks.erase(preIt);
+                    this->preupdateCallbacks[newKey] = std::move(callback);
+                }
+#endif
+            }
+
+            void register_change_hooks(sqlite3* db) {
+                if(!this->changeCallbacks.empty() || !this->objectCaches.empty() || this->queryCache.enabled) {
+                    sqlite3_update_hook(db, update_hook_callback, this);
+                } else {
+                    sqlite3_update_hook(db, nullptr, nullptr);
+                }
+#ifdef SQLITE_ENABLE_PREUPDATE_HOOK
+                if(!this->preupdateCallbacks.empty()) {
+                    sqlite3_preupdate_hook(db, preupdate_hook_callback, this);
+                } else {
+                    sqlite3_preupdate_hook(db, nullptr, nullptr);
+                }
+#endif
+            }
+
+            static void update_hook_callback(void* selfPointer,
+                                             int operation,
+                                             const char* dbName,
+                                             const char* tableName,
+                                             int64 rowid) {
+                auto& storage = *static_cast<storage_base*>(selfPointer);
+                try {
+                    //  SQLite passes names rather than table identities, so every event costs one string hash per
+                    //  map; reuse the key's buffer so that a lookup doesn't allocate
+                    storage.changeHookKey.assign(dbName).append(1, '.').append(tableName);
+                    storage.table_changed(rowid);
+                    auto it = storage.changeCallbacks.find(storage.changeHookKey);
+                    if(it != storage.changeCallbacks.end()) {
+                        it->second(operation, rowid);
+                    }
+                } catch(...) {
+                    storage.change_hook_failed();
+                }
+            }
+
+            /**
+             *  Exceptions must not unwind through SQLite's frames, so the hooks keep the first one thrown
+             *  while a statement runs and `perform_change_step()` rethrows it once the statement is done.
+             */
+            void change_hook_failed() {
+                if(!this->changeHookError) {
+                    this->changeHookError = std::current_exception();
+                }
+            }
+
+            void rethrow_change_hook_error() {
+                if(this->changeHookError) {
+                    std::rethrow_exception(std::exchange(this->changeHookError, nullptr));
+                }
+            }
+
+            /**
+             *  Steps a statement which inserts, updates or deletes rows and rethrows the first exception thrown by
+             *  a change callback meanwhile. The change itself isn't undone.
+             */
+            void perform_change_step(sqlite3_stmt* stmt) {
+                this->changeHookError = nullptr;
+                perform_step(stmt);
+                this->rethrow_change_hook_error();
+            }
+
+            /**
+             *  Invalidates cached data of the table named `changeHookKey`.
+             */
+            void table_changed(int64 rowid) {
+                auto cacheIt = this->objectCaches.find(this->changeHookKey);
+                if(cacheIt != this->objectCaches.end()) {
+                    cacheIt->second->invalidate(rowid);
+                }
+                if(this->queryCache.enabled) {
+                    this->queryCache.table_changed(this->changeHookKey);
+                }
+            }
+
+            /**
+             *  Called after all rows of a table might have been deleted without the update hook being invoked
+             *  (truncate optimization).
+             */
+            void table_truncated(const std::string& tableKey) {
+                auto cacheIt = this->objectCaches.find(tableKey);
+                if(cacheIt != this->objectCaches.end()) {
+                    cacheIt->second->clear();
+                }
+                if(this->queryCache.enabled) {
+                    this->queryCache.table_changed(tableKey);
+                }
+            }
+
+            /**
+             *  Called after a REPLACE into the table, see `basic_object_cache::rows_replaced()`.
+             */
+            void rows_replaced(const std::string& tableKey) {
+                auto cacheIt = this->objectCaches.find(tableKey);
+                if(cacheIt != this->objectCaches.end()) {
+                    cacheIt->second->rows_replaced();
+                }
+            }
+
+            /**
+             *  Called after a raw REPLACE, whose table isn't known.
+             */
+            void rows_replaced() {
+                for(auto& cache: this->objectCaches) {
+                    cache.second->rows_replaced();
+                }
+            }
+
+            /**
+             *  Caches are used only when the connection outlives single calls,
+             *  otherwise changes made by others in between could not be detected.
+             */
+            bool connection_kept_open() const {
+                return this->inMemory || this->isOpenedForever;
+            }
+
+            /**
+             *  Drops all cached objects and query results if another connection has committed changes
+             *  since the last check.
+             */
+            void validate_caches(sqlite3* db) {
+                if(this->inMemory) {
+                    return;
+                }
+                if(!this->dataVersionStatement) {
+                    if(sqlite3_prepare_v2(db, "PRAGMA data_version", -1, &this->dataVersionStatement, nullptr) !=
+                       SQLITE_OK) {
+                        throw_translated_sqlite_error(db);
+                    }
+                }
+                if(sqlite3_step(this->dataVersionStatement) != SQLITE_ROW) {
+                    sqlite3_reset(this->dataVersionStatement);
+                    throw_translated_sqlite_error(db);
+                }
+                auto version = sqlite3_column_int64(this->dataVersionStatement, 0);
+                sqlite3_reset(this->dataVersionStatement);
+                if(version != this->dataVersion) {
+                    this->clear_caches();
+                    this->dataVersion = version;
+                }
+            }
+
+            /**
+             *  Drops all cached objects and query results after changes the update hook doesn't report,
+             *  like dropped tables or a database overwritten by a backup.
+             */
+            void clear_caches() {
+                for(auto& cache: this->objectCaches) {
+                    cache.second->clear();
+                }
+                this->queryCache.clear();
+            }
+
+#ifdef SQLITE_ENABLE_PREUPDATE_HOOK
+            static void preupdate_hook_callback(void* selfPointer,
+                                                sqlite3* db,
+                                                int operation,
+                                                const char* dbName,
+                                                const char* tableName,
+                                                int64 oldRowid,
+                                                int64 newRowid) {
+                auto& storage = *static_cast<storage_base*>(selfPointer);
+                try {
+                    storage.changeHookKey.assign(dbName).append(1, '.').append(tableName);
+                    auto it = storage.preupdateCallbacks.find(storage.changeHookKey);
+                    if(it != storage.preupdateCallbacks.end()) {
+                        it->second(db, operation, oldRowid, newRowid);
+                    }
+                } catch(...) {
+                    storage.change_hook_failed();
+                }
+            }
+#endif
+
+            static busy_retry_policy make_no_retry_policy() {
+                busy_retry_policy policy;
+                policy.max_attempts = 1;
+                return policy;
+            }
+
+            void register_retry_policy(sqlite3* db) {
+                if(this->retryPolicy.max_attempts > 1) {
+                    sqlite3_busy_handler(db, retry_policy_busy_callback, this);
+                } else {
+                    sqlite3_busy_handler(db, nullptr, nullptr);
+                }
+            }
+
+            void sleep_before_retry(int retry) {
+                std::uniform_real_distribution<double> distribution{0, 1};
+                auto delay = this->retryPolicy.backoff(retry, distribution(this->retryRandomEngine));
+                this->retryStats.wait_time += delay;
+                std::this_thread::sleep_for(delay);
+            }
+
+            static int retry_policy_busy_callback(void* selfPointer, int triesCount) {
+                auto& storage = *static_cast<storage_base*>(selfPointer);
+                if(triesCount + 1 >= storage.retryPolicy.max_attempts) {
+                    return 0;
+                }
+                ++storage.retryStats.retries;
+                storage.sleep_before_retry(triesCount + 1);
+                return 1;
+            }
+
             bool calculate_remove_add_columns(std::vector<const table_xinfo*>& columnsToAdd,
                                               std::vector<table_xinfo>& storageTableInfo,
                                               std::vector<table_xinfo>& dbTableInfo) const {
@@ -954,9 +1955,41 @@ namespace sqlite_orm {
             std::unique_ptr<connection_holder> connection;
             std::map<std::string, collating_function> collatingFunctions;
             const int cachedForeignKeysCount;
+            //  schema name and file name of attached databases in the order they are attached
+            std::vector<std::pair<std::string, std::string>> attachedDatabases;
             std::function<int(int)> _busy_handler;
+            busy_retry_policy retryPolicy = make_no_retry_policy();
+            sqlite_orm::busy_retry_stats retryStats;
+            std::minstd_rand retryRandomEngine{
+                static_cast<std::minstd_rand::result_type>(std::chrono::steady_clock::now().time_since_epoch().count())};
+            unsigned int traceMask = 0;
+            std::function<void(const trace_event&)> traceCallback;
+            //  number of virtual machine instructions between checks of deadlines and cancellation tokens
+            static constexpr int progressHandlerOpcodes = 1000;
+            int interruptScopesCount = 0;
+            std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::time_point::max();
+            std::vector<cancellation_token> cancellationTokens;
+            //  the maps of callbacks and caches are keyed by `change_key(schema, table)`
+            std::unordered_map<std::string, change_callback> changeCallbacks;
+#ifdef SQLITE_ENABLE_PREUPDATE_HOOK
+            std::unordered_map<std::string, preupdate_callback> preupdateCallbacks;
+#endif
+            std::string changeHookKey;
+            std::exception_ptr changeHookError;
+            std::unordered_map<std::string, std::unique_ptr<basic_object_cache>> objectCaches;
+            query_cache queryCache;
+            bool recordingQueries = false;
+            std::vector<std::string> recordedQueries;
+            //  prepared once, the connection stays open while caches are in use
+            sqlite3_stmt* dataVersionStatement = nullptr;
+            int64 dataVersion = -1;
             std::list<udf_proxy> scalarFunctions;
+            //  backups started with start_backup running on background threads
+            std::vector<std::future<void>> backups;
             std::list<udf_proxy> aggregateFunctions;
+#if SQLITE_VERSION_NUMBER >= 3020000
+            std::map<std::string, std::unique_ptr<basic_range_table>> rangeTables;
+#endif
         };
     }
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <string>  //  std::string
+#include <type_traits>  //  std::decay_t
 
 #include "functional/cxx_universal.h"  //  ::size_t
 #include "functional/static_magic.h"
@@ -12,6 +13,7 @@
 #include "select_constraints.h"
 #include "cte_types.h"
 #include "storage_lookup.h"
+#include "schema/table.h"
 
 // interface functions
 namespace sqlite_orm {
@@ -38,6 +40,42 @@ namespace sqlite_orm {
                 empty_callable<std::string>)(dbObjects);
         }
 
+        inline std::string table_schema_name(const basic_table&) {
+            return {};
+        }
+
+        template<class O, bool WithoutRowId, class... Cs>
+        std::string table_schema_name(const table_t<O, WithoutRowId, Cs...>& table) {
+            return table.schema_name;
+        }
+
+        template<class Lookup, class DBOs, satisfies<is_db_objects, DBOs>>
+        decltype(auto) lookup_table_schema(const DBOs& dbObjects) {
+            return static_if<is_mapped<DBOs, Lookup>::value>(
+                [](const auto& dbObjects) {
+                    return table_schema_name(pick_table<Lookup>(dbObjects));
+                },
+                empty_callable<std::string>)(dbObjects);
+        }
+
+        /**
+         *  Whether the table named `tableName` in the schema `schemaName` is mapped as a WITHOUT ROWID table.
+         */
+        template<class DBOs, satisfies<is_db_objects, DBOs> = true>
+        bool table_is_without_rowid(const DBOs& dbObjects, const std::string& schemaName, const std::string& tableName) {
+            bool res = false;
+            iterate_tuple<true>(dbObjects,
+                                tables_index_sequence<DBOs>{},
+                                [&res, &schemaName, &tableName](const auto& table) {
+                                    using table_type = std::decay_t<decltype(table)>;
+                                    if(table_type::is_without_rowid_v && table.name == tableName &&
+                                       table.schema_name == schemaName) {
+                                        res = true;
+                                    }
+                                });
+            return res;
+        }
+
         /**
          *  Find column name by its type and member pointer.
          */
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <map>  //  std::map
 #include <set>  //  std::set
 #include <string>  //  std::string
 #include <utility>  //  std::pair, std::move
@@ -18,8 +19,12 @@ namespace sqlite_orm {
 
         struct table_name_collector_base {
             using table_name_set = std::set<std::pair<std::string, std::string>>;
+            using table_schema_map = std::map<std::pair<std::string, std::string>, std::string>;
 
             table_name_set table_names;
+            //  schema of each collected table (empty for the main database), taken from the mapped type because
+            //  tables with the same name in different schemas can't be told apart by their name
+            table_schema_map table_schemas;
         };
 
         template<class DBOs>
@@ -37,59 +42,64 @@ namespace sqlite_orm {
 
             template<class F, class O>
             void operator()(F O::*) {
-                this->table_names.emplace(lookup_table_name<O>(this->db_objects), "");
+                this->collect_table<O>("");
             }
 
             template<class T, class F>
             void operator()(const column_pointer<T, F>&) {
-                auto tableName = lookup_table_name<mapped_type_proxy_t<T>>(this->db_objects);
-                this->table_names.emplace(std::move(tableName), alias_extractor<T>::as_alias());
+                this->collect_table<mapped_type_proxy_t<T>>(alias_extractor<T>::as_alias());
             }
 
             template<class A, class C>
             void operator()(const alias_column_t<A, C>&) {
                 // note: instead of accessing the column, we are interested in the type the column is aliased into
-                auto tableName = lookup_table_name<mapped_type_proxy_t<A>>(this->db_objects);
-                this->table_names.emplace(std::move(tableName), alias_extractor<A>::as_alias());
+                this->collect_table<mapped_type_proxy_t<A>>(alias_extractor<A>::as_alias());
             }
 
             template<class T>
             void operator()(const count_asterisk_t<T>&) {
-                auto tableName = lookup_table_name<T>(this->db_objects);
-                if(!tableName.empty()) {
-                    this->table_names.emplace(std::move(tableName), "");
+                if(!lookup_table_name<T>(this->db_objects).empty()) {
+                    this->collect_table<T>("");
                 }
             }
 
             template<class T>
             void operator()(const asterisk_t<T>&) {
-                auto tableName = lookup_table_name<mapped_type_proxy_t<T>>(this->db_objects);
-                table_names.emplace(std::move(tableName), alias_extractor<T>::as_alias());
+                this->collect_table<mapped_type_proxy_t<T>>(alias_extractor<T>::as_alias());
             }
 
             template<class T>
             void operator()(const object_t<T>&) {
-                this->table_names.emplace(lookup_table_name<T>(this->db_objects), "");
+                this->collect_table<T>("");
             }
 
             template<class T>
             void operator()(const table_rowid_t<T>&) {
-                this->table_names.emplace(lookup_table_name<T>(this->db_objects), "");
+                this->collect_table<T>("");
             }
 
             template<class T>
             void operator()(const table_oid_t<T>&) {
-                this->table_names.emplace(lookup_table_name<T>(this->db_objects), "");
+                this->collect_table<T>("");
             }
 
             template<class T>
             void operator()(const table__rowid_t<T>&) {
-                this->table_names.emplace(lookup_table_name<T>(this->db_objects), "");
+                this->collect_table<T>("");
             }
 
             template<class T, class X, class Y, class Z>
             void operator()(const highlight_t<T, X, Y, Z>&) {
-                this->table_names.emplace(lookup_table_name<T>(this->db_objects), "");
+                this->collect_table<T>("");
+            }
+
+          protected:
+            template<class O>
+            void collect_table(std::string alias) {
+                auto inserted = this->table_names.emplace(lookup_table_name<O>(this->db_objects), std::move(alias));
+                if(inserted.second) {
+                    this->table_schemas.emplace(*inserted.first, lookup_table_schema<O>(this->db_objects));
+                }
             }
         };
 
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <sqlite3.h>
+#include <chrono>  //  std::chrono::nanoseconds
+#include <functional>  //  std::function
+#include <memory>  //  std::unique_ptr
+#include <string>  //  std::string
+#include <type_traits>  //  std::integral_constant
+#include <utility>  //  std::move
+
+#include "functional/cxx_universal.h"  //  ::int64
+
+namespace sqlite_orm {
+
+#if SQLITE_VERSION_NUMBER >= 3014000
+    /**
+     *  Event passed to a callback registered with `storage.on_trace()`.
+     *  Which fields are set depends on `type` (one of the SQLITE_TRACE_* codes):
+     *  * SQLITE_TRACE_STMT: `stmt` and `sql` (unexpanded SQL text or a trigger comment)
+     *  * SQLITE_TRACE_PROFILE: `stmt` and `nanoseconds` (estimated wall-clock time the statement took)
+     *  * SQLITE_TRACE_ROW: `stmt`
+     *  * SQLITE_TRACE_CLOSE: `db`
+     *  More info: https://www.sqlite.org/c3ref/c_trace.html
+     */
+    struct trace_event {
+        unsigned int type = 0;
+        sqlite3* db = nullptr;
+        sqlite3_stmt* stmt = nullptr;
+        const char* sql = nullptr;
+        int64 nanoseconds = 0;
+    };
+
+    /**
+     *  A statement captured by `slow_query_logger`.
+     *  Counters are read with `sqlite3_stmt_status()` and are cumulative over the lifetime
+     *  of the prepared statement; use `run` to normalize them per execution.
+     */
+    struct slow_query {
+        std::string sql;
+        int64 nanoseconds = 0;
+        int fullscan_step = 0;
+        int sort = 0;
+        int autoindex = 0;
+        int vm_step = 0;
+        int reprepare = 0;
+        int run = 0;
+    };
+
+    /**
+     *  Trace callback reporting statements running longer than a threshold.
+     *  Register it for SQLITE_TRACE_PROFILE events:
+     *  ```
+     *  storage.on_trace(SQLITE_TRACE_PROFILE, slow_query_logger{std::chrono::milliseconds{50}, [](const slow_query& q) {
+     *      std::cerr << q.sql << " took " << q.nanoseconds << "ns" << std::endl;
+     *  }});
+     *  ```
+     *  `sampleEvery` inspects only every n-th profiled statement, which keeps the cost of
+     *  expanding SQL text and reading counters negligible on hot paths.
+     */
+    struct slow_query_logger {
+        using sink_type = std::function<void(const slow_query&)>;
+
+        slow_query_logger(std::chrono::nanoseconds threshold, sink_type sink, unsigned int sampleEvery = 1) :
+            threshold(threshold.count()), sink(std::move(sink)), sampleEvery(sampleEvery ? sampleEvery : 1) {}
+
+        void operator()(const trace_event& event) {
+            if(event.type != SQLITE_TRACE_PROFILE || ++this->profiledCount % this->sampleEvery) {
+                return;
+            }
+            if(event.nanoseconds < this->threshold) {
+                return;
+            }
+            slow_query query;
+            //  note: must check return value due to SQLITE_OMIT_TRACE
+            using char_ptr = std::unique_ptr<char, std::integral_constant<decltype(&sqlite3_free), sqlite3_free>>;
+            if(char_ptr sql{sqlite3_expanded_sql(event.stmt)}) {
+                query.sql = sql.get();
+            }
+            query.nanoseconds = event.nanoseconds;
+            query.fullscan_step = sqlite3_stmt_status(event.stmt, SQLITE_STMTSTATUS_FULLSCAN_STEP, 0);
+            query.sort = sqlite3_stmt_status(event.stmt, SQLITE_STMTSTATUS_SORT, 0);
+            query.autoindex = sqlite3_stmt_status(event.stmt, SQLITE_STMTSTATUS_AUTOINDEX, 0);
+            query.vm_step = sqlite3_stmt_status(event.stmt, SQLITE_STMTSTATUS_VM_STEP, 0);
+#if SQLITE_VERSION_NUMBER >= 3020000
+            query.reprepare = sqlite3_stmt_status(event.stmt, SQLITE_STMTSTATUS_REPREPARE, 0);
+            query.run = sqlite3_stmt_status(event.stmt, SQLITE_STMTSTATUS_RUN, 0);
+#endif
+            this->sink(query);
+        }
+
+      private:
+        int64 threshold;
+        sink_type sink;
+        unsigned int sampleEvery;
+        unsigned long long profiledCount = 0;
+    };
+#endif
+}
@@ -1502,6 +1502,10 @@ namespace sqlite_orm {
         index_is_out_of_bounds,
         value_is_null,
         no_tables_specified,
+        deadline_exceeded,
+        query_cancelled,
+        backup_cancelled,
+        no_shards,
     };
 
 }
@@ -1562,6 +1566,14 @@ namespace sqlite_orm {
                     return "Value is null";
                 case orm_error_code::no_tables_specified:
                     return "No tables specified";
+                case orm_error_code::deadline_exceeded:
+                    return "Deadline exceeded";
+                case orm_error_code::query_cancelled:
+                    return "Query cancelled";
+                case orm_error_code::backup_cancelled:
+                    return "Backup cancelled";
+                case orm_error_code::no_shards:
+                    return "Sharded storage needs at least one shard";
                 default:
                     return "unknown error";
             }
@@ -2276,6 +2288,12 @@ namespace sqlite_orm {
         template<class T>
         struct is_primary_key : polyfill::bool_constant<is_primary_key_v<T>> {};
 
+        template<class T>
+        SQLITE_ORM_INLINE_VAR constexpr bool is_unique_v = std::is_base_of<unique_base, T>::value;
+
+        template<class T>
+        struct is_unique : polyfill::bool_constant<is_unique_v<T>> {};
+
         template<class T>
         SQLITE_ORM_INLINE_VAR constexpr bool is_generated_always_v =
 #if SQLITE_VERSION_NUMBER >= 3031000
@@ -5640,6 +5658,193 @@ namespace sqlite_orm {
     }
 }
 
+// #include "ast/window.h"
+
+#include <string>  //  std::string
+#include <tuple>  //  std::tuple
+#include <utility>  //  std::move, std::forward
+
+// #include "../functional/cxx_universal.h"
+
+// #include "../functional/cxx_type_traits_polyfill.h"
+
+namespace sqlite_orm {
+    namespace internal {
+
+        /**
+         *  PARTITION BY pack holder of a window definition.
+         */
+        template<class... Args>
+        struct partition_by_t {
+            using args_type = std::tuple<Args...>;
+
+            args_type args;
+        };
+
+        struct unbounded_preceding_t {};
+
+        struct current_row_t {};
+
+        struct unbounded_following_t {};
+
+        template<class T>
+        struct preceding_t {
+            using expression_type = T;
+
+            expression_type expression;
+        };
+
+        template<class T>
+        struct following_t {
+            using expression_type = T;
+
+            expression_type expression;
+        };
+
+        enum class frame_units {
+            rows,
+            range,
+            groups,
+        };
+
+        /**
+         *  Frame specification of a window definition: `ROWS|RANGE|GROUPS BETWEEN start AND end`.
+         */
+        template<class B, class E>
+        struct frame_t {
+            using start_type = B;
+            using end_type = E;
+
+            frame_units units;
+            start_type start;
+            end_type end;
+        };
+
+        /**
+         *  Window definition: `([PARTITION BY ...] [ORDER BY ...] [frame])`.
+         *  Args are `partition_by_t`, `order_by_t`/`multi_order_by_t` and `frame_t` in this order.
+         */
+        template<class... Args>
+        struct window_defn_t {
+            using args_type = std::tuple<Args...>;
+
+            args_type args;
+        };
+
+        /**
+         *  Named window definition of a WINDOW clause.
+         *  Don't construct it manually, call `window(...)` function instead.
+         */
+        template<class... Args>
+        struct window_t {
+            using definition_type = window_defn_t<Args...>;
+
+            std::string name;
+            definition_type definition;
+        };
+
+        template<class T>
+        using is_window = polyfill::is_specialization_of<T, window_t>;
+
+        /**
+         *  Reference to a named window from an OVER clause.
+         */
+        struct window_ref_t {
+            std::string name;
+        };
+
+        /**
+         *  Window function or aggregate function used as a window function: `function OVER window`.
+         *  W is either `window_defn_t` or `window_ref_t`.
+         */
+        template<class F, class W>
+        struct over_t {
+            using function_type = F;
+            using window_type = W;
+
+            function_type function;
+            window_type window;
+        };
+    }
+
+    /**
+     *  PARTITION BY clause of a window definition.
+     *  Example: storage.select(columns(&Employee::name, rank().over(partition_by(&Employee::department),
+     *                                                               order_by(&Employee::salary).desc()))));
+     */
+    template<class... Args>
+    internal::partition_by_t<Args...> partition_by(Args... args) {
+        return {{std::forward<Args>(args)...}};
+    }
+
+    inline internal::unbounded_preceding_t unbounded_preceding() {
+        return {};
+    }
+
+    /**
+     *  `expression PRECEDING` frame boundary.
+     */
+    template<class T>
+    internal::preceding_t<T> preceding(T expression) {
+        return {std::move(expression)};
+    }
+
+    inline internal::current_row_t current_row() {
+        return {};
+    }
+
+    /**
+     *  `expression FOLLOWING` frame boundary.
+     */
+    template<class T>
+    internal::following_t<T> following(T expression) {
+        return {std::move(expression)};
+    }
+
+    inline internal::unbounded_following_t unbounded_following() {
+        return {};
+    }
+
+    /**
+     *  ROWS frame of a window definition, e.g. a running total:
+     *  sum(&Sale::amount).over(order_by(&Sale::date), rows(unbounded_preceding(), current_row()))
+     *  The frame ends with the current row if `end` is omitted.
+     */
+    template<class B, class E = internal::current_row_t>
+    internal::frame_t<B, E> rows(B start, E end = {}) {
+        return {internal::frame_units::rows, std::move(start), std::move(end)};
+    }
+
+    /**
+     *  RANGE frame of a window definition. The frame ends with the current row if `end` is omitted.
+     */
+    template<class B, class E = internal::current_row_t>
+    internal::frame_t<B, E> range(B start, E end = {}) {
+        return {internal::frame_units::range, std::move(start), std::move(end)};
+    }
+
+    /**
+     *  GROUPS frame of a window definition (SQLite 3.28.0). The frame ends with the current row if `end` is omitted.
+     */
+    template<class B, class E = internal::current_row_t>
+    internal::frame_t<B, E> groups(B start, E end = {}) {
+        return {internal::frame_units::groups, std::move(start), std::move(end)};
+    }
+
+    /**
+     *  Named window definition of the WINDOW clause which is referred to by `over(window)`.
+     *  Pass it to `select()` among the conditions; all windows passed make up one WINDOW clause, which is put after
+     *  WHERE/GROUP BY/HAVING and before ORDER BY/LIMIT regardless of their positions.
+     *  Example:
+     *  auto byDepartment = window("d", partition_by(&Employee::department), order_by(&Employee::salary));
+     *  storage.select(columns(rank().over(byDepartment), sum(&Employee::salary).over(byDepartment)), byDepartment);
+     */
+    template<class... Args>
+    internal::window_t<Args...> window(std::string name, Args... args) {
+        return {std::move(name), {{std::forward<Args>(args)...}}};
+    }
+}
+
 namespace sqlite_orm {
 
     using int64 = sqlite_int64;
@@ -5676,6 +5881,11 @@ namespace sqlite_orm {
         template<class T>
         struct is_built_in_function : polyfill::bool_constant<is_built_in_function_v<T>> {};
 
+        /**
+         *  Aggregate function with a FILTER clause: `function FILTER (WHERE expression)`.
+         *  Only the rows for which `where` is true are aggregated, so several differently filtered aggregates
+         *  can be computed with a single scan.
+         */
         template<class F, class W>
         struct filtered_aggregate_function {
             using function_type = F;
@@ -5683,6 +5893,16 @@ namespace sqlite_orm {
 
             function_type function;
             where_expression where;
+
+            template<class... WArgs>
+            over_t<filtered_aggregate_function<F, W>, window_defn_t<WArgs...>> over(WArgs... args) {
+                return {*this, {{std::forward<WArgs>(args)...}}};
+            }
+
+            template<class... WArgs>
+            over_t<filtered_aggregate_function<F, W>, window_ref_t> over(const window_t<WArgs...>& window) {
+                return {*this, {window.name}};
+            }
         };
 
         template<class C>
@@ -5698,6 +5918,39 @@ namespace sqlite_orm {
             filtered_aggregate_function<built_in_aggregate_function_t<R, S, Args...>, W> filter(where_t<W> wh) {
                 return {*this, std::move(wh.expression)};
             }
+
+            /**
+             *  Use the aggregate function as a window function.
+             */
+            template<class... WArgs>
+            over_t<built_in_aggregate_function_t<R, S, Args...>, window_defn_t<WArgs...>> over(WArgs... args) {
+                return {*this, {{std::forward<WArgs>(args)...}}};
+            }
+
+            template<class... WArgs>
+            over_t<built_in_aggregate_function_t<R, S, Args...>, window_ref_t> over(const window_t<WArgs...>& window) {
+                return {*this, {window.name}};
+            }
+        };
+
+        /**
+         *  Function that can only be called as a window function, i.e. with `over(...)`.
+         */
+        template<class R, class S, class... Args>
+        struct built_in_window_function_t : built_in_function_t<R, S, Args...> {
+            using super = built_in_function_t<R, S, Args...>;
+
+            using super::super;
+
+            template<class... WArgs>
+            over_t<built_in_window_function_t<R, S, Args...>, window_defn_t<WArgs...>> over(WArgs... args) {
+                return {*this, {{std::forward<WArgs>(args)...}}};
+            }
+
+            template<class... WArgs>
+            over_t<built_in_window_function_t<R, S, Args...>, window_ref_t> over(const window_t<WArgs...>& window) {
+                return {*this, {window.name}};
+            }
         };
 
         struct typeof_string {
@@ -5920,6 +6173,16 @@ namespace sqlite_orm {
             filtered_aggregate_function<count_asterisk_t<T>, W> filter(where_t<W> wh) {
                 return {*this, std::move(wh.expression)};
             }
+
+            template<class... WArgs>
+            over_t<count_asterisk_t<T>, window_defn_t<WArgs...>> over(WArgs... args) {
+                return {*this, {{std::forward<WArgs>(args)...}}};
+            }
+
+            template<class... WArgs>
+            over_t<count_asterisk_t<T>, window_ref_t> over(const window_t<WArgs...>& window) {
+                return {*this, {window.name}};
+            }
         };
 
         /**
@@ -5942,7 +6205,12 @@ namespace sqlite_orm {
          *          group_by(&Customer::grade),
          *          having(greater_than(count(), 2))))));
          */
-        struct count_asterisk_without_type : count_string {};
+        struct count_asterisk_without_type : count_string {
+            template<class W>
+            filtered_aggregate_function<count_asterisk_without_type, W> filter(where_t<W> wh) {
+                return {*this, std::move(wh.expression)};
+            }
+        };
 
         struct avg_string {
             serialize_result_type serialize() const {
@@ -5967,6 +6235,72 @@ namespace sqlite_orm {
                 return "GROUP_CONCAT";
             }
         };
+
+        struct row_number_string {
+            serialize_result_type serialize() const {
+                return "ROW_NUMBER";
+            }
+        };
+
+        struct rank_string {
+            serialize_result_type serialize() const {
+                return "RANK";
+            }
+        };
+
+        struct dense_rank_string {
+            serialize_result_type serialize() const {
+                return "DENSE_RANK";
+            }
+        };
+
+        struct percent_rank_string {
+            serialize_result_type serialize() const {
+                return "PERCENT_RANK";
+            }
+        };
+
+        struct cume_dist_string {
+            serialize_result_type serialize() const {
+                return "CUME_DIST";
+            }
+        };
+
+        struct ntile_string {
+            serialize_result_type serialize() const {
+                return "NTILE";
+            }
+        };
+
+        struct lag_string {
+            serialize_result_type serialize() const {
+                return "LAG";
+            }
+        };
+
+        struct lead_string {
+            serialize_result_type serialize() const {
+                return "LEAD";
+            }
+        };
+
+        struct first_value_string {
+            serialize_result_type serialize() const {
+                return "FIRST_VALUE";
+            }
+        };
+
+        struct last_value_string {
+            serialize_result_type serialize() const {
+                return "LAST_VALUE";
+            }
+        };
+
+        struct nth_value_string {
+            serialize_result_type serialize() const {
+                return "NTH_VALUE";
+            }
+        };
 #ifdef SQLITE_ENABLE_MATH_FUNCTIONS
         struct acos_string {
             serialize_result_type serialize() const {
@@ -7538,6 +7872,93 @@ namespace sqlite_orm {
     internal::built_in_aggregate_function_t<std::string, internal::group_concat_string, X, Y> group_concat(X x, Y y) {
         return {std::tuple<X, Y>{std::forward<X>(x), std::forward<Y>(y)}};
     }
+
+    /**
+     *  ROW_NUMBER() window function https://www.sqlite.org/windowfunctions.html#built_in_window_functions
+     */
+    inline internal::built_in_window_function_t<int, internal::row_number_string> row_number() {
+        return {{}};
+    }
+
+    /**
+     *  DENSE_RANK() window function. RANK() is `rank().over(...)`.
+     */
+    inline internal::built_in_window_function_t<int, internal::dense_rank_string> dense_rank() {
+        return {{}};
+    }
+
+    /**
+     *  PERCENT_RANK() window function.
+     */
+    inline internal::built_in_window_function_t<double, internal::percent_rank_string> percent_rank() {
+        return {{}};
+    }
+
+    /**
+     *  CUME_DIST() window function.
+     */
+    inline internal::built_in_window_function_t<double, internal::cume_dist_string> cume_dist() {
+        return {{}};
+    }
+
+    /**
+     *  NTILE(N) window function.
+     */
+    template<class N>
+    internal::built_in_window_function_t<int, internal::ntile_string, N> ntile(N n) {
+        return {std::tuple<N>{std::forward<N>(n)}};
+    }
+
+    /**
+     *  LAG(X, ...) window function. Optional arguments are the offset (1 by default) and
+     *  the default value returned if there is no such row (NULL by default).
+     *  The return type is the type of the first argument.
+     */
+    template<class X, class... Args>
+    internal::built_in_window_function_t<internal::unique_ptr_result_of<X>, internal::lag_string, X, Args...>
+    lag(X x, Args... args) {
+        static_assert(sizeof...(Args) <= 2, "lag accepts an offset and a default value besides the expression");
+        return {std::tuple<X, Args...>{std::forward<X>(x), std::forward<Args>(args)...}};
+    }
+
+    /**
+     *  LEAD(X, ...) window function. Optional arguments are the offset (1 by default) and
+     *  the default value returned if there is no such row (NULL by default).
+     *  The return type is the type of the first argument.
+     */
+    template<class X, class... Args>
+    internal::built_in_window_function_t<internal::unique_ptr_result_of<X>, internal::lead_string, X, Args...>
+    lead(X x, Args... args) {
+        static_assert(sizeof...(Args) <= 2, "lead accepts an offset and a default value besides the expression");
+        return {std::tuple<X, Args...>{std::forward<X>(x), std::forward<Args>(args)...}};
+    }
+
+    /**
+     *  FIRST_VALUE(X) window function.
+     */
+    template<class X>
+    internal::built_in_window_function_t<internal::unique_ptr_result_of<X>, internal::first_value_string, X>
+    first_value(X x) {
+        return {std::tuple<X>{std::forward<X>(x)}};
+    }
+
+    /**
+     *  LAST_VALUE(X) window function.
+     */
+    template<class X>
+    internal::built_in_window_function_t<internal::unique_ptr_result_of<X>, internal::last_value_string, X>
+    last_value(X x) {
+        return {std::tuple<X>{std::forward<X>(x)}};
+    }
+
+    /**
+     *  NTH_VALUE(X, N) window function.
+     */
+    template<class X, class N>
+    internal::built_in_window_function_t<internal::unique_ptr_result_of<X>, internal::nth_value_string, X, N>
+    nth_value(X x, N n) {
+        return {std::tuple<X, N>{std::forward<X>(x), std::forward<N>(n)}};
+    }
 #ifdef SQLITE_ENABLE_JSON1
     template<class X>
     internal::built_in_function_t<std::string, internal::json_string, X> json(X x) {
@@ -8064,7 +8485,9 @@ namespace sqlite_orm {
 
 // #include "core_functions.h"
 
-// #include "alias_traits.h"
+// #include "conditions.h"
+
+// #include "alias_traits.h"
 
 // #include "cte_moniker.h"
 
@@ -8274,6 +8697,18 @@ namespace sqlite_orm {
         template<class T>
         using is_select = polyfill::bool_constant<is_select_v<T>>;
 
+        /**
+         *  Conditions a WINDOW clause has to precede.
+         */
+        template<class T>
+        using is_window_successor = polyfill::disjunction<is_order_by<T>, is_limit<T>>;
+
+        /**
+         *  Conditions a WINDOW clause has to follow (FROM, JOIN, WHERE, GROUP BY and HAVING).
+         */
+        template<class T>
+        using is_window_predecessor = polyfill::negation<polyfill::disjunction<is_window<T>, is_window_successor<T>>>;
+
         /**
          *  Base for UNION, UNION ALL, EXCEPT and INTERSECT
          */
@@ -11379,13 +11814,29 @@ namespace sqlite_orm {
 
             elements_type elements;
 
+            /**
+             *  Name of the attached database the table lives in, empty for the main database.
+             */
+            std::string schema_name;
+
 #ifndef SQLITE_ORM_AGGREGATE_BASES_SUPPORTED
-            table_t(std::string name_, elements_type elements_) :
-                basic_table{std::move(name_)}, elements{std::move(elements_)} {}
+            table_t(std::string name_, elements_type elements_, std::string schemaName = {}) :
+                basic_table{std::move(name_)}, elements{std::move(elements_)}, schema_name{std::move(schemaName)} {}
 #endif
 
             table_t<O, true, Cs...> without_rowid() const {
-                return {this->name, this->elements};
+                return {this->name, this->elements, this->schema_name};
+            }
+
+            /**
+             *  Returns a copy of this table definition which lives in the database attached as `schemaName`
+             *  with `storage.attach()`, e.g. `make_table("orders", ...).in_schema("archive")`.
+             *  Statements then refer to the table as `"archive"."orders"`.
+             */
+            table_t in_schema(std::string schemaName) const {
+                table_t result = *this;
+                result.schema_name = std::move(schemaName);
+                return result;
             }
 
             /*
@@ -11737,7 +12188,7 @@ namespace sqlite_orm {
                       "Incorrect table elements or constraints");
 
         SQLITE_ORM_CLANG_SUPPRESS_MISSING_BRACES(
-            return {std::move(name), std::make_tuple<Cs...>(std::forward<Cs>(args)...)});
+            return {std::move(name), std::make_tuple<Cs...>(std::forward<Cs>(args)...), {}});
     }
 
     /**
@@ -11751,7 +12202,7 @@ namespace sqlite_orm {
                       "Incorrect table elements or constraints");
 
         SQLITE_ORM_CLANG_SUPPRESS_MISSING_BRACES(
-            return {std::move(name), std::make_tuple<Cs...>(std::forward<Cs>(args)...)});
+            return {std::move(name), std::make_tuple<Cs...>(std::forward<Cs>(args)...), {}});
     }
 
 #ifdef SQLITE_ORM_WITH_CPP20_ALIASES
@@ -11774,6 +12225,7 @@ namespace sqlite_orm {
 #pragma once
 
 #include <string>  //  std::string
+#include <type_traits>  //  std::decay_t
 
 // #include "functional/cxx_universal.h"
 //  ::size_t
@@ -12029,9 +12481,14 @@ namespace sqlite_orm {
 
         template<class Lookup, class DBOs, satisfies<is_db_objects, DBOs> = true>
         decltype(auto) lookup_table_name(const DBOs& dbObjects);
+
+        template<class Lookup, class DBOs, satisfies<is_db_objects, DBOs> = true>
+        decltype(auto) lookup_table_schema(const DBOs& dbObjects);
     }
 }
 
+// #include "schema/table.h"
+
 // interface functions
 namespace sqlite_orm {
     namespace internal {
@@ -12057,6 +12514,42 @@ namespace sqlite_orm {
                 empty_callable<std::string>)(dbObjects);
         }
 
+        inline std::string table_schema_name(const basic_table&) {
+            return {};
+        }
+
+        template<class O, bool WithoutRowId, class... Cs>
+        std::string table_schema_name(const table_t<O, WithoutRowId, Cs...>& table) {
+            return table.schema_name;
+        }
+
+        template<class Lookup, class DBOs, satisfies<is_db_objects, DBOs>>
+        decltype(auto) lookup_table_schema(const DBOs& dbObjects) {
+            return static_if<is_mapped<DBOs, Lookup>::value>(
+                [](const auto& dbObjects) {
+                    return table_schema_name(pick_table<Lookup>(dbObjects));
+                },
+                empty_callable<std::string>)(dbObjects);
+        }
+
+        /**
+         *  Whether the table named `tableName` in the schema `schemaName` is mapped as a WITHOUT ROWID table.
+         */
+        template<class DBOs, satisfies<is_db_objects, DBOs> = true>
+        bool table_is_without_rowid(const DBOs& dbObjects, const std::string& schemaName, const std::string& tableName) {
+            bool res = false;
+            iterate_tuple<true>(dbObjects,
+                                tables_index_sequence<DBOs>{},
+                                [&res, &schemaName, &tableName](const auto& table) {
+                                    using table_type = std::decay_t<decltype(table)>;
+                                    if(table_type::is_without_rowid_v && table.name == tableName &&
+                                       table.schema_name == schemaName) {
+                                        res = true;
+                                    }
+                                });
+            return res;
+        }
+
         /**
          *  Find column name by its type and member pointer.
          */
@@ -12180,10 +12673,14 @@ namespace sqlite_orm {
 #include <functional>  //   std::identity
 #include <sstream>  //  std::stringstream
 #include <map>  //  std::map
+#include <set>  //  std::set
 #include <vector>  //  std::vector
 #include <tuple>  //  std::tuple_size, std::tuple, std::make_tuple, std::tie
 #include <utility>  //  std::forward, std::pair
-#include <algorithm>  //  std::for_each, std::ranges::for_each
+#include <algorithm>  //  std::for_each, std::ranges::for_each, std::max, std::find
+#include <cstdint>  //  std::uint64_t
+#include <future>  //  std::future, std::async
+#include <iterator>  //  std::make_move_iterator
 // #include "functional/cxx_optional.h"
 
 // #include "functional/cxx_universal.h"
@@ -13297,6 +13794,24 @@ namespace sqlite_orm {
             using type = std::unique_ptr<column_result_of_t<DBOs, X>>;
         };
 
+        template<class DBOs, class F, class W>
+        struct column_result_t<DBOs, filtered_aggregate_function<F, W>, void> : column_result_t<DBOs, F> {};
+
+        template<class DBOs, class F, class W>
+        struct column_result_t<DBOs, over_t<F, W>, void> : column_result_t<DBOs, F> {};
+
+        template<class DBOs, class R, class S, class... Args, class W>
+        struct column_result_t<DBOs, over_t<built_in_window_function_t<R, S, Args...>, W>, void> {
+            using type = R;
+        };
+
+        template<class DBOs, class X, class... Rest, class S, class W>
+        struct column_result_t<DBOs,
+                               over_t<built_in_window_function_t<unique_ptr_result_of<X>, S, X, Rest...>, W>,
+                               void> {
+            using type = std::unique_ptr<column_result_of_t<DBOs, X>>;
+        };
+
         template<class DBOs, class T>
         struct column_result_t<DBOs, count_asterisk_t<T>, void> {
             using type = int;
@@ -13521,6 +14036,88 @@ namespace sqlite_orm {
 
 // #include "sync_schema_result.h"
 
+// #include "online_migration.h"
+
+#include <chrono>  //  std::chrono::steady_clock
+#include <functional>  //  std::function
+#include <string>  //  std::string
+
+// #include "functional/cxx_universal.h"
+//  ::int64
+
+namespace sqlite_orm {
+
+    /**
+     *  State of a table copy made by `storage.sync_schema_online()`, reported after each chunk.
+     */
+    struct online_migration_progress {
+        std::string table;
+        int64 copied_rows = 0;
+
+        /**
+         *  Number of rows when the copy started, rows written meanwhile aren't included.
+         */
+        int64 total_rows = 0;
+        std::chrono::steady_clock::duration elapsed{};
+
+        /**
+         *  Estimated remaining time extrapolated from the copy speed so far.
+         */
+        std::chrono::steady_clock::duration eta{};
+    };
+
+    struct online_migration_options {
+
+        /**
+         *  Maximum number of rows copied in one transaction.
+         */
+        int64 chunk_size = 10000;
+        std::function<void(const online_migration_progress&)> on_progress;
+    };
+}
+
+// #include "schema_fingerprint.h"
+
+#include <cstdint>  //  std::uint64_t
+#include <string>  //  std::string
+
+namespace sqlite_orm {
+    namespace internal {
+
+        /**
+         *  Name of the table in which `storage.sync_schema_if_changed()` stores the schema fingerprint.
+         */
+        inline const char* schema_fingerprint_table_name() {
+            return "_sqlite_orm_schema";
+        }
+
+        /**
+         *  64-bit FNV-1a hash, the same on every platform.
+         */
+        inline std::uint64_t fnv1a_hash(const std::string& bytes) {
+            std::uint64_t hash = 14695981039346656037ull;
+            for(unsigned char c: bytes) {
+                hash ^= c;
+                hash *= 1099511628211ull;
+            }
+            return hash;
+        }
+
+        /**
+         *  64-bit FNV-1a hash of `definitions` as 16 hex digits.
+         */
+        inline std::string schema_fingerprint_hash(const std::string& definitions) {
+            std::uint64_t hash = fnv1a_hash(definitions);
+            static constexpr const char digits[] = "0123456789abcdef";
+            std::string result(16, '0');
+            for(int i = 15; i >= 0; --i, hash >>= 4) {
+                result[i] = digits[hash & 0xf];
+            }
+            return result;
+        }
+    }
+}
+
 // #include "table_info.h"
 
 // #include "storage_impl.h"
@@ -13893,6 +14490,8 @@ namespace sqlite_orm {
 #include <vector>  //  std::vector
 #include <functional>  //  std::reference_wrapper
 
+// #include "tuple_helper/tuple_filter.h"
+
 // #include "tuple_helper/tuple_iteration.h"
 
 // #include "type_traits.h"
@@ -14146,6 +14745,7 @@ namespace sqlite_orm {
 
 // #include "../table_name_collector.h"
 
+#include <map>  //  std::map
 #include <set>  //  std::set
 #include <string>  //  std::string
 #include <utility>  //  std::pair, std::move
@@ -14170,8 +14770,12 @@ namespace sqlite_orm {
 
         struct table_name_collector_base {
             using table_name_set = std::set<std::pair<std::string, std::string>>;
+            using table_schema_map = std::map<std::pair<std::string, std::string>, std::string>;
 
             table_name_set table_names;
+            //  schema of each collected table (empty for the main database), taken from the mapped type because
+            //  tables with the same name in different schemas can't be told apart by their name
+            table_schema_map table_schemas;
         };
 
         template<class DBOs>
@@ -14189,59 +14793,64 @@ namespace sqlite_orm {
 
             template<class F, class O>
             void operator()(F O::*) {
-                this->table_names.emplace(lookup_table_name<O>(this->db_objects), "");
+                this->collect_table<O>("");
             }
 
             template<class T, class F>
             void operator()(const column_pointer<T, F>&) {
-                auto tableName = lookup_table_name<mapped_type_proxy_t<T>>(this->db_objects);
-                this->table_names.emplace(std::move(tableName), alias_extractor<T>::as_alias());
+                this->collect_table<mapped_type_proxy_t<T>>(alias_extractor<T>::as_alias());
             }
 
             template<class A, class C>
             void operator()(const alias_column_t<A, C>&) {
                 // note: instead of accessing the column, we are interested in the type the column is aliased into
-                auto tableName = lookup_table_name<mapped_type_proxy_t<A>>(this->db_objects);
-                this->table_names.emplace(std::move(tableName), alias_extractor<A>::as_alias());
+                this->collect_table<mapped_type_proxy_t<A>>(alias_extractor<A>::as_alias());
             }
 
             template<class T>
             void operator()(const count_asterisk_t<T>&) {
-                auto tableName = lookup_table_name<T>(this->db_objects);
-                if(!tableName.empty()) {
-                    this->table_names.emplace(std::move(tableName), "");
+                if(!lookup_table_name<T>(this->db_objects).empty()) {
+                    this->collect_table<T>("");
                 }
             }
 
             template<class T>
             void operator()(const asterisk_t<T>&) {
-                auto tableName = lookup_table_name<mapped_type_proxy_t<T>>(this->db_objects);
-                table_names.emplace(std::move(tableName), alias_extractor<T>::as_alias());
+                this->collect_table<mapped_type_proxy_t<T>>(alias_extractor<T>::as_alias());
             }
 
             template<class T>
             void operator()(const object_t<T>&) {
-                this->table_names.emplace(lookup_table_name<T>(this->db_objects), "");
+                this->collect_table<T>("");
             }
 
             template<class T>
             void operator()(const table_rowid_t<T>&) {
-                this->table_names.emplace(lookup_table_name<T>(this->db_objects), "");
+                this->collect_table<T>("");
             }
 
             template<class T>
             void operator()(const table_oid_t<T>&) {
-                this->table_names.emplace(lookup_table_name<T>(this->db_objects), "");
+                this->collect_table<T>("");
             }
 
             template<class T>
             void operator()(const table__rowid_t<T>&) {
-                this->table_names.emplace(lookup_table_name<T>(this->db_objects), "");
+                this->collect_table<T>("");
             }
 
             template<class T, class X, class Y, class Z>
             void operator()(const highlight_t<T, X, Y, Z>&) {
-                this->table_names.emplace(lookup_table_name<T>(this->db_objects), "");
+                this->collect_table<T>("");
+            }
+
+          protected:
+            template<class O>
+            void collect_table(std::string alias) {
+                auto inserted = this->table_names.emplace(lookup_table_name<O>(this->db_objects), std::move(alias));
+                if(inserted.second) {
+                    this->table_schemas.emplace(*inserted.first, lookup_table_schema<O>(this->db_objects));
+                }
             }
         };
 
@@ -14295,7 +14904,7 @@ namespace sqlite_orm {
             void push_back(assign_t<L, R> assign) {
                 auto newContext = this->context;
                 newContext.skip_table_name = true;
-                iterate_ast(assign, this->collector);
+                iterate_ast(assign.lhs, this->collector);
                 std::stringstream ss;
                 ss << serialize(assign.lhs, newContext) << ' ' << assign.serialize() << ' '
                    << serialize(assign.rhs, context);
@@ -14313,6 +14922,7 @@ namespace sqlite_orm {
             void clear() {
                 this->entries.clear();
                 this->collector.table_names.clear();
+                this->collector.table_schemas.clear();
             }
 
             std::vector<entry_t> entries;
@@ -14620,6 +15230,32 @@ namespace sqlite_orm {
         template<class T>
         struct is_replace_raw : polyfill::bool_constant<is_replace_raw_v<T>> {};
 
+#if SQLITE_VERSION_NUMBER >= 3035000
+        /**
+         *  A data modification statement with a RETURNING clause.
+         *  `C` is a single column expression or `columns_t`, just like the columns of a SELECT.
+         */
+        template<class S, class C>
+        struct returning_t {
+            using statement_type = S;
+            using columns_type = C;
+
+            statement_type statement;
+            columns_type columns;
+        };
+#endif
+
+        template<class T>
+        SQLITE_ORM_INLINE_VAR constexpr bool is_returning_v =
+#if SQLITE_VERSION_NUMBER >= 3035000
+            polyfill::is_specialization_of<T, returning_t>::value;
+#else
+            false;
+#endif
+
+        template<class T>
+        struct is_returning : polyfill::bool_constant<is_returning_v<T>> {};
+
         struct default_values_t {};
 
         template<class T>
@@ -15080,12 +15716,21 @@ namespace sqlite_orm {
     /**
      *  Create an update all statement.
      *  Usage: storage.update_all(set(...), ...);
+     *
+     *  Values can be taken from other tables with a FROM clause and joins (`UPDATE ... FROM`, SQLite 3.33.0),
+     *  which replaces a correlated subquery evaluated for every updated row with a single join:
+     *  storage.update_all(set(c(&Inventory::quantity) = c(&Inventory::quantity) - c(&Sale::quantity)),
+     *                     from<Sale>(),
+     *                     where(c(&Inventory::itemId) == &Sale::itemId));
      */
     template<class S, class... Wargs>
     internal::update_all_t<S, Wargs...> update_all(S set, Wargs... wh) {
         static_assert(internal::is_set<S>::value, "first argument in update_all can be either set or dynamic_set");
         using args_tuple = std::tuple<Wargs...>;
         internal::validate_conditions<args_tuple>();
+        static_assert(internal::count_tuple<args_tuple, internal::is_constrained_join>::value == 0 ||
+                          internal::count_tuple<args_tuple, internal::is_from>::value == 1,
+                      "joins in update_all require a FROM clause");
         return {std::move(set), {std::forward<Wargs>(wh)...}};
     }
 
@@ -15146,6 +15791,31 @@ namespace sqlite_orm {
         return get_all_optional<internal::auto_decay_table_ref_t<table>, R>(std::forward<Args>(conditions)...);
     }
 #endif
+
+#if SQLITE_VERSION_NUMBER >= 3035000
+    /**
+     *  Adds a RETURNING clause to an insert, insert range, replace, replace range, update all or remove all statement.
+     *  Executing the prepared statement yields the returned rows the same way `select()` does:
+     *  a single column yields `std::vector<T>`, `columns(...)` yields `std::vector<std::tuple<...>>`
+     *  and `object<T>()` yields `std::vector<T>`.
+     *  Example:
+     *  auto statement = storage.prepare(returning(insert(user), columns(&User::id, &User::createdAt)));
+     *  auto rows = storage.execute(statement);
+     *  More info: https://www.sqlite.org/lang_returning.html
+     */
+    template<class S, class C>
+    internal::returning_t<S, C> returning(S statement, C columns) {
+        static_assert(polyfill::disjunction<internal::is_insert<S>,
+                                            internal::is_insert_range<S>,
+                                            internal::is_replace<S>,
+                                            internal::is_replace_range<S>,
+                                            polyfill::is_specialization_of<S, internal::update_all_t>,
+                                            polyfill::is_specialization_of<S, internal::remove_all_t>>::value,
+                      "RETURNING is supported for insert, insert_range, replace, replace_range, update_all and "
+                      "remove_all statements");
+        return {std::move(statement), std::move(columns)};
+    }
+#endif
 }
 
 // #include "values.h"
@@ -15239,6 +15909,103 @@ namespace sqlite_orm {
     }
 }
 
+// #include "range_source.h"
+
+#if SQLITE_VERSION_NUMBER >= 3020000
+#include <vector>  //  std::vector
+#ifdef SQLITE_ORM_CPP20_RANGES_SUPPORTED
+#include <ranges>  //  std::ranges::contiguous_range, std::ranges::sized_range, std::ranges::data, std::ranges::size
+#include <type_traits>  //  std::remove_cvref_t
+#endif
+#endif
+
+// #include "functional/cxx_universal.h"
+//  ::size_t
+// #include "pointer_value.h"
+
+#if SQLITE_VERSION_NUMBER >= 3020000
+namespace sqlite_orm {
+    namespace internal {
+
+        /**
+         *  Pointer type (tag) of the range passed to a range table.
+         */
+        struct range_pointer_type {
+            using value_type = const char*;
+            static constexpr const char* value = "sqlite_orm_range";
+        };
+
+        /**
+         *  Name of the hidden column of a range table which receives the range.
+         */
+        inline const char* range_source_column_name() {
+            return "sqlite_orm_source";
+        }
+
+        /**
+         *  Contiguous sequence of objects exposed by a range table, the objects aren't copied.
+         */
+        template<class O>
+        struct range_view {
+            const O* data = nullptr;
+            size_t size = 0;
+        };
+
+        /**
+         *  Condition binding a range to the range table of `O`: `"table"."sqlite_orm_source" = ?`.
+         *  Don't construct it manually, call `range_source(...)` function instead.
+         */
+        template<class O>
+        struct range_source_t {
+            using mapped_type = O;
+
+            range_view<O> view;
+        };
+    }
+
+#ifdef SQLITE_ORM_CPP20_RANGES_SUPPORTED
+    /**
+     *  Binds a contiguous range (`std::vector`, `std::array`, `std::span`, ...) to the range table of its element type
+     *  registered with `storage.create_range_table<O>()`.
+     *  The range is passed by pointer and must outlive the execution of the statement.
+     *  Example:
+     *  std::vector<Weight> weights = ...;
+     *  storage.select(columns(&Item::name, &Weight::weight),
+     *                 join<Weight>(on(c(&Weight::itemId) == &Item::id)),
+     *                 where(range_source(weights)));
+     */
+    template<std::ranges::contiguous_range R>
+        requires(std::ranges::sized_range<R>)
+    auto range_source(const R& range) {
+        using object_type = std::remove_cvref_t<std::ranges::range_value_t<R>>;
+        return internal::range_source_t<object_type>{{std::ranges::data(range), size_t(std::ranges::size(range))}};
+    }
+#else
+    /**
+     *  Binds a vector to the range table of its element type registered with `storage.create_range_table<O>()`.
+     *  The vector is passed by pointer and must outlive the execution of the statement.
+     *  Example:
+     *  std::vector<Weight> weights = ...;
+     *  storage.select(columns(&Item::name, &Weight::weight),
+     *                 join<Weight>(on(c(&Weight::itemId) == &Item::id)),
+     *                 where(range_source(weights)));
+     */
+    template<class O>
+    internal::range_source_t<O> range_source(const std::vector<O>& range) {
+        return {{range.data(), range.size()}};
+    }
+#endif
+
+    /**
+     *  Binds `size` objects starting at `data` to the range table of `O`.
+     */
+    template<class O>
+    internal::range_source_t<O> range_source(const O* data, size_t size) {
+        return {{data, size}};
+    }
+}
+#endif
+
 namespace sqlite_orm {
 
     namespace internal {
@@ -15313,6 +16080,21 @@ namespace sqlite_orm {
             }
         };
 
+#if SQLITE_VERSION_NUMBER >= 3020000
+        /**
+         *  The range is bound by pointer to the view stored in the node, which lives as long as the statement.
+         */
+        template<class O>
+        struct ast_iterator<range_source_t<O>, void> {
+            using node_type = range_source_t<O>;
+
+            template<class L>
+            void operator()(const node_type& node, L& lambda) const {
+                lambda(bind_pointer_statically<range_pointer_type>(&node.view));
+            }
+        };
+#endif
+
         template<class... Args>
         struct ast_iterator<group_by_t<Args...>, void> {
             using node_type = group_by_t<Args...>;
@@ -15513,9 +16295,50 @@ namespace sqlite_orm {
             template<class L>
             void operator()(const node_type& sel, L& lambda) const {
                 iterate_ast(sel.col, lambda);
-                iterate_ast(sel.conditions, lambda);
+                using conditions_type = typename node_type::conditions_type;
+                this->iterate_conditions(sel.conditions,
+                                         lambda,
+                                         polyfill::bool_constant<tuple_has<conditions_type, is_window>::value>{});
+            }
+
+          private:
+            template<class L>
+            static void iterate_conditions(const typename node_type::conditions_type& conditions,
+                                           L& lambda,
+                                           std::false_type) {
+                iterate_ast(conditions, lambda);
+            }
+
+            /**
+             *  The serializer moves the WINDOW clause before ORDER BY and LIMIT,
+             *  bindables have to be visited in the same order.
+             */
+            template<class L>
+            static void iterate_conditions(const typename node_type::conditions_type& conditions,
+                                           L& lambda,
+                                           std::true_type) {
+                using conditions_type = typename node_type::conditions_type;
+                auto visit = [&lambda](auto& condition) {
+                    iterate_ast(condition, lambda);
+                };
+                iterate_tuple(conditions, filter_tuple_sequence_t<conditions_type, is_window_predecessor>{}, visit);
+                iterate_tuple(conditions, filter_tuple_sequence_t<conditions_type, is_window>{}, visit);
+                iterate_tuple(conditions, filter_tuple_sequence_t<conditions_type, is_window_successor>{}, visit);
+            }
+        };
+
+#if SQLITE_VERSION_NUMBER >= 3035000
+        template<class S, class C>
+        struct ast_iterator<returning_t<S, C>, void> {
+            using node_type = returning_t<S, C>;
+
+            template<class L>
+            void operator()(const node_type& node, L& lambda) const {
+                iterate_ast(node.statement, lambda);
+                iterate_ast(node.columns, lambda);
             }
         };
+#endif
 
         template<class T, class R, class... Args>
         struct ast_iterator<get_all_t<T, R, Args...>, void> {
@@ -15751,59 +16574,141 @@ namespace sqlite_orm {
             }
         };
 
-        template<class Join>
-        struct ast_iterator<Join, match_if<is_constrained_join, Join>> {
-            using node_type = Join;
+        template<class R, class S, class... Args>
+        struct ast_iterator<built_in_window_function_t<R, S, Args...>, void> {
+            using node_type = built_in_window_function_t<R, S, Args...>;
 
             template<class L>
-            void operator()(const node_type& join, L& lambda) const {
-                iterate_ast(join.constraint, lambda);
+            void operator()(const node_type& node, L& lambda) const {
+                iterate_ast(node.args, lambda);
             }
         };
 
-        template<class T>
-        struct ast_iterator<on_t<T>, void> {
-            using node_type = on_t<T>;
+        template<class F, class W>
+        struct ast_iterator<over_t<F, W>, void> {
+            using node_type = over_t<F, W>;
 
             template<class L>
-            void operator()(const node_type& on, L& lambda) const {
-                iterate_ast(on.arg, lambda);
+            void operator()(const node_type& node, L& lambda) const {
+                iterate_ast(node.function, lambda);
+                iterate_ast(node.window, lambda);
             }
         };
 
-        // note: not strictly necessary as there's no binding support for USING;
-        // we provide it nevertheless, in line with on_t.
-        template<class T>
-        struct ast_iterator<T, std::enable_if_t<polyfill::is_specialization_of<T, using_t>::value>> {
-            using node_type = T;
+        template<class... Args>
+        struct ast_iterator<window_defn_t<Args...>, void> {
+            using node_type = window_defn_t<Args...>;
 
             template<class L>
-            void operator()(const node_type& o, L& lambda) const {
-                iterate_ast(o.column, lambda);
+            void operator()(const node_type& node, L& lambda) const {
+                iterate_ast(node.args, lambda);
             }
         };
 
-        template<class R, class T, class E, class... Args>
-        struct ast_iterator<simple_case_t<R, T, E, Args...>, void> {
-            using node_type = simple_case_t<R, T, E, Args...>;
+        template<class... Args>
+        struct ast_iterator<window_t<Args...>, void> {
+            using node_type = window_t<Args...>;
 
             template<class L>
-            void operator()(const node_type& c, L& lambda) const {
-                c.case_expression.apply([&lambda](auto& c_) {
-                    iterate_ast(c_, lambda);
-                });
-                iterate_tuple(c.args, [&lambda](auto& pair) {
-                    iterate_ast(pair.first, lambda);
-                    iterate_ast(pair.second, lambda);
-                });
-                c.else_expression.apply([&lambda](auto& el) {
-                    iterate_ast(el, lambda);
-                });
+            void operator()(const node_type& node, L& lambda) const {
+                iterate_ast(node.definition, lambda);
             }
         };
 
-        template<class T, class E>
-        struct ast_iterator<as_t<T, E>, void> {
+        template<class... Args>
+        struct ast_iterator<partition_by_t<Args...>, void> {
+            using node_type = partition_by_t<Args...>;
+
+            template<class L>
+            void operator()(const node_type& node, L& lambda) const {
+                iterate_ast(node.args, lambda);
+            }
+        };
+
+        template<class B, class E>
+        struct ast_iterator<frame_t<B, E>, void> {
+            using node_type = frame_t<B, E>;
+
+            template<class L>
+            void operator()(const node_type& node, L& lambda) const {
+                iterate_ast(node.start, lambda);
+                iterate_ast(node.end, lambda);
+            }
+        };
+
+        template<class T>
+        struct ast_iterator<preceding_t<T>, void> {
+            using node_type = preceding_t<T>;
+
+            template<class L>
+            void operator()(const node_type& node, L& lambda) const {
+                iterate_ast(node.expression, lambda);
+            }
+        };
+
+        template<class T>
+        struct ast_iterator<following_t<T>, void> {
+            using node_type = following_t<T>;
+
+            template<class L>
+            void operator()(const node_type& node, L& lambda) const {
+                iterate_ast(node.expression, lambda);
+            }
+        };
+
+        template<class Join>
+        struct ast_iterator<Join, match_if<is_constrained_join, Join>> {
+            using node_type = Join;
+
+            template<class L>
+            void operator()(const node_type& join, L& lambda) const {
+                iterate_ast(join.constraint, lambda);
+            }
+        };
+
+        template<class T>
+        struct ast_iterator<on_t<T>, void> {
+            using node_type = on_t<T>;
+
+            template<class L>
+            void operator()(const node_type& on, L& lambda) const {
+                iterate_ast(on.arg, lambda);
+            }
+        };
+
+        // note: not strictly necessary as there's no binding support for USING;
+        // we provide it nevertheless, in line with on_t.
+        template<class T>
+        struct ast_iterator<T, std::enable_if_t<polyfill::is_specialization_of<T, using_t>::value>> {
+            using node_type = T;
+
+            template<class L>
+            void operator()(const node_type& o, L& lambda) const {
+                iterate_ast(o.column, lambda);
+            }
+        };
+
+        template<class R, class T, class E, class... Args>
+        struct ast_iterator<simple_case_t<R, T, E, Args...>, void> {
+            using node_type = simple_case_t<R, T, E, Args...>;
+
+            template<class L>
+            void operator()(const node_type& c, L& lambda) const {
+                c.case_expression.apply([&lambda](auto& c_) {
+                    iterate_ast(c_, lambda);
+                });
+                iterate_tuple(c.args, [&lambda](auto& pair) {
+                    iterate_ast(pair.first, lambda);
+                    iterate_ast(pair.second, lambda);
+                });
+                c.else_expression.apply([&lambda](auto& el) {
+                    iterate_ast(el, lambda);
+                });
+            }
+        };
+
+        template<class T, class E>
+        struct ast_iterator<as_t<T, E>, void> {
             using node_type = as_t<T, E>;
 
             template<class L>
@@ -16182,6 +17087,247 @@ inline constexpr bool std::ranges::enable_borrowed_range<sqlite_orm::internal::r
 #endif
 #endif
 
+// #include "pipelined_view.h"
+
+#include <algorithm>  //  std::max
+#include <condition_variable>  //  std::condition_variable
+#include <exception>  //  std::exception_ptr, std::current_exception, std::rethrow_exception
+#include <iterator>  //  std::input_iterator_tag
+#include <memory>  //  std::shared_ptr, std::unique_ptr, std::make_unique
+#include <mutex>  //  std::mutex, std::unique_lock, std::lock_guard
+#include <new>  //  placement new
+#include <thread>  //  std::thread
+#include <utility>  //  std::move, std::exchange
+
+// #include "functional/cxx_universal.h"
+//  ::size_t, ::ptrdiff_t
+
+namespace sqlite_orm {
+    namespace internal {
+
+        /**
+         *  Bounded single-producer/single-consumer queue of rows: a ring buffer between the thread stepping a
+         *  statement and the thread iterating over its rows. A side only waits if the buffer is full (producer)
+         *  or empty (consumer), and is only notified when the buffer stops being full or empty.
+         *  Rows are constructed in place in the slots and the consumer reads the row it popped from its slot, so `R`
+         *  needs to be move constructible only.
+         */
+        template<class R>
+        class row_queue {
+          public:
+            explicit row_queue(size_t capacity) :
+                capacity{std::max<size_t>(capacity, 1)}, slots{std::make_unique<slot[]>(this->capacity)} {}
+
+            row_queue(const row_queue&) = delete;
+            row_queue& operator=(const row_queue&) = delete;
+
+            ~row_queue() {
+                for(; this->count; --this->count) {
+                    this->row_at(this->head)->~R();
+                    this->head = (this->head + 1) % this->capacity;
+                }
+            }
+
+            /**
+             *  Waits for a free slot and moves `row` into it. Returns false if the consumer cancelled.
+             */
+            bool push(R row) {
+                std::unique_lock<std::mutex> lock{this->mutex};
+                this->notFull.wait(lock, [this] {
+                    return this->count < this->capacity || this->cancelled;
+                });
+                if(this->cancelled) {
+                    return false;
+                }
+                ::new(static_cast<void*>(&this->slots[(this->head + this->count) % this->capacity])) R(std::move(row));
+                if(this->count++ == 0) {
+                    lock.unlock();
+                    this->notEmpty.notify_one();
+                }
+                return true;
+            }
+
+            /**
+             *  Called by the producer after the last row, with the exception which stopped it if any.
+             */
+            void finish(std::exception_ptr exception = nullptr) {
+                {
+                    std::lock_guard<std::mutex> lock{this->mutex};
+                    this->finished = true;
+                    this->error = std::move(exception);
+                }
+                this->notEmpty.notify_one();
+            }
+
+            /**
+             *  Frees the slot of the previously popped row and waits for the next row. Returns the next row, which
+             *  stays in its slot until the following `pop`, or nullptr after the last row. Rethrows the exception
+             *  which stopped the producer once the rows before it are consumed.
+             */
+            R* pop() {
+                std::unique_lock<std::mutex> lock{this->mutex};
+                if(this->popped) {
+                    this->popped = false;
+                    this->row_at(this->head)->~R();
+                    this->head = (this->head + 1) % this->capacity;
+                    if(this->count-- == this->capacity) {
+                        this->notFull.notify_one();
+                    }
+                }
+                this->notEmpty.wait(lock, [this] {
+                    return this->count || this->finished;
+                });
+                if(!this->count) {
+                    if(this->error) {
+                        std::rethrow_exception(std::exchange(this->error, nullptr));
+                    }
+                    return nullptr;
+                }
+                //  the producer doesn't touch the head slot until it is freed
+                this->popped = true;
+                return this->row_at(this->head);
+            }
+
+            /**
+             *  Called by the consumer if it stops before the last row: a waiting producer gives up.
+             */
+            void cancel() {
+                {
+                    std::lock_guard<std::mutex> lock{this->mutex};
+                    this->cancelled = true;
+                }
+                this->notFull.notify_one();
+            }
+
+          private:
+            struct alignas(R) slot {
+                unsigned char bytes[sizeof(R)];
+            };
+
+            R* row_at(size_t index) {
+                return reinterpret_cast<R*>(&this->slots[index]);
+            }
+
+            const size_t capacity;
+            std::unique_ptr<slot[]> slots;
+            size_t head = 0;
+            size_t count = 0;
+            bool popped = false;
+            bool finished = false;
+            bool cancelled = false;
+            std::exception_ptr error;
+            std::mutex mutex;
+            std::condition_variable notEmpty;
+            std::condition_variable notFull;
+        };
+
+        /**
+         *  A single-pass view returned by `storage_t::iterate_pipelined()`. A producer thread steps the statement and
+         *  extracts rows into a `row_queue` while the caller consumes the previous ones. Destroying the view stops the
+         *  producer and waits for it, so the view must not outlive the storage.
+         *  Note: iterators point to the view, they are invalidated if the view is moved.
+         */
+        template<class R>
+        class pipelined_view {
+          public:
+            class iterator {
+              public:
+                using iterator_category = std::input_iterator_tag;
+                using difference_type = ptrdiff_t;
+                using value_type = R;
+                using reference = R&;
+                using pointer = R*;
+
+                iterator() = default;
+
+                explicit iterator(pipelined_view* view) : view{view} {}
+
+                R& operator*() const {
+                    return *this->view->current;
+                }
+
+                R* operator->() const {
+                    return this->view->current;
+                }
+
+                iterator& operator++() {
+                    this->view->next();
+                    return *this;
+                }
+
+                void operator++(int) {
+                    this->operator++();
+                }
+
+                friend bool operator==(const iterator& lhs, const iterator& rhs) {
+                    return lhs.at_end() == rhs.at_end();
+                }
+
+                friend bool operator!=(const iterator& lhs, const iterator& rhs) {
+                    return !(lhs == rhs);
+                }
+
+              private:
+                bool at_end() const {
+                    return !this->view || !this->view->current;
+                }
+
+                pipelined_view* view = nullptr;
+            };
+
+            /**
+             *  Starts `producer(queue)` on a new thread. `statement` keeps whatever the producer steps alive until
+             *  the producer is stopped.
+             */
+            template<class P>
+            pipelined_view(std::shared_ptr<void> statement, size_t queueDepth, P producer) :
+                statement{std::move(statement)}, queue{std::make_unique<row_queue<R>>(queueDepth)} {
+                this->producer = std::thread{[producer = std::move(producer), &queue = *this->queue]() mutable {
+                    try {
+                        producer(queue);
+                        queue.finish();
+                    } catch(...) {
+                        queue.finish(std::current_exception());
+                    }
+                }};
+            }
+
+            pipelined_view(pipelined_view&&) = default;
+
+            ~pipelined_view() {
+                if(this->producer.joinable()) {
+                    this->queue->cancel();
+                    this->producer.join();
+                }
+            }
+
+            iterator begin() {
+                if(!this->started) {
+                    this->started = true;
+                    this->next();
+                }
+                return iterator{this};
+            }
+
+            iterator end() {
+                return {};
+            }
+
+          private:
+            void next() {
+                this->current = this->queue->pop();
+            }
+
+            std::shared_ptr<void> statement;
+            std::unique_ptr<row_queue<R>> queue;
+            std::thread producer;
+            //  the row in the queue slot the iterators point to, nullptr at the end
+            R* current = nullptr;
+            bool started = false;
+        };
+    }
+}
+
 // #include "ast_iterator.h"
 
 // #include "storage_base.h"
@@ -16191,14 +17337,20 @@ inline constexpr bool std::ranges::enable_borrowed_range<sqlite_orm::internal::r
 #include <functional>  //  std::function, std::bind, std::bind_front
 #include <string>  //  std::string
 #include <sstream>  //  std::stringstream
-#include <utility>  //  std::move
+#include <utility>  //  std::move, std::pair, std::exchange
 #include <system_error>  //  std::system_error
 #include <vector>  //  std::vector
 #include <list>  //  std::list
 #include <memory>  //  std::make_unique, std::unique_ptr
 #include <map>  //  std::map
-#include <type_traits>  //  std::is_same
-#include <algorithm>  //  std::find_if, std::ranges::find
+#include <unordered_map>  //  std::unordered_map
+#include <type_traits>  //  std::is_same, std::integral_constant
+#include <algorithm>  //  std::find_if, std::ranges::find, std::min, std::any_of, std::copy, std::remove_if
+#include <chrono>  //  std::chrono::steady_clock
+#include <random>  //  std::minstd_rand, std::uniform_real_distribution
+#include <thread>  //  std::this_thread::sleep_for
+#include <future>  //  std::future, std::async, std::promise
+#include <exception>  //  std::exception_ptr, std::current_exception, std::rethrow_exception
 
 // #include "functional/cxx_universal.h"
 //  ::size_t
@@ -16817,13 +17969,23 @@ namespace sqlite_orm {
 
             // will include generated columns in response as opposed to table_info
             std::vector<sqlite_orm::table_xinfo> table_xinfo(const std::string& tableName) const {
+                return this->table_xinfo(std::string{}, tableName);
+            }
+
+            /**
+             *  Columns of table `tableName` in the database attached as `schemaName`, the main database if it is empty.
+             */
+            std::vector<sqlite_orm::table_xinfo> table_xinfo(const std::string& schemaName,
+                                                             const std::string& tableName) const {
                 auto connection = this->get_connection();
 
                 std::vector<sqlite_orm::table_xinfo> result;
                 std::ostringstream ss;
-                ss << "PRAGMA "
-                      "table_xinfo("
-                   << streaming_identifier(tableName) << ")" << std::flush;
+                ss << "PRAGMA ";
+                if(!schemaName.empty()) {
+                    ss << streaming_identifier(schemaName) << ".";
+                }
+                ss << "table_xinfo(" << streaming_identifier(tableName) << ")" << std::flush;
                 perform_exec(
                     connection.get(),
                     ss.str(),
@@ -17158,13 +18320,86 @@ namespace sqlite_orm {
 #include <string>  //  std::string
 #include <memory>
 #include <utility>  //  std::move, std::exchange
+#include <chrono>  //  std::chrono::milliseconds
+#include <functional>  //  std::function
 
 // #include "error_code.h"
 
 // #include "connection_holder.h"
 
+// #include "cancellation_token.h"
+
+#include <atomic>  //  std::atomic_bool
+#include <memory>  //  std::shared_ptr, std::make_shared
+
+namespace sqlite_orm {
+
+    /**
+     *  A token used to cancel queries run inside `storage.with_cancellation(token, f)`.
+     *  Copies share the same state, so a copy can be handed over to another thread which calls `cancel()`.
+     *  The running statement is then interrupted at its next progress handler invocation
+     *  and `with_cancellation` throws `std::system_error{orm_error_code::query_cancelled}`.
+     */
+    struct cancellation_token {
+        void cancel() noexcept {
+            this->cancelled->store(true);
+        }
+
+        bool is_cancelled() const noexcept {
+            return this->cancelled->load();
+        }
+
+        /**
+         *  Makes the token usable again after a cancellation.
+         */
+        void reset() noexcept {
+            this->cancelled->store(false);
+        }
+
+      private:
+        std::shared_ptr<std::atomic_bool> cancelled = std::make_shared<std::atomic_bool>(false);
+    };
+}
+
 namespace sqlite_orm {
 
+    /**
+     *  State of a backup started with `storage.start_backup()`, reported after each batch of pages.
+     */
+    struct backup_progress {
+        int remaining = 0;
+        int pagecount = 0;
+
+        /**
+         *  Number of times the copy started over because another connection changed the source database.
+         */
+        int restarts = 0;
+    };
+
+    struct backup_options {
+
+        /**
+         *  Number of pages copied in one batch, the source database is locked while a batch is copied.
+         */
+        int pages_per_step = 1024;
+
+        /**
+         *  Pause between two batches, caps the I/O bandwidth to `pages_per_step` pages per pause.
+         */
+        std::chrono::milliseconds sleep{10};
+
+        /**
+         *  Called from the backup thread after every batch.
+         */
+        std::function<void(const backup_progress&)> on_progress;
+
+        /**
+         *  Stops the backup before its next batch, the future then throws
+         *  `std::system_error{orm_error_code::backup_cancelled}`.
+         */
+        cancellation_token cancellation;
+    };
+
     namespace internal {
 
         /**
@@ -17662,25 +18897,1536 @@ namespace sqlite_orm {
 
 // #include "serializing_util.h"
 
-namespace sqlite_orm {
-
-    namespace internal {
+// #include "trace.h"
 
-        struct storage_base {
-            using collating_function = std::function<int(int, const void*, int, const void*)>;
+#include <sqlite3.h>
+#include <chrono>  //  std::chrono::nanoseconds
+#include <functional>  //  std::function
+#include <memory>  //  std::unique_ptr
+#include <string>  //  std::string
+#include <type_traits>  //  std::integral_constant
+#include <utility>  //  std::move
 
-            std::function<void(sqlite3*)> on_open;
-            pragma_t pragma;
-            limit_accessor limit;
+// #include "functional/cxx_universal.h"
+//  ::int64
 
-            transaction_guard_t transaction_guard() {
-                this->begin_transaction();
-                return {this->get_connection(),
-                        std::bind(&storage_base::commit, this),
-                        std::bind(&storage_base::rollback, this)};
-            }
+namespace sqlite_orm {
 
-            transaction_guard_t deferred_transaction_guard() {
+#if SQLITE_VERSION_NUMBER >= 3014000
+    /**
+     *  Event passed to a callback registered with `storage.on_trace()`.
+     *  Which fields are set depends on `type` (one of the SQLITE_TRACE_* codes):
+     *  * SQLITE_TRACE_STMT: `stmt` and `sql` (unexpanded SQL text or a trigger comment)
+     *  * SQLITE_TRACE_PROFILE: `stmt` and `nanoseconds` (estimated wall-clock time the statement took)
+     *  * SQLITE_TRACE_ROW: `stmt`
+     *  * SQLITE_TRACE_CLOSE: `db`
+     *  More info: https://www.sqlite.org/c3ref/c_trace.html
+     */
+    struct trace_event {
+        unsigned int type = 0;
+        sqlite3* db = nullptr;
+        sqlite3_stmt* stmt = nullptr;
+        const char* sql = nullptr;
+        int64 nanoseconds = 0;
+    };
+
+    /**
+     *  A statement captured by `slow_query_logger`.
+     *  Counters are read with `sqlite3_stmt_status()` and are cumulative over the lifetime
+     *  of the prepared statement; use `run` to normalize them per execution.
+     */
+    struct slow_query {
+        std::string sql;
+        int64 nanoseconds = 0;
+        int fullscan_step = 0;
+        int sort = 0;
+        int autoindex = 0;
+        int vm_step = 0;
+        int reprepare = 0;
+        int run = 0;
+    };
+
+    /**
+     *  Trace callback reporting statements running longer than a threshold.
+     *  Register it for SQLITE_TRACE_PROFILE events:
+     *  ```
+     *  storage.on_trace(SQLITE_TRACE_PROFILE, slow_query_logger{std::chrono::milliseconds{50}, [](const slow_query& q) {
+     *      std::cerr << q.sql << " took " << q.nanoseconds << "ns" << std::endl;
+     *  }});
+     *  ```
+     *  `sampleEvery` inspects only every n-th profiled statement, which keeps the cost of
+     *  expanding SQL text and reading counters negligible on hot paths.
+     */
+    struct slow_query_logger {
+        using sink_type = std::function<void(const slow_query&)>;
+
+        slow_query_logger(std::chrono::nanoseconds threshold, sink_type sink, unsigned int sampleEvery = 1) :
+            threshold(threshold.count()), sink(std::move(sink)), sampleEvery(sampleEvery ? sampleEvery : 1) {}
+
+        void operator()(const trace_event& event) {
+            if(event.type != SQLITE_TRACE_PROFILE || ++this->profiledCount % this->sampleEvery) {
+                return;
+            }
+            if(event.nanoseconds < this->threshold) {
+                return;
+            }
+            slow_query query;
+            //  note: must check return value due to SQLITE_OMIT_TRACE
+            using char_ptr = std::unique_ptr<char, std::integral_constant<decltype(&sqlite3_free), sqlite3_free>>;
+            if(char_ptr sql{sqlite3_expanded_sql(event.stmt)}) {
+                query.sql = sql.get();
+            }
+            query.nanoseconds = event.nanoseconds;
+            query.fullscan_step = sqlite3_stmt_status(event.stmt, SQLITE_STMTSTATUS_FULLSCAN_STEP, 0);
+            query.sort = sqlite3_stmt_status(event.stmt, SQLITE_STMTSTATUS_SORT, 0);
+            query.autoindex = sqlite3_stmt_status(event.stmt, SQLITE_STMTSTATUS_AUTOINDEX, 0);
+            query.vm_step = sqlite3_stmt_status(event.stmt, SQLITE_STMTSTATUS_VM_STEP, 0);
+#if SQLITE_VERSION_NUMBER >= 3020000
+            query.reprepare = sqlite3_stmt_status(event.stmt, SQLITE_STMTSTATUS_REPREPARE, 0);
+            query.run = sqlite3_stmt_status(event.stmt, SQLITE_STMTSTATUS_RUN, 0);
+#endif
+            this->sink(query);
+        }
+
+      private:
+        int64 threshold;
+        sink_type sink;
+        unsigned int sampleEvery;
+        unsigned long long profiledCount = 0;
+    };
+#endif
+}
+
+// #include "cancellation_token.h"
+
+// #include "busy_retry_policy.h"
+
+#include <chrono>  //  std::chrono::microseconds, std::chrono::duration_cast
+#include <algorithm>  //  std::min
+
+// #include "functional/cxx_universal.h"
+//  ::int64
+
+namespace sqlite_orm {
+
+    /**
+     *  Describes how a storage reacts to SQLITE_BUSY, see `storage.retry_on_busy()`.
+     *  The delay before retry number `n` (starting with 1) is
+     *  `min(initial_backoff * multiplier^(n - 1), max_backoff)`, of which a random fraction up to `jitter`
+     *  is subtracted so that competing processes don't retry in lockstep.
+     */
+    struct busy_retry_policy {
+        /**
+         *  Total number of attempts including the first one. 1 means no retries.
+         */
+        int max_attempts = 5;
+        std::chrono::microseconds initial_backoff{1000};
+        std::chrono::microseconds max_backoff{100000};
+        double multiplier = 2;
+        double jitter = 0.5;
+
+        /**
+         *  @param retry number of the retry, starting with 1
+         *  @param random a random value in [0, 1)
+         */
+        std::chrono::microseconds backoff(int retry, double random) const {
+            double delay = double(this->initial_backoff.count());
+            for(int i = 1; i < retry && delay < double(this->max_backoff.count()); ++i) {
+                delay *= this->multiplier;
+            }
+            delay = (std::min)(delay, double(this->max_backoff.count()));
+            delay -= delay * this->jitter * random;
+            return std::chrono::microseconds{int64(delay)};
+        }
+    };
+
+    /**
+     *  Counters collected while retrying on SQLITE_BUSY, see `storage.busy_retry_stats()`.
+     */
+    struct busy_retry_stats {
+        /**
+         *  Number of times a lock was waited for by the busy handler.
+         */
+        int64 retries = 0;
+
+        /**
+         *  Number of times a whole `storage.transaction(f)` was started over.
+         */
+        int64 transaction_retries = 0;
+
+        /**
+         *  Accumulated time spent sleeping between retries.
+         */
+        std::chrono::microseconds wait_time{0};
+    };
+}
+
+// #include "data_change.h"
+
+#include <memory>  //  std::unique_ptr
+
+// #include "functional/cxx_universal.h"
+//  ::int64
+
+namespace sqlite_orm {
+
+#ifdef SQLITE_ENABLE_PREUPDATE_HOOK
+    /**
+     *  A row change of a table mapped to `O`, reported by `storage.on_preupdate<O>()` before it is applied.
+     *  `operation` is SQLITE_INSERT, SQLITE_UPDATE or SQLITE_DELETE.
+     *  `old_object` is set for updates and deletes, `new_object` for inserts and updates.
+     */
+    template<class O>
+    struct preupdate_change {
+        int operation = 0;
+        int64 old_rowid = 0;
+        int64 new_rowid = 0;
+        std::unique_ptr<O> old_object;
+        std::unique_ptr<O> new_object;
+    };
+#endif
+}
+
+// #include "object_cache.h"
+
+#include <list>  //  std::list
+#include <memory>  //  std::shared_ptr
+#include <unordered_map>  //  std::unordered_map
+#include <utility>  //  std::move, std::pair
+
+// #include "functional/cxx_universal.h"
+//  ::size_t, ::int64
+
+namespace sqlite_orm {
+
+    /**
+     *  Counters of an object cache, see `storage.object_cache_stats<O>()`.
+     */
+    struct object_cache_stats {
+        int64 hits = 0;
+        int64 misses = 0;
+
+        /**
+         *  Number of objects dropped because the cache was full.
+         */
+        int64 evictions = 0;
+
+        /**
+         *  Number of objects dropped because the database changed.
+         */
+        int64 invalidations = 0;
+    };
+
+    namespace internal {
+
+        struct basic_object_cache {
+            basic_object_cache(size_t capacity, bool keyIsRowid, bool uniqueKeys) :
+                capacity(capacity), keyIsRowid(keyIsRowid), uniqueKeys(uniqueKeys) {}
+
+            virtual ~basic_object_cache() = default;
+
+            /**
+             *  Called when a row of the cached table changed.
+             *  Drops just that row if objects are keyed by rowid and everything otherwise.
+             */
+            virtual void invalidate(int64 rowid) = 0;
+
+            virtual void clear() = 0;
+
+            /**
+             *  Called after a REPLACE into the cached table. Rows it deletes because they conflict on a UNIQUE
+             *  constraint are not reported to the update hook, so they can only be dropped along with everything.
+             */
+            void rows_replaced() {
+                if(this->uniqueKeys) {
+                    this->clear();
+                }
+            }
+
+            object_cache_stats stats;
+
+          protected:
+            const size_t capacity;
+            const bool keyIsRowid;
+            //  whether the table has UNIQUE constraints or indexes besides its primary key
+            const bool uniqueKeys;
+        };
+
+        /**
+         *  LRU cache of objects of type `O` keyed by their integral primary key.
+         */
+        template<class O>
+        struct object_cache : basic_object_cache {
+            using basic_object_cache::basic_object_cache;
+
+            std::shared_ptr<const O> find(int64 key) {
+                auto it = this->index.find(key);
+                if(it == this->index.end()) {
+                    ++this->stats.misses;
+                    return nullptr;
+                }
+                ++this->stats.hits;
+                this->entries.splice(this->entries.begin(), this->entries, it->second);
+                return it->second->second;
+            }
+
+            void insert(int64 key, std::shared_ptr<const O> object) {
+                auto it = this->index.find(key);
+                if(it != this->index.end()) {
+                    it->second->second = std::move(object);
+                    this->entries.splice(this->entries.begin(), this->entries, it->second);
+                    return;
+                }
+                this->entries.emplace_front(key, std::move(object));
+                this->index.emplace(key, this->entries.begin());
+                if(this->entries.size() > this->capacity) {
+                    this->index.erase(this->entries.back().first);
+                    this->entries.pop_back();
+                    ++this->stats.evictions;
+                }
+            }
+
+            void invalidate(int64 rowid) override {
+                if(!this->keyIsRowid) {
+                    this->clear();
+                    return;
+                }
+                auto it = this->index.find(rowid);
+                if(it != this->index.end()) {
+                    this->entries.erase(it->second);
+                    this->index.erase(it);
+                    ++this->stats.invalidations;
+                }
+            }
+
+            void clear() override {
+                this->stats.invalidations += int64(this->entries.size());
+                this->index.clear();
+                this->entries.clear();
+            }
+
+          private:
+            using entry_type = std::pair<int64, std::shared_ptr<const O>>;
+
+            std::list<entry_type> entries;
+            std::unordered_map<int64, typename std::list<entry_type>::iterator> index;
+        };
+    }
+}
+
+// #include "query_cache.h"
+
+#include <chrono>  //  std::chrono::steady_clock
+#include <cstring>  //  std::memcpy
+#include <list>  //  std::list
+#include <memory>  //  std::shared_ptr
+#include <string>  //  std::string, std::to_string
+#include <tuple>  //  std::tuple
+#include <type_traits>  //  std::is_arithmetic, std::is_floating_point, std::is_signed, std::remove_pointer_t
+#include <unordered_map>  //  std::unordered_map
+#include <utility>  //  std::move, std::pair
+#include <vector>  //  std::vector
+
+// #include "functional/cxx_universal.h"
+//  ::size_t, ::int64
+// #include "functional/cxx_type_traits_polyfill.h"
+
+// #include "type_traits.h"
+
+// #include "mapped_type_proxy.h"
+
+// #include "conditions.h"
+
+// #include "storage_lookup.h"
+
+// #include "table_name_collector.h"
+
+// #include "tuple_helper/tuple_iteration.h"
+
+// #include "statement_binder.h"
+
+// #include "field_printer.h"
+
+namespace sqlite_orm {
+
+    /**
+     *  Counters of the query result cache, see `storage.query_cache_stats()`.
+     */
+    struct query_cache_stats {
+        int64 hits = 0;
+        int64 misses = 0;
+
+        /**
+         *  Number of results dropped because the cache was full.
+         */
+        int64 evictions = 0;
+
+        /**
+         *  Number of results dropped because they expired or a table they were read from changed.
+         */
+        int64 invalidations = 0;
+    };
+
+    namespace internal {
+
+        /**
+         *  Builds the part of a query cache key made of the values bound to a statement.
+         *  Values that can't be represented disable caching of the statement.
+         */
+        struct bindings_key_builder {
+            std::string key;
+            bool representable = true;
+
+            /**
+             *  Numbers are tagged with their kind and size, the same bytes of different types are different values.
+             */
+            template<class T, satisfies<std::is_arithmetic, T> = true>
+            void operator()(const T& value) {
+                char bytes[sizeof(T)];
+                std::memcpy(bytes, &value, sizeof(T));
+                this->key += std::is_floating_point<T>::value ? 'f' : std::is_signed<T>::value ? 'i' : 'u';
+                this->key += char(sizeof(T));
+                this->key.append(bytes, sizeof(T));
+            }
+
+            template<class T,
+                     std::enable_if_t<!std::is_arithmetic<T>::value && is_bindable<T>::value && is_printable<T>::value,
+                                      bool> = true>
+            void operator()(const T& value) {
+                auto text = field_printer<T>{}(value);
+                this->key += 's';
+                this->key += std::to_string(text.size());
+                this->key += ':';
+                this->key += text;
+            }
+
+            template<class T,
+                     std::enable_if_t<!std::is_arithmetic<T>::value && is_bindable<T>::value && !is_printable<T>::value,
+                                      bool> = true>
+            void operator()(const T&) {
+                this->representable = false;
+            }
+
+            template<class T, satisfies_not<is_bindable, T> = true>
+            void operator()(const T&) const {}
+        };
+
+        /**
+         *  Collects all tables a query reads from, including those only mentioned in FROM and JOIN clauses.
+         */
+        template<class DBOs>
+        struct referenced_tables_collector : table_name_collector<DBOs> {
+            using table_name_collector<DBOs>::table_name_collector;
+            using table_name_collector<DBOs>::operator();
+
+            template<class... Args>
+            void operator()(const from_t<Args...>&) {
+                iterate_tuple<std::tuple<Args...>>([this](auto* dummyItem) {
+                    using table_type = std::remove_pointer_t<decltype(dummyItem)>;
+                    this->add_table<table_type>();
+                });
+            }
+
+            template<class T>
+            void operator()(const cross_join_t<T>&) {
+                this->add_table<T>();
+            }
+
+            template<class T>
+            void operator()(const natural_join_t<T>&) {
+                this->add_table<T>();
+            }
+
+            template<class T, class O>
+            void operator()(const left_join_t<T, O>&) {
+                this->add_table<T>();
+            }
+
+            template<class T, class O>
+            void operator()(const join_t<T, O>&) {
+                this->add_table<T>();
+            }
+
+            template<class T, class O>
+            void operator()(const left_outer_join_t<T, O>&) {
+                this->add_table<T>();
+            }
+
+            template<class T, class O>
+            void operator()(const inner_join_t<T, O>&) {
+                this->add_table<T>();
+            }
+
+          private:
+            template<class T>
+            void add_table() {
+                this->template collect_table<mapped_type_proxy_t<T>>("");
+            }
+        };
+
+        /**
+         *  LRU cache of materialized query results.
+         *  Rather than scanning entries on every change, each table has a generation counter that is bumped
+         *  when the table changes; an entry remembers the generations of the tables it was read from
+         *  and is stale as soon as one of them moved.
+         */
+        struct query_cache {
+            using clock_type = std::chrono::steady_clock;
+
+            std::shared_ptr<const void> find(const std::string& key, clock_type::time_point now) {
+                auto it = this->index.find(key);
+                if(it == this->index.end()) {
+                    ++this->stats.misses;
+                    return nullptr;
+                }
+                auto entryIt = it->second;
+                if(entryIt->expires <= now || !this->is_current(*entryIt)) {
+                    this->index.erase(it);
+                    this->entries.erase(entryIt);
+                    ++this->stats.invalidations;
+                    ++this->stats.misses;
+                    return nullptr;
+                }
+                ++this->stats.hits;
+                this->entries.splice(this->entries.begin(), this->entries, entryIt);
+                return entryIt->result;
+            }
+
+            void insert(std::string key,
+                        std::shared_ptr<const void> result,
+                        clock_type::time_point expires,
+                        const std::vector<std::string>& tableKeys) {
+                auto it = this->index.find(key);
+                if(it != this->index.end()) {
+                    this->entries.erase(it->second);
+                    this->index.erase(it);
+                }
+                entry_type entry;
+                entry.key = std::move(key);
+                entry.result = std::move(result);
+                entry.expires = expires;
+                entry.anyTableGeneration = this->anyTableGeneration;
+                //  an empty set means the tables are unknown, so any change makes the entry stale
+                entry.dependsOnAnyTable = tableKeys.empty();
+                for(auto& tableKey: tableKeys) {
+                    entry.tableGenerations.emplace_back(tableKey, this->tableGenerations[tableKey]);
+                }
+                this->entries.push_front(std::move(entry));
+                this->index.emplace(this->entries.front().key, this->entries.begin());
+                if(this->entries.size() > this->capacity) {
+                    this->index.erase(this->entries.back().key);
+                    this->entries.pop_back();
+                    ++this->stats.evictions;
+                }
+            }
+
+            void table_changed(const std::string& tableKey) {
+                ++this->anyTableGeneration;
+                ++this->tableGenerations[tableKey];
+            }
+
+            void clear() {
+                this->stats.invalidations += int64(this->entries.size());
+                this->index.clear();
+                this->entries.clear();
+            }
+
+            void set_capacity(size_t value) {
+                this->capacity = value;
+                while(this->entries.size() > this->capacity) {
+                    this->index.erase(this->entries.back().key);
+                    this->entries.pop_back();
+                    ++this->stats.evictions;
+                }
+            }
+
+            /**
+             *  Whether results are cached at all, the update hook is needed only if they are.
+             */
+            bool enabled = false;
+            query_cache_stats stats;
+
+          private:
+            struct entry_type {
+                std::string key;
+                std::shared_ptr<const void> result;
+                clock_type::time_point expires;
+                std::vector<std::pair<std::string, int64>> tableGenerations;
+                int64 anyTableGeneration = 0;
+                bool dependsOnAnyTable = false;
+            };
+
+            bool is_current(const entry_type& entry) const {
+                if(entry.dependsOnAnyTable) {
+                    return entry.anyTableGeneration == this->anyTableGeneration;
+                }
+                for(auto& tableGeneration: entry.tableGenerations) {
+                    auto it = this->tableGenerations.find(tableGeneration.first);
+                    if(it != this->tableGenerations.end() && it->second != tableGeneration.second) {
+                        return false;
+                    }
+                }
+                return true;
+            }
+
+            size_t capacity = 256;
+            std::list<entry_type> entries;
+            std::unordered_map<std::string, std::list<entry_type>::iterator> index;
+            std::unordered_map<std::string, int64> tableGenerations;
+            int64 anyTableGeneration = 0;
+        };
+
+        /**
+         *  Returned by `storage.cached(ttl)`, memoizes the results of `select()`.
+         */
+        template<class S>
+        struct cached_select {
+            S& storage;
+            std::chrono::steady_clock::duration ttl;
+
+            template<class T, class... Args>
+            auto select(T m, Args... args) {
+                return this->storage.select_cached(this->ttl, std::move(m), std::forward<Args>(args)...);
+            }
+        };
+
+        /**
+         *  Unique key of a type without relying on RTTI.
+         */
+        template<class T>
+        const void* type_key() {
+            static const char key = 0;
+            return &key;
+        }
+    }
+}
+
+// #include "range_table.h"
+
+#include <sqlite3.h>
+#if SQLITE_VERSION_NUMBER >= 3020000
+#include <algorithm>  //  std::sort, std::equal_range
+#include <map>  //  std::map
+#include <memory>  //  std::shared_ptr, std::make_shared
+#include <new>  //  std::bad_alloc
+#include <numeric>  //  std::iota
+#include <string>  //  std::string
+#include <tuple>  //  std::tuple_element_t, std::get
+#include <type_traits>  //  std::decay_t, std::true_type, std::false_type
+#include <utility>  //  std::index_sequence, std::pair
+#include <vector>  //  std::vector
+#endif
+
+// #include "functional/cxx_universal.h"
+//  ::size_t
+// #include "functional/cxx_functional_polyfill.h"
+
+// #include "tuple_helper/tuple_filter.h"
+
+// #include "type_traits.h"
+
+// #include "schema/column.h"
+
+// #include "type_printer.h"
+
+// #include "statement_binder.h"
+
+// #include "row_extractor.h"
+
+// #include "util.h"
+
+// #include "range_source.h"
+
+#if SQLITE_VERSION_NUMBER >= 3020000
+namespace sqlite_orm {
+    namespace internal {
+
+        /**
+         *  Virtual table module registered with a connection, see `storage.create_range_table<O>()`.
+         */
+        struct basic_range_table {
+            virtual ~basic_range_table() = default;
+
+            sqlite3_module module{};
+        };
+
+        /**
+         *  The key of a range table is its single primary key column, equality on it is answered
+         *  by a binary search instead of a scan.
+         */
+        template<class Table, class PkIndices = col_index_sequence_with<elements_type_t<Table>, is_primary_key>>
+        struct range_table_key {
+            static constexpr bool is_declared = false;
+        };
+
+        template<class Table, size_t I>
+        struct range_table_key<Table, std::index_sequence<I>> {
+            static constexpr bool is_declared = true;
+
+            using column_type = std::tuple_element_t<I, elements_type_t<Table>>;
+            using field_type = field_type_t<column_type>;
+
+            static const column_type& column(const Table& table) {
+                return std::get<I>(table.elements);
+            }
+        };
+
+        /**
+         *  Eponymous-only virtual table module exposing a range of objects of a mapped type
+         *  as a table with the mapped columns.
+         *  The range is bound to the hidden column `sqlite_orm_source` with the pointer-passing interface,
+         *  so objects are read in place and never copied into the database.
+         */
+        template<class Table>
+        struct range_table : basic_range_table {
+            using table_type = Table;
+            using object_type = object_type_t<Table>;
+            using key_type = range_table_key<Table>;
+            using column_index_sequence = filter_tuple_sequence_t<elements_type_t<Table>, is_column>;
+
+            range_table(const table_type& table) :
+                table(table), columnResults{make_column_results(column_index_sequence{})} {
+                int index = 0;
+                this->table.for_each_column([this, &index](auto& column) {
+                    this->columnsCount = ++index;
+                    if(this->is_key_column(column)) {
+                        this->keyColumn = index - 1;
+                    }
+                });
+                this->module.iVersion = 0;
+                this->module.xCreate = nullptr;
+                this->module.xConnect = connect;
+                this->module.xBestIndex = best_index;
+                this->module.xDisconnect = disconnect;
+                this->module.xDestroy = disconnect;
+                this->module.xOpen = open;
+                this->module.xClose = close;
+                this->module.xFilter = filter;
+                this->module.xNext = next;
+                this->module.xEof = eof;
+                this->module.xColumn = column_value;
+                this->module.xRowid = row_id;
+            }
+
+            const table_type table;
+
+          private:
+            struct vtab_type : sqlite3_vtab {
+                range_table* rangeTable = nullptr;
+            };
+
+            using key_order_type = std::vector<size_t>;
+
+            struct cursor_type : sqlite3_vtab_cursor {
+                range_view<object_type> view;
+                //  held by the cursor so that lookups into other ranges can't invalidate it
+                std::shared_ptr<const key_order_type> keyOrder;
+                size_t orderBegin = 0;
+                bool byKey = false;
+                size_t position = 0;
+                size_t end = 0;
+
+                size_t current() const {
+                    return this->byKey ? (*this->keyOrder)[this->orderBegin + this->position] : this->position;
+                }
+            };
+
+            enum idx_flags {
+                key_lookup = 1,
+            };
+
+            template<class C>
+            bool is_key_column(const C& column) const {
+                return this->is_key_column(column, polyfill::bool_constant<key_type::is_declared>{});
+            }
+
+            template<class C>
+            bool is_key_column(const C& column, std::true_type) const {
+                return static_cast<const void*>(&column) == static_cast<const void*>(&key_type::column(this->table));
+            }
+
+            template<class C>
+            bool is_key_column(const C&, std::false_type) const {
+                return false;
+            }
+
+            std::string declaration() const {
+                std::string sql = "CREATE TABLE x(";
+                this->table.for_each_column([&sql](auto& column) {
+                    using field_type = field_type_t<std::decay_t<decltype(column)>>;
+                    sql += quote_identifier(column.name);
+                    sql += ' ';
+                    sql += type_printer<field_type>().print();
+                    sql += ", ";
+                });
+                sql += quote_identifier(range_source_column_name());
+                sql += " HIDDEN)";
+                return sql;
+            }
+
+            static int connect(sqlite3* db, void* aux, int, const char* const*, sqlite3_vtab** vtab, char**) {
+                auto& rangeTable = *static_cast<range_table*>(aux);
+                try {
+                    int rc = sqlite3_declare_vtab(db, rangeTable.declaration().c_str());
+                    if(rc != SQLITE_OK) {
+                        return rc;
+                    }
+                    auto result = new vtab_type{};
+                    result->rangeTable = &rangeTable;
+                    *vtab = result;
+                } catch(const std::bad_alloc&) {
+                    return SQLITE_NOMEM;
+                }
+                return SQLITE_OK;
+            }
+
+            static int disconnect(sqlite3_vtab* vtab) {
+                delete static_cast<vtab_type*>(vtab);
+                return SQLITE_OK;
+            }
+
+            static int best_index(sqlite3_vtab* vtab, sqlite3_index_info* info) {
+                auto& rangeTable = *static_cast<vtab_type*>(vtab)->rangeTable;
+                int sourceConstraint = -1;
+                int keyConstraint = -1;
+                for(int i = 0; i < info->nConstraint; ++i) {
+                    auto& constraint = info->aConstraint[i];
+                    if(!constraint.usable || constraint.op != SQLITE_INDEX_CONSTRAINT_EQ) {
+                        continue;
+                    }
+                    if(constraint.iColumn == rangeTable.columnsCount) {
+                        sourceConstraint = i;
+                    } else if(constraint.iColumn == rangeTable.keyColumn) {
+                        keyConstraint = i;
+                    }
+                }
+                //  a plan without the range is unusable rather than empty
+                if(sourceConstraint == -1) {
+#if SQLITE_VERSION_NUMBER >= 3026000
+                    return SQLITE_CONSTRAINT;
+#else
+                    //  SQLITE_CONSTRAINT rejects a plan only since 3.26.0, before that a prohibitive cost has to do
+                    info->estimatedCost = 1e300;
+                    info->estimatedRows = 1000000000;
+                    return SQLITE_OK;
+#endif
+                }
+                info->aConstraintUsage[sourceConstraint].argvIndex = 1;
+                info->aConstraintUsage[sourceConstraint].omit = 1;
+                if(keyConstraint != -1) {
+                    info->aConstraintUsage[keyConstraint].argvIndex = 2;
+                    //  the lookup converts the value to the key's type, e.g. 4.5 to 4, so SQLite checks the
+                    //  equality of the rows found once more
+                    info->idxNum = key_lookup;
+                    info->estimatedCost = 10;
+                    info->estimatedRows = 1;
+                } else {
+                    info->estimatedCost = 100000;
+                    info->estimatedRows = 100000;
+                }
+                return SQLITE_OK;
+            }
+
+            static int open(sqlite3_vtab* vtab, sqlite3_vtab_cursor** cursor) {
+                try {
+                    *cursor = new cursor_type{};
+                } catch(const std::bad_alloc&) {
+                    return SQLITE_NOMEM;
+                }
+                ++static_cast<vtab_type*>(vtab)->rangeTable->openCursorsCount;
+                return SQLITE_OK;
+            }
+
+            static int close(sqlite3_vtab_cursor* cursor) {
+                auto& rangeTable = *static_cast<vtab_type*>(cursor->pVtab)->rangeTable;
+                //  a range may change between statements, so key orders are kept only while they are scanned
+                if(--rangeTable.openCursorsCount == 0) {
+                    rangeTable.keyOrders.clear();
+                }
+                delete static_cast<cursor_type*>(cursor);
+                return SQLITE_OK;
+            }
+
+            static int filter(sqlite3_vtab_cursor* cursor, int idxNum, const char*, int argc, sqlite3_value** argv) {
+                auto& c = *static_cast<cursor_type*>(cursor);
+                auto view = argc > 0 ? static_cast<const range_view<object_type>*>(
+                                           sqlite3_value_pointer(argv[0], range_pointer_type::value))
+                                     : nullptr;
+                c.view = view ? *view : range_view<object_type>{};
+                c.keyOrder = nullptr;
+                c.byKey = false;
+                c.position = 0;
+                c.end = c.view.size;
+                if((idxNum & key_lookup) && argc > 1) {
+                    c.byKey = true;
+                    c.end = 0;
+                    if(view && sqlite3_value_type(argv[1]) != SQLITE_NULL) {
+                        try {
+                            filter_by_key(c, argv[1], polyfill::bool_constant<key_type::is_declared>{});
+                        } catch(const std::bad_alloc&) {
+                            return SQLITE_NOMEM;
+                        }
+                    }
+                }
+                return SQLITE_OK;
+            }
+
+            /**
+             *  Key lookups binary search positions of the objects ordered by key, which are sorted on the first
+             *  lookup into a range and shared by all cursors scanning the same range, even in nested statements
+             *  scanning different ranges.
+             */
+            static void filter_by_key(cursor_type& c, sqlite3_value* value, std::true_type) {
+                using field_type = typename key_type::field_type;
+                auto& rangeTable = *static_cast<vtab_type*>(c.pVtab)->rangeTable;
+                auto& keyColumn = key_type::column(rangeTable.table);
+                auto keyOf = [&c, &keyColumn](size_t position) -> decltype(auto) {
+                    return polyfill::invoke(keyColumn.member_pointer, c.view.data[position]);
+                };
+                auto& sharedOrder = rangeTable.keyOrders[{c.view.data, c.view.size}];
+                if(!sharedOrder) {
+                    auto keyOrder = std::make_shared<key_order_type>(c.view.size);
+                    std::iota(keyOrder->begin(), keyOrder->end(), size_t(0));
+                    std::sort(keyOrder->begin(), keyOrder->end(), [&keyOf](size_t lhs, size_t rhs) {
+                        return keyOf(lhs) < keyOf(rhs);
+                    });
+                    sharedOrder = std::move(keyOrder);
+                }
+                c.keyOrder = sharedOrder;
+                const field_type key = row_extractor<field_type>().extract(value);
+                auto range = std::equal_range(c.keyOrder->cbegin(),
+                                              c.keyOrder->cend(),
+                                              key,
+                                              key_less<decltype(keyOf), field_type>{keyOf});
+                c.orderBegin = size_t(range.first - c.keyOrder->cbegin());
+                c.end = size_t(range.second - range.first);
+            }
+
+            static void filter_by_key(cursor_type&, sqlite3_value*, std::false_type) {}
+
+            /**
+             *  Compares positions in the range with a key value for `std::equal_range`.
+             */
+            template<class F, class K>
+            struct key_less {
+                F& keyOf;
+
+                bool operator()(size_t position, const K& key) const {
+                    return this->keyOf(position) < key;
+                }
+
+                bool operator()(const K& key, size_t position) const {
+                    return key < this->keyOf(position);
+                }
+            };
+
+            static int next(sqlite3_vtab_cursor* cursor) {
+                ++static_cast<cursor_type*>(cursor)->position;
+                return SQLITE_OK;
+            }
+
+            static int eof(sqlite3_vtab_cursor* cursor) {
+                auto& c = *static_cast<cursor_type*>(cursor);
+                return c.position >= c.end;
+            }
+
+            static int column_value(sqlite3_vtab_cursor* cursor, sqlite3_context* context, int columnIndex) {
+                auto& c = *static_cast<cursor_type*>(cursor);
+                auto& rangeTable = *static_cast<vtab_type*>(c.pVtab)->rangeTable;
+                if(size_t(columnIndex) < rangeTable.columnResults.size()) {
+                    rangeTable.columnResults[columnIndex](rangeTable.table, context, c.view.data[c.current()]);
+                } else {
+                    //  the hidden column of the range
+                    sqlite3_result_null(context);
+                }
+                return SQLITE_OK;
+            }
+
+            using column_result_fn = void (*)(const table_type& table, sqlite3_context* context, const object_type&);
+
+            template<size_t I>
+            static void column_result(const table_type& table, sqlite3_context* context, const object_type& object) {
+                auto& column = std::get<I>(table.elements);
+                using field_type = field_type_t<std::decay_t<decltype(column)>>;
+                statement_binder<field_type>().result(context, polyfill::invoke(column.member_pointer, object));
+            }
+
+            /**
+             *  Functions returning the value of a column, indexed by the column's number in the virtual table.
+             */
+            template<size_t... Idx>
+            static std::vector<column_result_fn> make_column_results(std::index_sequence<Idx...>) {
+                return {&column_result<Idx>...};
+            }
+
+            static int row_id(sqlite3_vtab_cursor* cursor, sqlite3_int64* rowid) {
+                *rowid = sqlite3_int64(static_cast<cursor_type*>(cursor)->current());
+                return SQLITE_OK;
+            }
+
+            const std::vector<column_result_fn> columnResults;
+            int columnsCount = 0;
+            int keyColumn = -1;
+            int openCursorsCount = 0;
+            //  positions of the objects of each range (data and size) ordered by key, built on the first key lookup
+            std::map<std::pair<const object_type*, size_t>, std::shared_ptr<const key_order_type>> keyOrders;
+        };
+    }
+}
+#endif
+
+// #include "index_advisor.h"
+
+#include <sqlite3.h>
+#include <algorithm>  //  std::find, std::find_if
+#include <memory>  //  std::unique_ptr
+#include <set>  //  std::set
+#include <string>  //  std::string, std::to_string
+#include <type_traits>  //  std::integral_constant
+#include <utility>  //  std::pair, std::move
+#include <vector>  //  std::vector
+
+// #include "error_code.h"
+
+// #include "util.h"
+
+// #include "statement_finalizer.h"
+
+namespace sqlite_orm {
+
+    /**
+     *  An index recommended by `storage.advise_indexes()`.
+     */
+    struct index_advice {
+        std::string table;
+        std::vector<std::string> columns;
+
+        /**
+         *  `CREATE INDEX` statement.
+         */
+        std::string sql;
+
+        /**
+         *  The same index as a `make_index()` call, e.g. `make_index("idx_users_name", &T::name)`,
+         *  where `T` stands for the type mapped to `table` and members are named after the columns.
+         */
+        std::string definition;
+
+        /**
+         *  Recorded statements which scan `table` without the index.
+         */
+        std::vector<std::string> queries;
+    };
+
+    namespace internal {
+
+        /**
+         *  Recommends indexes for queries the way the `.expert` command of the sqlite3 shell does:
+         *  the schema of the database is copied into an empty in-memory database where candidate indexes
+         *  on the columns each query reads are tried with `EXPLAIN QUERY PLAN`. Without data and statistics
+         *  the planner uses an index whenever it can constrain the lookup, so an index is recommended if it
+         *  turns a full table scan or an automatic index into a search. Candidates are extended column by column
+         *  as long as the planner uses more of them, which yields composite indexes.
+         */
+        struct index_advisor {
+
+            explicit index_advisor(sqlite3* db) {
+                sqlite3* scratchDb = nullptr;
+                int rc = sqlite3_open(":memory:", &scratchDb);
+                this->scratch.reset(scratchDb);
+                if(rc != SQLITE_OK) {
+                    throw_translated_sqlite_error(scratchDb);
+                }
+                sqlite3_stmt* stmt = prepare_stmt(db,
+                                                  "SELECT sql FROM sqlite_master WHERE sql IS NOT NULL ORDER BY CASE "
+                                                  "type WHEN 'table' THEN 0 WHEN 'index' THEN 1 ELSE 2 END");
+                statement_finalizer finalizer{stmt};
+                while(sqlite3_step(stmt) == SQLITE_ROW) {
+                    //  objects which can't be copied (internal tables, virtual tables of unknown modules) are
+                    //  skipped, queries using them are skipped later
+                    sqlite3_exec(this->scratch.get(),
+                                 reinterpret_cast<const char*>(sqlite3_column_text(stmt, 0)),
+                                 nullptr,
+                                 nullptr,
+                                 nullptr);
+                }
+            }
+
+            std::vector<index_advice> advise(const std::vector<std::string>& queries) {
+                std::vector<index_advice> result;
+                for(auto& query: queries) {
+                    for(auto& index: this->advise(query)) {
+                        auto it = std::find_if(result.begin(), result.end(), [&index](const index_advice& advice) {
+                            return advice.table == index.first && advice.columns == index.second;
+                        });
+                        if(it == result.end()) {
+                            result.push_back(make_advice(index.first, index.second));
+                            it = result.end() - 1;
+                        }
+                        it->queries.push_back(query);
+                    }
+                }
+                return result;
+            }
+
+          private:
+            using table_column = std::pair<std::string, std::string>;
+            using index_columns = std::pair<std::string, std::vector<std::string>>;
+
+            struct plan_t {
+                bool valid = false;
+                std::vector<std::string> details;
+            };
+
+            /**
+             *  Indexes needed by `query`, picked greedily: every round keeps the candidate removing the most full
+             *  scans until no candidate helps anymore.
+             */
+            std::vector<index_columns> advise(const std::string& query) {
+                std::vector<index_columns> result;
+                auto plan = this->explain(query);
+                if(!plan.valid) {
+                    return result;
+                }
+                int score = scan_score(plan);
+                if(!score) {
+                    return result;
+                }
+                auto readColumns = this->read_columns(query);
+                std::vector<std::string> keptIndexes;
+                while(score) {
+                    const table_column* best = nullptr;
+                    int bestScore = score;
+                    int terms = 0;
+                    for(auto& readColumn: readColumns) {
+                        auto alreadyIndexed = [&readColumn](const index_columns& index) {
+                            return index.first == readColumn.first;
+                        };
+                        if(std::find_if(result.begin(), result.end(), alreadyIndexed) != result.end()) {
+                            continue;
+                        }
+                        int trialScore = 0;
+                        int trialTerms = this->try_index(query, readColumn.first, {readColumn.second}, &trialScore);
+                        //  equality columns go first
+                        if(trialTerms &&
+                           (trialScore < bestScore || (best && trialScore == bestScore && trialTerms > terms))) {
+                            best = &readColumn;
+                            bestScore = trialScore;
+                            terms = trialTerms;
+                        }
+                    }
+                    if(!best) {
+                        break;
+                    }
+                    std::vector<std::string> columns{best->second};
+                    for(bool extended = true; extended;) {
+                        extended = false;
+                        for(auto& readColumn: readColumns) {
+                            if(readColumn.first != best->first ||
+                               std::find(columns.begin(), columns.end(), readColumn.second) != columns.end()) {
+                                continue;
+                            }
+                            auto candidate = columns;
+                            candidate.push_back(readColumn.second);
+                            int trialScore = 0;
+                            int candidateTerms = this->try_index(query, best->first, candidate, &trialScore);
+                            if(candidateTerms > terms && trialScore <= bestScore) {
+                                columns = std::move(candidate);
+                                terms = candidateTerms;
+                                extended = true;
+                            }
+                        }
+                    }
+                    //  kept while looking for indexes on the other tables of the query
+                    keptIndexes.push_back("advised_index_" + std::to_string(keptIndexes.size()));
+                    this->create_index(keptIndexes.back(), best->first, columns);
+                    result.emplace_back(best->first, std::move(columns));
+                    score = bestScore;
+                }
+                for(auto& indexName: keptIndexes) {
+                    this->drop_index(indexName);
+                }
+                return result;
+            }
+
+            plan_t explain(const std::string& query) {
+                plan_t result;
+                sqlite3_stmt* stmt = nullptr;
+                std::string sql = "EXPLAIN QUERY PLAN " + query;
+                if(sqlite3_prepare_v2(this->scratch.get(), sql.c_str(), -1, &stmt, nullptr) != SQLITE_OK) {
+                    return result;
+                }
+                statement_finalizer finalizer{stmt};
+                while(sqlite3_step(stmt) == SQLITE_ROW) {
+                    result.details.emplace_back(reinterpret_cast<const char*>(sqlite3_column_text(stmt, 3)));
+                }
+                result.valid = true;
+                return result;
+            }
+
+            /**
+             *  Number of full table scans and automatic indexes in `plan`.
+             */
+            static int scan_score(const plan_t& plan) {
+                int result = 0;
+                for(auto& detail: plan.details) {
+                    bool fullScan = detail.compare(0, 5, "SCAN ") == 0 && detail.find(" INDEX") == detail.npos;
+                    if(fullScan || detail.find(" AUTOMATIC ") != detail.npos) {
+                        ++result;
+                    }
+                }
+                return result;
+            }
+
+            /**
+             *  How much of the index named `indexName` `plan` uses to constrain a lookup: every equality term
+             *  counts 2 and every range term 1, e.g. 3 for `SEARCH users USING INDEX idx (name=? AND age>?)`.
+             *  0 if the index isn't used as a constraint.
+             */
+            static int used_terms(const plan_t& plan, const std::string& indexName) {
+                for(auto& detail: plan.details) {
+                    auto begin = detail.find("INDEX " + indexName + " (");
+                    if(begin == detail.npos) {
+                        continue;
+                    }
+                    begin = detail.find('(', begin) + 1;
+                    auto terms = detail.substr(begin, detail.find(')', begin) - begin);
+                    int result = 0;
+                    for(size_t pos = 0; pos != terms.npos;) {
+                        auto end = terms.find(" AND ", pos);
+                        auto term = terms.substr(pos, end == terms.npos ? terms.npos : end - pos);
+                        bool equality = term.find("=?") != term.npos && term.find(">=?") == term.npos &&
+                                        term.find("<=?") == term.npos;
+                        result += equality ? 2 : 1;
+                        pos = end == terms.npos ? end : end + 5;
+                    }
+                    return result;
+                }
+                return 0;
+            }
+
+            /**
+             *  Creates a trial index and returns the number of its terms `query` uses as constraints. 0 if it
+             *  can't be created or isn't used.
+             */
+            int try_index(const std::string& query,
+                          const std::string& table,
+                          const std::vector<std::string>& columns,
+                          int* score) {
+                static const std::string trialIndexName = "advised_index_trial";
+                if(!this->create_index(trialIndexName, table, columns)) {
+                    return 0;
+                }
+                auto plan = this->explain(query);
+                this->drop_index(trialIndexName);
+                if(score) {
+                    *score = scan_score(plan);
+                }
+                return used_terms(plan, trialIndexName);
+            }
+
+            bool create_index(const std::string& indexName,
+                              const std::string& table,
+                              const std::vector<std::string>& columns) {
+                std::string sql = index_sql(indexName, table, columns);
+                return sqlite3_exec(this->scratch.get(), sql.c_str(), nullptr, nullptr, nullptr) == SQLITE_OK;
+            }
+
+            void drop_index(const std::string& indexName) {
+                perform_void_exec(this->scratch.get(), "DROP INDEX IF EXISTS " + quote_identifier(indexName));
+            }
+
+            /**
+             *  Table columns read by `query`, collected with an authorizer while it is being prepared.
+             */
+            std::set<table_column> read_columns(const std::string& query) {
+                std::set<table_column> result;
+                sqlite3_set_authorizer(
+                    this->scratch.get(),
+                    [](void* data, int action, const char* table, const char* column, const char*, const char*) {
+                        if(action == SQLITE_READ && table && column && *column) {
+                            static_cast<std::set<table_column>*>(data)->emplace(table, column);
+                        }
+                        return SQLITE_OK;
+                    },
+                    &result);
+                sqlite3_stmt* stmt = nullptr;
+                sqlite3_prepare_v2(this->scratch.get(), query.c_str(), -1, &stmt, nullptr);
+                sqlite3_finalize(stmt);
+                sqlite3_set_authorizer(this->scratch.get(), nullptr, nullptr);
+                return result;
+            }
+
+            static std::string
+            index_sql(const std::string& indexName, const std::string& table, const std::vector<std::string>& columns) {
+                std::string result = "CREATE INDEX " + quote_identifier(indexName) + " ON " + quote_identifier(table);
+                result += " (";
+                for(size_t i = 0; i < columns.size(); ++i) {
+                    if(i) {
+                        result += ", ";
+                    }
+                    result += quote_identifier(columns[i]);
+                }
+                result += ")";
+                return result;
+            }
+
+            static index_advice make_advice(const std::string& table, const std::vector<std::string>& columns) {
+                index_advice result;
+                result.table = table;
+                result.columns = columns;
+                std::string indexName = "idx_" + table;
+                for(auto& column: columns) {
+                    indexName += "_" + column;
+                }
+                result.sql = index_sql(indexName, table, columns);
+                result.definition = "make_index(\"" + indexName + "\"";
+                for(auto& column: columns) {
+                    result.definition += ", &T::" + column;
+                }
+                result.definition += ")";
+                return result;
+            }
+
+            using scratch_closer = std::integral_constant<decltype(&sqlite3_close), sqlite3_close>;
+            std::unique_ptr<sqlite3, scratch_closer> scratch;
+        };
+    }
+}
+
+// #include "index_info.h"
+
+#include <cctype>  //  std::isalnum, std::isspace, std::tolower
+#include <string>  //  std::string, std::char_traits
+#include <vector>  //  std::vector
+
+// #include "functional/cxx_universal.h"
+//  ::size_t
+
+namespace sqlite_orm {
+
+    namespace internal {
+
+        /**
+         *  Key column of an index like `PRAGMA index_xinfo` reports it.
+         */
+        struct index_key_column {
+            //  empty for an expression
+            std::string name;
+            bool desc = false;
+            std::string collation;
+
+            /**
+             *  An indexed expression normalized with `normalized_sql_expression()`, empty for a column.
+             */
+            std::string expression;
+        };
+
+        /**
+         *  Structure of an index which `sync_schema` compares to decide whether it has to be rebuilt.
+         */
+        struct index_structure {
+            bool unique = false;
+            std::vector<index_key_column> columns;
+
+            /**
+             *  Condition of a partial index normalized with `normalized_index_condition()`, empty for a full index.
+             */
+            std::string condition;
+        };
+
+        inline bool equal_ignoring_case(const std::string& lhs, const std::string& rhs) {
+            if(lhs.size() != rhs.size()) {
+                return false;
+            }
+            for(size_t i = 0; i < lhs.size(); ++i) {
+                if(std::tolower(static_cast<unsigned char>(lhs[i])) !=
+                   std::tolower(static_cast<unsigned char>(rhs[i]))) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        inline bool operator==(const index_key_column& lhs, const index_key_column& rhs) {
+            return equal_ignoring_case(lhs.name, rhs.name) && lhs.desc == rhs.desc &&
+                   equal_ignoring_case(lhs.collation, rhs.collation) && lhs.expression == rhs.expression;
+        }
+
+        inline bool operator==(const index_structure& lhs, const index_structure& rhs) {
+            return lhs.unique == rhs.unique && lhs.columns == rhs.columns && lhs.condition == rhs.condition;
+        }
+
+        inline bool operator!=(const index_structure& lhs, const index_structure& rhs) {
+            return !(lhs == rhs);
+        }
+
+        /**
+         *  Position right after the first occurrence of the keyword `keyword` (lowercase) in `sql` at parenthesis
+         *  depth `depth`, outside of string literals and quoted identifiers. `std::string::npos` if there is none.
+         */
+        inline size_t find_sql_keyword(const std::string& sql, const std::string& keyword, int depth = 0) {
+            char closingQuote = 0;
+            int currentDepth = 0;
+            std::string word;
+            for(size_t i = 0; i <= sql.size(); ++i) {
+                const char ch = i < sql.size() ? sql[i] : ' ';
+                if(closingQuote) {
+                    if(ch == closingQuote) {
+                        closingQuote = 0;
+                    }
+                    continue;
+                }
+                if(std::isalnum(static_cast<unsigned char>(ch)) || ch == '_') {
+                    word += char(std::tolower(static_cast<unsigned char>(ch)));
+                    continue;
+                }
+                if(word == keyword && currentDepth == depth) {
+                    return i;
+                }
+                word.clear();
+                switch(ch) {
+                    case '\'':
+                    case '"':
+                    case '`':
+                        closingQuote = ch;
+                        break;
+                    case '[':
+                        closingQuote = ']';
+                        break;
+                    case '(':
+                        ++currentDepth;
+                        break;
+                    case ')':
+                        --currentDepth;
+                        break;
+                }
+            }
+            return std::string::npos;
+        }
+
+        /**
+         *  `expression` in a form independent of formatting: whitespace and identifier quotes are removed and
+         *  keywords lowercased outside of string literals, and parentheses enclosing the whole expression are
+         *  dropped.
+         */
+        inline std::string normalized_sql_expression(const std::string& expression) {
+            std::string res;
+            bool inLiteral = false;
+            for(char ch: expression) {
+                if(ch == '\'') {
+                    inLiteral = !inLiteral;
+                }
+                if(inLiteral || ch == '\'') {
+                    res += ch;
+                } else if(!std::isspace(static_cast<unsigned char>(ch)) && ch != '"' && ch != '`' && ch != '[' &&
+                          ch != ']') {
+                    res += char(std::tolower(static_cast<unsigned char>(ch)));
+                }
+            }
+            //  drop parentheses around the whole expression, but not those of e.g. `(a) or (b)`
+            while(res.size() >= 2 && res.front() == '(' && res.back() == ')') {
+                int depth = 0;
+                bool enclosing = true;
+                bool literal = false;
+                for(size_t i = 0; i + 1 < res.size() && enclosing; ++i) {
+                    if(res[i] == '\'') {
+                        literal = !literal;
+                    } else if(!literal && res[i] == '(') {
+                        ++depth;
+                    } else if(!literal && res[i] == ')') {
+                        enclosing = --depth > 0;
+                    }
+                }
+                if(!enclosing) {
+                    break;
+                }
+                res = res.substr(1, res.size() - 2);
+            }
+            return res;
+        }
+
+        /**
+         *  Condition of the WHERE clause of a CREATE INDEX statement normalized with `normalized_sql_expression()`.
+         *  Empty if there is no WHERE clause.
+         */
+        inline std::string normalized_index_condition(const std::string& sql) {
+            const size_t wherePosition = find_sql_keyword(sql, "where");
+            if(wherePosition == std::string::npos) {
+                return {};
+            }
+            return normalized_sql_expression(sql.substr(wherePosition));
+        }
+
+        /**
+         *  Key columns and expressions listed by a CREATE INDEX statement, without their COLLATE and ASC/DESC
+         *  suffixes and normalized with `normalized_sql_expression()`.
+         */
+        inline std::vector<std::string> normalized_index_keys(const std::string& sql) {
+            std::vector<std::string> res;
+            const size_t onPosition = find_sql_keyword(sql, "on");
+            if(onPosition == std::string::npos) {
+                return res;
+            }
+            const size_t listStart = sql.find('(', onPosition);
+            if(listStart == std::string::npos) {
+                return res;
+            }
+            //  split the list at the commas between its elements
+            std::vector<std::string> elements(1);
+            char closingQuote = 0;
+            int depth = 1;
+            for(size_t i = listStart + 1; i < sql.size() && depth; ++i) {
+                const char ch = sql[i];
+                if(closingQuote) {
+                    closingQuote = ch == closingQuote ? 0 : closingQuote;
+                } else if(ch == '\'' || ch == '"' || ch == '`') {
+                    closingQuote = ch;
+                } else if(ch == '[') {
+                    closingQuote = ']';
+                } else if(ch == '(') {
+                    ++depth;
+                } else if(ch == ')' && --depth == 0) {
+                    break;
+                } else if(ch == ',' && depth == 1) {
+                    elements.emplace_back();
+                    continue;
+                }
+                elements.back() += ch;
+            }
+            for(auto& element: elements) {
+                for(const char* suffix: {"collate", "asc", "desc"}) {
+                    const size_t suffixEnd = find_sql_keyword(element, suffix);
+                    if(suffixEnd != std::string::npos) {
+                        element.resize(suffixEnd - std::char_traits<char>::length(suffix));
+                    }
+                }
+                res.push_back(normalized_sql_expression(element));
+            }
+            return res;
+        }
+    }
+}
+
+namespace sqlite_orm {
+
+    namespace internal {
+
+        struct storage_base {
+            using collating_function = std::function<int(int, const void*, int, const void*)>;
+
+            std::function<void(sqlite3*)> on_open;
+            pragma_t pragma;
+            limit_accessor limit;
+
+            transaction_guard_t transaction_guard() {
+                this->begin_transaction();
+                return {this->get_connection(),
+                        std::bind(&storage_base::commit, this),
+                        std::bind(&storage_base::rollback, this)};
+            }
+
+            transaction_guard_t deferred_transaction_guard() {
                 this->begin_deferred_transaction();
                 return {this->get_connection(),
                         std::bind(&storage_base::commit, this),
@@ -17701,6 +20447,33 @@ namespace sqlite_orm {
                         std::bind(&storage_base::rollback, this)};
             }
 
+            /**
+             *  Starts a savepoint and returns a guard for it. `commit()` releases the savepoint,
+             *  `rollback()` and the destructor roll back the changes made since the savepoint was started
+             *  and release it. Savepoints nest inside transactions and other savepoints; outside of a transaction
+             *  a savepoint behaves like `BEGIN DEFERRED TRANSACTION`.
+             *  More info: https://www.sqlite.org/lang_savepoint.html
+             */
+            transaction_guard_t savepoint(std::string name) {
+                this->begin_savepoint(name);
+                return {this->get_connection(),
+                        std::bind(&storage_base::release_savepoint, this, name),
+                        std::bind(&storage_base::rollback_to_savepoint, this, name)};
+            }
+
+            /**
+             *  Returns a guard for a unit of work that should be atomic without forcing its own commit:
+             *  inside a transaction it is a savepoint within the outer transaction, so many small units
+             *  share the outer transaction's single commit; otherwise it starts a transaction.
+             */
+            transaction_guard_t batch_scope() {
+                bool inTransaction = this->is_opened() && !sqlite3_get_autocommit(this->connection->get());
+                if(inTransaction) {
+                    return this->savepoint("sqlite_orm_batch");
+                }
+                return this->transaction_guard();
+            }
+
             void drop_index(const std::string& indexName) {
                 std::stringstream ss;
                 ss << "DROP INDEX " << quote_identifier(indexName) << std::flush;
@@ -17717,6 +20490,56 @@ namespace sqlite_orm {
                 perform_void_exec(this->get_connection().get(), "VACUUM");
             }
 
+#if SQLITE_VERSION_NUMBER >= 3027000
+            /**
+             *  Writes a vacuumed copy of the database into the file `filename`, which must not exist or be empty.
+             *  The database itself is left as is, so it is a way to make compact and defragmented snapshots.
+             *  https://www.sqlite.org/lang_vacuum.html#vacuuminto
+             */
+            void vacuum_into(const std::string& filename) {
+                perform_void_exec(this->get_connection().get(), "VACUUM INTO " + quote_string_literal(filename));
+            }
+#endif
+
+#if SQLITE_VERSION_NUMBER >= 3036000 && !defined(SQLITE_OMIT_DESERIALIZE)
+            /**
+             *  Returns the content of the database as it would be written to a file.
+             *  Only a database loaded with `deserialize()` lives in one contiguous buffer, which is copied directly.
+             *  Any other database, an ordinary in-memory one included, is serialized by SQLite into a temporary
+             *  buffer first, so the call costs two copies of the database.
+             */
+            std::vector<char> serialize() {
+                auto con = this->get_connection();
+                sqlite3_int64 size = 0;
+                auto data = reinterpret_cast<const char*>(
+                    sqlite3_serialize(con.get(), "main", &size, SQLITE_SERIALIZE_NOCOPY));
+                if(data) {
+                    return {data, data + size};
+                }
+                using buffer_ptr =
+                    std::unique_ptr<unsigned char, std::integral_constant<decltype(&sqlite3_free), sqlite3_free>>;
+                buffer_ptr copy{sqlite3_serialize(con.get(), "main", &size, 0)};
+                if(!copy) {
+                    throw_translated_sqlite_error(SQLITE_NOMEM);
+                }
+                auto copyData = reinterpret_cast<const char*>(copy.get());
+                return {copyData, copyData + size};
+            }
+
+            /**
+             *  Replaces the database with the content `data` previously returned by `serialize()` or read from a
+             *  database file. The content is copied once into memory owned by SQLite and the connection works with
+             *  it as with an in-memory database, so the storage keeps its connection open from now on. Cached objects
+             *  and query results are dropped.
+             *  @param readonly whether the deserialized database rejects writes; otherwise it grows as needed.
+             */
+            void deserialize(const std::vector<char>& data, bool readonly = false) {
+                this->open_forever();
+                this->deserialize_internal(data.data(), sqlite3_int64(data.size()), readonly);
+                this->clear_caches();
+            }
+#endif
+
             /**
              *  Drops table with given name.
              */
@@ -17733,9 +20556,19 @@ namespace sqlite_orm {
 
           protected:
             void rename_table(sqlite3* db, const std::string& oldName, const std::string& newName) const {
+                this->rename_table(db, std::string{}, oldName, newName);
+            }
+
+            /**
+             *  Renames a table of the database attached as `schemaName`, it stays in that database.
+             */
+            void rename_table(sqlite3* db,
+                              const std::string& schemaName,
+                              const std::string& oldName,
+                              const std::string& newName) const {
                 std::stringstream ss;
-                ss << "ALTER TABLE " << streaming_identifier(oldName) << " RENAME TO " << streaming_identifier(newName)
-                   << std::flush;
+                ss << "ALTER TABLE " << streaming_identifier(schemaName, oldName, std::string{}) << " RENAME TO "
+                   << streaming_identifier(newName) << std::flush;
                 perform_void_exec(db, ss.str());
             }
 
@@ -17750,9 +20583,17 @@ namespace sqlite_orm {
             }
 
             bool table_exists(sqlite3* db, const std::string& tableName) const {
+                return this->table_exists(db, std::string{}, tableName);
+            }
+
+            /**
+             *  Checks whether table exists in the database attached as `schemaName`, the main database if it is empty.
+             */
+            bool table_exists(sqlite3* db, const std::string& schemaName, const std::string& tableName) const {
                 bool result = false;
                 std::stringstream ss;
-                ss << "SELECT COUNT(*) FROM sqlite_master WHERE type = " << quote_string_literal("table")
+                ss << "SELECT COUNT(*) FROM " << streaming_identifier(schemaName, "sqlite_master", std::string{})
+                   << " WHERE type = " << quote_string_literal("table")
                    << " AND name = " << quote_string_literal(tableName) << std::flush;
                 perform_exec(
                     db,
@@ -17768,6 +20609,111 @@ namespace sqlite_orm {
                 return result;
             }
 
+            void record_query(const std::string& sql) {
+                if(this->recordingQueries &&
+                   std::find(this->recordedQueries.begin(), this->recordedQueries.end(), sql) ==
+                       this->recordedQueries.end()) {
+                    this->recordedQueries.push_back(sql);
+                }
+            }
+
+            /**
+             *  SQL text of the index with name `indexName` from sqlite_master of the database attached as `schemaName`
+             *  (the main database if it is empty) or an empty string if there is no such index.
+             */
+            std::string index_sql(sqlite3* db, const std::string& schemaName, const std::string& indexName) const {
+                std::string result;
+                std::stringstream ss;
+                ss << "SELECT sql FROM " << streaming_identifier(schemaName, "sqlite_master", std::string{})
+                   << " WHERE type = " << quote_string_literal("index")
+                   << " AND name = " << quote_string_literal(indexName) << std::flush;
+                perform_exec(
+                    db,
+                    ss.str(),
+                    [](void* data, int argc, char** argv, char** /*azColName*/) -> int {
+                        auto& res = *(std::string*)data;
+                        if(argc && argv[0]) {
+                            res = argv[0];
+                        }
+                        return 0;
+                    },
+                    &result);
+                return result;
+            }
+
+            /**
+             *  Structure of the index named `indexName` on table `tableName` of the database attached as
+             *  `schemaName` (the main database if it is empty), read with `PRAGMA index_list` and
+             *  `PRAGMA index_xinfo`. Returns false if there is no such index.
+             */
+            bool read_index_structure(sqlite3* db,
+                                      const std::string& schemaName,
+                                      const std::string& tableName,
+                                      const std::string& indexName,
+                                      index_structure& result) const {
+                const std::string pragmaPrefix =
+                    "PRAGMA " + (schemaName.empty() ? std::string{} : quote_identifier(schemaName) + ".");
+                struct index_list_row {
+                    const std::string& indexName;
+                    bool found = false;
+                    bool unique = false;
+                    bool partial = false;
+                } listRow{indexName};
+                perform_exec(
+                    db,
+                    pragmaPrefix + "index_list(" + quote_identifier(tableName) + ")",
+                    [](void* data, int argc, char** argv, char** /*columnName*/) -> int {
+                        auto& row = *static_cast<index_list_row*>(data);
+                        //  seq, name, unique, origin, partial
+                        if(argc >= 3 && argv[1] && row.indexName == argv[1]) {
+                            row.found = true;
+                            row.unique = argv[2] && std::atoi(argv[2]) != 0;
+                            row.partial = argc >= 5 && argv[4] && std::atoi(argv[4]) != 0;
+                        }
+                        return 0;
+                    },
+                    &listRow);
+                if(!listRow.found) {
+                    return false;
+                }
+                result.unique = listRow.unique;
+                result.columns.clear();
+                perform_exec(
+                    db,
+                    pragmaPrefix + "index_xinfo(" + quote_identifier(indexName) + ")",
+                    [](void* data, int argc, char** argv, char** /*columnName*/) -> int {
+                        auto& columns = *static_cast<std::vector<index_key_column>*>(data);
+                        //  seqno, cid, name, desc, coll, key
+                        if(argc >= 6 && argv[5] && std::atoi(argv[5]) != 0) {
+                            index_key_column column;
+                            column.name = argv[2] ? argv[2] : "";
+                            column.desc = argv[3] && std::atoi(argv[3]) != 0;
+                            column.collation = argv[4] ? argv[4] : "";
+                            columns.push_back(std::move(column));
+                        }
+                        return 0;
+                    },
+                    &result.columns);
+                //  no pragma reports indexed expressions or the condition of a partial index, they are taken from
+                //  the index's SQL
+                const bool hasExpressions =
+                    std::any_of(result.columns.begin(), result.columns.end(), [](const index_key_column& column) {
+                        return column.name.empty();
+                    });
+                const std::string sql =
+                    hasExpressions || listRow.partial ? this->index_sql(db, schemaName, indexName) : std::string{};
+                if(hasExpressions) {
+                    auto keys = normalized_index_keys(sql);
+                    for(size_t i = 0; i < result.columns.size() && i < keys.size(); ++i) {
+                        if(result.columns[i].name.empty()) {
+                            result.columns[i].expression = std::move(keys[i]);
+                        }
+                    }
+                }
+                result.condition = listRow.partial ? normalized_index_condition(sql) : "";
+                return true;
+            }
+
             void add_generated_cols(std::vector<const table_xinfo*>& columnsToAdd,
                                     const std::vector<table_xinfo>& storageTableInfo) {
                 //  iterate through storage columns
@@ -17812,9 +20758,64 @@ namespace sqlite_orm {
                 return sqlite3_libversion();
             }
 
+            /**
+             *  Runs `f` inside a transaction which is committed if `f` returns true and rolled back otherwise.
+             *  If a retry policy is set with `retry_on_busy()`, the whole transaction is started over
+             *  when any of its statements or the commit fails with SQLITE_BUSY (including SQLITE_BUSY_SNAPSHOT in WAL mode).
+             */
             bool transaction(const std::function<bool()>& f) {
-                auto guard = this->transaction_guard();
-                return guard.commit_on_destroy = f();
+                if(this->retryPolicy.max_attempts <= 1) {
+                    auto guard = this->transaction_guard();
+                    return guard.commit_on_destroy = f();
+                }
+                for(int attempt = 1;; ++attempt) {
+                    try {
+                        auto guard = this->transaction_guard();
+                        const bool shouldCommit = f();
+                        if(shouldCommit) {
+                            try {
+                                guard.commit();
+                            } catch(const std::system_error&) {
+                                //  a failed commit leaves the transaction open
+                                this->rollback();
+                                throw;
+                            }
+                        }
+                        return shouldCommit;
+                    } catch(const std::system_error& e) {
+                        if(e.code() != make_error_code(sqlite_errc(SQLITE_BUSY)) ||
+                           attempt >= this->retryPolicy.max_attempts) {
+                            throw;
+                        }
+                        ++this->retryStats.transaction_retries;
+                        this->sleep_before_retry(attempt);
+                    }
+                }
+            }
+
+            /**
+             *  Sets a policy for dealing with SQLITE_BUSY: locks are waited for by a busy handler with exponential
+             *  backoff and jitter, and `transaction(f)` is started over as a whole on busy conflicts.
+             *  The policy is applied every time the connection is opened and replaces `busy_timeout()`;
+             *  a handler set with `busy_handler()` takes precedence over it.
+             *  Pass a policy with `max_attempts = 1` to switch retrying off.
+             */
+            void retry_on_busy(busy_retry_policy policy) {
+                this->retryPolicy = policy;
+                if(this->is_opened() && !this->_busy_handler) {
+                    this->register_retry_policy(this->connection->get());
+                }
+            }
+
+            /**
+             *  Returns counters of retries performed due to the policy set with `retry_on_busy()`.
+             */
+            sqlite_orm::busy_retry_stats busy_retry_stats() const {
+                return this->retryStats;
+            }
+
+            void reset_busy_retry_stats() {
+                this->retryStats = {};
             }
 
             std::string current_time() {
@@ -18143,6 +21144,49 @@ namespace sqlite_orm {
                 this->create_collation(ss.str(), {});
             }
 
+            /**
+             *  Attaches the database file `filename` under the name `schemaName`. Tables of the attached database are
+             *  mapped with `make_table(...).in_schema(schemaName)` and can be joined with tables of the main database.
+             *  The database is attached right away if the connection is open and to every connection the storage opens
+             *  later on. Attaching another file under the same name replaces the previous attachment.
+             *  Note: ATTACH doesn't work inside of a transaction.
+             */
+            void attach(const std::string& filename, const std::string& schemaName) {
+                auto it = std::find_if(this->attachedDatabases.begin(),
+                                       this->attachedDatabases.end(),
+                                       [&schemaName](const std::pair<std::string, std::string>& attachment) {
+                                           return attachment.first == schemaName;
+                                       });
+                if(this->connection->retain_count() > 0) {
+                    sqlite3* db = this->connection->get();
+                    if(it != this->attachedDatabases.end()) {
+                        detach_database(db, schemaName);
+                    }
+                    attach_database(db, filename, schemaName);
+                }
+                if(it != this->attachedDatabases.end()) {
+                    it->second = filename;
+                } else {
+                    this->attachedDatabases.emplace_back(schemaName, filename);
+                }
+            }
+
+            /**
+             *  Detaches the database attached as `schemaName` and stops attaching it to new connections.
+             */
+            void detach(const std::string& schemaName) {
+                if(this->connection->retain_count() > 0) {
+                    detach_database(this->connection->get(), schemaName);
+                }
+                this->attachedDatabases.erase(
+                    std::remove_if(this->attachedDatabases.begin(),
+                                   this->attachedDatabases.end(),
+                                   [&schemaName](const std::pair<std::string, std::string>& attachment) {
+                                       return attachment.first == schemaName;
+                                   }),
+                    this->attachedDatabases.end());
+            }
+
             void begin_transaction() {
                 this->begin_transaction_internal("BEGIN TRANSACTION");
             }
@@ -18177,6 +21221,32 @@ namespace sqlite_orm {
                 }
             }
 
+            void begin_savepoint(const std::string& name) {
+                std::stringstream ss;
+                ss << "SAVEPOINT " << streaming_identifier(name) << std::flush;
+                this->begin_transaction_internal(ss.str());
+            }
+
+            /**
+             *  Releases the most recent savepoint with the given name, committing it if it is the outermost one.
+             */
+            void release_savepoint(const std::string& name) {
+                std::stringstream ss;
+                ss << "RELEASE " << streaming_identifier(name) << std::flush;
+                this->end_savepoint_internal(ss.str());
+            }
+
+            /**
+             *  Rolls back the changes made since the most recent savepoint with the given name was started,
+             *  then releases it.
+             */
+            void rollback_to_savepoint(const std::string& name) {
+                std::stringstream ss;
+                ss << "ROLLBACK TO " << streaming_identifier(name) << "; RELEASE " << streaming_identifier(name)
+                   << std::flush;
+                this->end_savepoint_internal(ss.str());
+            }
+
             void backup_to(const std::string& filename) {
                 auto backup = this->make_backup_to(filename);
                 backup.step(-1);
@@ -18185,16 +21255,19 @@ namespace sqlite_orm {
             void backup_to(storage_base& other) {
                 auto backup = this->make_backup_to(other);
                 backup.step(-1);
+                other.clear_caches();
             }
 
             void backup_from(const std::string& filename) {
                 auto backup = this->make_backup_from(filename);
                 backup.step(-1);
+                this->clear_caches();
             }
 
             void backup_from(storage_base& other) {
                 auto backup = this->make_backup_from(other);
                 backup.step(-1);
+                this->clear_caches();
             }
 
             backup_t make_backup_to(const std::string& filename) {
@@ -18213,45 +21286,263 @@ namespace sqlite_orm {
                 return {this->get_connection(), "main", conRef, "main", std::move(holder)};
             }
 
-            backup_t make_backup_from(storage_base& other) {
-                return {this->get_connection(), "main", other.get_connection(), "main", {}};
+            backup_t make_backup_from(storage_base& other) {
+                return {this->get_connection(), "main", other.get_connection(), "main", {}};
+            }
+
+            const std::string& filename() const {
+                return this->connection->filename;
+            }
+
+            /**
+             *  Copies the database to the file `target` on a background thread while the storage stays usable.
+             *  Pages are copied in batches of `options.pages_per_step` with a pause of `options.sleep` in between,
+             *  so foreground readers and writers only wait for one batch at a time and the I/O bandwidth is capped.
+             *  A file database is read through a separate connection: if it is changed meanwhile the copy starts
+             *  over automatically, which `backup_progress::restarts` counts. An in-memory database is read through
+             *  the storage's connection and changes made through it are applied to the copy in place.
+             *  Threading: the background thread and the storage's users share that connection, which is safe only
+             *  in SQLite's serialized threading mode (the default, see `sqlite3_threadsafe()`) because SQLite then
+             *  serializes calls on the connection. The storage's destructor waits for running backups, so an
+             *  in-memory database stays open until they finish and the returned future may be dropped.
+             *  Busy or locked batches are retried after the pause.
+             *  @return a future which becomes ready when the copy is complete and rethrows its error if it failed.
+             */
+            std::future<void> start_backup(const std::string& target, backup_options options) {
+                //  an in-memory database keeps its connection open as long as the storage exists
+                connection_holder* memoryConnection = this->inMemory ? this->connection.get() : nullptr;
+                auto copy = [target, source = this->filename(), memoryConnection, options = std::move(options)]() {
+                    std::unique_ptr<connection_holder> sourceHolder;
+                    if(!memoryConnection) {
+                        sourceHolder = std::make_unique<connection_holder>(source);
+                    }
+                    connection_ref sourceRef{memoryConnection ? *memoryConnection : *sourceHolder};
+                    auto backup = [&target, &sourceRef] {
+                        auto holder = std::make_unique<connection_holder>(target);
+                        connection_ref conRef{*holder};
+                        return backup_t{conRef, "main", sourceRef, "main", std::move(holder)};
+                    }();
+                    backup_progress progress;
+                    int copiedPages = 0;
+                    while(true) {
+                        if(options.cancellation.is_cancelled()) {
+                            throw std::system_error{orm_error_code::backup_cancelled};
+                        }
+                        int rc = backup.step(options.pages_per_step);
+                        if(rc != SQLITE_OK && rc != SQLITE_DONE && rc != SQLITE_BUSY && rc != SQLITE_LOCKED) {
+                            throw_translated_sqlite_error(rc);
+                        }
+                        progress.remaining = backup.remaining();
+                        progress.pagecount = backup.pagecount();
+                        //  a successful batch always copies pages unless the copy started over
+                        if(rc == SQLITE_OK && progress.pagecount - progress.remaining <= copiedPages) {
+                            ++progress.restarts;
+                        }
+                        if(rc == SQLITE_OK || rc == SQLITE_DONE) {
+                            copiedPages = progress.pagecount - progress.remaining;
+                        }
+                        if(options.on_progress) {
+                            options.on_progress(progress);
+                        }
+                        if(rc == SQLITE_DONE) {
+                            break;
+                        }
+                        std::this_thread::sleep_for(options.sleep);
+                    }
+                };
+                //  the storage holds the task so that its destructor can wait for it and so that dropping the
+                //  returned future doesn't block the caller until the copy is complete
+                this->backups.erase(std::remove_if(this->backups.begin(),
+                                                   this->backups.end(),
+                                                   [](const std::future<void>& task) {
+                                                       return task.wait_for(std::chrono::seconds{0}) ==
+                                                              std::future_status::ready;
+                                                   }),
+                                    this->backups.end());
+                std::promise<void> promise;
+                auto result = promise.get_future();
+                this->backups.push_back(
+                    std::async(std::launch::async, [copy = std::move(copy), promise = std::move(promise)]() mutable {
+                        try {
+                            copy();
+                            promise.set_value();
+                        } catch(...) {
+                            promise.set_exception(std::current_exception());
+                        }
+                    }));
+                return result;
+            }
+
+            /**
+             * Checks whether connection to database is opened right now.
+             * Returns always `true` for in memory databases.
+             */
+            bool is_opened() const {
+                return this->connection->retain_count() > 0;
+            }
+
+            /*
+             * returning false when there is a transaction in place
+             * otherwise true; function is not const because it has to call get_connection()
+             */
+            bool get_autocommit() {
+                auto con = this->get_connection();
+                return sqlite3_get_autocommit(con.get());
+            }
+
+            int busy_handler(std::function<int(int)> handler) {
+                _busy_handler = std::move(handler);
+                if(this->is_opened()) {
+                    if(_busy_handler) {
+                        return sqlite3_busy_handler(this->connection->get(), busy_handler_callback, this);
+                    } else {
+                        return sqlite3_busy_handler(this->connection->get(), nullptr, nullptr);
+                    }
+                } else {
+                    return SQLITE_OK;
+                }
+            }
+
+            /**
+             *  Removes all callbacks registered with `on_change()` and `on_preupdate()`.
+             */
+            void clear_change_callbacks() {
+                this->changeCallbacks.clear();
+#ifdef SQLITE_ENABLE_PREUPDATE_HOOK
+                this->preupdateCallbacks.clear();
+#endif
+                if(this->is_opened()) {
+                    this->register_change_hooks(this->connection->get());
+                }
+            }
+
+            sqlite_orm::query_cache_stats query_cache_stats() const {
+                return this->queryCache.stats;
+            }
+
+            /**
+             *  Drops all results memoized by `cached(ttl).select(...)`.
+             */
+            void clear_query_cache() {
+                this->queryCache.clear();
+            }
+
+            /**
+             *  Sets the maximum number of results memoized by `cached(ttl).select(...)`, 256 by default.
+             */
+            void set_query_cache_capacity(size_t value) {
+                this->queryCache.set_capacity(value);
+            }
+
+            /**
+             *  Starts or stops recording the SQL of statements prepared from the DSL for `advise_indexes()`.
+             *  Meant for development and test runs: every distinct statement is kept until
+             *  `clear_recorded_queries()` is called.
+             */
+            void record_queries(bool value) {
+                this->recordingQueries = value;
+            }
+
+            const std::vector<std::string>& recorded_queries() const {
+                return this->recordedQueries;
+            }
+
+            void clear_recorded_queries() {
+                this->recordedQueries.clear();
+            }
+
+            /**
+             *  Recommends indexes for the recorded statements which currently scan whole tables.
+             *  The schema of the database is copied into an in-memory database and candidate indexes are
+             *  tried there with `EXPLAIN QUERY PLAN`, so the database itself isn't modified and the result
+             *  doesn't depend on its data.
+             */
+            std::vector<index_advice> advise_indexes() {
+                auto con = this->get_connection();
+                internal::index_advisor advisor{con.get()};
+                return advisor.advise(this->recordedQueries);
             }
 
-            const std::string& filename() const {
-                return this->connection->filename;
+            /**
+             *  Interrupts the statement currently running on the storage's connection, if any.
+             *  Can be called from another thread; the interrupted statement fails with SQLITE_INTERRUPT.
+             */
+            void interrupt() {
+                if(this->is_opened()) {
+                    sqlite3_interrupt(this->connection->get());
+                }
             }
 
             /**
-             * Checks whether connection to database is opened right now.
-             * Returns always `true` for in memory databases.
+             *  Calls `f` and interrupts any statement it runs once `timeout` has elapsed.
+             *  Throws `std::system_error{orm_error_code::deadline_exceeded}` in this case, the connection remains usable.
+             *  Nested calls are bounded by the earliest deadline.
+             *  @example: auto users = storage.with_deadline(std::chrono::milliseconds{50}, [&storage] {
+             *      return storage.get_all<User>();
+             *  });
              */
-            bool is_opened() const {
-                return this->connection->retain_count() > 0;
+            template<class F>
+            auto with_deadline(std::chrono::steady_clock::duration timeout, F&& f) -> decltype(f()) {
+                interrupt_scope scope{*this, std::chrono::steady_clock::now() + timeout, nullptr};
+                return this->call_interruptible(std::forward<F>(f));
             }
 
-            /*
-             * returning false when there is a transaction in place
-             * otherwise true; function is not const because it has to call get_connection()
+            /**
+             *  Calls `f` and interrupts any statement it runs as soon as `token` gets cancelled from another thread.
+             *  Throws `std::system_error{orm_error_code::query_cancelled}` in this case, the connection remains usable.
              */
-            bool get_autocommit() {
-                auto con = this->get_connection();
-                return sqlite3_get_autocommit(con.get());
+            template<class F>
+            auto with_cancellation(const cancellation_token& token, F&& f) -> decltype(f()) {
+                interrupt_scope scope{*this, std::chrono::steady_clock::time_point::max(), &token};
+                return this->call_interruptible(std::forward<F>(f));
             }
 
-            int busy_handler(std::function<int(int)> handler) {
-                _busy_handler = std::move(handler);
+#if SQLITE_VERSION_NUMBER >= 3014000
+            /**
+             *  Registers a trace callback using `sqlite3_trace_v2`.
+             *  `mask` is a combination of SQLITE_TRACE_STMT, SQLITE_TRACE_PROFILE, SQLITE_TRACE_ROW and SQLITE_TRACE_CLOSE.
+             *  The callback is kept by the storage and registered again every time the connection is reopened.
+             *  Pass an empty callback or zero mask to remove it.
+             *  The callback must not throw: it runs inside SQLite while statements are stepped, reset or finalized
+             *  and while the connection closes, where an exception can't be propagated, so one escaping the callback
+             *  calls `std::terminate()`.
+             *  Use `slow_query_logger` as a callback to log statements exceeding a duration threshold.
+             */
+            int on_trace(unsigned int mask, std::function<void(const trace_event&)> callback) {
+                this->traceCallback = std::move(callback);
+                this->traceMask = this->traceCallback ? mask : 0;
                 if(this->is_opened()) {
-                    if(_busy_handler) {
-                        return sqlite3_busy_handler(this->connection->get(), busy_handler_callback, this);
-                    } else {
-                        return sqlite3_busy_handler(this->connection->get(), nullptr, nullptr);
-                    }
+                    return this->register_trace(this->connection->get());
                 } else {
                     return SQLITE_OK;
                 }
             }
+#endif
 
           protected:
+#if SQLITE_VERSION_NUMBER >= 3036000 && !defined(SQLITE_OMIT_DESERIALIZE)
+            void deserialize_internal(const char* data, sqlite3_int64 size, bool readonly) {
+                auto con = this->get_connection();
+                auto buffer = static_cast<char*>(sqlite3_malloc64(sqlite3_uint64(size ? size : 1)));
+                if(!buffer) {
+                    throw_translated_sqlite_error(SQLITE_NOMEM);
+                }
+                std::copy(data, data + size, buffer);
+                unsigned int flags = SQLITE_DESERIALIZE_FREEONCLOSE |
+                                     (readonly ? SQLITE_DESERIALIZE_READONLY : SQLITE_DESERIALIZE_RESIZEABLE);
+                //  the buffer is freed by SQLite even if this fails
+                int rc = sqlite3_deserialize(con.get(),
+                                             "main",
+                                             reinterpret_cast<unsigned char*>(buffer),
+                                             size,
+                                             size,
+                                             flags);
+                if(rc != SQLITE_OK) {
+                    throw_translated_sqlite_error(con.get());
+                }
+            }
+#endif
+
             storage_base(std::string filename, int foreignKeysCount) :
                 pragma(std::bind(&storage_base::get_connection, this)),
                 limit(std::bind(&storage_base::get_connection, this)),
@@ -18265,10 +21556,20 @@ namespace sqlite_orm {
             }
 
             storage_base(const storage_base& other) :
+                storage_base{other, other.connection->filename, other.attachedDatabases} {}
+
+            /**
+             *  Copy of `other` connecting to `filename` and attaching `attachedDatabases` instead of the databases
+             *  of `other`.
+             */
+            storage_base(const storage_base& other,
+                         std::string filename,
+                         std::vector<std::pair<std::string, std::string>> attachedDatabases) :
                 on_open(other.on_open), pragma(std::bind(&storage_base::get_connection, this)),
-                limit(std::bind(&storage_base::get_connection, this)), inMemory(other.inMemory),
-                connection(std::make_unique<connection_holder>(other.connection->filename)),
-                cachedForeignKeysCount(other.cachedForeignKeysCount) {
+                limit(std::bind(&storage_base::get_connection, this)),
+                inMemory(filename.empty() || filename == ":memory:"),
+                connection(std::make_unique<connection_holder>(std::move(filename))),
+                cachedForeignKeysCount(other.cachedForeignKeysCount), attachedDatabases(std::move(attachedDatabases)) {
                 if(this->inMemory) {
                     this->connection->retain();
                     this->on_open_internal(this->connection->get());
@@ -18276,6 +21577,12 @@ namespace sqlite_orm {
             }
 
             ~storage_base() {
+                for(auto& backup: this->backups) {
+                    backup.wait();
+                }
+                if(this->dataVersionStatement) {
+                    sqlite3_finalize(this->dataVersionStatement);
+                }
                 if(this->isOpenedForever) {
                     this->connection->release();
                 }
@@ -18293,6 +21600,15 @@ namespace sqlite_orm {
                 perform_void_exec(db, query);
             }
 
+            void end_savepoint_internal(const std::string& query) {
+                sqlite3* db = this->connection->get();
+                perform_void_exec(db, query);
+                this->connection->release();
+                if(this->connection->retain_count() < 0) {
+                    throw std::system_error{orm_error_code::no_active_transaction};
+                }
+            }
+
             connection_ref get_connection() {
                 connection_ref res{*this->connection};
                 if(1 == this->connection->retain_count()) {
@@ -18341,8 +21657,26 @@ namespace sqlite_orm {
                     sqlite3_limit(db, p.first, p.second);
                 }
 
+                for(auto& attachment: this->attachedDatabases) {
+                    attach_database(db, attachment.second, attachment.first);
+                }
+
                 if(_busy_handler) {
                     sqlite3_busy_handler(this->connection->get(), busy_handler_callback, this);
+                } else if(this->retryPolicy.max_attempts > 1) {
+                    this->register_retry_policy(db);
+                }
+
+#if SQLITE_VERSION_NUMBER >= 3014000
+                if(this->traceMask) {
+                    this->register_trace(db);
+                }
+#endif
+
+                this->register_change_hooks(db);
+
+                if(this->interruptScopesCount) {
+                    sqlite3_progress_handler(db, progressHandlerOpcodes, progress_handler_callback, this);
                 }
 
                 for(auto& udfProxy: this->scalarFunctions) {
@@ -18353,6 +21687,12 @@ namespace sqlite_orm {
                     try_to_create_aggregate_function(db, udfProxy);
                 }
 
+#if SQLITE_VERSION_NUMBER >= 3020000
+                for(auto& p: this->rangeTables) {
+                    register_range_table(db, p.first, *p.second);
+                }
+#endif
+
                 if(this->on_open) {
                     this->on_open(db);
                 }
@@ -18439,101 +21779,493 @@ namespace sqlite_orm {
                 }
             }
 
-            void delete_function_impl(const std::string& name, std::list<udf_proxy>& functions) const {
-#if __cpp_lib_ranges >= 201911L
-                auto it = std::ranges::find(functions, name, &udf_proxy::name);
-#else
-                auto it = std::find_if(functions.begin(), functions.end(), [&name](auto& udfProxy) {
-                    return udfProxy.name == name;
-                });
-#endif
-                if(it != functions.end()) {
-                    if(this->connection->retain_count() > 0) {
-                        sqlite3* db = this->connection->get();
-                        int rc = sqlite3_create_function_v2(db,
-                                                            name.c_str(),
-                                                            it->argumentsCount,
-                                                            SQLITE_UTF8,
-                                                            nullptr,
-                                                            nullptr,
-                                                            nullptr,
-                                                            nullptr,
-                                                            nullptr);
-                        if(rc != SQLITE_OK) {
-                            throw_translated_sqlite_error(db);
-                        }
-                    }
-                    it = functions.erase(it);
-                } else {
-                    throw std::system_error{orm_error_code::function_not_found};
+            void delete_function_impl(const std::string& name, std::list<udf_proxy>& functions) const {
+#if __cpp_lib_ranges >= 201911L
+                auto it = std::ranges::find(functions, name, &udf_proxy::name);
+#else
+                auto it = std::find_if(functions.begin(), functions.end(), [&name](auto& udfProxy) {
+                    return udfProxy.name == name;
+                });
+#endif
+                if(it != functions.end()) {
+                    if(this->connection->retain_count() > 0) {
+                        sqlite3* db = this->connection->get();
+                        int rc = sqlite3_create_function_v2(db,
+                                                            name.c_str(),
+                                                            it->argumentsCount,
+                                                            SQLITE_UTF8,
+                                                            nullptr,
+                                                            nullptr,
+                                                            nullptr,
+                                                            nullptr,
+                                                            nullptr);
+                        if(rc != SQLITE_OK) {
+                            throw_translated_sqlite_error(db);
+                        }
+                    }
+                    it = functions.erase(it);
+                } else {
+                    throw std::system_error{orm_error_code::function_not_found};
+                }
+            }
+
+            static void try_to_create_scalar_function(sqlite3* db, udf_proxy& udfProxy) {
+                int rc = sqlite3_create_function_v2(db,
+                                                    udfProxy.name.c_str(),
+                                                    udfProxy.argumentsCount,
+                                                    SQLITE_UTF8,
+                                                    &udfProxy,
+                                                    udfProxy.func,
+                                                    nullptr,
+                                                    nullptr,
+                                                    nullptr);
+                if(rc != SQLITE_OK) {
+                    throw_translated_sqlite_error(db);
+                }
+            }
+
+            static void try_to_create_aggregate_function(sqlite3* db, udf_proxy& udfProxy) {
+                int rc = sqlite3_create_function(db,
+                                                 udfProxy.name.c_str(),
+                                                 udfProxy.argumentsCount,
+                                                 SQLITE_UTF8,
+                                                 &udfProxy,
+                                                 nullptr,
+                                                 udfProxy.func,
+                                                 aggregate_function_final_callback);
+                if(rc != SQLITE_OK) {
+                    throw_translated_sqlite_error(rc);
+                }
+            }
+
+#if SQLITE_VERSION_NUMBER >= 3020000
+            static void register_range_table(sqlite3* db, const std::string& name, basic_range_table& rangeTable) {
+                int rc = sqlite3_create_module_v2(db, name.c_str(), &rangeTable.module, &rangeTable, nullptr);
+                if(rc != SQLITE_OK) {
+                    throw_translated_sqlite_error(db);
+                }
+            }
+#endif
+
+            std::string current_time(sqlite3* db) {
+                std::string result;
+                perform_exec(db, "SELECT CURRENT_TIME", extract_single_value<std::string>, &result);
+                return result;
+            }
+
+            std::string current_date(sqlite3* db) {
+                std::string result;
+                perform_exec(db, "SELECT CURRENT_DATE", extract_single_value<std::string>, &result);
+                return result;
+            }
+
+            std::string current_timestamp(sqlite3* db) {
+                std::string result;
+                perform_exec(db, "SELECT CURRENT_TIMESTAMP", extract_single_value<std::string>, &result);
+                return result;
+            }
+
+            static void attach_database(sqlite3* db, const std::string& filename, const std::string& schemaName) {
+                std::stringstream ss;
+                ss << "ATTACH DATABASE " << quote_string_literal(filename) << " AS " << streaming_identifier(schemaName)
+                   << std::flush;
+                perform_void_exec(db, ss.str());
+            }
+
+            static void detach_database(sqlite3* db, const std::string& schemaName) {
+                std::stringstream ss;
+                ss << "DETACH DATABASE " << streaming_identifier(schemaName) << std::flush;
+                perform_void_exec(db, ss.str());
+            }
+
+            void drop_table_internal(sqlite3* db, const std::string& tableName) {
+                this->drop_table_internal(db, std::string{}, tableName);
+            }
+
+            void drop_table_internal(sqlite3* db, const std::string& schemaName, const std::string& tableName) {
+                std::stringstream ss;
+                ss << "DROP TABLE " << streaming_identifier(schemaName, tableName, std::string{}) << std::flush;
+                perform_void_exec(db, ss.str());
+                //  rows of a dropped table aren't reported by the update hook
+                this->clear_caches();
+            }
+
+            static int collate_callback(void* arg, int leftLen, const void* lhs, int rightLen, const void* rhs) {
+                auto& f = *(collating_function*)arg;
+                return f(leftLen, lhs, rightLen, rhs);
+            }
+
+            static int busy_handler_callback(void* selfPointer, int triesCount) {
+                auto& storage = *static_cast<storage_base*>(selfPointer);
+                if(storage._busy_handler) {
+                    return storage._busy_handler(triesCount);
+                } else {
+                    return 0;
+                }
+            }
+
+            /**
+             *  Activates a deadline and/or a cancellation token for the lifetime of the scope.
+             *  The progress handler is registered only as long as there is an active scope.
+             */
+            struct interrupt_scope {
+                interrupt_scope(storage_base& storage,
+                                std::chrono::steady_clock::time_point deadline,
+                                const cancellation_token* token) :
+                    storage(storage),
+                    previousDeadline(storage.deadline), hasToken(token != nullptr) {
+                    storage.deadline = (std::min)(storage.deadline, deadline);
+                    if(token) {
+                        storage.cancellationTokens.push_back(*token);
+                    }
+                    if(1 == ++storage.interruptScopesCount && storage.is_opened()) {
+                        sqlite3_progress_handler(storage.connection->get(),
+                                                 progressHandlerOpcodes,
+                                                 progress_handler_callback,
+                                                 &storage);
+                    }
+                }
+
+                ~interrupt_scope() {
+                    if(0 == --this->storage.interruptScopesCount && this->storage.is_opened()) {
+                        sqlite3_progress_handler(this->storage.connection->get(), 0, nullptr, nullptr);
+                    }
+                    if(this->hasToken) {
+                        this->storage.cancellationTokens.pop_back();
+                    }
+                    this->storage.deadline = this->previousDeadline;
+                }
+
+                interrupt_scope(const interrupt_scope&) = delete;
+                interrupt_scope& operator=(const interrupt_scope&) = delete;
+
+              private:
+                storage_base& storage;
+                std::chrono::steady_clock::time_point previousDeadline;
+                bool hasToken;
+            };
+
+            template<class F>
+            auto call_interruptible(F&& f) -> decltype(f()) {
+                try {
+                    return f();
+                } catch(const std::system_error& e) {
+                    if(e.code() != make_error_code(sqlite_errc(SQLITE_INTERRUPT))) {
+                        throw;
+                    }
+                    if(this->is_cancelled()) {
+                        throw std::system_error{orm_error_code::query_cancelled};
+                    }
+                    if(std::chrono::steady_clock::now() >= this->deadline) {
+                        throw std::system_error{orm_error_code::deadline_exceeded};
+                    }
+                    throw;
+                }
+            }
+
+            bool is_cancelled() const {
+                return std::any_of(this->cancellationTokens.begin(),
+                                   this->cancellationTokens.end(),
+                                   [](const cancellation_token& token) {
+                                       return token.is_cancelled();
+                                   });
+            }
+
+            static int progress_handler_callback(void* selfPointer) {
+                auto& storage = *static_cast<storage_base*>(selfPointer);
+                return storage.is_cancelled() || std::chrono::steady_clock::now() >= storage.deadline;
+            }
+
+#if SQLITE_VERSION_NUMBER >= 3014000
+            int register_trace(sqlite3* db) {
+                if(this->traceMask) {
+                    return sqlite3_trace_v2(db, this->traceMask, trace_callback, this);
+                } else {
+                    return sqlite3_trace_v2(db, 0, nullptr, nullptr);
+                }
+            }
+
+            //  noexcept: an exception must not unwind through SQLite's frames
+            static int trace_callback(unsigned int type, void* selfPointer, void* p, void* x) noexcept {
+                auto& storage = *static_cast<storage_base*>(selfPointer);
+                trace_event event;
+                event.type = type;
+                switch(type) {
+                    case SQLITE_TRACE_STMT:
+                        event.stmt = static_cast<sqlite3_stmt*>(p);
+                        event.sql = static_cast<const char*>(x);
+                        break;
+                    case SQLITE_TRACE_PROFILE:
+                        event.stmt = static_cast<sqlite3_stmt*>(p);
+                        event.nanoseconds = *static_cast<sqlite3_int64*>(x);
+                        break;
+                    case SQLITE_TRACE_ROW:
+                        event.stmt = static_cast<sqlite3_stmt*>(p);
+                        break;
+                    case SQLITE_TRACE_CLOSE:
+                        event.db = static_cast<sqlite3*>(p);
+                        break;
+                }
+                if(event.stmt) {
+                    event.db = sqlite3_db_handle(event.stmt);
+                }
+                storage.traceCallback(event);
+                return 0;
+            }
+#endif
+
+            using change_callback = std::function<void(int operation, int64 rowid)>;
+            using preupdate_callback = std::function<void(sqlite3* db, int operation, int64 oldRowid, int64 newRowid)>;
+
+            /**
+             *  Key of a table in the maps of change callbacks and object caches and in the query cache:
+             *  `schema.table`, the way the update hook reports tables, so that tables with the same name
+             *  in attached databases are told apart. An empty schema name stands for the main database.
+             */
+            static std::string change_key(const std::string& schemaName, const std::string& tableName) {
+                std::string key = schemaName.empty() ? "main" : schemaName;
+                key += '.';
+                key += tableName;
+                return key;
+            }
+
+            template<class Callbacks, class F>
+            void set_change_callback(Callbacks& callbacks, const std::string& tableKey, F callback) {
+                if(callback) {
+                    callbacks[tableKey] = std::move(callback);
+                } else {
+                    callbacks.erase(tableKey);
+                }
+                if(this->is_opened()) {
+                    this->register_change_hooks(this->connection->get());
+                }
+            }
+
+            void rename_change_callbacks(const std::string& oldKey, const std::string& newKey) {
+                auto it = this->changeCallbacks.find(oldKey);
+                if(it != this->changeCallbacks.end()) {
+                    auto callback = std::move(it->second);
+                    this->changeCallbacks.erase(it);
+                    this->changeCallbacks[newKey] = std::move(callback);
+                }
+                auto cacheIt = this->objectCaches.find(oldKey);
+                if(cacheIt != this->objectCaches.end()) {
+                    auto cache = std::move(cacheIt->second);
+                    this->objectCaches.erase(cacheIt);
+                    this->objectCaches[newKey] = std::move(cache);
+                }
+#ifdef SQLITE_ENABLE_PREUPDATE_HOOK
+                auto preIt = this->preupdateCallbacks.find(oldKey);
+                if(preIt != this->preupdateCallbacks.end()) {
+                    auto callback = std::move(preIt->second);
+                    this->preupdateCallbacks.erase(preIt);
+                    this->preupdateCallbacks[newKey] = std::move(callback);
+                }
+#endif
+            }
+
+            void register_change_hooks(sqlite3* db) {
+                if(!this->changeCallbacks.empty() || !this->objectCaches.empty() || this->queryCache.enabled) {
+                    sqlite3_update_hook(db, update_hook_callback, this);
+                } else {
+                    sqlite3_update_hook(db, nullptr, nullptr);
+                }
+#ifdef SQLITE_ENABLE_PREUPDATE_HOOK
+                if(!this->preupdateCallbacks.empty()) {
+                    sqlite3_preupdate_hook(db, preupdate_hook_callback, this);
+                } else {
+                    sqlite3_preupdate_hook(db, nullptr, nullptr);
+                }
+#endif
+            }
+
+            static void update_hook_callback(void* selfPointer,
+                                             int operation,
+                                             const char* dbName,
+                                             const char* tableName,
+                                             int64 rowid) {
+                auto& storage = *static_cast<storage_base*>(selfPointer);
+                try {
+                    //  SQLite passes names rather than table identities, so every event costs one string hash per
+                    //  map; reuse the key's buffer so that a lookup doesn't allocate
+                    storage.changeHookKey.assign(dbName).append(1, '.').append(tableName);
+                    storage.table_changed(rowid);
+                    auto it = storage.changeCallbacks.find(storage.changeHookKey);
+                    if(it != storage.changeCallbacks.end()) {
+                        it->second(operation, rowid);
+                    }
+                } catch(...) {
+                    storage.change_hook_failed();
+                }
+            }
+
+            /**
+             *  Exceptions must not unwind through SQLite's frames, so the hooks keep the first one thrown
+             *  while a statement runs and `perform_change_step()` rethrows it once the statement is done.
+             */
+            void change_hook_failed() {
+                if(!this->changeHookError) {
+                    this->changeHookError = std::current_exception();
+                }
+            }
+
+            void rethrow_change_hook_error() {
+                if(this->changeHookError) {
+                    std::rethrow_exception(std::exchange(this->changeHookError, nullptr));
                 }
             }
 
-            static void try_to_create_scalar_function(sqlite3* db, udf_proxy& udfProxy) {
-                int rc = sqlite3_create_function_v2(db,
-                                                    udfProxy.name.c_str(),
-                                                    udfProxy.argumentsCount,
-                                                    SQLITE_UTF8,
-                                                    &udfProxy,
-                                                    udfProxy.func,
-                                                    nullptr,
-                                                    nullptr,
-                                                    nullptr);
-                if(rc != SQLITE_OK) {
-                    throw_translated_sqlite_error(db);
+            /**
+             *  Steps a statement which inserts, updates or deletes rows and rethrows the first exception thrown by
+             *  a change callback meanwhile. The change itself isn't undone.
+             */
+            void perform_change_step(sqlite3_stmt* stmt) {
+                this->changeHookError = nullptr;
+                perform_step(stmt);
+                this->rethrow_change_hook_error();
+            }
+
+            /**
+             *  Invalidates cached data of the table named `changeHookKey`.
+             */
+            void table_changed(int64 rowid) {
+                auto cacheIt = this->objectCaches.find(this->changeHookKey);
+                if(cacheIt != this->objectCaches.end()) {
+                    cacheIt->second->invalidate(rowid);
+                }
+                if(this->queryCache.enabled) {
+                    this->queryCache.table_changed(this->changeHookKey);
                 }
             }
 
-            static void try_to_create_aggregate_function(sqlite3* db, udf_proxy& udfProxy) {
-                int rc = sqlite3_create_function(db,
-                                                 udfProxy.name.c_str(),
-                                                 udfProxy.argumentsCount,
-                                                 SQLITE_UTF8,
-                                                 &udfProxy,
-                                                 nullptr,
-                                                 udfProxy.func,
-                                                 aggregate_function_final_callback);
-                if(rc != SQLITE_OK) {
-                    throw_translated_sqlite_error(rc);
+            /**
+             *  Called after all rows of a table might have been deleted without the update hook being invoked
+             *  (truncate optimization).
+             */
+            void table_truncated(const std::string& tableKey) {
+                auto cacheIt = this->objectCaches.find(tableKey);
+                if(cacheIt != this->objectCaches.end()) {
+                    cacheIt->second->clear();
+                }
+                if(this->queryCache.enabled) {
+                    this->queryCache.table_changed(tableKey);
                 }
             }
 
-            std::string current_time(sqlite3* db) {
-                std::string result;
-                perform_exec(db, "SELECT CURRENT_TIME", extract_single_value<std::string>, &result);
-                return result;
+            /**
+             *  Called after a REPLACE into the table, see `basic_object_cache::rows_replaced()`.
+             */
+            void rows_replaced(const std::string& tableKey) {
+                auto cacheIt = this->objectCaches.find(tableKey);
+                if(cacheIt != this->objectCaches.end()) {
+                    cacheIt->second->rows_replaced();
+                }
             }
 
-            std::string current_date(sqlite3* db) {
-                std::string result;
-                perform_exec(db, "SELECT CURRENT_DATE", extract_single_value<std::string>, &result);
-                return result;
+            /**
+             *  Called after a raw REPLACE, whose table isn't known.
+             */
+            void rows_replaced() {
+                for(auto& cache: this->objectCaches) {
+                    cache.second->rows_replaced();
+                }
             }
 
-            std::string current_timestamp(sqlite3* db) {
-                std::string result;
-                perform_exec(db, "SELECT CURRENT_TIMESTAMP", extract_single_value<std::string>, &result);
-                return result;
+            /**
+             *  Caches are used only when the connection outlives single calls,
+             *  otherwise changes made by others in between could not be detected.
+             */
+            bool connection_kept_open() const {
+                return this->inMemory || this->isOpenedForever;
             }
 
-            void drop_table_internal(sqlite3* db, const std::string& tableName) {
-                std::stringstream ss;
-                ss << "DROP TABLE " << streaming_identifier(tableName) << std::flush;
-                perform_void_exec(db, ss.str());
+            /**
+             *  Drops all cached objects and query results if another connection has committed changes
+             *  since the last check.
+             */
+            void validate_caches(sqlite3* db) {
+                if(this->inMemory) {
+                    return;
+                }
+                if(!this->dataVersionStatement) {
+                    if(sqlite3_prepare_v2(db, "PRAGMA data_version", -1, &this->dataVersionStatement, nullptr) !=
+                       SQLITE_OK) {
+                        throw_translated_sqlite_error(db);
+                    }
+                }
+                if(sqlite3_step(this->dataVersionStatement) != SQLITE_ROW) {
+                    sqlite3_reset(this->dataVersionStatement);
+                    throw_translated_sqlite_error(db);
+                }
+                auto version = sqlite3_column_int64(this->dataVersionStatement, 0);
+                sqlite3_reset(this->dataVersionStatement);
+                if(version != this->dataVersion) {
+                    this->clear_caches();
+                    this->dataVersion = version;
+                }
             }
 
-            static int collate_callback(void* arg, int leftLen, const void* lhs, int rightLen, const void* rhs) {
-                auto& f = *(collating_function*)arg;
-                return f(leftLen, lhs, rightLen, rhs);
+            /**
+             *  Drops all cached objects and query results after changes the update hook doesn't report,
+             *  like dropped tables or a database overwritten by a backup.
+             */
+            void clear_caches() {
+                for(auto& cache: this->objectCaches) {
+                    cache.second->clear();
+                }
+                this->queryCache.clear();
             }
 
-            static int busy_handler_callback(void* selfPointer, int triesCount) {
+#ifdef SQLITE_ENABLE_PREUPDATE_HOOK
+            static void preupdate_hook_callback(void* selfPointer,
+                                                sqlite3* db,
+                                                int operation,
+                                                const char* dbName,
+                                                const char* tableName,
+                                                int64 oldRowid,
+                                                int64 newRowid) {
                 auto& storage = *static_cast<storage_base*>(selfPointer);
-                if(storage._busy_handler) {
-                    return storage._busy_handler(triesCount);
+                try {
+                    storage.changeHookKey.assign(dbName).append(1, '.').append(tableName);
+                    auto it = storage.preupdateCallbacks.find(storage.changeHookKey);
+                    if(it != storage.preupdateCallbacks.end()) {
+                        it->second(db, operation, oldRowid, newRowid);
+                    }
+                } catch(...) {
+                    storage.change_hook_failed();
+                }
+            }
+#endif
+
+            static busy_retry_policy make_no_retry_policy() {
+                busy_retry_policy policy;
+                policy.max_attempts = 1;
+                return policy;
+            }
+
+            void register_retry_policy(sqlite3* db) {
+                if(this->retryPolicy.max_attempts > 1) {
+                    sqlite3_busy_handler(db, retry_policy_busy_callback, this);
                 } else {
+                    sqlite3_busy_handler(db, nullptr, nullptr);
+                }
+            }
+
+            void sleep_before_retry(int retry) {
+                std::uniform_real_distribution<double> distribution{0, 1};
+                auto delay = this->retryPolicy.backoff(retry, distribution(this->retryRandomEngine));
+                this->retryStats.wait_time += delay;
+                std::this_thread::sleep_for(delay);
+            }
+
+            static int retry_policy_busy_callback(void* selfPointer, int triesCount) {
+                auto& storage = *static_cast<storage_base*>(selfPointer);
+                if(triesCount + 1 >= storage.retryPolicy.max_attempts) {
                     return 0;
                 }
+                ++storage.retryStats.retries;
+                storage.sleep_before_retry(triesCount + 1);
+                return 1;
             }
 
             bool calculate_remove_add_columns(std::vector<const table_xinfo*>& columnsToAdd,
@@ -18585,9 +22317,41 @@ namespace sqlite_orm {
             std::unique_ptr<connection_holder> connection;
             std::map<std::string, collating_function> collatingFunctions;
             const int cachedForeignKeysCount;
+            //  schema name and file name of attached databases in the order they are attached
+            std::vector<std::pair<std::string, std::string>> attachedDatabases;
             std::function<int(int)> _busy_handler;
+            busy_retry_policy retryPolicy = make_no_retry_policy();
+            sqlite_orm::busy_retry_stats retryStats;
+            std::minstd_rand retryRandomEngine{
+                static_cast<std::minstd_rand::result_type>(std::chrono::steady_clock::now().time_since_epoch().count())};
+            unsigned int traceMask = 0;
+            std::function<void(const trace_event&)> traceCallback;
+            //  number of virtual machine instructions between checks of deadlines and cancellation tokens
+            static constexpr int progressHandlerOpcodes = 1000;
+            int interruptScopesCount = 0;
+            std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::time_point::max();
+            std::vector<cancellation_token> cancellationTokens;
+            //  the maps of callbacks and caches are keyed by `change_key(schema, table)`
+            std::unordered_map<std::string, change_callback> changeCallbacks;
+#ifdef SQLITE_ENABLE_PREUPDATE_HOOK
+            std::unordered_map<std::string, preupdate_callback> preupdateCallbacks;
+#endif
+            std::string changeHookKey;
+            std::exception_ptr changeHookError;
+            std::unordered_map<std::string, std::unique_ptr<basic_object_cache>> objectCaches;
+            query_cache queryCache;
+            bool recordingQueries = false;
+            std::vector<std::string> recordedQueries;
+            //  prepared once, the connection stays open while caches are in use
+            sqlite3_stmt* dataVersionStatement = nullptr;
+            int64 dataVersion = -1;
             std::list<udf_proxy> scalarFunctions;
+            //  backups started with start_backup running on background threads
+            std::vector<std::future<void>> backups;
             std::list<udf_proxy> aggregateFunctions;
+#if SQLITE_VERSION_NUMBER >= 3020000
+            std::map<std::string, std::unique_ptr<basic_range_table>> rangeTables;
+#endif
         };
     }
 }
@@ -18748,9 +22512,25 @@ namespace sqlite_orm {
 
 // #include "ast/rank.h"
 
+// #include "../core_functions.h"
+
 namespace sqlite_orm {
     namespace internal {
-        struct rank_t {};
+        /**
+         *  `rank` column of a FTS5 table, or RANK() window function if used with `over(...)`.
+         */
+        struct rank_t {
+            template<class... WArgs>
+            over_t<built_in_window_function_t<int, rank_string>, window_defn_t<WArgs...>> over(WArgs... args) const {
+                return {{{}}, {{std::forward<WArgs>(args)...}}};
+            }
+
+            template<class... WArgs>
+            over_t<built_in_window_function_t<int, rank_string>, window_ref_t>
+            over(const window_t<WArgs...>& window) const {
+                return {{{}}, {window.name}};
+            }
+        };
     }
 
     inline internal::rank_t rank() {
@@ -18778,6 +22558,8 @@ namespace sqlite_orm {
 
 // #include "pointer_value.h"
 
+// #include "range_source.h"
+
 // #include "type_printer.h"
 
 // #include "field_printer.h"
@@ -19324,110 +23106,252 @@ namespace sqlite_orm {
                 return quote_blob_literal(field_printer<std::vector<char>>{}(t));
             }
 
-#if SQLITE_VERSION_NUMBER >= 3020000
-            template<class P, class PT, class D>
-            std::string do_serialize(const pointer_binding<P, PT, D>&) const {
-                // always serialize null (security reasons)
-                return field_printer<nullptr_t>{}(nullptr);
+#if SQLITE_VERSION_NUMBER >= 3020000
+            template<class P, class PT, class D>
+            std::string do_serialize(const pointer_binding<P, PT, D>&) const {
+                // always serialize null (security reasons)
+                return field_printer<nullptr_t>{}(nullptr);
+            }
+#endif
+        };
+
+        template<class O, bool WithoutRowId, class... Cs>
+        struct statement_serializer<table_t<O, WithoutRowId, Cs...>, void> {
+            using statement_type = table_t<O, WithoutRowId, Cs...>;
+
+            template<class Ctx>
+            std::string operator()(const statement_type& statement, const Ctx& context) {
+                return this->serialize(statement, context, statement.name);
+            }
+
+            template<class Ctx>
+            auto serialize(const statement_type& statement, const Ctx& context, const std::string& tableName) {
+                std::stringstream ss;
+                ss << "CREATE TABLE " << streaming_identifier(statement.schema_name, tableName, std::string{}) << " ("
+                   << streaming_expressions_tuple(statement.elements, context) << ")";
+                if(statement_type::is_without_rowid_v) {
+                    ss << " WITHOUT ROWID";
+                }
+                return ss.str();
+            }
+        };
+
+        template<>
+        struct statement_serializer<current_time_t, void> {
+            using statement_type = current_time_t;
+
+            template<class Ctx>
+            std::string operator()(const statement_type& /*statement*/, const Ctx& /*context*/) {
+                return "CURRENT_TIME";
+            }
+        };
+
+        template<>
+        struct statement_serializer<current_date_t, void> {
+            using statement_type = current_date_t;
+
+            template<class Ctx>
+            std::string operator()(const statement_type& /*statement*/, const Ctx& /*context*/) {
+                return "CURRENT_DATE";
+            }
+        };
+
+        template<>
+        struct statement_serializer<current_timestamp_t, void> {
+            using statement_type = current_timestamp_t;
+
+            template<class Ctx>
+            std::string operator()(const statement_type& /*statement*/, const Ctx& /*context*/) {
+                return "CURRENT_TIMESTAMP";
+            }
+        };
+
+        template<class T, class X, class Y, class Z>
+        struct statement_serializer<highlight_t<T, X, Y, Z>, void> {
+            using statement_type = highlight_t<T, X, Y, Z>;
+
+            template<class Ctx>
+            std::string operator()(const statement_type& statement, const Ctx& context) {
+                std::stringstream ss;
+                auto& tableName = lookup_table_name<T>(context.db_objects);
+                ss << "HIGHLIGHT (" << streaming_identifier(tableName);
+                ss << ", " << serialize(statement.argument0, context);
+                ss << ", " << serialize(statement.argument1, context);
+                ss << ", " << serialize(statement.argument2, context) << ")";
+                return ss.str();
+            }
+        };
+
+        /**
+         *  Serializer for literal values.
+         */
+        template<class T>
+        struct statement_serializer<T, match_specialization_of<T, literal_holder>> {
+            using statement_type = T;
+
+            template<class Ctx>
+            std::string operator()(const statement_type& literal, const Ctx& context) const {
+                static_assert(is_bindable_v<type_t<statement_type>>, "A literal value must be also bindable");
+
+                Ctx literalCtx = context;
+                literalCtx.replace_bindable_with_question = false;
+                statement_serializer<type_t<statement_type>> serializer{};
+                return serializer(literal.value, literalCtx);
+            }
+        };
+
+        template<class F, class W>
+        struct statement_serializer<filtered_aggregate_function<F, W>, void> {
+            using statement_type = filtered_aggregate_function<F, W>;
+
+            template<class Ctx>
+            std::string operator()(const statement_type& statement, const Ctx& context) {
+                std::stringstream ss;
+                ss << serialize(statement.function, context);
+                ss << " FILTER (WHERE " << serialize(statement.where, context) << ")";
+                return ss.str();
+            }
+        };
+
+        template<class F, class W>
+        struct statement_serializer<over_t<F, W>, void> {
+            using statement_type = over_t<F, W>;
+
+            template<class Ctx>
+            std::string operator()(const statement_type& statement, const Ctx& context) const {
+                std::stringstream ss;
+                ss << serialize(statement.function, context) << " OVER " << serialize(statement.window, context);
+                return ss.str();
+            }
+        };
+
+        template<>
+        struct statement_serializer<window_ref_t, void> {
+            using statement_type = window_ref_t;
+
+            template<class Ctx>
+            std::string operator()(const statement_type& statement, const Ctx&) const {
+                std::stringstream ss;
+                ss << streaming_identifier(statement.name);
+                return ss.str();
+            }
+        };
+
+        template<class... Args>
+        struct statement_serializer<window_defn_t<Args...>, void> {
+            using statement_type = window_defn_t<Args...>;
+
+            template<class Ctx>
+            std::string operator()(const statement_type& statement, const Ctx& context) const {
+                std::stringstream ss;
+                ss << "(";
+                iterate_tuple(statement.args, [&ss, &context, first = true](auto& arg) mutable {
+                    constexpr std::array<const char*, 2> sep = {" ", ""};
+                    ss << sep[std::exchange(first, false)] << serialize(arg, context);
+                });
+                ss << ")";
+                return ss.str();
             }
-#endif
         };
 
-        template<class O, bool WithoutRowId, class... Cs>
-        struct statement_serializer<table_t<O, WithoutRowId, Cs...>, void> {
-            using statement_type = table_t<O, WithoutRowId, Cs...>;
+        template<class... Args>
+        struct statement_serializer<window_t<Args...>, void> {
+            using statement_type = window_t<Args...>;
 
             template<class Ctx>
-            std::string operator()(const statement_type& statement, const Ctx& context) {
-                return this->serialize(statement, context, statement.name);
+            std::string operator()(const statement_type& statement, const Ctx& context) const {
+                std::stringstream ss;
+                ss << "WINDOW " << streaming_identifier(statement.name) << " AS "
+                   << serialize(statement.definition, context);
+                return ss.str();
             }
+        };
+
+        template<class... Args>
+        struct statement_serializer<partition_by_t<Args...>, void> {
+            using statement_type = partition_by_t<Args...>;
 
             template<class Ctx>
-            auto serialize(const statement_type& statement, const Ctx& context, const std::string& tableName) {
+            std::string operator()(const statement_type& statement, const Ctx& context) const {
                 std::stringstream ss;
-                ss << "CREATE TABLE " << streaming_identifier(tableName) << " ("
-                   << streaming_expressions_tuple(statement.elements, context) << ")";
-                if(statement_type::is_without_rowid_v) {
-                    ss << " WITHOUT ROWID";
-                }
+                auto newContext = context;
+                newContext.skip_table_name = false;
+                ss << "PARTITION BY " << streaming_expressions_tuple(statement.args, newContext);
                 return ss.str();
             }
         };
 
-        template<>
-        struct statement_serializer<current_time_t, void> {
-            using statement_type = current_time_t;
+        template<class B, class E>
+        struct statement_serializer<frame_t<B, E>, void> {
+            using statement_type = frame_t<B, E>;
 
             template<class Ctx>
-            std::string operator()(const statement_type& /*statement*/, const Ctx& /*context*/) {
-                return "CURRENT_TIME";
+            std::string operator()(const statement_type& statement, const Ctx& context) const {
+                std::stringstream ss;
+                switch(statement.units) {
+                    case frame_units::rows:
+                        ss << "ROWS";
+                        break;
+                    case frame_units::range:
+                        ss << "RANGE";
+                        break;
+                    case frame_units::groups:
+                        ss << "GROUPS";
+                        break;
+                }
+                ss << " BETWEEN " << serialize(statement.start, context) << " AND "
+                   << serialize(statement.end, context);
+                return ss.str();
             }
         };
 
         template<>
-        struct statement_serializer<current_date_t, void> {
-            using statement_type = current_date_t;
+        struct statement_serializer<unbounded_preceding_t, void> {
+            using statement_type = unbounded_preceding_t;
 
             template<class Ctx>
-            std::string operator()(const statement_type& /*statement*/, const Ctx& /*context*/) {
-                return "CURRENT_DATE";
+            std::string operator()(const statement_type&, const Ctx&) const {
+                return "UNBOUNDED PRECEDING";
             }
         };
 
         template<>
-        struct statement_serializer<current_timestamp_t, void> {
-            using statement_type = current_timestamp_t;
+        struct statement_serializer<current_row_t, void> {
+            using statement_type = current_row_t;
 
             template<class Ctx>
-            std::string operator()(const statement_type& /*statement*/, const Ctx& /*context*/) {
-                return "CURRENT_TIMESTAMP";
+            std::string operator()(const statement_type&, const Ctx&) const {
+                return "CURRENT ROW";
             }
         };
 
-        template<class T, class X, class Y, class Z>
-        struct statement_serializer<highlight_t<T, X, Y, Z>, void> {
-            using statement_type = highlight_t<T, X, Y, Z>;
+        template<>
+        struct statement_serializer<unbounded_following_t, void> {
+            using statement_type = unbounded_following_t;
 
             template<class Ctx>
-            std::string operator()(const statement_type& statement, const Ctx& context) {
-                std::stringstream ss;
-                auto& tableName = lookup_table_name<T>(context.db_objects);
-                ss << "HIGHLIGHT (" << streaming_identifier(tableName);
-                ss << ", " << serialize(statement.argument0, context);
-                ss << ", " << serialize(statement.argument1, context);
-                ss << ", " << serialize(statement.argument2, context) << ")";
-                return ss.str();
+            std::string operator()(const statement_type&, const Ctx&) const {
+                return "UNBOUNDED FOLLOWING";
             }
         };
 
-        /**
-         *  Serializer for literal values.
-         */
         template<class T>
-        struct statement_serializer<T, match_specialization_of<T, literal_holder>> {
-            using statement_type = T;
+        struct statement_serializer<preceding_t<T>, void> {
+            using statement_type = preceding_t<T>;
 
             template<class Ctx>
-            std::string operator()(const statement_type& literal, const Ctx& context) const {
-                static_assert(is_bindable_v<type_t<statement_type>>, "A literal value must be also bindable");
-
-                Ctx literalCtx = context;
-                literalCtx.replace_bindable_with_question = false;
-                statement_serializer<type_t<statement_type>> serializer{};
-                return serializer(literal.value, literalCtx);
+            std::string operator()(const statement_type& statement, const Ctx& context) const {
+                return serialize(statement.expression, context) + " PRECEDING";
             }
         };
 
-        template<class F, class W>
-        struct statement_serializer<filtered_aggregate_function<F, W>, void> {
-            using statement_type = filtered_aggregate_function<F, W>;
+        template<class T>
+        struct statement_serializer<following_t<T>, void> {
+            using statement_type = following_t<T>;
 
             template<class Ctx>
-            std::string operator()(const statement_type& statement, const Ctx& context) {
-                std::stringstream ss;
-                ss << serialize(statement.function, context);
-                ss << " FILTER (WHERE " << serialize(statement.where, context) << ")";
-                return ss.str();
+            std::string operator()(const statement_type& statement, const Ctx& context) const {
+                return serialize(statement.expression, context) + " FOLLOWING";
             }
         };
 
@@ -19493,6 +23417,22 @@ namespace sqlite_orm {
             }
         };
 
+#if SQLITE_VERSION_NUMBER >= 3020000
+        template<class O>
+        struct statement_serializer<range_source_t<O>, void> {
+            using statement_type = range_source_t<O>;
+
+            template<class Ctx>
+            std::string operator()(const statement_type&, const Ctx& context) const {
+                std::stringstream ss;
+                ss << streaming_identifier(lookup_table_name<O>(context.db_objects)) << "."
+                   << streaming_identifier(range_source_column_name()) << " = "
+                   << (context.replace_bindable_with_question ? "?" : "NULL");
+                return ss.str();
+            }
+        };
+#endif
+
         template<char... C>
         struct statement_serializer<column_alias<C...>, void> {
             using statement_type = column_alias<C...>;
@@ -19553,6 +23493,10 @@ namespace sqlite_orm {
         struct statement_serializer<built_in_aggregate_function_t<R, S, Args...>, void>
             : statement_serializer<built_in_function_t<R, S, Args...>, void> {};
 
+        template<class R, class S, class... Args>
+        struct statement_serializer<built_in_window_function_t<R, S, Args...>, void>
+            : statement_serializer<built_in_function_t<R, S, Args...>, void> {};
+
         template<class F, class... CallArgs>
         struct statement_serializer<function_call<F, CallArgs...>, void> {
             using statement_type = function_call<F, CallArgs...>;
@@ -20420,7 +24364,7 @@ namespace sqlite_orm {
                 auto& table = pick_table<T>(context.db_objects);
 
                 std::stringstream ss;
-                ss << "DELETE FROM " << streaming_identifier(table.name)
+                ss << "DELETE FROM " << streaming_identifier(table_schema_name(table), table.name, std::string{})
                    << streaming_conditions_tuple(rem.conditions, context);
                 return ss.str();
             }
@@ -20435,8 +24379,8 @@ namespace sqlite_orm {
                 using object_type = expression_object_type_t<statement_type>;
                 auto& table = pick_table<object_type>(context.db_objects);
                 std::stringstream ss;
-                ss << "REPLACE INTO " << streaming_identifier(table.name) << " ("
-                   << streaming_non_generated_column_names(table) << ")"
+                ss << "REPLACE INTO " << streaming_identifier(table_schema_name(table), table.name, std::string{})
+                   << " (" << streaming_non_generated_column_names(table) << ")"
                    << " VALUES ("
                    << streaming_field_values_excluding(check_if<is_generated_always>{},
                                                        empty_callable<std::false_type>,  //  don't exclude
@@ -20458,7 +24402,8 @@ namespace sqlite_orm {
                 using object_type = expression_object_type_t<statement_type>;
                 auto& table = pick_table<object_type>(context.db_objects);
                 std::stringstream ss;
-                ss << "INSERT INTO " << streaming_identifier(table.name) << " ";
+                ss << "INSERT INTO " << streaming_identifier(table_schema_name(table), table.name, std::string{})
+                   << " ";
                 ss << "(" << streaming_mapped_columns_expressions(ins.columns.columns, context) << ") "
                    << "VALUES (";
                 iterate_tuple(ins.columns.columns,
@@ -20486,7 +24431,7 @@ namespace sqlite_orm {
                 auto& table = pick_table<object_type>(context.db_objects);
 
                 std::stringstream ss;
-                ss << "UPDATE " << streaming_identifier(table.name) << " SET ";
+                ss << "UPDATE " << streaming_identifier(table_schema_name(table), table.name, std::string{}) << " SET ";
                 table.template for_each_column_excluding<mpl::disjunction_fn<is_primary_key, is_generated_always>>(
                     [&table, &ss, &context, &object = get_ref(statement.object), first = true](auto& column) mutable {
                         if(exists_in_composite_primary_key(table, column)) {
@@ -20551,25 +24496,30 @@ namespace sqlite_orm {
             }
         };
 
+        /**
+         *  Collects the tables of the assigned columns, i.e. the table being updated.
+         *  The assigned values may refer to other tables by means of subqueries or `UPDATE ... FROM`.
+         */
         template<class Ctx, class... Args>
-        std::set<std::pair<std::string, std::string>> collect_table_names(const set_t<Args...>& set, const Ctx& ctx) {
+        table_name_collector_base collect_table_names(const set_t<Args...>& set, const Ctx& ctx) {
             auto collector = make_table_name_collector(ctx.db_objects);
-            iterate_ast(set, collector);
-            return std::move(collector.table_names);
+            iterate_tuple(set.assigns, [&collector](auto& assign) {
+                iterate_ast(assign.lhs, collector);
+            });
+            return std::move(collector);
         }
 
         template<class Ctx, class C>
-        const std::set<std::pair<std::string, std::string>>& collect_table_names(const dynamic_set_t<C>& set,
-                                                                                 const Ctx&) {
-            return set.collector.table_names;
+        const table_name_collector_base& collect_table_names(const dynamic_set_t<C>& set, const Ctx&) {
+            return set.collector;
         }
 
         template<class Ctx, class T, satisfies<is_select, T> = true>
-        std::set<std::pair<std::string, std::string>> collect_table_names(const T& sel, const Ctx& ctx) {
+        table_name_collector_base collect_table_names(const T& sel, const Ctx& ctx) {
             auto collector = make_table_name_collector(ctx.db_objects);
             iterate_ast(sel.col, collector);
             iterate_ast(sel.conditions, collector);
-            return std::move(collector.table_names);
+            return std::move(collector);
         }
 
         template<class S, class... Wargs>
@@ -20577,20 +24527,43 @@ namespace sqlite_orm {
             using statement_type = update_all_t<S, Wargs...>;
 
             template<class Ctx>
-            std::string operator()(const statement_type& statement, const Ctx& context) const {
-                const auto& tableNames = collect_table_names(statement.set, context);
-                if(tableNames.empty()) {
+            std::string operator()(const statement_type& statement, Ctx context) const {
+                const auto& tables = collect_table_names(statement.set, context);
+                if(tables.table_names.empty()) {
                     throw std::system_error{orm_error_code::no_tables_specified};
                 }
-                const std::string& tableName = tableNames.begin()->first;
+                const std::string& tableName = tables.table_names.begin()->first;
+                const std::string& schemaName = tables.table_schemas.at(*tables.table_names.begin());
+                // UPDATE ... FROM: columns of the updated table and of the joined tables must be told apart
+                if(tuple_has<typename statement_type::conditions_type, is_from>::value) {
+                    context.skip_table_name = false;
+                }
 
                 std::stringstream ss;
-                ss << "UPDATE " << streaming_identifier(tableName) << ' ' << serialize(statement.set, context)
+                ss << "UPDATE " << streaming_identifier(schemaName, tableName, std::string{}) << ' '
+                   << serialize(statement.set, context)
                    << streaming_conditions_tuple(statement.conditions, context);
                 return ss.str();
             }
         };
 
+#if SQLITE_VERSION_NUMBER >= 3035000
+        template<class S, class C>
+        struct statement_serializer<returning_t<S, C>, void> {
+            using statement_type = returning_t<S, C>;
+
+            template<class Ctx>
+            std::string operator()(const statement_type& statement, Ctx context) const {
+                std::stringstream ss;
+                ss << serialize(statement.statement, context);
+                // columns can only refer to the modified table, qualified names are not allowed
+                context.skip_table_name = true;
+                ss << " RETURNING " << streaming_serialized(get_column_names(statement.columns, context));
+                return ss.str();
+            }
+        };
+#endif
+
         template<class T>
         struct statement_serializer<insert_t<T>, void> {
             using statement_type = insert_t<T>;
@@ -20615,7 +24588,8 @@ namespace sqlite_orm {
                 const size_t columnNamesCount = columnNames.size();
 
                 std::stringstream ss;
-                ss << "INSERT INTO " << streaming_identifier(table.name) << " ";
+                ss << "INSERT INTO " << streaming_identifier(table_schema_name(table), table.name, std::string{})
+                   << " ";
                 if(columnNamesCount) {
                     ss << "(" << streaming_identifiers(columnNames) << ")";
                 } else {
@@ -20648,7 +24622,7 @@ namespace sqlite_orm {
                 auto& table = pick_table<T>(context.db_objects);
 
                 std::stringstream ss;
-                ss << "INTO " << streaming_identifier(table.name);
+                ss << "INTO " << streaming_identifier(table_schema_name(table), table.name, std::string{});
                 return ss.str();
             }
         };
@@ -20717,7 +24691,7 @@ namespace sqlite_orm {
             std::string operator()(const statement_type& statement, const Ctx& context) const {
                 auto& table = pick_table<T>(context.db_objects);
                 std::stringstream ss;
-                ss << "DELETE FROM " << streaming_identifier(table.name) << " "
+                ss << "DELETE FROM " << streaming_identifier(table_schema_name(table), table.name, std::string{}) << " "
                    << "WHERE ";
                 std::vector<std::string> idsStrings;
                 idsStrings.reserve(std::tuple_size<typename statement_type::ids_type>::value);
@@ -20748,8 +24722,8 @@ namespace sqlite_orm {
                 auto& table = pick_table<object_type>(context.db_objects);
 
                 std::stringstream ss;
-                ss << "REPLACE INTO " << streaming_identifier(table.name) << " ("
-                   << streaming_non_generated_column_names(table) << ")";
+                ss << "REPLACE INTO " << streaming_identifier(table_schema_name(table), table.name, std::string{})
+                   << " (" << streaming_non_generated_column_names(table) << ")";
                 const auto valuesCount = std::distance(rep.range.first, rep.range.second);
                 const auto columnsCount = table.template count_of_columns_excluding<is_generated_always>();
                 ss << " VALUES " << streaming_values_placeholders(columnsCount, valuesCount);
@@ -20782,7 +24756,8 @@ namespace sqlite_orm {
                 const size_t columnNamesCount = columnNames.size();
 
                 std::stringstream ss;
-                ss << "INSERT INTO " << streaming_identifier(table.name) << " ";
+                ss << "INSERT INTO " << streaming_identifier(table_schema_name(table), table.name, std::string{})
+                   << " ";
                 if(columnNamesCount) {
                     ss << "(" << streaming_identifiers(columnNames) << ")";
                 } else {
@@ -20807,7 +24782,8 @@ namespace sqlite_orm {
 
             std::stringstream ss;
             ss << "SELECT " << streaming_table_column_names(table, alias_extractor<table_type>::as_qualifier(table))
-               << " FROM " << streaming_identifier(table.name, alias_extractor<table_type>::as_alias())
+               << " FROM "
+               << streaming_identifier(table_schema_name(table), table.name, alias_extractor<table_type>::as_alias())
                << streaming_conditions_tuple(getAll.conditions, context);
             return ss.str();
         }
@@ -20850,7 +24826,7 @@ namespace sqlite_orm {
             auto& table = pick_table<primary_type>(context.db_objects);
             std::stringstream ss;
             ss << "SELECT " << streaming_table_column_names(table, std::string{}) << " FROM "
-               << streaming_identifier(table.name) << " WHERE ";
+               << streaming_identifier(table_schema_name(table), table.name, std::string{}) << " WHERE ";
 
             auto primaryKeyColumnNames = table.primary_key_column_names();
             if(primaryKeyColumnNames.empty()) {
@@ -20957,7 +24933,8 @@ namespace sqlite_orm {
                 using conditions_tuple = typename statement_type::conditions_type;
                 constexpr bool hasExplicitFrom = tuple_has<conditions_tuple, is_from>::value;
                 if(!hasExplicitFrom) {
-                    auto tableNames = collect_table_names(sel, context);
+                    auto tables = collect_table_names(sel, context);
+                    auto& tableNames = tables.table_names;
                     using joins_index_sequence = filter_tuple_sequence_t<conditions_tuple, is_constrained_join>;
                     // deduplicate table names of constrained join statements
                     iterate_tuple(sel.conditions, joins_index_sequence{}, [&tableNames, &context](auto& join) {
@@ -20969,10 +24946,40 @@ namespace sqlite_orm {
                         tableNames.erase(tableNameWithAlias);
                     });
                     if(!tableNames.empty() && !is_compound_operator<T>::value) {
-                        ss << " FROM " << streaming_identifiers(tableNames);
+                        // tables of attached databases are qualified with their schema
+                        std::vector<std::tuple<std::string, const std::string&, const std::string&>> identifiers;
+                        identifiers.reserve(tableNames.size());
+                        for(auto& tableName: tableNames) {
+                            identifiers.emplace_back(tables.table_schemas.at(tableName),
+                                                     tableName.first,
+                                                     tableName.second);
+                        }
+                        ss << " FROM " << streaming_identifiers(identifiers);
                     }
                 }
-                ss << streaming_conditions_tuple(sel.conditions, context);
+                if(tuple_has<conditions_tuple, is_window>::value) {
+                    //  the WINDOW clause goes between HAVING and ORDER BY, wherever the windows were passed
+                    auto serializeCondition = [&ss, &context](auto& condition) {
+                        ss << " " << serialize(condition, context);
+                    };
+                    iterate_tuple(sel.conditions,
+                                  filter_tuple_sequence_t<conditions_tuple, is_window_predecessor>{},
+                                  serializeCondition);
+                    //  all named windows make up one clause
+                    ss << " WINDOW ";
+                    iterate_tuple(sel.conditions,
+                                  filter_tuple_sequence_t<conditions_tuple, is_window>{},
+                                  [&ss, &context, first = true](auto& window) mutable {
+                                      constexpr std::array<const char*, 2> sep = {", ", ""};
+                                      ss << sep[std::exchange(first, false)] << streaming_identifier(window.name)
+                                         << " AS " << serialize(window.definition, context);
+                                  });
+                    iterate_tuple(sel.conditions,
+                                  filter_tuple_sequence_t<conditions_tuple, is_window_successor>{},
+                                  serializeCondition);
+                } else {
+                    ss << streaming_conditions_tuple(sel.conditions, context);
+                }
                 if(!is_compound_operator<T>::value) {
                     if(!sel.highest_level && context.use_parentheses) {
                         ss << ")";
@@ -21052,8 +25059,12 @@ namespace sqlite_orm {
                     ss << "UNIQUE ";
                 }
                 using indexed_type = typename std::decay_t<decltype(statement)>::table_mapped_type;
-                ss << "INDEX IF NOT EXISTS " << streaming_identifier(statement.name) << " ON "
-                   << streaming_identifier(lookup_table_name<indexed_type>(context.db_objects));
+                // an index lives in the schema of its table
+                ss << "INDEX IF NOT EXISTS "
+                   << streaming_identifier(lookup_table_schema<indexed_type>(context.db_objects),
+                                           statement.name,
+                                           std::string{})
+                   << " ON " << streaming_identifier(lookup_table_name<indexed_type>(context.db_objects));
                 std::vector<std::string> columnNames;
                 std::string whereString;
                 iterate_tuple(statement.elements, [&columnNames, &context, &whereString](auto& value) {
@@ -21088,8 +25099,10 @@ namespace sqlite_orm {
                     using table_type = std::remove_pointer_t<decltype(dummyItem)>;
 
                     constexpr std::array<const char*, 2> sep = {", ", ""};
+                    using mapped_type = mapped_type_proxy_t<table_type>;
                     ss << sep[std::exchange(first, false)]
-                       << streaming_identifier(lookup_table_name<mapped_type_proxy_t<table_type>>(context.db_objects),
+                       << streaming_identifier(lookup_table_schema<mapped_type>(context.db_objects),
+                                               lookup_table_name<mapped_type>(context.db_objects),
                                                alias_extractor<table_type>::as_alias());
                 });
                 return ss.str();
@@ -21321,7 +25334,9 @@ namespace sqlite_orm {
             std::string operator()(const statement_type& join, const Ctx& context) const {
                 std::stringstream ss;
                 ss << static_cast<std::string>(join) << " "
-                   << streaming_identifier(lookup_table_name<type_t<Join>>(context.db_objects));
+                   << streaming_identifier(lookup_table_schema<type_t<Join>>(context.db_objects),
+                                           lookup_table_name<type_t<Join>>(context.db_objects),
+                                           std::string{});
                 return ss.str();
             }
         };
@@ -21333,8 +25348,10 @@ namespace sqlite_orm {
             template<class Ctx>
             std::string operator()(const statement_type& join, const Ctx& context) const {
                 std::stringstream ss;
+                using mapped_type = mapped_type_proxy_t<type_t<Join>>;
                 ss << static_cast<std::string>(join) << " "
-                   << streaming_identifier(lookup_table_name<mapped_type_proxy_t<type_t<Join>>>(context.db_objects),
+                   << streaming_identifier(lookup_table_schema<mapped_type>(context.db_objects),
+                                           lookup_table_name<mapped_type>(context.db_objects),
                                            alias_extractor<type_t<Join>>::as_alias())
                    << " " << serialize(join.constraint, context);
                 return ss.str();
@@ -22006,8 +26023,40 @@ namespace sqlite_orm {
 
             storage_t(const storage_t&) = default;
 
+            /**
+             *  Returns an independent in-memory storage with the schema objects of this storage and a copy of its
+             *  database, which makes it cheap to create many fixtures from one prepared template.
+             *  The database is copied in one step: an image deserialized into memory is copied directly
+             *  from the contiguous memory holding it, any other database page by page with the backup API.
+             *  The clone is configured like a copy of this storage, except that only the main database is cloned:
+             *  databases attached with `attach()` are neither copied nor attached to the clone, so that writing to it
+             *  never changes the files of the template.
+             */
+            storage_t clone_in_memory() {
+                //  constructed in place, a copy of an in-memory storage would connect to a new empty database
+                return {*this, ":memory:"};
+            }
+
           private:
+            /**
+             *  Copy of `source` together with its database, connected to `filename`.
+             */
+            storage_t(storage_t& source, std::string filename) :
+                storage_base{source, std::move(filename), {}}, db_objects{source.db_objects} {
+#if SQLITE_VERSION_NUMBER >= 3036000 && !defined(SQLITE_OMIT_DESERIALIZE)
+                auto con = source.get_connection();
+                sqlite3_int64 size = 0;
+                if(auto data = sqlite3_serialize(con.get(), "main", &size, SQLITE_SERIALIZE_NOCOPY)) {
+                    this->deserialize_internal(reinterpret_cast<const char*>(data), size, false);
+                    return;
+                }
+#endif
+                source.backup_to(*this);
+            }
+
             db_objects_type db_objects;
+            //  set while `sync_schema_online()` runs
+            const online_migration_options* onlineMigration = nullptr;
 
             /**
              *  Obtain a storage_t's const db_objects_tuple.
@@ -22047,10 +26096,115 @@ namespace sqlite_orm {
                             const Table& table,
                             const std::vector<const table_xinfo*>& columnsToIgnore) const;
 
+            /**
+             *  Copies sourceTableName to destinationTableName like `copy_table` but in rowid ordered chunks,
+             *  each in its own transaction, while triggers mirror concurrent writes to the source table.
+             *  Then replaces the source table with the copy in one transaction.
+             */
+            template<class Table>
+            void copy_table_online(sqlite3* db,
+                                   const std::string& sourceTableName,
+                                   const std::string& destinationTableName,
+                                   const Table& table,
+                                   const std::vector<const table_xinfo*>& columnsToIgnore,
+                                   const online_migration_options& options);
+
+            /**
+             *  Whether rows keep their rowids when copied from the existing table, which is required to mirror writes
+             *  by rowid. It is not the case if the INTEGER PRIMARY KEY (rowid alias) of the table changes.
+             */
+            template<class Table>
+            bool keeps_rowids(const Table& table) {
+                auto rowidAlias = [](const auto& tableInfo) {
+                    const std::string* result = nullptr;
+                    int primaryKeyColumnsCount = 0;
+                    for(auto& columnInfo: tableInfo) {
+                        if(columnInfo.pk) {
+                            ++primaryKeyColumnsCount;
+                            if(columnInfo.type == "INTEGER" || columnInfo.type == "integer") {
+                                result = &columnInfo.name;
+                            }
+                        }
+                    }
+                    return primaryKeyColumnsCount == 1 && result ? *result : std::string{};
+                };
+                return rowidAlias(table.get_table_info()) ==
+                       rowidAlias(this->pragma.table_xinfo(table.schema_name, table.name));
+            }
+
+            /**
+             *  Hash of the SQL creating every schema object of the storage, so it changes with any mapping change
+             *  `sync_schema()` would have to apply.
+             */
+            std::string schema_fingerprint() {
+                using context_t = serializer_context<db_objects_type>;
+                context_t context{this->db_objects};
+                std::string definitions;
+                iterate_tuple(this->db_objects, [&definitions, &context](auto& schemaObject) {
+                    definitions += internal::serialize(schemaObject, context);
+                    definitions += ";\n";
+                });
+                //  range tables aren't created by `sync_schema()`
+                for(auto& p: this->rangeTables) {
+                    definitions += p.first;
+                    definitions += ";\n";
+                }
+                return schema_fingerprint_hash(definitions);
+            }
+
+            int schema_version(sqlite3* db) {
+                int result = 0;
+                perform_exec(db, "PRAGMA schema_version", extract_single_value<int>, &result);
+                return result;
+            }
+
+            /**
+             *  Whether `fingerprint` is the one stored by the last `sync_schema_if_changed()` and the schema of
+             *  the database hasn't been changed since then.
+             */
+            bool schema_fingerprint_matches(sqlite3* db, const std::string& fingerprint) {
+                std::stringstream ss;
+                ss << "SELECT \"fingerprint\", \"schema_version\" FROM "
+                   << streaming_identifier(schema_fingerprint_table_name()) << " WHERE \"id\" = 1" << std::flush;
+                sqlite3_stmt* stmt = nullptr;
+                //  fails if no fingerprint has been stored yet
+                if(sqlite3_prepare_v2(db, ss.str().c_str(), -1, &stmt, nullptr) != SQLITE_OK) {
+                    return false;
+                }
+                statement_finalizer finalizer{stmt};
+                if(sqlite3_step(stmt) != SQLITE_ROW) {
+                    return false;
+                }
+                auto storedFingerprint = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 0));
+                return storedFingerprint && fingerprint == storedFingerprint &&
+                       sqlite3_column_int(stmt, 1) == this->schema_version(db);
+            }
+
+            void store_schema_fingerprint(sqlite3* db, const std::string& fingerprint) {
+                const std::string tableName = schema_fingerprint_table_name();
+                {
+                    std::stringstream ss;
+                    ss << "CREATE TABLE IF NOT EXISTS " << streaming_identifier(tableName)
+                       << " (\"id\" INTEGER PRIMARY KEY CHECK (\"id\" = 1), \"fingerprint\" TEXT NOT NULL, "
+                          "\"schema_version\" INTEGER NOT NULL)"
+                       << std::flush;
+                    perform_void_exec(db, ss.str());
+                }
+                //  read after the table is created because creating it changes the schema version
+                std::stringstream ss;
+                ss << "REPLACE INTO " << streaming_identifier(tableName)
+                   << " (\"id\", \"fingerprint\", \"schema_version\") VALUES (1, " << quote_string_literal(fingerprint)
+                   << ", " << this->schema_version(db) << ")" << std::flush;
+                perform_void_exec(db, ss.str());
+            }
+
 #if SQLITE_VERSION_NUMBER >= 3035000  //  DROP COLUMN feature exists (v3.35.0)
-            void drop_column(sqlite3* db, const std::string& tableName, const std::string& columnName) {
+            void drop_column(sqlite3* db,
+                             const std::string& schemaName,
+                             const std::string& tableName,
+                             const std::string& columnName) {
                 std::stringstream ss;
-                ss << "ALTER TABLE " << streaming_identifier(tableName) << " DROP COLUMN "
+                ss << "ALTER TABLE " << streaming_identifier(schemaName, tableName, std::string{}) << " DROP COLUMN "
                    << streaming_identifier(columnName) << std::flush;
                 perform_void_exec(db, ss.str());
             }
@@ -22059,7 +26213,7 @@ namespace sqlite_orm {
             template<class Table>
             void drop_create_with_loss(sqlite3* db, const Table& table) {
                 // eliminated all transaction handling
-                this->drop_table_internal(db, table.name);
+                this->drop_table_internal(db, table.schema_name, table.name);
                 this->create_table(db, table.name, table);
             }
 
@@ -22069,13 +26223,13 @@ namespace sqlite_orm {
                 //  here we copy source table to another with a name with '_backup' suffix, but in case table with such
                 //  a name already exists we append suffix 1, then 2, etc until we find a free name..
                 auto backupTableName = table.name + "_backup";
-                if(this->table_exists(db, backupTableName)) {
+                if(this->table_exists(db, table.schema_name, backupTableName)) {
                     int suffix = 1;
                     do {
                         std::stringstream ss;
                         ss << suffix << std::flush;
                         auto anotherBackupTableName = backupTableName + ss.str();
-                        if(!this->table_exists(db, anotherBackupTableName)) {
+                        if(!this->table_exists(db, table.schema_name, anotherBackupTableName)) {
                             backupTableName = std::move(anotherBackupTableName);
                             break;
                         }
@@ -22084,11 +26238,23 @@ namespace sqlite_orm {
                 }
                 this->create_table(db, backupTableName, table);
 
+                //  chunks are committed separately, so the copy can't be online inside of a transaction
+                if(this->onlineMigration && !Table::is_without_rowid_v && sqlite3_get_autocommit(db) &&
+                   this->keeps_rowids(table)) {
+                    this->copy_table_online(db,
+                                            table.name,
+                                            backupTableName,
+                                            table,
+                                            columnsToIgnore,
+                                            *this->onlineMigration);
+                    return;
+                }
+
                 this->copy_table(db, table.name, backupTableName, table, columnsToIgnore);
 
-                this->drop_table_internal(db, table.name);
+                this->drop_table_internal(db, table.schema_name, table.name);
 
-                this->rename_table(db, backupTableName, table.name);
+                this->rename_table(db, table.schema_name, backupTableName, table.name);
             }
 
             template<class O>
@@ -22152,6 +26318,43 @@ namespace sqlite_orm {
                 return pick_table<O>(this->db_objects);
             }
 
+            /**
+             *  Splits the span between the smallest and the largest rowid of the table of `O` into at most
+             *  `partitions` inclusive ranges of the same size; no range if the table is empty.
+             */
+            template<class O>
+            std::vector<std::pair<int64, int64>> rowid_ranges(int partitions) {
+                std::vector<std::pair<int64, int64>> res;
+                auto bounds = this->select(columns(sqlite_orm::min(rowid<O>()), sqlite_orm::max(rowid<O>())));
+                if(bounds.empty() || !std::get<0>(bounds.front())) {
+                    return res;
+                }
+                const int64 first = *std::get<0>(bounds.front());
+                const int64 last = *std::get<1>(bounds.front());
+                //  unsigned arithmetic on offsets from `first` doesn't overflow even for the full int64 range
+                const auto span = std::uint64_t(last) - std::uint64_t(first);
+                const auto count = std::uint64_t(std::max(partitions, 1));
+                const auto size = span / count + 1;
+                for(std::uint64_t offset = 0;; offset += size) {
+                    bool isLast = res.size() + 1 == count || span - offset < size;
+                    res.emplace_back(int64(std::uint64_t(first) + offset),
+                                     isLast ? last : int64(std::uint64_t(first) + offset + size - 1));
+                    if(isLast) {
+                        return res;
+                    }
+                }
+            }
+
+            template<class O>
+            static auto partition_where(std::pair<int64, int64> range) {
+                return where(between(rowid<O>(), range.first, range.second));
+            }
+
+            template<class O, class C>
+            static auto partition_where(std::pair<int64, int64> range, const where_t<C>& condition) {
+                return where(and_(between(rowid<O>(), range.first, range.second), condition.expression));
+            }
+
           public:
             template<class T, class O = mapped_type_proxy_t<T>, class... Args>
             mapped_view<O, self, Args...> iterate(Args&&... args) {
@@ -22191,6 +26394,118 @@ namespace sqlite_orm {
 #endif
 #endif
 
+            /**
+             *  Iterates over the rows of `expression` while a background thread steps the statement and extracts the
+             *  next rows into a queue of up to `queueDepth` rows. So stepping overlaps with the processing of the
+             *  rows, which pays off if the caller does more than a trivial amount of work per row.
+             *  The background thread uses the storage's connection until the returned view is destroyed, don't use
+             *  the storage meanwhile. Destroying the view before the last row stops the background thread.
+             *  @example for(auto& row: storage.iterate_pipelined(select(columns(&User::id, &User::name)))) {...}
+             */
+            template<class T, class... Args>
+            auto iterate_pipelined(select_t<T, Args...> expression, size_t queueDepth = 256) {
+                using ColResult = column_result_of_t<db_objects_type, T>;
+                using row_extractor_type = decltype(make_row_extractor<ColResult>(this->db_objects));
+                using R = decltype(std::declval<row_extractor_type>().extract(nullptr, 0));
+                auto statement =
+                    std::make_shared<prepared_statement_t<select_t<T, Args...>>>(this->prepare(std::move(expression)));
+                iterate_ast(statement->expression, conditional_binder{statement->stmt});
+                return pipelined_view<R>{
+                    statement,
+                    queueDepth,
+                    [stmt = statement->stmt,
+                     rowExtractor = make_row_extractor<ColResult>(this->db_objects)](row_queue<R>& queue) {
+                        int rc;
+                        while((rc = sqlite3_step(stmt)) == SQLITE_ROW) {
+                            if(!queue.push(rowExtractor.extract(stmt, 0))) {
+                                return;
+                            }
+                        }
+                        if(rc != SQLITE_DONE) {
+                            throw_translated_sqlite_error(stmt);
+                        }
+                    }};
+            }
+
+            /**
+             *  Calls `callback(object, partition)` for every object of type `O` (matching an optional `where`
+             *  condition), scanning the table in up to `partitions` rowid ranges in parallel. The ranges split the span
+             *  between the smallest and the largest rowid evenly. Every range is read on its own connection and thread,
+             *  the first one on the calling thread. So `callback` is called concurrently for different partitions but
+             *  sequentially and in rowid order within a partition, e.g. to fill per partition accumulators.
+             *  Note: partitions are read in separate read transactions, they don't see changes not committed yet on
+             *  the storage's connection. The other partitions are read by copies of the storage, whose connections get
+             *  the `on_open` callback and attached databases but no functions, collations, busy handler, retry policy,
+             *  limits or pragmas registered on this storage, so `conditions` must not depend on them.
+             *  An in-memory database is scanned partition by partition on the calling thread.
+             *  The number of partitions isn't limited to the number of hardware threads since scans are often
+             *  bound by I/O rather than by CPU, choose it according to the workload.
+             *  @example storage.parallel_for_each<User>(8, [&counts](const User& user, int partition) {
+             *               ++counts[partition];
+             *           }, where(c(&User::age) > 18));
+             */
+            template<class O, class F, class... Args>
+            void parallel_for_each(int partitions, F callback, Args... conditions) {
+                static_assert(sizeof...(Args) <= 1 && polyfill::conjunction_v<is_where<Args>...>,
+                              "parallel_for_each accepts a single `where` condition");
+                static_assert(!storage_pick_table_t<O, db_objects_type>::is_without_rowid_v,
+                              "parallel_for_each needs a table with rowids");
+                this->assert_mapped_type<O>();
+                auto ranges = this->rowid_ranges<O>(partitions);
+                if(ranges.empty()) {
+                    return;
+                }
+                auto scan = [&callback, &conditions...](self& storage, int partition, std::pair<int64, int64> range) {
+                    for(auto& object: storage.template iterate<O>(partition_where<O>(range, conditions...))) {
+                        callback(object, partition);
+                    }
+                };
+                if(this->inMemory) {
+                    for(size_t i = 0; i < ranges.size(); ++i) {
+                        scan(*this, int(i), ranges[i]);
+                    }
+                    return;
+                }
+                //  copies of a storage connect to the same database file on their own
+                std::vector<std::unique_ptr<self>> readers;
+                std::vector<std::future<void>> futures;
+                readers.reserve(ranges.size() - 1);
+                futures.reserve(ranges.size() - 1);
+                for(size_t i = 1; i < ranges.size(); ++i) {
+                    readers.emplace_back(new self(*this));
+                    futures.push_back(
+                        std::async(std::launch::async, [&scan, &reader = *readers.back(), i, range = ranges[i]] {
+                            scan(reader, int(i), range);
+                        }));
+                }
+                scan(*this, 0, ranges.front());
+                for(auto& future: futures) {
+                    future.get();
+                }
+            }
+
+            /**
+             *  Like `get_all<O>(where(...))` but reads the table with `parallel_for_each`. Partitions are
+             *  concatenated in their order, so objects are ordered by rowid.
+             */
+            template<class O, class... Args>
+            std::vector<O> parallel_get_all(int partitions, Args... conditions) {
+                std::vector<std::vector<O>> partitionObjects(std::max(partitions, 1));
+                this->parallel_for_each<O>(
+                    partitions,
+                    [&partitionObjects](O& object, int partition) {
+                        partitionObjects[partition].push_back(std::move(object));
+                    },
+                    std::move(conditions)...);
+                std::vector<O> res;
+                for(auto& objects: partitionObjects) {
+                    res.insert(res.end(),
+                               std::make_move_iterator(objects.begin()),
+                               std::make_move_iterator(objects.end()));
+                }
+                return res;
+            }
+
             /**
              * Delete from routine.
              * O is an object's type. Must be specified explicitly.
@@ -22364,6 +26679,13 @@ namespace sqlite_orm {
             template<class O, class... Ids>
             O get(Ids... ids) {
                 this->assert_mapped_type<O>();
+                std::shared_ptr<const O> object;
+                if(this->get_through_cache<O>(object, ids...)) {
+                    if(object) {
+                        return *object;
+                    }
+                    throw std::system_error{orm_error_code::not_found};
+                }
                 auto statement = this->prepare(sqlite_orm::get<O>(std::forward<Ids>(ids)...));
                 return this->execute(statement);
             }
@@ -22382,6 +26704,10 @@ namespace sqlite_orm {
             template<class O, class... Ids>
             std::unique_ptr<O> get_pointer(Ids... ids) {
                 this->assert_mapped_type<O>();
+                std::shared_ptr<const O> object;
+                if(this->get_through_cache<O>(object, ids...)) {
+                    return object ? std::make_unique<O>(*object) : nullptr;
+                }
                 auto statement = this->prepare(sqlite_orm::get_pointer<O>(std::forward<Ids>(ids)...));
                 return this->execute(statement);
             }
@@ -22411,6 +26737,89 @@ namespace sqlite_orm {
                 return std::shared_ptr<O>(this->get_pointer<O>(std::forward<Ids>(ids)...));
             }
 
+            /**
+             *  The same as `get_pointer` but returns a shared handle to an immutable object.
+             *  If an object cache is enabled for `O` the handle to the cached object is returned without copying it.
+             */
+            template<class O, class... Ids>
+            std::shared_ptr<const O> get_shared(Ids... ids) {
+                this->assert_mapped_type<O>();
+                std::shared_ptr<const O> object;
+                if(this->get_through_cache<O>(object, ids...)) {
+                    return object;
+                }
+                return std::shared_ptr<const O>(this->get_pointer<O>(std::forward<Ids>(ids)...));
+            }
+
+            /**
+             *  Enables a read-through LRU cache used by `get`, `get_pointer`, `get_optional` and `get_shared`
+             *  when they are called with a single integral id. Passing 0 disables the cache.
+             *  Cached objects are invalidated per rowid when the table changes through this storage's connection
+             *  and all at once when `PRAGMA data_version` shows that another connection committed changes.
+             *  A REPLACE into a table with UNIQUE constraints or unique indexes drops all cached objects of the table
+             *  because rows it deletes to resolve a conflict aren't reported to the update hook. For the same reason
+             *  `update_all()` assigning the primary key or the rowid, dropping a table and `backup_from()` drop all
+             *  cached objects.
+             *  Only a primary key that is an alias for the rowid allows dropping single objects, for other keys
+             *  any change drops all cached objects of the table.
+             *  Objects are neither looked up in nor added to the cache when the connection isn't kept open
+             *  (see `open_forever()`), and objects read inside a transaction are not added.
+             *  @param maxObjects maximum number of cached objects of type `O`
+             */
+            template<class O>
+            void enable_object_cache(size_t maxObjects) {
+                this->assert_mapped_type<O>();
+                using table_type = storage_pick_table_t<O, db_objects_type>;
+                static_assert(!table_type::is_without_rowid_v,
+                              "Changes to WITHOUT ROWID tables can't be observed, so their objects can't be cached");
+                auto& table = this->get_table<O>();
+                auto key = this->change_key<O>();
+                if(maxObjects) {
+                    this->objectCaches[key] =
+                        std::make_unique<object_cache<O>>(maxObjects, key_is_rowid(table), this->has_unique_keys<O>());
+                } else {
+                    this->objectCaches.erase(key);
+                }
+                if(this->is_opened()) {
+                    this->register_change_hooks(this->connection->get());
+                }
+            }
+
+            template<class O>
+            sqlite_orm::object_cache_stats object_cache_stats() const {
+                this->assert_mapped_type<O>();
+                auto it = this->objectCaches.find(this->change_key<O>());
+                if(it != this->objectCaches.end()) {
+                    return it->second->stats;
+                }
+                return {};
+            }
+
+#if SQLITE_VERSION_NUMBER >= 3020000
+            /**
+             *  Registers an eponymous virtual table named like the table of `O` which exposes a range of `O` objects
+             *  bound with `range_source(...)`, e.g. to join in-memory data without a temporary table.
+             *  The objects are read in place, equality on a single primary key column is answered by a binary search.
+             *  Range tables are read-only and skipped by `sync_schema()`.
+             *  Example:
+             *  storage.create_range_table<Weight>();
+             *  storage.select(columns(&Item::name, &Weight::weight),
+             *                 join<Weight>(on(c(&Weight::itemId) == &Item::id)),
+             *                 where(range_source(weights)));
+             */
+            template<class O>
+            void create_range_table() {
+                this->assert_mapped_type<O>();
+                using table_type = storage_pick_table_t<O, db_objects_type>;
+                auto& table = this->get_table<O>();
+                auto rangeTable = std::make_unique<range_table<table_type>>(table);
+                if(this->is_opened()) {
+                    register_range_table(this->connection->get(), table.name, *rangeTable);
+                }
+                this->rangeTables[table.name] = std::move(rangeTable);
+            }
+#endif
+
 #ifdef SQLITE_ORM_OPTIONAL_SUPPORTED
             /**
              *  The same as `get` function but doesn't throw an exception if noting found but
@@ -22419,6 +26828,10 @@ namespace sqlite_orm {
             template<class O, class... Ids>
             std::optional<O> get_optional(Ids... ids) {
                 this->assert_mapped_type<O>();
+                std::shared_ptr<const O> object;
+                if(this->get_through_cache<O>(object, ids...)) {
+                    return object ? std::optional<O>(*object) : std::nullopt;
+                }
                 auto statement = this->prepare(sqlite_orm::get_optional<O>(std::forward<Ids>(ids)...));
                 return this->execute(statement);
             }
@@ -22608,315 +27021,754 @@ namespace sqlite_orm {
                 }
             }
 
-            /**
-             *  TOTAL(x) query.
-             *  @param m is a class member pointer (the same you passed into make_column).
-             *  @return total value (the same as SUM but not nullable. More details here
-             * https://www.sqlite.org/lang_aggfunc.html)
-             */
-            template<class F,
-                     class... Args,
-                     std::enable_if_t<polyfill::disjunction<std::is_member_pointer<F>, is_column_pointer<F>>::value,
-                                      bool> = true>
-            double total(F field, Args&&... args) {
-                this->assert_mapped_type<table_type_of_t<F>>();
-                auto rows = this->select(sqlite_orm::total(std::move(field)), std::forward<Args>(args)...);
-                if(!rows.empty()) {
-                    return std::move(rows.front());
-                } else {
-                    return {};
+            /**
+             *  TOTAL(x) query.
+             *  @param m is a class member pointer (the same you passed into make_column).
+             *  @return total value (the same as SUM but not nullable. More details here
+             * https://www.sqlite.org/lang_aggfunc.html)
+             */
+            template<class F,
+                     class... Args,
+                     std::enable_if_t<polyfill::disjunction<std::is_member_pointer<F>, is_column_pointer<F>>::value,
+                                      bool> = true>
+            double total(F field, Args&&... args) {
+                this->assert_mapped_type<table_type_of_t<F>>();
+                auto rows = this->select(sqlite_orm::total(std::move(field)), std::forward<Args>(args)...);
+                if(!rows.empty()) {
+                    return std::move(rows.front());
+                } else {
+                    return {};
+                }
+            }
+
+            /**
+             *  Select a single column into std::vector<T> or multiple columns into std::vector<std::tuple<...>>.
+             *  For a single column use `auto rows = storage.select(&User::id, where(...));
+             *  For multicolumns use `auto rows = storage.select(columns(&User::id, &User::name), where(...));
+             */
+            template<class T, class... Args>
+            auto select(T m, Args... args) {
+                static_assert(!is_compound_operator_v<T> || sizeof...(Args) == 0,
+                              "Cannot use args with a compound operator");
+                auto statement = this->prepare(sqlite_orm::select(std::move(m), std::forward<Args>(args)...));
+                return this->execute(statement);
+            }
+
+            /**
+             *  Returns a proxy whose `select()` memoizes results for `ttl`:
+             *  `auto rows = storage.cached(std::chrono::seconds{1}).select(count(&User::id), group_by(&User::type));`
+             *  Results are keyed by the statement's SQL and bound values. They are dropped when a table
+             *  the statement reads from changes through this storage's connection, or when `PRAGMA data_version`
+             *  shows that another connection committed changes. All results are dropped when a table is dropped
+             *  or the database is overwritten by `backup_from()`.
+             *  Results are neither looked up nor stored when the connection isn't kept open (see `open_forever()`)
+             *  or when a bound value can't be printed with `field_printer`; results read inside a transaction
+             *  or from a WITHOUT ROWID table (whose changes can't be observed) are not stored.
+             */
+            cached_select<self> cached(std::chrono::steady_clock::duration ttl) {
+                return {*this, ttl};
+            }
+
+#if(SQLITE_VERSION_NUMBER >= 3008003) && defined(SQLITE_ORM_WITH_CTE)
+            /**
+             *  Using a CTE, select a single column into std::vector<T> or multiple columns into std::vector<std::tuple<...>>.
+             */
+            template<class CTE, class E>
+            auto with(CTE cte, E expression) {
+                auto statement = this->prepare(sqlite_orm::with(std::move(cte), std::move(expression)));
+                return this->execute(statement);
+            }
+
+            /**
+             *  Using a CTE, select a single column into std::vector<T> or multiple columns into std::vector<std::tuple<...>>.
+             */
+            template<class... CTEs, class E>
+            auto with(common_table_expressions<CTEs...> cte, E expression) {
+                auto statement = this->prepare(sqlite_orm::with(std::move(cte), std::move(expression)));
+                return this->execute(statement);
+            }
+
+            /**
+             *  Using a CTE, select a single column into std::vector<T> or multiple columns into std::vector<std::tuple<...>>.
+             */
+            template<class CTE, class E>
+            auto with_recursive(CTE cte, E expression) {
+                auto statement = this->prepare(sqlite_orm::with_recursive(std::move(cte), std::move(expression)));
+                return this->execute(statement);
+            }
+
+            /**
+             *  Using a CTE, select a single column into std::vector<T> or multiple columns into std::vector<std::tuple<...>>.
+             */
+            template<class... CTEs, class E>
+            auto with_recursive(common_table_expressions<CTEs...> cte, E expression) {
+                auto statement = this->prepare(sqlite_orm::with_recursive(std::move(cte), std::move(expression)));
+                return this->execute(statement);
+            }
+#endif
+
+            template<class T, satisfies<is_prepared_statement, T> = true>
+            std::string dump(const T& preparedStatement, bool parametrized = true) const {
+                return this->dump_highest_level(preparedStatement.expression, parametrized);
+            }
+
+            template<class E,
+                     class Ex = polyfill::remove_cvref_t<E>,
+                     std::enable_if_t<!is_prepared_statement<Ex>::value && !is_mapped<db_objects_type, Ex>::value,
+                                      bool> = true>
+            std::string dump(E&& expression, bool parametrized = false) const {
+                static_assert(is_preparable_v<self, Ex>, "Expression must be a high-level statement");
+
+                decltype(auto) e2 = static_if<is_select<Ex>::value>(
+                    [](auto expression) -> auto {
+                        expression.highest_level = true;
+                        return expression;
+                    },
+                    [](const auto& expression) -> decltype(auto) {
+                        return (expression);
+                    })(std::forward<E>(expression));
+                return this->dump_highest_level(e2, parametrized);
+            }
+
+            /**
+             *  Returns a string representation of object of a class mapped to the storage.
+             *  Type of string has json-like style.
+             */
+            template<class O, satisfies<is_mapped, db_objects_type, O> = true>
+            std::string dump(const O& object) const {
+                auto& table = this->get_table<O>();
+                std::stringstream ss;
+                ss << "{ ";
+                table.for_each_column([&ss, &object, first = true](auto& column) mutable {
+                    using column_type = std::decay_t<decltype(column)>;
+                    using field_type = typename column_type::field_type;
+                    constexpr std::array<const char*, 2> sep = {", ", ""};
+
+                    ss << sep[std::exchange(first, false)] << column.name << " : '"
+                       << field_printer<field_type>{}(polyfill::invoke(column.member_pointer, object)) << "'";
+                });
+                ss << " }";
+                return ss.str();
+            }
+
+            /**
+             *  This is REPLACE (INSERT OR REPLACE) function.
+             *  Also if you need to insert value with knows id you should
+             *  also you this function instead of insert cause inserts ignores
+             *  id and creates own one.
+             */
+            template<class O>
+            void replace(const O& o) {
+                this->assert_mapped_type<O>();
+                auto statement = this->prepare(sqlite_orm::replace(std::ref(o)));
+                this->execute(statement);
+            }
+
+            template<class It, class Projection = polyfill::identity>
+            void replace_range(It from, It to, Projection project = {}) {
+                using O = std::decay_t<decltype(polyfill::invoke(project, *from))>;
+                this->assert_mapped_type<O>();
+                if(from == to) {
+                    return;
+                }
+
+                auto statement =
+                    this->prepare(sqlite_orm::replace_range(std::move(from), std::move(to), std::move(project)));
+                this->execute(statement);
+            }
+
+            template<class O, class It, class Projection = polyfill::identity>
+            void replace_range(It from, It to, Projection project = {}) {
+                this->assert_mapped_type<O>();
+                if(from == to) {
+                    return;
+                }
+
+                auto statement =
+                    this->prepare(sqlite_orm::replace_range<O>(std::move(from), std::move(to), std::move(project)));
+                this->execute(statement);
+            }
+
+            template<class O, class... Cols>
+            int insert(const O& o, columns_t<Cols...> cols) {
+                static_assert(cols.count > 0, "Use insert or replace with 1 argument instead");
+                this->assert_mapped_type<O>();
+                auto statement = this->prepare(sqlite_orm::insert(std::ref(o), std::move(cols)));
+                return int(this->execute(statement));
+            }
+
+            /**
+             *  Insert routine. Inserts object with all non primary key fields in passed object. Id of passed
+             *  object doesn't matter.
+             *  @return id of just created object.
+             */
+            template<class O>
+            int insert(const O& o) {
+                this->assert_mapped_type<O>();
+                this->assert_insertable_type<O>();
+                auto statement = this->prepare(sqlite_orm::insert(std::ref(o)));
+                return int(this->execute(statement));
+            }
+
+            /**
+             *  Raw insert routine. Use this if `insert` with object does not fit you. This insert is designed to be able
+             *  to call any type of `INSERT` query with no limitations.
+             *  @example
+             *  ```sql
+             *  INSERT INTO users (id, name) VALUES(5, 'Little Mix')
+             *  ```
+             *  will be
+             *  ```c++
+             *  storage.insert(into<User>, columns(&User::id, &User::name), values(std::make_tuple(5, "Little Mix")));
+             *  ```
+             *  One more example:
+             *  ```sql
+             *  INSERT INTO singers (name) VALUES ('Sofia Reyes')('Kungs')
+             *  ```
+             *  will be
+             *  ```c++
+             *  storage.insert(into<Singer>(), columns(&Singer::name), values(std::make_tuple("Sofia Reyes"), std::make_tuple("Kungs")));
+             *  ```
+             *  One can use `default_values` to add `DEFAULT VALUES` modifier:
+             *  ```sql
+             *  INSERT INTO users DEFAULT VALUES
+             *  ```
+             *  will be
+             *  ```c++
+             *  storage.insert(into<Singer>(), default_values());
+             *  ```
+             *  Also one can use `INSERT OR ABORT`/`INSERT OR FAIL`/`INSERT OR IGNORE`/`INSERT OR REPLACE`/`INSERT ROLLBACK`:
+             *  ```c++
+             *  storage.insert(or_ignore(), into<Singer>(), columns(&Singer::name), values(std::make_tuple("Sofia Reyes"), std::make_tuple("Kungs")));
+             *  storage.insert(or_rollback(), into<Singer>(), default_values());
+             *  storage.insert(or_abort(), into<User>, columns(&User::id, &User::name), values(std::make_tuple(5, "Little Mix")));
+             *  ```
+             */
+            template<class... Args>
+            void insert(Args... args) {
+                auto statement = this->prepare(sqlite_orm::insert(std::forward<Args>(args)...));
+                this->execute(statement);
+            }
+
+            /**
+             *  Raw replace statement creation routine. Use this if `replace` with object does not fit you. This replace is designed to be able
+             *  to call any type of `REPLACE` query with no limitations. Actually this is the same query as raw insert except `OR...` option existance.
+             *  @example
+             *  ```sql
+             *  REPLACE INTO users (id, name) VALUES(5, 'Little Mix')
+             *  ```
+             *  will be
+             *  ```c++
+             *  storage.prepare(replace(into<User>, columns(&User::id, &User::name), values(std::make_tuple(5, "Little Mix"))));
+             *  ```
+             *  One more example:
+             *  ```sql
+             *  REPLACE INTO singers (name) VALUES ('Sofia Reyes')('Kungs')
+             *  ```
+             *  will be
+             *  ```c++
+             *  storage.prepare(replace(into<Singer>(), columns(&Singer::name), values(std::make_tuple("Sofia Reyes"), std::make_tuple("Kungs"))));
+             *  ```
+             *  One can use `default_values` to add `DEFAULT VALUES` modifier:
+             *  ```sql
+             *  REPLACE INTO users DEFAULT VALUES
+             *  ```
+             *  will be
+             *  ```c++
+             *  storage.prepare(replace(into<Singer>(), default_values()));
+             *  ```
+             */
+            template<class... Args>
+            void replace(Args... args) {
+                auto statement = this->prepare(sqlite_orm::replace(std::forward<Args>(args)...));
+                this->execute(statement);
+            }
+
+            template<class It, class Projection = polyfill::identity>
+            void insert_range(It from, It to, Projection project = {}) {
+                using O = std::decay_t<decltype(polyfill::invoke(std::declval<Projection>(), *std::declval<It>()))>;
+                this->assert_mapped_type<O>();
+                this->assert_insertable_type<O>();
+                if(from == to) {
+                    return;
+                }
+                auto statement =
+                    this->prepare(sqlite_orm::insert_range(std::move(from), std::move(to), std::move(project)));
+                this->execute(statement);
+            }
+
+            template<class O, class It, class Projection = polyfill::identity>
+            void insert_range(It from, It to, Projection project = {}) {
+                this->assert_mapped_type<O>();
+                this->assert_insertable_type<O>();
+                if(from == to) {
+                    return;
                 }
+                auto statement =
+                    this->prepare(sqlite_orm::insert_range<O>(std::move(from), std::move(to), std::move(project)));
+                this->execute(statement);
             }
 
             /**
-             *  Select a single column into std::vector<T> or multiple columns into std::vector<std::tuple<...>>.
-             *  For a single column use `auto rows = storage.select(&User::id, where(...));
-             *  For multicolumns use `auto rows = storage.select(columns(&User::id, &User::name), where(...));
+             * Change table name inside storage's schema info. This function does not
+             * affect database
              */
-            template<class T, class... Args>
-            auto select(T m, Args... args) {
-                static_assert(!is_compound_operator_v<T> || sizeof...(Args) == 0,
-                              "Cannot use args with a compound operator");
-                auto statement = this->prepare(sqlite_orm::select(std::move(m), std::forward<Args>(args)...));
-                return this->execute(statement);
+            template<class O>
+            void rename_table(std::string name) {
+                this->assert_mapped_type<O>();
+                auto& table = this->get_table<O>();
+                this->rename_change_callbacks(this->change_key<O>(), storage_base::change_key(table.schema_name, name));
+                table.name = std::move(name);
             }
 
-#if(SQLITE_VERSION_NUMBER >= 3008003) && defined(SQLITE_ORM_WITH_CTE)
+            using storage_base::rename_table;
+
             /**
-             *  Using a CTE, select a single column into std::vector<T> or multiple columns into std::vector<std::tuple<...>>.
+             *  Registers a callback invoked after a row of the table mapped to `O` is inserted, updated or deleted
+             *  on this storage's connection. Useful for invalidating caches.
+             *  `operation` is SQLITE_INSERT, SQLITE_UPDATE or SQLITE_DELETE, `rowid` is the rowid of the affected row.
+             *  Passing an empty function removes the callback.
+             *  Tables are told apart by schema, so a table in an attached database (see `attach()`) doesn't trigger
+             *  the callback of a table with the same name in the main database.
+             *  An exception thrown by the callback is rethrown by the storage call which made the change once its
+             *  statement is done, the change isn't undone.
+             *  Notes (from https://www.sqlite.org/c3ref/update_hook.html):
+             *  * not invoked for WITHOUT ROWID tables;
+             *  * not invoked when rows are deleted by the truncate optimization (`remove_all<O>()` without conditions)
+             *    or due to an ON CONFLICT REPLACE resolution;
+             *  * the callback must not modify the database.
              */
-            template<class CTE, class E>
-            auto with(CTE cte, E expression) {
-                auto statement = this->prepare(sqlite_orm::with(std::move(cte), std::move(expression)));
-                return this->execute(statement);
+            template<class O>
+            void on_change(std::function<void(int operation, int64 rowid)> callback) {
+                this->assert_mapped_type<O>();
+                this->set_change_callback(this->changeCallbacks, this->change_key<O>(), std::move(callback));
             }
 
+#ifdef SQLITE_ENABLE_PREUPDATE_HOOK
             /**
-             *  Using a CTE, select a single column into std::vector<T> or multiple columns into std::vector<std::tuple<...>>.
+             *  Registers a callback invoked before a row of the table mapped to `O` is inserted, updated or deleted,
+             *  with the old and new row values materialized as objects.
+             *  Unlike `on_change()` it also reports WITHOUT ROWID tables and rows deleted by the truncate optimization.
+             *  Exceptions are rethrown like the ones of `on_change()` callbacks.
+             *  Passing an empty function removes the callback.
+             *  Requires SQLite compiled with SQLITE_ENABLE_PREUPDATE_HOOK.
              */
-            template<class... CTEs, class E>
-            auto with(common_table_expressions<CTEs...> cte, E expression) {
-                auto statement = this->prepare(sqlite_orm::with(std::move(cte), std::move(expression)));
-                return this->execute(statement);
+            template<class O>
+            void on_preupdate(std::function<void(const preupdate_change<O>&)> callback) {
+                this->assert_mapped_type<O>();
+                preupdate_callback hook;
+                if(callback) {
+                    hook = [this, callback = std::move(callback)](sqlite3* db,
+                                                                  int operation,
+                                                                  int64 oldRowid,
+                                                                  int64 newRowid) {
+                        preupdate_change<O> change;
+                        change.operation = operation;
+                        change.old_rowid = oldRowid;
+                        change.new_rowid = newRowid;
+                        if(operation != SQLITE_INSERT) {
+                            change.old_object = this->make_preupdate_object<O>(db, sqlite3_preupdate_old);
+                        }
+                        if(operation != SQLITE_DELETE) {
+                            change.new_object = this->make_preupdate_object<O>(db, sqlite3_preupdate_new);
+                        }
+                        callback(change);
+                    };
+                }
+                this->set_change_callback(this->preupdateCallbacks, this->change_key<O>(), std::move(hook));
             }
+#endif
 
             /**
-             *  Using a CTE, select a single column into std::vector<T> or multiple columns into std::vector<std::tuple<...>>.
+             * Get table's name stored in storage's schema info. This function does not call
+             * any SQLite queries
              */
-            template<class CTE, class E>
-            auto with_recursive(CTE cte, E expression) {
-                auto statement = this->prepare(sqlite_orm::with_recursive(std::move(cte), std::move(expression)));
-                return this->execute(statement);
+            template<class O>
+            const std::string& tablename() const {
+                this->assert_mapped_type<O>();
+                auto& table = this->get_table<O>();
+                return table.name;
             }
 
-            /**
-             *  Using a CTE, select a single column into std::vector<T> or multiple columns into std::vector<std::tuple<...>>.
-             */
-            template<class... CTEs, class E>
-            auto with_recursive(common_table_expressions<CTEs...> cte, E expression) {
-                auto statement = this->prepare(sqlite_orm::with_recursive(std::move(cte), std::move(expression)));
-                return this->execute(statement);
+            template<class F, class O>
+            [[deprecated("Use the more accurately named function `find_column_name()`")]] const std::string*
+            column_name(F O::*memberPointer) const {
+                return internal::find_column_name(this->db_objects, memberPointer);
             }
-#endif
 
-            template<class T, satisfies<is_prepared_statement, T> = true>
-            std::string dump(const T& preparedStatement, bool parametrized = true) const {
-                return this->dump_highest_level(preparedStatement.expression, parametrized);
+            template<class F, class O>
+            const std::string* find_column_name(F O::*memberPointer) const {
+                return internal::find_column_name(this->db_objects, memberPointer);
             }
 
-            template<class E,
-                     class Ex = polyfill::remove_cvref_t<E>,
-                     std::enable_if_t<!is_prepared_statement<Ex>::value && !is_mapped<db_objects_type, Ex>::value,
-                                      bool> = true>
-            std::string dump(E&& expression, bool parametrized = false) const {
-                static_assert(is_preparable_v<self, Ex>, "Expression must be a high-level statement");
+          protected:
+            friend struct cached_select<self>;
 
-                decltype(auto) e2 = static_if<is_select<Ex>::value>(
-                    [](auto expression) -> auto {
-                        expression.highest_level = true;
-                        return expression;
-                    },
-                    [](const auto& expression) -> decltype(auto) {
-                        return (expression);
-                    })(std::forward<E>(expression));
-                return this->dump_highest_level(e2, parametrized);
+            template<class T, class... Args>
+            auto select_cached(std::chrono::steady_clock::duration ttl, T m, Args... args) {
+                static_assert(!is_compound_operator_v<T> || sizeof...(Args) == 0,
+                              "Cannot use args with a compound operator");
+                auto expression = sqlite_orm::select(std::move(m), std::forward<Args>(args)...);
+                using result_type = decltype(this->execute(this->prepare(expression)));
+                if(!this->connection_kept_open()) {
+                    return this->execute(this->prepare(std::move(expression)));
+                }
+                bindings_key_builder keyBuilder;
+                iterate_ast(expression, keyBuilder);
+                if(!keyBuilder.representable) {
+                    return this->execute(this->prepare(std::move(expression)));
+                }
+                if(!this->queryCache.enabled) {
+                    this->queryCache.enabled = true;
+                    this->register_change_hooks(this->connection->get());
+                }
+
+                //  the type is part of the key because different result types can share the same SQL
+                const void* typeKey = type_key<result_type>();
+                std::string key(reinterpret_cast<const char*>(&typeKey), sizeof(typeKey));
+                expression.highest_level = true;
+                key += this->dump_highest_level(expression, true);
+                key += '\0';
+                key += keyBuilder.key;
+
+                auto connection = this->get_connection();
+                sqlite3* db = connection.get();
+                this->validate_caches(db);
+                auto now = std::chrono::steady_clock::now();
+                if(auto result = this->queryCache.find(key, now)) {
+                    return *static_cast<const result_type*>(result.get());
+                }
+                auto statement = this->prepare(expression);
+                auto result = std::make_shared<result_type>(this->execute(statement));
+                //  uncommitted results must not outlive a rollback
+                if(sqlite3_get_autocommit(db)) {
+                    referenced_tables_collector<db_objects_type> collector{this->db_objects};
+                    iterate_ast(expression, collector);
+                    std::vector<std::string> tableKeys;
+                    tableKeys.reserve(collector.table_names.size());
+                    bool observable = true;
+                    for(auto& tableName: collector.table_names) {
+                        const std::string& schemaName = collector.table_schemas.at(tableName);
+                        //  the update hook isn't invoked for WITHOUT ROWID tables, so changes to them go unnoticed
+                        if(table_is_without_rowid(this->db_objects, schemaName, tableName.first)) {
+                            observable = false;
+                            break;
+                        }
+                        tableKeys.push_back(storage_base::change_key(schemaName, tableName.first));
+                    }
+                    if(observable) {
+                        this->queryCache.insert(std::move(key), result, now + ttl, tableKeys);
+                    }
+                }
+                return *result;
             }
 
-            /**
-             *  Returns a string representation of object of a class mapped to the storage.
-             *  Type of string has json-like style.
-             */
-            template<class O, satisfies<is_mapped, db_objects_type, O> = true>
-            std::string dump(const O& object) const {
-                auto& table = this->get_table<O>();
-                std::stringstream ss;
-                ss << "{ ";
-                table.for_each_column([&ss, &object, first = true](auto& column) mutable {
-                    using column_type = std::decay_t<decltype(column)>;
-                    using field_type = typename column_type::field_type;
-                    constexpr std::array<const char*, 2> sep = {", ", ""};
+            template<class T,
+                     std::enable_if_t<polyfill::disjunction<is_replace<T>, is_replace_range<T>>::value, bool> = true>
+            void bind_statement(sqlite3_stmt* stmt, const T& expression) {
+                using object_type = expression_object_type_t<T>;
 
-                    ss << sep[std::exchange(first, false)] << column.name << " : '"
-                       << field_printer<field_type>{}(polyfill::invoke(column.member_pointer, object)) << "'";
-                });
-                ss << " }";
-                return ss.str();
+                auto processObject = [&table = this->get_table<object_type>(),
+                                      bindValue = field_value_binder{stmt}](auto& object) mutable {
+                    table.template for_each_column_excluding<is_generated_always>(
+                        call_as_template_base<column_field>([&bindValue, &object](auto& column) {
+                            bindValue(polyfill::invoke(column.member_pointer, object));
+                        }));
+                };
+
+                static_if<is_replace_range<T>::value>(
+                    [&processObject](auto& expression) {
+#if __cpp_lib_ranges >= 201911L
+                        std::ranges::for_each(expression.range.first,
+                                              expression.range.second,
+                                              std::ref(processObject),
+                                              std::ref(expression.transformer));
+#else
+                        auto& transformer = expression.transformer;
+                        std::for_each(expression.range.first,
+                                      expression.range.second,
+                                      [&processObject, &transformer](auto& item) {
+                                          const object_type& object = polyfill::invoke(transformer, item);
+                                          processObject(object);
+                                      });
+#endif
+                    },
+                    [&processObject](auto& expression) {
+                        const object_type& o = get_object(expression);
+                        processObject(o);
+                    })(expression);
             }
 
-            /**
-             *  This is REPLACE (INSERT OR REPLACE) function.
-             *  Also if you need to insert value with knows id you should
-             *  also you this function instead of insert cause inserts ignores
-             *  id and creates own one.
-             */
-            template<class O>
-            void replace(const O& o) {
-                this->assert_mapped_type<O>();
-                auto statement = this->prepare(sqlite_orm::replace(std::ref(o)));
-                this->execute(statement);
+            template<class T,
+                     std::enable_if_t<polyfill::disjunction<is_insert<T>, is_insert_range<T>>::value, bool> = true>
+            void bind_statement(sqlite3_stmt* stmt, const T& expression) {
+                using object_type = expression_object_type_t<T>;
+
+                auto processObject = [&table = this->get_table<object_type>(),
+                                      bindValue = field_value_binder{stmt}](auto& object) mutable {
+                    using is_without_rowid = typename std::decay_t<decltype(table)>::is_without_rowid;
+                    table.template for_each_column_excluding<
+                        mpl::conjunction<mpl::not_<mpl::always<is_without_rowid>>,
+                                         mpl::disjunction_fn<is_primary_key, is_generated_always>>>(
+                        call_as_template_base<column_field>([&table, &bindValue, &object](auto& column) {
+                            if(!exists_in_composite_primary_key(table, column)) {
+                                bindValue(polyfill::invoke(column.member_pointer, object));
+                            }
+                        }));
+                };
+
+                static_if<is_insert_range<T>::value>(
+                    [&processObject](auto& expression) {
+#if __cpp_lib_ranges >= 201911L
+                        std::ranges::for_each(expression.range.first,
+                                              expression.range.second,
+                                              std::ref(processObject),
+                                              std::ref(expression.transformer));
+#else
+                        auto& transformer = expression.transformer;
+                        std::for_each(expression.range.first,
+                                      expression.range.second,
+                                      [&processObject, &transformer](auto& item) {
+                                          const object_type& object = polyfill::invoke(transformer, item);
+                                          processObject(object);
+                                      });
+#endif
+                    },
+                    [&processObject](auto& expression) {
+                        const object_type& o = get_object(expression);
+                        processObject(o);
+                    })(expression);
             }
 
-            template<class It, class Projection = polyfill::identity>
-            void replace_range(It from, It to, Projection project = {}) {
-                using O = std::decay_t<decltype(polyfill::invoke(project, *from))>;
-                this->assert_mapped_type<O>();
-                if(from == to) {
-                    return;
-                }
+            template<class T, class... Args>
+            void bind_statement(sqlite3_stmt* stmt, const remove_all_t<T, Args...>& expression) {
+                iterate_ast(expression.conditions, conditional_binder{stmt});
+            }
 
-                auto statement =
-                    this->prepare(sqlite_orm::replace_range(std::move(from), std::move(to), std::move(project)));
-                this->execute(statement);
+            template<class S, class... Wargs>
+            void bind_statement(sqlite3_stmt* stmt, const update_all_t<S, Wargs...>& expression) {
+                conditional_binder bindNode{stmt};
+                iterate_ast(expression.set, bindNode);
+                iterate_ast(expression.conditions, bindNode);
             }
 
-            template<class O, class It, class Projection = polyfill::identity>
-            void replace_range(It from, It to, Projection project = {}) {
-                this->assert_mapped_type<O>();
-                if(from == to) {
-                    return;
-                }
+            /**
+             *  Whether the primary key of `table` is an alias for the rowid: a single integral column declared
+             *  INTEGER which isn't declared `PRIMARY KEY DESC` in its column definition.
+             */
+            template<class Table>
+            static bool key_is_rowid(const Table& table) {
+                int primaryKeyColumnsCount = 0;
+                bool integerPrimaryKey = false;
+                table.for_each_primary_key_column([&primaryKeyColumnsCount, &integerPrimaryKey](auto memberPointer) {
+                    using field_type = member_field_type_t<decltype(memberPointer)>;
+                    ++primaryKeyColumnsCount;
+                    integerPrimaryKey =
+                        std::is_integral<field_type>::value && type_printer<field_type>().print() == "INTEGER";
+                });
+                bool descendingColumnKey = false;
+                table.for_each_column([&descendingColumnKey](auto& column) {
+                    iterate_tuple(column.constraints, [&descendingColumnKey](auto& constraint) {
+                        descendingColumnKey = descendingColumnKey || is_descending_primary_key(constraint);
+                    });
+                });
+                return primaryKeyColumnsCount == 1 && integerPrimaryKey && !descendingColumnKey;
+            }
 
-                auto statement =
-                    this->prepare(sqlite_orm::replace_range<O>(std::move(from), std::move(to), std::move(project)));
-                this->execute(statement);
+            template<class C, satisfies<is_primary_key, C> = true>
+            static bool is_descending_primary_key(const C& primaryKey) {
+                return primaryKey.options.asc_option == primary_key_base::order_by::descending;
             }
 
-            template<class O, class... Cols>
-            int insert(const O& o, columns_t<Cols...> cols) {
-                static_assert(cols.count > 0, "Use insert or replace with 1 argument instead");
-                this->assert_mapped_type<O>();
-                auto statement = this->prepare(sqlite_orm::insert(std::ref(o), std::move(cols)));
-                return int(this->execute(statement));
+            template<class C, satisfies_not<is_primary_key, C> = true>
+            static bool is_descending_primary_key(const C&) {
+                return false;
             }
 
             /**
-             *  Insert routine. Inserts object with all non primary key fields in passed object. Id of passed
-             *  object doesn't matter.
-             *  @return id of just created object.
+             *  Whether the table of `O` has UNIQUE constraints or unique indexes, on which a REPLACE can conflict
+             *  with rows other than the one having the same primary key.
              */
             template<class O>
-            int insert(const O& o) {
-                this->assert_mapped_type<O>();
-                this->assert_insertable_type<O>();
-                auto statement = this->prepare(sqlite_orm::insert(std::ref(o)));
-                return int(this->execute(statement));
+            bool has_unique_keys() const {
+                using table_type = storage_pick_table_t<O, db_objects_type>;
+                bool result = table_type::template count_of<is_unique>() > 0 ||
+                              table_type::template count_of_columns_with<is_unique>() > 0;
+                iterate_tuple(this->db_objects, [&result](auto& schemaObject) {
+                    result = result || is_unique_index_of<O>(schemaObject);
+                });
+                return result;
             }
 
-            /**
-             *  Raw insert routine. Use this if `insert` with object does not fit you. This insert is designed to be able
-             *  to call any type of `INSERT` query with no limitations.
-             *  @example
-             *  ```sql
-             *  INSERT INTO users (id, name) VALUES(5, 'Little Mix')
-             *  ```
-             *  will be
-             *  ```c++
-             *  storage.insert(into<User>, columns(&User::id, &User::name), values(std::make_tuple(5, "Little Mix")));
-             *  ```
-             *  One more example:
-             *  ```sql
-             *  INSERT INTO singers (name) VALUES ('Sofia Reyes')('Kungs')
-             *  ```
-             *  will be
-             *  ```c++
-             *  storage.insert(into<Singer>(), columns(&Singer::name), values(std::make_tuple("Sofia Reyes"), std::make_tuple("Kungs")));
-             *  ```
-             *  One can use `default_values` to add `DEFAULT VALUES` modifier:
-             *  ```sql
-             *  INSERT INTO users DEFAULT VALUES
-             *  ```
-             *  will be
-             *  ```c++
-             *  storage.insert(into<Singer>(), default_values());
-             *  ```
-             *  Also one can use `INSERT OR ABORT`/`INSERT OR FAIL`/`INSERT OR IGNORE`/`INSERT OR REPLACE`/`INSERT ROLLBACK`:
-             *  ```c++
-             *  storage.insert(or_ignore(), into<Singer>(), columns(&Singer::name), values(std::make_tuple("Sofia Reyes"), std::make_tuple("Kungs")));
-             *  storage.insert(or_rollback(), into<Singer>(), default_values());
-             *  storage.insert(or_abort(), into<User>, columns(&User::id, &User::name), values(std::make_tuple(5, "Little Mix")));
-             *  ```
-             */
-            template<class... Args>
-            void insert(Args... args) {
-                auto statement = this->prepare(sqlite_orm::insert(std::forward<Args>(args)...));
-                this->execute(statement);
+            template<class O, class T, class... Els>
+            static bool is_unique_index_of(const index_t<T, Els...>& index) {
+                return std::is_same<T, O>::value && index.unique;
+            }
+
+            template<class O, class E>
+            static bool is_unique_index_of(const E&) {
+                return false;
+            }
+
+            template<class O>
+            std::string change_key() const {
+                auto& table = this->get_table<O>();
+                return storage_base::change_key(table_schema_name(table), table.name);
             }
 
             /**
-             *  Raw replace statement creation routine. Use this if `replace` with object does not fit you. This replace is designed to be able
-             *  to call any type of `REPLACE` query with no limitations. Actually this is the same query as raw insert except `OR...` option existance.
-             *  @example
-             *  ```sql
-             *  REPLACE INTO users (id, name) VALUES(5, 'Little Mix')
-             *  ```
-             *  will be
-             *  ```c++
-             *  storage.prepare(replace(into<User>, columns(&User::id, &User::name), values(std::make_tuple(5, "Little Mix"))));
-             *  ```
-             *  One more example:
-             *  ```sql
-             *  REPLACE INTO singers (name) VALUES ('Sofia Reyes')('Kungs')
-             *  ```
-             *  will be
-             *  ```c++
-             *  storage.prepare(replace(into<Singer>(), columns(&Singer::name), values(std::make_tuple("Sofia Reyes"), std::make_tuple("Kungs"))));
-             *  ```
-             *  One can use `default_values` to add `DEFAULT VALUES` modifier:
-             *  ```sql
-             *  REPLACE INTO users DEFAULT VALUES
-             *  ```
-             *  will be
-             *  ```c++
-             *  storage.prepare(replace(into<Singer>(), default_values()));
-             *  ```
+             *  Maintains the caches after a data modification statement, with or without a RETURNING clause,
+             *  for the changes the update hook doesn't report.
              */
-            template<class... Args>
-            void replace(Args... args) {
-                auto statement = this->prepare(sqlite_orm::replace(std::forward<Args>(args)...));
-                this->execute(statement);
+            template<class T,
+                     std::enable_if_t<polyfill::disjunction<is_replace<T>, is_replace_range<T>>::value, bool> = true>
+            void statement_performed(const T&) {
+                if(!this->objectCaches.empty()) {
+                    this->rows_replaced(this->change_key<expression_object_type_t<T>>());
+                }
             }
 
-            template<class It, class Projection = polyfill::identity>
-            void insert_range(It from, It to, Projection project = {}) {
-                using O = std::decay_t<decltype(polyfill::invoke(std::declval<Projection>(), *std::declval<It>()))>;
-                this->assert_mapped_type<O>();
-                this->assert_insertable_type<O>();
-                if(from == to) {
-                    return;
+            template<class T,
+                     std::enable_if_t<polyfill::disjunction<is_insert<T>, is_insert_range<T>>::value, bool> = true>
+            void statement_performed(const T&) {}
+
+            template<class T, class... Args>
+            void statement_performed(const remove_all_t<T, Args...>&) {
+                //  only a DELETE without conditions is eligible for the truncate optimization,
+                //  rows deleted otherwise are reported by the update hook
+                if(sizeof...(Args) == 0) {
+                    this->table_truncated(this->change_key<T>());
                 }
-                auto statement =
-                    this->prepare(sqlite_orm::insert_range(std::move(from), std::move(to), std::move(project)));
-                this->execute(statement);
             }
 
-            template<class O, class It, class Projection = polyfill::identity>
-            void insert_range(It from, It to, Projection project = {}) {
-                this->assert_mapped_type<O>();
-                this->assert_insertable_type<O>();
-                if(from == to) {
-                    return;
+            template<class S, class... Wargs>
+            void statement_performed(const update_all_t<S, Wargs...>& statement) {
+                if(!this->objectCaches.empty()) {
+                    this->keys_assigned(statement.set);
                 }
-                auto statement =
-                    this->prepare(sqlite_orm::insert_range<O>(std::move(from), std::move(to), std::move(project)));
-                this->execute(statement);
             }
 
             /**
-             * Change table name inside storage's schema info. This function does not
-             * affect database
+             *  The update hook reports an UPDATE by the new rowid only, so once a primary key column or the rowid
+             *  is assigned, objects cached under their old keys can't be found and the caches of the updated tables
+             *  are dropped.
              */
-            template<class O>
-            void rename_table(std::string name) {
-                this->assert_mapped_type<O>();
-                auto& table = this->get_table<O>();
-                table.name = std::move(name);
+            template<class... Args>
+            void keys_assigned(const set_t<Args...>& set) {
+                bool keyAssigned = false;
+                auto collector = make_table_name_collector(this->db_objects);
+                iterate_tuple(set.assigns, [this, &keyAssigned, &collector](auto& assign) {
+                    keyAssigned = keyAssigned || this->is_key(assign.lhs);
+                    iterate_ast(assign.lhs, collector);
+                });
+                if(keyAssigned) {
+                    this->clear_caches_of(collector);
+                }
             }
 
-            using storage_base::rename_table;
+            template<class C>
+            void keys_assigned(const dynamic_set_t<C>& set) {
+                //  the assignments are serialized already, any of them might assign a key
+                this->clear_caches_of(set.collector);
+            }
+
+            void clear_caches_of(const table_name_collector_base& tables) {
+                for(auto& table: tables.table_schemas) {
+                    auto it = this->objectCaches.find(storage_base::change_key(table.second, table.first.first));
+                    if(it != this->objectCaches.end()) {
+                        it->second->clear();
+                    }
+                }
+            }
+
+            template<class F, class O>
+            bool is_key(F O::*memberPointer) const {
+                return this->is_key_of<O>(memberPointer);
+            }
+
+            template<class T, class F>
+            bool is_key(const column_pointer<T, F>& column) const {
+                return this->is_key_of<mapped_type_proxy_t<T>>(column.field);
+            }
+
+            template<class T>
+            bool is_key(const T&) const {
+                return std::is_base_of<rowid_t, T>::value || std::is_base_of<oid_t, T>::value ||
+                       std::is_base_of<_rowid_t, T>::value;
+            }
+
+            template<class O, class M>
+            bool is_key_of(M memberPointer) const {
+                auto& table = this->get_table<O>();
+                const std::string* columnName = table.find_column_name(memberPointer);
+                if(!columnName) {
+                    return false;
+                }
+                auto keyColumnNames = table.primary_key_column_names();
+                return std::find(keyColumnNames.begin(), keyColumnNames.end(), *columnName) != keyColumnNames.end();
+            }
 
             /**
-             * Get table's name stored in storage's schema info. This function does not call
-             * any SQLite queries
+             *  Looks up an object in the cache enabled with `enable_object_cache<O>()`, loading and caching it
+             *  on a miss.
+             *  @return false if the object cache doesn't apply, in which case `result` is left untouched
              */
-            template<class O>
-            const std::string& tablename() const {
-                this->assert_mapped_type<O>();
-                auto& table = this->get_table<O>();
-                return table.name;
+            template<class O, class... Ids>
+            bool get_through_cache(std::shared_ptr<const O>&, const Ids&...) {
+                return false;
             }
 
-            template<class F, class O>
-            [[deprecated("Use the more accurately named function `find_column_name()`")]] const std::string*
-            column_name(F O::*memberPointer) const {
-                return internal::find_column_name(this->db_objects, memberPointer);
+            template<class O, class Id, satisfies<std::is_integral, Id> = true>
+            bool get_through_cache(std::shared_ptr<const O>& result, const Id& id) {
+                if(this->objectCaches.empty() || !this->connection_kept_open()) {
+                    return false;
+                }
+                auto it = this->objectCaches.find(this->change_key<O>());
+                if(it == this->objectCaches.end()) {
+                    return false;
+                }
+                auto& cache = static_cast<object_cache<O>&>(*it->second);
+                auto connection = this->get_connection();
+                sqlite3* db = connection.get();
+                this->validate_caches(db);
+                result = cache.find(int64(id));
+                if(result) {
+                    return true;
+                }
+                auto statement = this->prepare(sqlite_orm::get_pointer<O>(id));
+                result = this->execute(statement);
+                //  uncommitted objects must not outlive a rollback
+                if(result && sqlite3_get_autocommit(db)) {
+                    cache.insert(int64(id), result);
+                }
+                return true;
             }
 
-            template<class F, class O>
-            const std::string* find_column_name(F O::*memberPointer) const {
-                return internal::find_column_name(this->db_objects, memberPointer);
+#ifdef SQLITE_ENABLE_PREUPDATE_HOOK
+            template<class O>
+            std::unique_ptr<O> make_preupdate_object(sqlite3* db, int (*getValue)(sqlite3*, int, sqlite3_value**)) {
+                auto object = std::make_unique<O>();
+                auto& table = this->get_table<O>();
+                int columnIndex = 0;
+                table.for_each_column([db, getValue, &object, &columnIndex](auto& column) {
+                    sqlite3_value* value = nullptr;
+                    if(getValue(db, columnIndex++, &value) != SQLITE_OK) {
+                        throw_translated_sqlite_error(db);
+                    }
+                    using column_type = std::remove_reference_t<decltype(column)>;
+                    auto fieldValue = boxed_value_extractor<typename column_type::field_type>().extract(value);
+                    static_if<std::is_member_object_pointer<typename column_type::member_pointer_t>::value>(
+                        [&fieldValue, &object](const auto& column) {
+                            (*object).*column.member_pointer = std::move(fieldValue);
+                        },
+                        [&fieldValue, &object](const auto& column) {
+                            ((*object).*column.setter)(std::move(fieldValue));
+                        })(column);
+                });
+                return object;
             }
+#endif
 
-          protected:
             template<class M>
             sync_schema_result schema_status(const virtual_table_t<M>&, sqlite3*, bool, bool*) {
                 return sync_schema_result::already_in_sync;
@@ -22927,11 +27779,101 @@ namespace sqlite_orm {
                 return sync_schema_result::already_in_sync;
             }
 
+            /**
+             *  An existing index whose structure differs from the mapped one has to be dropped and recreated.
+             *  Uniqueness, key columns and expressions with their order and collation and the condition of a
+             *  partial index are compared, so an index created with differently formatted SQL is still in sync.
+             */
             template<class... Cols>
-            sync_schema_result schema_status(const index_t<Cols...>&, sqlite3*, bool, bool*) {
+            sync_schema_result schema_status(const index_t<Cols...>& index, sqlite3* db, bool, bool*) {
+                using indexed_type = typename index_t<Cols...>::table_mapped_type;
+                auto schemaName = lookup_table_schema<indexed_type>(this->db_objects);
+                index_structure dbIndex;
+                if(!this->read_index_structure(db,
+                                               schemaName,
+                                               lookup_table_name<indexed_type>(this->db_objects),
+                                               index.name,
+                                               dbIndex)) {
+                    //  an index with this name on another table has to be moved
+                    return this->index_sql(db, schemaName, index.name).empty()
+                               ? sync_schema_result::already_in_sync
+                               : sync_schema_result::dropped_and_recreated;
+                }
+                if(dbIndex != this->mapped_index_structure(index)) {
+                    return sync_schema_result::dropped_and_recreated;
+                }
                 return sync_schema_result::already_in_sync;
             }
 
+            template<class... Cols>
+            index_structure mapped_index_structure(const index_t<Cols...>& index) {
+                using context_t = serializer_context<db_objects_type>;
+                context_t context{this->db_objects};
+                context.use_parentheses = false;
+                index_structure result;
+                result.unique = index.unique;
+                iterate_tuple(index.elements, [this, &index, &result, &context](auto& element) {
+                    this->add_index_element(index, result, element, context);
+                });
+                return result;
+            }
+
+            template<class I, class C, class Ctx>
+            void add_index_element(const I&, index_structure& result, const where_t<C>& where, const Ctx& context) {
+                result.condition = normalized_index_condition(internal::serialize(where, context));
+            }
+
+            template<class I, class C, class Ctx>
+            void add_index_element(const I&,
+                                   index_structure& result,
+                                   const indexed_column_t<C>& column,
+                                   const Ctx& context) {
+                index_key_column keyColumn;
+                keyColumn.desc = column._order == -1;
+                keyColumn.collation = column._collation_name;
+                this->describe_index_column<typename I::table_mapped_type>(keyColumn,
+                                                                           column.column_or_expression,
+                                                                           context);
+                if(keyColumn.collation.empty()) {
+                    keyColumn.collation = "BINARY";
+                }
+                result.columns.push_back(std::move(keyColumn));
+            }
+
+            /**
+             *  Name of an indexed column and, unless the index specifies one, the collation the column is
+             *  declared with, which the index inherits.
+             */
+            template<class O, class M, class Ctx, satisfies<std::is_member_pointer, M> = true>
+            void describe_index_column(index_key_column& keyColumn, M memberPointer, const Ctx&) {
+                const bool inheritCollation = keyColumn.collation.empty();
+                this->get_table<O>().for_each_column([&keyColumn, memberPointer, inheritCollation](auto& column) {
+                    if(!compare_any(column.member_pointer, memberPointer) &&
+                       !compare_any(column.setter, memberPointer)) {
+                        return;
+                    }
+                    keyColumn.name = column.name;
+                    if(inheritCollation) {
+                        iterate_tuple(column.constraints, [&keyColumn](auto& constraint) {
+                            apply_collation(keyColumn.collation, constraint);
+                        });
+                    }
+                });
+            }
+
+            //  expressions have no name and no collation of their own
+            template<class O, class E, class Ctx, satisfies_not<std::is_member_pointer, E> = true>
+            void describe_index_column(index_key_column& keyColumn, const E& expression, const Ctx& context) {
+                keyColumn.expression = normalized_sql_expression(internal::serialize(expression, context));
+            }
+
+            static void apply_collation(std::string& collation, const collate_constraint_t& constraint) {
+                collation = collate_constraint_t::string_from_collate_argument(constraint.argument);
+            }
+
+            template<class T>
+            static void apply_collation(std::string&, const T&) {}
+
             template<class T, bool WithoutRowId, class... Cs>
             sync_schema_result schema_status(const table_t<T, WithoutRowId, Cs...>& table,
                                              sqlite3* db,
@@ -22941,11 +27883,11 @@ namespace sqlite_orm {
                     *attempt_to_preserve = true;
                 }
 
-                auto dbTableInfo = this->pragma.table_xinfo(table.name);
+                auto dbTableInfo = this->pragma.table_xinfo(table.schema_name, table.name);
                 auto res = sync_schema_result::already_in_sync;
 
                 //  first let's see if table with such name exists..
-                auto gottaCreateTable = !this->table_exists(db, table.name);
+                auto gottaCreateTable = !this->table_exists(db, table.schema_name, table.name);
                 if(!gottaCreateTable) {
 
                     //  get table info provided in `make_table` call..
@@ -23024,19 +27966,84 @@ namespace sqlite_orm {
                 auto res = sync_schema_result::already_in_sync;
                 using context_t = serializer_context<db_objects_type>;
                 context_t context{this->db_objects};
-                auto query = serialize(virtualTable, context);
+                auto query = internal::serialize(virtualTable, context);
                 perform_void_exec(db, query);
                 return res;
             }
 
+            /**
+             *  Creates the index if it doesn't exist. A changed index is only reported here and rebuilt later by
+             *  `rebuild_indexes()` together with all other changed indexes.
+             */
             template<class... Cols>
-            sync_schema_result sync_table(const index_t<Cols...>& index, sqlite3* db, bool) {
-                auto res = sync_schema_result::already_in_sync;
+            sync_schema_result sync_table(const index_t<Cols...>& index, sqlite3* db, bool preserve) {
+                auto res = this->schema_status(index, db, preserve, nullptr);
+                if(res == sync_schema_result::already_in_sync) {
+                    using context_t = serializer_context<db_objects_type>;
+                    context_t context{this->db_objects};
+                    auto query = internal::serialize(index, context);
+                    perform_void_exec(db, query);
+                }
+                return res;
+            }
+
+            /**
+             *  Drops and recreates every index reported as `dropped_and_recreated` in `syncResult` in one
+             *  transaction and runs ANALYZE on the tables they belong to, so the query planner has fresh
+             *  statistics for the new indexes.
+             */
+            void rebuild_indexes(sqlite3* db, const std::map<std::string, sync_schema_result>& syncResult) {
+                std::vector<std::string> statements;
+                //  schema qualified and quoted names of the tables to analyze
+                std::set<std::string> tableIdentifiers;
+                iterate_tuple(this->db_objects,
+                              [this, &syncResult, &statements, &tableIdentifiers](auto& schemaObject) {
+                                  this->collect_index_rebuild(schemaObject, syncResult, statements, tableIdentifiers);
+                              });
+                if(statements.empty()) {
+                    return;
+                }
+                for(auto& tableIdentifier: tableIdentifiers) {
+                    statements.push_back("ANALYZE " + tableIdentifier);
+                }
+                //  a savepoint works both inside and outside of a transaction
+                perform_void_exec(db, "SAVEPOINT sqlite_orm_rebuild_indexes");
+                try {
+                    for(auto& statement: statements) {
+                        perform_void_exec(db, statement);
+                    }
+                } catch(...) {
+                    sqlite3_exec(db, "ROLLBACK TO sqlite_orm_rebuild_indexes", nullptr, nullptr, nullptr);
+                    sqlite3_exec(db, "RELEASE sqlite_orm_rebuild_indexes", nullptr, nullptr, nullptr);
+                    throw;
+                }
+                perform_void_exec(db, "RELEASE sqlite_orm_rebuild_indexes");
+            }
+
+            template<class E>
+            void collect_index_rebuild(const E&,
+                                       const std::map<std::string, sync_schema_result>&,
+                                       std::vector<std::string>&,
+                                       std::set<std::string>&) {}
+
+            template<class... Cols>
+            void collect_index_rebuild(const index_t<Cols...>& index,
+                                       const std::map<std::string, sync_schema_result>& syncResult,
+                                       std::vector<std::string>& statements,
+                                       std::set<std::string>& tableIdentifiers) {
+                auto it = syncResult.find(index.name);
+                if(it == syncResult.end() || it->second != sync_schema_result::dropped_and_recreated) {
+                    return;
+                }
                 using context_t = serializer_context<db_objects_type>;
                 context_t context{this->db_objects};
-                auto query = serialize(index, context);
-                perform_void_exec(db, query);
-                return res;
+                using indexed_type = typename index_t<Cols...>::table_mapped_type;
+                auto schemaName = lookup_table_schema<indexed_type>(this->db_objects);
+                auto qualifier = schemaName.empty() ? std::string{} : quote_identifier(schemaName) + ".";
+                statements.push_back("DROP INDEX IF EXISTS " + qualifier + quote_identifier(index.name));
+                statements.push_back(internal::serialize(index, context));
+                auto& tableName = lookup_table_name<indexed_type>(this->db_objects);
+                tableIdentifiers.insert(qualifier + quote_identifier(tableName));
             }
 
             template<class... Cols>
@@ -23044,7 +28051,7 @@ namespace sqlite_orm {
                 auto res = sync_schema_result::already_in_sync;  // TODO Change accordingly
                 using context_t = serializer_context<db_objects_type>;
                 context_t context{this->db_objects};
-                auto query = serialize(trigger, context);
+                auto query = internal::serialize(trigger, context);
                 perform_void_exec(db, query);
                 return res;
             }
@@ -23053,13 +28060,14 @@ namespace sqlite_orm {
             sync_schema_result sync_table(const Table& table, sqlite3* db, bool preserve);
 
             template<class C>
-            void add_column(sqlite3* db, const std::string& tableName, const C& column) const {
+            void add_column(sqlite3* db, const std::string& schemaName, const std::string& tableName, const C& column)
+                const {
                 using context_t = serializer_context<db_objects_type>;
 
                 context_t context{this->db_objects};
                 std::stringstream ss;
-                ss << "ALTER TABLE " << streaming_identifier(tableName) << " ADD COLUMN " << serialize(column, context)
-                   << std::flush;
+                ss << "ALTER TABLE " << streaming_identifier(schemaName, tableName, std::string{}) << " ADD COLUMN "
+                   << internal::serialize(column, context) << std::flush;
                 perform_void_exec(db, ss.str());
             }
 
@@ -23088,7 +28096,7 @@ namespace sqlite_orm {
                 context.replace_bindable_with_question = parametrized;
                 // just like prepare_impl()
                 context.skip_table_name = false;
-                return serialize(expression, context);
+                return internal::serialize(expression, context);
             }
 
             template<typename S>
@@ -23100,7 +28108,8 @@ namespace sqlite_orm {
                 context.replace_bindable_with_question = true;
 
                 auto con = this->get_connection();
-                std::string sql = serialize(statement, context);
+                std::string sql = internal::serialize(statement, context);
+                this->record_query(sql);
                 sqlite3_stmt* stmt = prepare_stmt(con.get(), std::move(sql));
                 return prepared_statement_t<S>{std::forward<S>(statement), stmt, con};
             }
@@ -23124,6 +28133,12 @@ namespace sqlite_orm {
              * file at all it will be created and all tables also will be created with exact tables and columns you
              * specified in `make_storage`, `make_table` and `make_column` calls. The best practice is to call this
              * function right after storage creation.
+             *  * every index from storage is compared with the structure of the existing index, which `PRAGMA
+             * index_list` and `PRAGMA index_xinfo` report (indexed expressions and the partial `WHERE` are compared
+             * in their normalized SQL), and if it differs (columns or expressions, order, collation, partial `WHERE`
+             * or uniqueness) it is reported as `dropped_and_recreated`. All
+             * changed indexes are rebuilt in one transaction after the tables are synced, followed by `ANALYZE` of
+             * their tables.
              *  @param preserve affects function's behaviour in case it is needed to remove a column. If it is `false`
              * so table will be dropped if there is column to remove if SQLite version is < 3.35.0 and remove column if SQLite version >= 3.35.0,
              * if `true` -  table is being copied into another table, dropped and copied table is renamed with source table name.
@@ -23136,10 +28151,63 @@ namespace sqlite_orm {
             std::map<std::string, sync_schema_result> sync_schema(bool preserve = false) {
                 auto con = this->get_connection();
                 std::map<std::string, sync_schema_result> result;
+                //  copying rows into recreated tables invokes change callbacks
+                this->changeHookError = nullptr;
                 iterate_tuple<true>(this->db_objects, [this, db = con.get(), preserve, &result](auto& schemaObject) {
                     sync_schema_result status = this->sync_table(schemaObject, db, preserve);
                     result.emplace(schemaObject.name, status);
                 });
+                this->rebuild_indexes(con.get(), result);
+                this->rethrow_change_hook_error();
+                return result;
+            }
+
+            /**
+             *  Same as `sync_schema(true)` but tables which have to be recreated are copied online
+             *  rather than with a single `INSERT INTO ... SELECT` which blocks writers for the whole copy:
+             *  * rows are copied in rowid order in chunks of `options.chunk_size` rows, each chunk in its own
+             *    transaction, so other connections can write between chunks
+             *  * triggers on the old table mirror inserts, updates and deletes to the copy while it is being made
+             *  * the old table is dropped and the copy renamed in one last transaction
+             *  `options.on_progress` is called after every chunk with the number of copied rows and an estimate
+             *  of the remaining time. WITHOUT ROWID tables, tables whose INTEGER PRIMARY KEY changes and calls made
+             *  inside of a transaction fall back to the single statement copy.
+             *  If the copy fails the triggers and the partial copy are dropped and the old table is left untouched.
+             */
+            std::map<std::string, sync_schema_result> sync_schema_online(const online_migration_options& options) {
+                this->onlineMigration = &options;
+                try {
+                    auto result = this->sync_schema(true);
+                    this->onlineMigration = nullptr;
+                    return result;
+                } catch(...) {
+                    this->onlineMigration = nullptr;
+                    throw;
+                }
+            }
+
+            /**
+             *  Same as `sync_schema()` but skips comparing the schema with the database when nothing has changed
+             *  since the last call, which saves reading `table_xinfo` of every table on startup.
+             *  A fingerprint of the storage schema (a hash of the SQL creating all tables, indexes, triggers and
+             *  virtual tables) is stored in the "_sqlite_orm_schema" table together with `PRAGMA schema_version`
+             *  after a sync. If both still match the sync is skipped and every object is reported as
+             *  `sync_schema_result::already_in_sync`, otherwise the full `sync_schema(preserve)` is performed.
+             *  Because of the schema version any schema change made outside of the storage forces the full sync too.
+             */
+            std::map<std::string, sync_schema_result> sync_schema_if_changed(bool preserve = false) {
+                auto con = this->get_connection();
+                sqlite3* db = con.get();
+                const std::string fingerprint = this->schema_fingerprint();
+                if(this->schema_fingerprint_matches(db, fingerprint)) {
+                    std::map<std::string, sync_schema_result> result;
+                    iterate_tuple<true>(this->db_objects, [&result](auto& schemaObject) {
+                        result.emplace(schemaObject.name, sync_schema_result::already_in_sync);
+                    });
+                    return result;
+                }
+                auto result = this->sync_schema(preserve);
+                this->store_schema_fingerprint(db, fingerprint);
                 return result;
             }
 
@@ -23213,6 +28281,13 @@ namespace sqlite_orm {
                 return this->prepare_impl(std::move(statement));
             }
 
+#if SQLITE_VERSION_NUMBER >= 3035000
+            template<class S, class C>
+            prepared_statement_t<returning_t<S, C>> prepare(returning_t<S, C> statement) {
+                return this->prepare_impl(std::move(statement));
+            }
+#endif
+
             template<class T, class... Ids>
             prepared_statement_t<get_t<T, Ids...>> prepare(get_t<T, Ids...> statement) {
                 return this->prepare_impl(std::move(statement));
@@ -23286,7 +28361,8 @@ namespace sqlite_orm {
             void execute(const prepared_statement_t<replace_raw_t<Args...>>& statement) {
                 sqlite3_stmt* stmt = reset_stmt(statement.stmt);
                 iterate_ast(statement.expression, conditional_binder{stmt});
-                perform_step(stmt);
+                this->perform_change_step(stmt);
+                this->rows_replaced();
             }
 
 #if(SQLITE_VERSION_NUMBER >= 3008003) && defined(SQLITE_ORM_WITH_CTE)
@@ -23294,7 +28370,7 @@ namespace sqlite_orm {
             void execute(const prepared_statement_t<with_t<E, CTEs...>>& statement) {
                 sqlite3_stmt* stmt = reset_stmt(statement.stmt);
                 iterate_ast(statement.expression, conditional_binder{stmt});
-                perform_step(stmt);
+                this->perform_change_step(stmt);
             }
 #endif
 
@@ -23302,7 +28378,15 @@ namespace sqlite_orm {
             void execute(const prepared_statement_t<insert_raw_t<Args...>>& statement) {
                 sqlite3_stmt* stmt = reset_stmt(statement.stmt);
                 iterate_ast(statement.expression, conditional_binder{stmt});
-                perform_step(stmt);
+                this->perform_change_step(stmt);
+                using args_tuple = typename insert_raw_t<Args...>::args_tuple;
+                iterate_tuple(statement.expression.args,
+                              filter_tuple_sequence_t<args_tuple, is_insert_constraint>{},
+                              [this](const insert_constraint& constraint) {
+                                  if(constraint.action == conflict_action::replace) {
+                                      this->rows_replaced();
+                                  }
+                              });
             }
 
             template<class T, class... Cols>
@@ -23316,93 +28400,25 @@ namespace sqlite_orm {
                     [&table = this->get_table<object_type>(), &object = statement.expression.obj](auto& memberPointer) {
                         return table.object_field_value(object, memberPointer);
                     });
-                perform_step(stmt);
+                this->perform_change_step(stmt);
                 return sqlite3_last_insert_rowid(sqlite3_db_handle(stmt));
             }
 
             template<class T,
                      std::enable_if_t<polyfill::disjunction<is_replace<T>, is_replace_range<T>>::value, bool> = true>
             void execute(const prepared_statement_t<T>& statement) {
-                using object_type = statement_object_type_t<decltype(statement)>;
-
                 sqlite3_stmt* stmt = reset_stmt(statement.stmt);
-
-                auto processObject = [&table = this->get_table<object_type>(),
-                                      bindValue = field_value_binder{stmt}](auto& object) mutable {
-                    table.template for_each_column_excluding<is_generated_always>(
-                        call_as_template_base<column_field>([&bindValue, &object](auto& column) {
-                            bindValue(polyfill::invoke(column.member_pointer, object));
-                        }));
-                };
-
-                static_if<is_replace_range<T>::value>(
-                    [&processObject](auto& expression) {
-#if __cpp_lib_ranges >= 201911L
-                        std::ranges::for_each(expression.range.first,
-                                              expression.range.second,
-                                              std::ref(processObject),
-                                              std::ref(expression.transformer));
-#else
-                        auto& transformer = expression.transformer;
-                        std::for_each(expression.range.first,
-                                      expression.range.second,
-                                      [&processObject, &transformer](auto& item) {
-                                          const object_type& object = polyfill::invoke(transformer, item);
-                                          processObject(object);
-                                      });
-#endif
-                    },
-                    [&processObject](auto& expression) {
-                        const object_type& o = get_object(expression);
-                        processObject(o);
-                    })(statement.expression);
-
-                perform_step(stmt);
+                this->bind_statement(stmt, statement.expression);
+                this->perform_change_step(stmt);
+                this->statement_performed(statement.expression);
             }
 
             template<class T,
                      std::enable_if_t<polyfill::disjunction<is_insert<T>, is_insert_range<T>>::value, bool> = true>
             int64 execute(const prepared_statement_t<T>& statement) {
-                using object_type = statement_object_type_t<decltype(statement)>;
-
                 sqlite3_stmt* stmt = reset_stmt(statement.stmt);
-
-                auto processObject = [&table = this->get_table<object_type>(),
-                                      bindValue = field_value_binder{stmt}](auto& object) mutable {
-                    using is_without_rowid = typename std::decay_t<decltype(table)>::is_without_rowid;
-                    table.template for_each_column_excluding<
-                        mpl::conjunction<mpl::not_<mpl::always<is_without_rowid>>,
-                                         mpl::disjunction_fn<is_primary_key, is_generated_always>>>(
-                        call_as_template_base<column_field>([&table, &bindValue, &object](auto& column) {
-                            if(!exists_in_composite_primary_key(table, column)) {
-                                bindValue(polyfill::invoke(column.member_pointer, object));
-                            }
-                        }));
-                };
-
-                static_if<is_insert_range<T>::value>(
-                    [&processObject](auto& expression) {
-#if __cpp_lib_ranges >= 201911L
-                        std::ranges::for_each(expression.range.first,
-                                              expression.range.second,
-                                              std::ref(processObject),
-                                              std::ref(expression.transformer));
-#else
-                        auto& transformer = expression.transformer;
-                        std::for_each(expression.range.first,
-                                      expression.range.second,
-                                      [&processObject, &transformer](auto& item) {
-                                          const object_type& object = polyfill::invoke(transformer, item);
-                                          processObject(object);
-                                      });
-#endif
-                    },
-                    [&processObject](auto& expression) {
-                        const object_type& o = get_object(expression);
-                        processObject(o);
-                    })(statement.expression);
-
-                perform_step(stmt);
+                this->bind_statement(stmt, statement.expression);
+                this->perform_change_step(stmt);
                 return sqlite3_last_insert_rowid(sqlite3_db_handle(stmt));
             }
 
@@ -23410,7 +28426,7 @@ namespace sqlite_orm {
             void execute(const prepared_statement_t<remove_t<T, Ids...>>& statement) {
                 sqlite3_stmt* stmt = reset_stmt(statement.stmt);
                 iterate_ast(statement.expression.ids, conditional_binder{stmt});
-                perform_step(stmt);
+                this->perform_change_step(stmt);
             }
 
             template<class T>
@@ -23433,7 +28449,7 @@ namespace sqlite_orm {
                         bindValue(polyfill::invoke(column.member_pointer, object));
                     }
                 });
-                perform_step(stmt);
+                this->perform_change_step(stmt);
             }
 
             template<class T, class... Ids>
@@ -23506,18 +28522,50 @@ namespace sqlite_orm {
             template<class T, class... Args>
             void execute(const prepared_statement_t<remove_all_t<T, Args...>>& statement) {
                 sqlite3_stmt* stmt = reset_stmt(statement.stmt);
-                iterate_ast(statement.expression.conditions, conditional_binder{stmt});
-                perform_step(stmt);
+                this->bind_statement(stmt, statement.expression);
+                this->perform_change_step(stmt);
+                this->statement_performed(statement.expression);
             }
 
             template<class S, class... Wargs>
             void execute(const prepared_statement_t<update_all_t<S, Wargs...>>& statement) {
                 sqlite3_stmt* stmt = reset_stmt(statement.stmt);
+                this->bind_statement(stmt, statement.expression);
+                this->perform_change_step(stmt);
+                this->statement_performed(statement.expression);
+            }
+
+#if SQLITE_VERSION_NUMBER >= 3035000
+            template<class S, class C>
+            auto execute(const prepared_statement_t<returning_t<S, C>>& statement) {
+                sqlite3_stmt* stmt = reset_stmt(statement.stmt);
+                this->bind_statement(stmt, statement.expression.statement);
+                // the RETURNING clause comes last, so its parameters are the last ones
+                int columnsParametersCount = 0;
+                iterate_ast(statement.expression.columns, [&columnsParametersCount](auto& node) {
+                    if(is_bindable<std::decay_t<decltype(node)>>::value) {
+                        ++columnsParametersCount;
+                    }
+                });
                 conditional_binder bindNode{stmt};
-                iterate_ast(statement.expression.set, bindNode);
-                iterate_ast(statement.expression.conditions, bindNode);
-                perform_step(stmt);
+                bindNode.index = sqlite3_bind_parameter_count(stmt) - columnsParametersCount + 1;
+                iterate_ast(statement.expression.columns, bindNode);
+
+                using ColResult = column_result_of_t<db_objects_type, C>;
+                using R = decltype(make_row_extractor<ColResult>(this->db_objects).extract(nullptr, 0));
+                std::vector<R> res;
+                this->changeHookError = nullptr;
+                perform_steps(
+                    stmt,
+                    [rowExtractor = make_row_extractor<ColResult>(this->db_objects), &res](sqlite3_stmt* stmt) {
+                        res.push_back(rowExtractor.extract(stmt, 0));
+                    });
+                this->rethrow_change_hook_error();
+                this->statement_performed(statement.expression.statement);
+                res.shrink_to_fit();
+                return res;
             }
+#endif
 
 #if(SQLITE_VERSION_NUMBER >= 3008003) && defined(SQLITE_ORM_WITH_CTE)
             template<class... CTEs, class T, class... Args>
@@ -23860,6 +28908,30 @@ namespace sqlite_orm {
         template<class F, class W>
         struct node_tuple<filtered_aggregate_function<F, W>, void> : node_tuple_for<F, W> {};
 
+        template<class R, class S, class... Args>
+        struct node_tuple<built_in_window_function_t<R, S, Args...>, void> : node_tuple_for<Args...> {};
+
+        template<class F, class W>
+        struct node_tuple<over_t<F, W>, void> : node_tuple_for<F, W> {};
+
+        template<class... Args>
+        struct node_tuple<window_defn_t<Args...>, void> : node_tuple_for<Args...> {};
+
+        template<class... Args>
+        struct node_tuple<window_t<Args...>, void> : node_tuple_for<Args...> {};
+
+        template<class... Args>
+        struct node_tuple<partition_by_t<Args...>, void> : node_tuple_for<Args...> {};
+
+        template<class B, class E>
+        struct node_tuple<frame_t<B, E>, void> : node_tuple_for<B, E> {};
+
+        template<class T>
+        struct node_tuple<preceding_t<T>, void> : node_tuple<T> {};
+
+        template<class T>
+        struct node_tuple<following_t<T>, void> : node_tuple<T> {};
+
         template<class F, class... Args>
         struct node_tuple<function_call<F, Args...>, void> : node_tuple_for<Args...> {};
 
@@ -24257,50 +29329,355 @@ namespace sqlite_orm {
                           make_column("sql", &sqlite_master::sql));
     }
 
-#ifdef SQLITE_ORM_WITH_CPP20_ALIASES
-    inline constexpr orm_table_reference auto sqlite_master_table = c<sqlite_master>();
-    inline constexpr orm_table_alias auto sqlite_schema = "sqlite_schema"_alias.for_<sqlite_master>();
-#endif
-}
-#pragma once
+#ifdef SQLITE_ORM_WITH_CPP20_ALIASES
+    inline constexpr orm_table_reference auto sqlite_master_table = c<sqlite_master>();
+    inline constexpr orm_table_alias auto sqlite_schema = "sqlite_schema"_alias.for_<sqlite_master>();
+#endif
+}
+#pragma once
+
+#ifdef SQLITE_ENABLE_DBSTAT_VTAB
+#include <string>  //  std::string
+#endif
+
+// #include "../schema/column.h"
+
+// #include "../schema/table.h"
+
+namespace sqlite_orm {
+#ifdef SQLITE_ENABLE_DBSTAT_VTAB
+    struct dbstat {
+        std::string name;
+        std::string path;
+        int pageno = 0;
+        std::string pagetype;
+        int ncell = 0;
+        int payload = 0;
+        int unused = 0;
+        int mx_payload = 0;
+        int pgoffset = 0;
+        int pgsize = 0;
+    };
+
+    inline auto make_dbstat_table() {
+        return make_table("dbstat",
+                          make_column("name", &dbstat::name),
+                          make_column("path", &dbstat::path),
+                          make_column("pageno", &dbstat::pageno),
+                          make_column("pagetype", &dbstat::pagetype),
+                          make_column("ncell", &dbstat::ncell),
+                          make_column("payload", &dbstat::payload),
+                          make_column("unused", &dbstat::unused),
+                          make_column("mx_payload", &dbstat::mx_payload),
+                          make_column("pgoffset", &dbstat::pgoffset),
+                          make_column("pgsize", &dbstat::pgsize));
+    }
+#endif  //  SQLITE_ENABLE_DBSTAT_VTAB
+}
+#pragma once
+
+#include <algorithm>  //  std::make_heap, std::push_heap, std::pop_heap
+#include <cstdint>  //  std::uint64_t
+#include <iterator>  //  std::make_move_iterator
+#include <future>  //  std::future, std::async
+#include <map>  //  std::map
+#include <memory>  //  std::unique_ptr
+#include <string>  //  std::string
+#include <system_error>  //  std::system_error
+#include <type_traits>  //  std::decay_t, std::enable_if_t, std::is_integral
+#include <utility>  //  std::declval, std::move, std::pair, std::index_sequence
+#include <vector>  //  std::vector
+
+// #include "functional/cxx_universal.h"
+//  ::size_t
+// #include "error_code.h"
+
+// #include "constraints.h"
+
+// #include "schema/column.h"
+
+// #include "select_constraints.h"
+
+// #include "schema_fingerprint.h"
+
+// #include "storage_lookup.h"
+
+// #include "sync_schema_result.h"
+
+namespace sqlite_orm {
+
+    namespace internal {
+
+        /**
+         *  Maps a shard key to its shard. Unlike `std::hash` it's the same with every standard library, so shards
+         *  written by one build are read correctly by another.
+         */
+        template<class K, std::enable_if_t<std::is_integral<K>::value, bool> = true>
+        std::uint64_t shard_hash(K key) {
+            return std::uint64_t(key);
+        }
+
+        inline std::uint64_t shard_hash(const std::string& key) {
+            return fnv1a_hash(key);
+        }
+
+        /**
+         *  Storages with the same schema on separate database files (shards). Objects are distributed over the
+         *  shards by a shard key, so writes to different shards don't wait for each other's write lock.
+         *
+         *  Object operations go to the shard of the object's key, which `shardKey(object)` returns. Operations
+         *  taking primary key values (`get`, `get_pointer`, `remove`) use the first one as the key, so the shard
+         *  key has to be the (first) primary key column for them to find their objects. Note that objects must
+         *  carry their key when they are inserted: rowids generated by the shards are unique only within a shard, so
+         *  `insert` stores the primary key of the object too rather than letting the shard generate one.
+         *
+         *  Queries (`get_all`, `select`, `count`, `remove_all`) run on all shards in parallel, one thread per shard,
+         *  and their results are concatenated in the order of the shards. `get_all_merged` and `select_merged` merge
+         *  results which every shard returns sorted (by an `order_by` condition) into one sorted result.
+         *
+         *  S - storage type (`storage_t`)
+         *  KeyFn - shard key extractor, called with a mapped object
+         */
+        template<class S, class KeyFn>
+        struct sharded_storage {
+            using storage_type = S;
+
+            sharded_storage(std::vector<std::unique_ptr<storage_type>> shards, KeyFn shardKey) :
+                shards{std::move(shards)}, shardKey{std::move(shardKey)} {}
+
+            size_t shards_count() const {
+                return this->shards.size();
+            }
+
+            storage_type& shard(size_t index) {
+                return *this->shards.at(index);
+            }
+
+            /**
+             *  Index of the shard objects with the given shard key live in. The mapping doesn't depend on the
+             *  standard library or the platform, so database files written by one build are read by another:
+             *  integral keys are taken modulo the number of shards (negative ones as their 64-bit two's complement),
+             *  strings are hashed with 64-bit FNV-1a first.
+             */
+            template<class K>
+            size_t shard_index(const K& key) const {
+                return size_t(shard_hash(key) % this->shards.size());
+            }
+
+            template<class K>
+            storage_type& shard_for(const K& key) {
+                return *this->shards[this->shard_index(key)];
+            }
+
+            /**
+             *  Syncs the schema of all shards, returns the result of the first one.
+             */
+            std::map<std::string, sync_schema_result> sync_schema(bool preserve = false) {
+                auto results = this->fan_out([preserve](storage_type& storage) {
+                    return storage.sync_schema(preserve);
+                });
+                return std::move(results.front());
+            }
+
+            /**
+             *  Inserts the object with all its columns including the primary key, which chooses the shard.
+             *  @return rowid of the inserted row, which equals an integer primary key.
+             */
+            template<class O>
+            int insert(const O& object) {
+                auto& storage = this->shard_of(object);
+                auto& table = pick_table<O>(obtain_db_objects(storage));
+                using elements_type = typename std::decay_t<decltype(table)>::elements_type;
+                return storage.insert(
+                    object,
+                    insertable_columns(table, col_index_sequence_excluding<elements_type, is_generated_always>{}));
+            }
+
+            template<class O>
+            void replace(const O& object) {
+                this->shard_of(object).replace(object);
+            }
+
+            template<class O>
+            void update(const O& object) {
+                this->shard_of(object).update(object);
+            }
+
+            template<class O, class K, class... Ids>
+            O get(const K& key, Ids... ids) {
+                return this->shard_for(key).template get<O>(key, std::forward<Ids>(ids)...);
+            }
+
+            template<class O, class K, class... Ids>
+            std::unique_ptr<O> get_pointer(const K& key, Ids... ids) {
+                return this->shard_for(key).template get_pointer<O>(key, std::forward<Ids>(ids)...);
+            }
+
+            template<class O, class K, class... Ids>
+            void remove(const K& key, Ids... ids) {
+                this->shard_for(key).template remove<O>(key, std::forward<Ids>(ids)...);
+            }
+
+            template<class O, class... Args>
+            std::vector<O> get_all(Args... args) {
+                return concatenate(this->fan_out([&args...](storage_type& storage) {
+                    return storage.template get_all<O>(args...);
+                }));
+            }
+
+            /**
+             *  Like `get_all` but merges the sorted results of the shards with `compare`, which has to order objects
+             *  the way the `order_by` passed with `args` does.
+             */
+            template<class O, class Compare, class... Args>
+            std::vector<O> get_all_merged(Compare compare, Args... args) {
+                return merge(this->fan_out([&args...](storage_type& storage) {
+                                 return storage.template get_all<O>(args...);
+                             }),
+                             compare);
+            }
+
+            template<class T, class... Args>
+            auto select(T expression, Args... args) {
+                return concatenate(this->fan_out([&expression, &args...](storage_type& storage) {
+                    return storage.select(expression, args...);
+                }));
+            }
+
+            /**
+             *  Like `select` but merges the sorted results of the shards with `compare`, which has to order rows
+             *  the way the `order_by` passed with `args` does.
+             */
+            template<class Compare, class T, class... Args>
+            auto select_merged(Compare compare, T expression, Args... args) {
+                return merge(this->fan_out([&expression, &args...](storage_type& storage) {
+                                 return storage.select(expression, args...);
+                             }),
+                             compare);
+            }
+
+            template<class O, class... Args>
+            int count(Args... args) {
+                int result = 0;
+                for(int shardCount: this->fan_out([&args...](storage_type& storage) {
+                        return storage.template count<O>(args...);
+                    })) {
+                    result += shardCount;
+                }
+                return result;
+            }
+
+            template<class O, class... Args>
+            void remove_all(Args... args) {
+                this->fan_out([&args...](storage_type& storage) {
+                    storage.template remove_all<O>(args...);
+                    return true;
+                });
+            }
+
+          private:
+            template<class O>
+            storage_type& shard_of(const O& object) {
+                return this->shard_for(this->shardKey(object));
+            }
+
+            /**
+             *  Calls `f` with every shard, the first shard on the calling thread and every other one on its own
+             *  thread, and returns the results in the order of the shards.
+             */
+            template<class F>
+            auto fan_out(const F& f) -> std::vector<decltype(f(std::declval<storage_type&>()))> {
+                using result_type = decltype(f(std::declval<storage_type&>()));
+                std::vector<std::future<result_type>> futures;
+                futures.reserve(this->shards.size() - 1);
+                for(size_t i = 1; i < this->shards.size(); ++i) {
+                    futures.push_back(std::async(std::launch::async, [&f, &storage = *this->shards[i]] {
+                        return f(storage);
+                    }));
+                }
+                std::vector<result_type> results;
+                results.reserve(this->shards.size());
+                results.push_back(f(*this->shards.front()));
+                for(auto& future: futures) {
+                    results.push_back(future.get());
+                }
+                return results;
+            }
 
-#ifdef SQLITE_ENABLE_DBSTAT_VTAB
-#include <string>  //  std::string
-#endif
+            template<class Table, size_t... Idx>
+            static auto insertable_columns(const Table& table, std::index_sequence<Idx...>) {
+                return columns(std::get<Idx>(table.elements).member_pointer...);
+            }
 
-// #include "../schema/column.h"
+            template<class R>
+            static R concatenate(std::vector<R> results) {
+                R result = std::move(results.front());
+                for(size_t i = 1; i < results.size(); ++i) {
+                    result.insert(result.end(),
+                                  std::make_move_iterator(results[i].begin()),
+                                  std::make_move_iterator(results[i].end()));
+                }
+                return result;
+            }
 
-// #include "../schema/table.h"
+            /**
+             *  k-way merge of sorted results using a heap of the current positions in the results.
+             */
+            template<class R, class Compare>
+            static R merge(std::vector<R> results, Compare& compare) {
+                using position = std::pair<typename R::iterator, typename R::iterator>;
+                std::vector<position> heap;
+                size_t size = 0;
+                for(auto& result: results) {
+                    size += result.size();
+                    if(!result.empty()) {
+                        heap.emplace_back(result.begin(), result.end());
+                    }
+                }
+                //  std heaps are max heaps, the top is the position with the smallest value
+                auto greater = [&compare](const position& lhs, const position& rhs) {
+                    return compare(*rhs.first, *lhs.first);
+                };
+                std::make_heap(heap.begin(), heap.end(), greater);
+                R merged;
+                merged.reserve(size);
+                while(!heap.empty()) {
+                    std::pop_heap(heap.begin(), heap.end(), greater);
+                    auto& top = heap.back();
+                    merged.push_back(std::move(*top.first));
+                    if(++top.first == top.second) {
+                        heap.pop_back();
+                    } else {
+                        std::push_heap(heap.begin(), heap.end(), greater);
+                    }
+                }
+                return merged;
+            }
 
-namespace sqlite_orm {
-#ifdef SQLITE_ENABLE_DBSTAT_VTAB
-    struct dbstat {
-        std::string name;
-        std::string path;
-        int pageno = 0;
-        std::string pagetype;
-        int ncell = 0;
-        int payload = 0;
-        int unused = 0;
-        int mx_payload = 0;
-        int pgoffset = 0;
-        int pgsize = 0;
-    };
+            std::vector<std::unique_ptr<storage_type>> shards;
+            KeyFn shardKey;
+        };
+    }
 
-    inline auto make_dbstat_table() {
-        return make_table("dbstat",
-                          make_column("name", &dbstat::name),
-                          make_column("path", &dbstat::path),
-                          make_column("pageno", &dbstat::pageno),
-                          make_column("pagetype", &dbstat::pagetype),
-                          make_column("ncell", &dbstat::ncell),
-                          make_column("payload", &dbstat::payload),
-                          make_column("unused", &dbstat::unused),
-                          make_column("mx_payload", &dbstat::mx_payload),
-                          make_column("pgoffset", &dbstat::pgoffset),
-                          make_column("pgsize", &dbstat::pgsize));
+    /**
+     *  Factory function for a sharded storage made of one storage per database file. `makeStorage(filename)` creates
+     *  the storage of a shard and `shardKey(object)` returns the shard key of a mapped object, e.g.
+     *  `make_sharded_storage(filenames, makeStorage, [](const auto& object) { return object.id; })`.
+     */
+    template<class MakeStorage, class KeyFn>
+    internal::sharded_storage<decltype(std::declval<MakeStorage&>()(std::string{})), KeyFn>
+    make_sharded_storage(const std::vector<std::string>& filenames, MakeStorage makeStorage, KeyFn shardKey) {
+        using storage_type = decltype(makeStorage(std::string{}));
+        if(filenames.empty()) {
+            throw std::system_error{orm_error_code::no_shards};
+        }
+        std::vector<std::unique_ptr<storage_type>> shards;
+        shards.reserve(filenames.size());
+        for(auto& filename: filenames) {
+            shards.emplace_back(new storage_type(makeStorage(filename)));
+        }
+        return {std::move(shards), std::move(shardKey)};
     }
-#endif  //  SQLITE_ENABLE_DBSTAT_VTAB
 }
 /** @file Mainly existing to disentangle implementation details from circular and cross dependencies
  *  (e.g. column_t -> default_value_extractor -> serializer_context -> db_objects_tuple -> table_t -> column_t)
@@ -24413,17 +29790,368 @@ namespace sqlite_orm {
 #include <sstream>
 #include <functional>  //  std::reference_wrapper, std::cref
 #include <algorithm>  //  std::find_if, std::ranges::find
+#include <chrono>  //  std::chrono::steady_clock
+#include <limits>  //  std::numeric_limits
+#include <vector>  //  std::vector
 
 // #include "../sqlite_schema_table.h"
 
 // #include "../eponymous_vtabs/dbstat.h"
 
+// #include "../eponymous_vtabs/json_each.h"
+
+#ifdef SQLITE_ENABLE_JSON1
+#include <string>  //  std::string
+#include <memory>  //  std::unique_ptr
+#endif
+
+// #include "../schema/column.h"
+
+// #include "../schema/table.h"
+
+namespace sqlite_orm {
+#ifdef SQLITE_ENABLE_JSON1
+    /**
+     *  Row of the `json_each` table-valued function https://www.sqlite.org/json1.html#jeach
+     *  which walks the immediate children of the top-level array or object of a JSON document.
+     *
+     *  `json` and `root` are the hidden columns which take the function arguments:
+     *  `json_each(X)` is the same as the constraint `json_each.json = X`. E.g. unnesting the tags of users:
+     *  storage.select(columns(&User::id, &json_each::value),
+     *                 from<User>(),
+     *                 cross_join<json_each>(),
+     *                 where(c(&json_each::json) == &User::tags));
+     *  `key` is null for the top-level element, `value` for JSON nulls and `atom` for arrays and objects.
+     */
+    struct json_each {
+        std::unique_ptr<std::string> key;
+        std::unique_ptr<std::string> value;
+        std::string type;
+        std::unique_ptr<std::string> atom;
+        int id = 0;
+        std::unique_ptr<int> parent;
+        std::string fullkey;
+        std::string path;
+        std::string json;
+        std::string root;
+    };
+
+    inline auto make_json_each_table() {
+        return make_table("json_each",
+                          make_column("key", &json_each::key),
+                          make_column("value", &json_each::value),
+                          make_column("type", &json_each::type),
+                          make_column("atom", &json_each::atom),
+                          make_column("id", &json_each::id),
+                          make_column("parent", &json_each::parent),
+                          make_column("fullkey", &json_each::fullkey),
+                          make_column("path", &json_each::path),
+                          make_column("json", &json_each::json),
+                          make_column("root", &json_each::root));
+    }
+#endif  //  SQLITE_ENABLE_JSON1
+}
+
+// #include "../eponymous_vtabs/json_tree.h"
+
+#ifdef SQLITE_ENABLE_JSON1
+#include <string>  //  std::string
+#include <memory>  //  std::unique_ptr
+#endif
+
+// #include "../schema/column.h"
+
+// #include "../schema/table.h"
+
+namespace sqlite_orm {
+#ifdef SQLITE_ENABLE_JSON1
+    /**
+     *  Row of the `json_tree` table-valued function https://www.sqlite.org/json1.html#jtree
+     *  which recursively walks all elements of a JSON document, the top-level element included.
+     *
+     *  `json` and `root` are the hidden columns which take the function arguments:
+     *  `json_tree(X)` is the same as the constraint `json_tree.json = X`. E.g. all leaves of the settings of users:
+     *  storage.select(columns(&User::id, &json_tree::fullkey, &json_tree::value),
+     *                 from<User>(),
+     *                 cross_join<json_tree>(),
+     *                 where(c(&json_tree::json) == &User::settings and is_not_null(&json_tree::atom)));
+     *  `key` is null for the top-level element, `value` for JSON nulls and `atom` for arrays and objects.
+     */
+    struct json_tree {
+        std::unique_ptr<std::string> key;
+        std::unique_ptr<std::string> value;
+        std::string type;
+        std::unique_ptr<std::string> atom;
+        int id = 0;
+        std::unique_ptr<int> parent;
+        std::string fullkey;
+        std::string path;
+        std::string json;
+        std::string root;
+    };
+
+    inline auto make_json_tree_table() {
+        return make_table("json_tree",
+                          make_column("key", &json_tree::key),
+                          make_column("value", &json_tree::value),
+                          make_column("type", &json_tree::type),
+                          make_column("atom", &json_tree::atom),
+                          make_column("id", &json_tree::id),
+                          make_column("parent", &json_tree::parent),
+                          make_column("fullkey", &json_tree::fullkey),
+                          make_column("path", &json_tree::path),
+                          make_column("json", &json_tree::json),
+                          make_column("root", &json_tree::root));
+    }
+#endif  //  SQLITE_ENABLE_JSON1
+}
+
+// #include "../eponymous_vtabs/generate_series.h"
+
+// #include "../functional/cxx_universal.h"
+//  ::int64
+// #include "../schema/column.h"
+
+// #include "../schema/table.h"
+
+namespace sqlite_orm {
+    /**
+     *  Row of the `generate_series` table-valued function https://www.sqlite.org/series.html
+     *  which yields the integers from `start` to `stop` by `step`.
+     *  It comes with the `series` extension rather than with every build of SQLite,
+     *  so it is mapped unconditionally and queries fail with "no such table" if it isn't available.
+     *
+     *  `start`, `stop` and `step` are the hidden columns which take the function arguments:
+     *  `generate_series(1, 10, 2)` is the same as the constraints
+     *  `generate_series.start = 1 AND generate_series.stop = 10 AND generate_series.step = 2`.
+     *  E.g. filling the gaps of daily totals:
+     *  storage.select(columns(&generate_series::value, coalesce<double>(sum(&Sale::amount), 0)),
+     *                 from<generate_series>(),
+     *                 left_join<Sale>(on(c(&Sale::day) == &generate_series::value)),
+     *                 where(c(&generate_series::start) == firstDay and c(&generate_series::stop) == lastDay),
+     *                 group_by(&generate_series::value));
+     */
+    struct generate_series {
+        int64 value = 0;
+        int64 start = 0;
+        int64 stop = 0;
+        int64 step = 0;
+    };
+
+    inline auto make_generate_series_table() {
+        return make_table("generate_series",
+                          make_column("value", &generate_series::value),
+                          make_column("start", &generate_series::start),
+                          make_column("stop", &generate_series::stop),
+                          make_column("step", &generate_series::step));
+    }
+}
+
+// #include "../eponymous_vtabs/pragma_functions.h"
+
+#if SQLITE_VERSION_NUMBER >= 3016000
+#include <string>  //  std::string
+#include <memory>  //  std::unique_ptr
+#include <type_traits>  //  std::is_same
+#endif
+
+// #include "../functional/cxx_type_traits_polyfill.h"
+
+// #include "../schema/column.h"
+
+// #include "../schema/table.h"
+
+namespace sqlite_orm {
+#if SQLITE_VERSION_NUMBER >= 3016000
+    /**
+     *  Rows of the table-valued pragma functions https://www.sqlite.org/pragma.html#pragfunc
+     *  which run schema introspection pragmas inside queries.
+     *  `arg` and `schema` are the hidden columns which take the pragma argument and the database name:
+     *  `pragma_table_info('users')` is the same as the constraint `pragma_table_info.arg = 'users'`.
+     *  E.g. all indexed columns of the main database:
+     *  storage.select(columns(&sqlite_master::tbl_name, &pragma_index_info::name),
+     *                 from<sqlite_master>(),
+     *                 cross_join<pragma_index_info>(),
+     *                 where(c(&sqlite_master::type) == "index" and
+     *                       c(&pragma_index_info::arg) == &sqlite_master::name));
+     *  `dflt_value` is null for columns without a default value.
+     */
+
+    struct pragma_table_info {
+        int cid = 0;
+        std::string name;
+        std::string type;
+        bool notnull = false;
+        std::unique_ptr<std::string> dflt_value;
+        int pk = 0;
+        std::string arg;
+        std::string schema;
+    };
+
+    inline auto make_pragma_table_info_table() {
+        return make_table("pragma_table_info",
+                          make_column("cid", &pragma_table_info::cid),
+                          make_column("name", &pragma_table_info::name),
+                          make_column("type", &pragma_table_info::type),
+                          make_column("notnull", &pragma_table_info::notnull),
+                          make_column("dflt_value", &pragma_table_info::dflt_value),
+                          make_column("pk", &pragma_table_info::pk),
+                          make_column("arg", &pragma_table_info::arg),
+                          make_column("schema", &pragma_table_info::schema));
+    }
+
+#if SQLITE_VERSION_NUMBER >= 3026000
+    /**
+     *  Same as `pragma_table_info` plus the hidden columns of virtual tables and generated columns,
+     *  available since SQLite 3.26.0.
+     */
+    struct pragma_table_xinfo {
+        int cid = 0;
+        std::string name;
+        std::string type;
+        bool notnull = false;
+        std::unique_ptr<std::string> dflt_value;
+        int pk = 0;
+        int hidden = 0;
+        std::string arg;
+        std::string schema;
+    };
+
+    inline auto make_pragma_table_xinfo_table() {
+        return make_table("pragma_table_xinfo",
+                          make_column("cid", &pragma_table_xinfo::cid),
+                          make_column("name", &pragma_table_xinfo::name),
+                          make_column("type", &pragma_table_xinfo::type),
+                          make_column("notnull", &pragma_table_xinfo::notnull),
+                          make_column("dflt_value", &pragma_table_xinfo::dflt_value),
+                          make_column("pk", &pragma_table_xinfo::pk),
+                          make_column("hidden", &pragma_table_xinfo::hidden),
+                          make_column("arg", &pragma_table_xinfo::arg),
+                          make_column("schema", &pragma_table_xinfo::schema));
+    }
+#endif
+
+    struct pragma_index_list {
+        int seq = 0;
+        std::string name;
+        bool unique = false;
+        std::string origin;
+        bool partial = false;
+        std::string arg;
+        std::string schema;
+    };
+
+    inline auto make_pragma_index_list_table() {
+        return make_table("pragma_index_list",
+                          make_column("seq", &pragma_index_list::seq),
+                          make_column("name", &pragma_index_list::name),
+                          make_column("unique", &pragma_index_list::unique),
+                          make_column("origin", &pragma_index_list::origin),
+                          make_column("partial", &pragma_index_list::partial),
+                          make_column("arg", &pragma_index_list::arg),
+                          make_column("schema", &pragma_index_list::schema));
+    }
+
+    struct pragma_index_info {
+        int seqno = 0;
+        int cid = 0;
+        std::string name;
+        std::string arg;
+        std::string schema;
+    };
+
+    inline auto make_pragma_index_info_table() {
+        return make_table("pragma_index_info",
+                          make_column("seqno", &pragma_index_info::seqno),
+                          make_column("cid", &pragma_index_info::cid),
+                          make_column("name", &pragma_index_info::name),
+                          make_column("arg", &pragma_index_info::arg),
+                          make_column("schema", &pragma_index_info::schema));
+    }
+
+    struct pragma_foreign_key_list {
+        int id = 0;
+        int seq = 0;
+        std::string table;
+        std::string from;
+        std::string to;
+        std::string on_update;
+        std::string on_delete;
+        std::string match;
+        std::string arg;
+        std::string schema;
+    };
+
+    inline auto make_pragma_foreign_key_list_table() {
+        return make_table("pragma_foreign_key_list",
+                          make_column("id", &pragma_foreign_key_list::id),
+                          make_column("seq", &pragma_foreign_key_list::seq),
+                          make_column("table", &pragma_foreign_key_list::table),
+                          make_column("from", &pragma_foreign_key_list::from),
+                          make_column("to", &pragma_foreign_key_list::to),
+                          make_column("on_update", &pragma_foreign_key_list::on_update),
+                          make_column("on_delete", &pragma_foreign_key_list::on_delete),
+                          make_column("match", &pragma_foreign_key_list::match),
+                          make_column("arg", &pragma_foreign_key_list::arg),
+                          make_column("schema", &pragma_foreign_key_list::schema));
+    }
+
+    namespace internal {
+        template<class O>
+        using is_pragma_function = polyfill::disjunction<std::is_same<O, pragma_table_info>,
+#if SQLITE_VERSION_NUMBER >= 3026000
+                                                         std::is_same<O, pragma_table_xinfo>,
+#endif
+                                                         std::is_same<O, pragma_index_list>,
+                                                         std::is_same<O, pragma_index_info>,
+                                                         std::is_same<O, pragma_foreign_key_list>>;
+    }
+#endif
+}
+
+// #include "../eponymous_vtabs/sqlite_dbpage.h"
+
+#ifdef SQLITE_ENABLE_DBPAGE_VTAB
+#include <string>  //  std::string
+#include <vector>  //  std::vector
+#endif
+
+// #include "../schema/column.h"
+
+// #include "../schema/table.h"
+
+namespace sqlite_orm {
+#ifdef SQLITE_ENABLE_DBPAGE_VTAB
+    /**
+     *  Row of the `sqlite_dbpage` virtual table https://www.sqlite.org/dbpage.html
+     *  which exposes the raw pages of a database file.
+     *  `schema` is the hidden column which selects the attached database, "main" by default.
+     */
+    struct sqlite_dbpage {
+        int pgno = 0;
+        std::vector<char> data;
+        std::string schema;
+    };
+
+    inline auto make_sqlite_dbpage_table() {
+        return make_table("sqlite_dbpage",
+                          make_column("pgno", &sqlite_dbpage::pgno),
+                          make_column("data", &sqlite_dbpage::data),
+                          make_column("schema", &sqlite_dbpage::schema));
+    }
+#endif  //  SQLITE_ENABLE_DBPAGE_VTAB
+}
+
 // #include "../type_traits.h"
 
 // #include "../util.h"
 
 // #include "../serializing_util.h"
 
+// #include "../statement_finalizer.h"
+
+// #include "../online_migration.h"
+
 // #include "../storage.h"
 
 namespace sqlite_orm {
@@ -24440,6 +30168,30 @@ namespace sqlite_orm {
                 return sync_schema_result::already_in_sync;
             }
 #endif  //  SQLITE_ENABLE_DBSTAT_VTAB
+#ifdef SQLITE_ENABLE_JSON1
+            if(std::is_same<object_type_t<Table>, json_each>::value ||
+               std::is_same<object_type_t<Table>, json_tree>::value) {
+                return sync_schema_result::already_in_sync;
+            }
+#endif  //  SQLITE_ENABLE_JSON1
+            if(std::is_same<object_type_t<Table>, generate_series>::value) {
+                return sync_schema_result::already_in_sync;
+            }
+#if SQLITE_VERSION_NUMBER >= 3016000
+            if(is_pragma_function<object_type_t<Table>>::value) {
+                return sync_schema_result::already_in_sync;
+            }
+#endif
+#ifdef SQLITE_ENABLE_DBPAGE_VTAB
+            if(std::is_same<object_type_t<Table>, sqlite_dbpage>::value) {
+                return sync_schema_result::already_in_sync;
+            }
+#endif  //  SQLITE_ENABLE_DBPAGE_VTAB
+#if SQLITE_VERSION_NUMBER >= 3020000
+            if(this->rangeTables.count(table.name)) {
+                return sync_schema_result::already_in_sync;
+            }
+#endif
             auto res = sync_schema_result::already_in_sync;
             bool attempt_to_preserve = true;
 
@@ -24457,7 +30209,8 @@ namespace sqlite_orm {
                         auto storageTableInfo = table.get_table_info();
 
                         //  now get current table info from db using `PRAGMA table_xinfo` query..
-                        auto dbTableInfo = this->pragma.table_xinfo(table.name);  // should include generated columns
+                        //  should include generated columns
+                        auto dbTableInfo = this->pragma.table_xinfo(table.schema_name, table.name);
 
                         //  this vector will contain pointers to columns that gotta be added..
                         std::vector<const table_xinfo*> columnsToAdd;
@@ -24467,7 +30220,7 @@ namespace sqlite_orm {
                         if(schema_stat == sync_schema_result::old_columns_removed) {
 #if SQLITE_VERSION_NUMBER >= 3035000  //  DROP COLUMN feature exists (v3.35.0)
                             for(auto& tableInfo: dbTableInfo) {
-                                this->drop_column(db, table.name, tableInfo.name);
+                                this->drop_column(db, table.schema_name, table.name, tableInfo.name);
                             }
                             res = sync_schema_result::old_columns_removed;
 #else
@@ -24479,11 +30232,11 @@ namespace sqlite_orm {
 
                         if(schema_stat == sync_schema_result::new_columns_added) {
                             for(const table_xinfo* colInfo: columnsToAdd) {
-                                table.for_each_column([this, colInfo, &tableName = table.name, db](auto& column) {
+                                table.for_each_column([this, colInfo, &table, db](auto& column) {
                                     if(column.name != colInfo->name) {
                                         return;
                                     }
-                                    this->add_column(db, tableName, column);
+                                    this->add_column(db, table.schema_name, table.name, column);
                                 });
                             }
                             res = sync_schema_result::new_columns_added;
@@ -24500,7 +30253,8 @@ namespace sqlite_orm {
                         }
                     } else if(schema_stat == sync_schema_result::dropped_and_recreated) {
                         //  now get current table info from db using `PRAGMA table_xinfo` query..
-                        auto dbTableInfo = this->pragma.table_xinfo(table.name);  // should include generated columns
+                        //  should include generated columns
+                        auto dbTableInfo = this->pragma.table_xinfo(table.schema_name, table.name);
                         auto storageTableInfo = table.get_table_info();
 
                         //  this vector will contain pointers to columns that gotta be added..
@@ -24522,14 +30276,12 @@ namespace sqlite_orm {
             return res;
         }
 
-        template<class... DBO>
+        /**
+         *  Names of the columns of `table` which are copied to a recreated table, generated columns are left out.
+         */
         template<class Table>
-        void storage_t<DBO...>::copy_table(
-            sqlite3* db,
-            const std::string& sourceTableName,
-            const std::string& destinationTableName,
-            const Table& table,
-            const std::vector<const table_xinfo*>& columnsToIgnore) const {  // must ignore generated columns
+        std::vector<std::reference_wrapper<const std::string>>
+        copied_column_names(const Table& table, const std::vector<const table_xinfo*>& columnsToIgnore) {
             std::vector<std::reference_wrapper<const std::string>> columnNames;
             columnNames.reserve(table.template count_of<is_column>());
             table.for_each_column([&columnNames, &columnsToIgnore](const column_identifier& column) {
@@ -24547,14 +30299,153 @@ namespace sqlite_orm {
                     columnNames.push_back(cref(columnName));
                 }
             });
+            return columnNames;
+        }
+
+        template<class... DBO>
+        template<class Table>
+        void storage_t<DBO...>::copy_table(
+            sqlite3* db,
+            const std::string& sourceTableName,
+            const std::string& destinationTableName,
+            const Table& table,
+            const std::vector<const table_xinfo*>& columnsToIgnore) const {  // must ignore generated columns
+            auto columnNames = copied_column_names(table, columnsToIgnore);
 
             std::stringstream ss;
-            ss << "INSERT INTO " << streaming_identifier(destinationTableName) << " ("
+            ss << "INSERT INTO " << streaming_identifier(table.schema_name, destinationTableName, std::string{}) << " ("
                << streaming_identifiers(columnNames) << ") "
-               << "SELECT " << streaming_identifiers(columnNames) << " FROM " << streaming_identifier(sourceTableName)
-               << std::flush;
+               << "SELECT " << streaming_identifiers(columnNames) << " FROM "
+               << streaming_identifier(table.schema_name, sourceTableName, std::string{}) << std::flush;
             perform_void_exec(db, ss.str());
         }
+
+        template<class... DBO>
+        template<class Table>
+        void storage_t<DBO...>::copy_table_online(sqlite3* db,
+                                                  const std::string& sourceTableName,
+                                                  const std::string& destinationTableName,
+                                                  const Table& table,
+                                                  const std::vector<const table_xinfo*>& columnsToIgnore,
+                                                  const online_migration_options& options) {
+            using clock_type = std::chrono::steady_clock;
+            auto columnNames = copied_column_names(table, columnsToIgnore);
+            auto& schemaName = table.schema_name;
+
+            //  rows keep their rowids in the copy, so the triggers find the rows to update and delete by rowid
+            std::stringstream insertNew;
+            insertNew << "INSERT OR REPLACE INTO " << streaming_identifier(destinationTableName) << " (rowid, "
+                      << streaming_identifiers(columnNames) << ") VALUES (NEW.rowid";
+            for(const std::string& columnName: columnNames) {
+                insertNew << ", NEW." << streaming_identifier(columnName);
+            }
+            insertNew << ");";
+            std::stringstream deleteOld;
+            deleteOld << "DELETE FROM " << streaming_identifier(destinationTableName) << " WHERE rowid = OLD.rowid;";
+            const std::string triggerNames[] = {sourceTableName + "_online_migration_insert",
+                                                sourceTableName + "_online_migration_update",
+                                                sourceTableName + "_online_migration_delete"};
+            auto dropTriggers = [db, &schemaName, &triggerNames] {
+                for(auto& triggerName: triggerNames) {
+                    std::stringstream ss;
+                    ss << "DROP TRIGGER IF EXISTS " << streaming_identifier(schemaName, triggerName, std::string{})
+                       << std::flush;
+                    perform_void_exec(db, ss.str());
+                }
+            };
+
+            try {
+                const char* events[] = {"INSERT", "UPDATE", "DELETE"};
+                const std::string actions[] = {insertNew.str(),
+                                               deleteOld.str() + " " + insertNew.str(),
+                                               deleteOld.str()};
+                for(int i = 0; i < 3; ++i) {
+                    std::stringstream ss;
+                    //  a trigger lives in the database of its table, which also resolves the names in its body
+                    ss << "CREATE TRIGGER " << streaming_identifier(schemaName, triggerNames[i], std::string{})
+                       << " AFTER " << events[i] << " ON " << streaming_identifier(sourceTableName) << " BEGIN "
+                       << actions[i] << " END" << std::flush;
+                    perform_void_exec(db, ss.str());
+                }
+
+                online_migration_progress progress;
+                progress.table = table.name;
+                {
+                    std::stringstream ss;
+                    ss << "SELECT COUNT(*) FROM " << streaming_identifier(schemaName, sourceTableName, std::string{})
+                       << std::flush;
+                    perform_exec(db, ss.str(), extract_single_value<int64>, &progress.total_rows);
+                }
+                std::stringstream chunkEndSql;
+                chunkEndSql << "SELECT rowid FROM " << streaming_identifier(schemaName, sourceTableName, std::string{})
+                            << " WHERE rowid >= ? ORDER BY rowid LIMIT 1 OFFSET ?" << std::flush;
+                statement_finalizer chunkEndStatement{prepare_stmt(db, chunkEndSql.str())};
+                std::stringstream copySql;
+                //  rows which the triggers already mirrored are newer than the ones read here
+                copySql << "INSERT OR IGNORE INTO "
+                        << streaming_identifier(schemaName, destinationTableName, std::string{}) << " (rowid, "
+                        << streaming_identifiers(columnNames) << ") SELECT rowid, "
+                        << streaming_identifiers(columnNames) << " FROM "
+                        << streaming_identifier(schemaName, sourceTableName, std::string{})
+                        << " WHERE rowid >= ? AND rowid <= ? ORDER BY rowid" << std::flush;
+                statement_finalizer copyStatement{prepare_stmt(db, copySql.str())};
+
+                const int64 chunkSize = options.chunk_size > 0 ? options.chunk_size : 1;
+                const auto start = clock_type::now();
+                //  chunks are closed ranges, so that rows at both ends of the rowid domain are copied
+                int64 firstRowid = std::numeric_limits<int64>::min();
+                for(bool lastChunk = false; !lastChunk;) {
+                    perform_void_exec(db, "BEGIN IMMEDIATE");
+                    sqlite3_stmt* stmt = reset_stmt(chunkEndStatement.get());
+                    sqlite3_bind_int64(stmt, 1, firstRowid);
+                    sqlite3_bind_int64(stmt, 2, chunkSize - 1);
+                    int64 chunkEnd = std::numeric_limits<int64>::max();
+                    perform_step(stmt, [&chunkEnd](sqlite3_stmt* stmt) {
+                        chunkEnd = sqlite3_column_int64(stmt, 0);
+                    });
+                    //  an unfinished statement would keep reading the table after the commit
+                    sqlite3_reset(stmt);
+                    lastChunk = chunkEnd == std::numeric_limits<int64>::max();
+                    stmt = reset_stmt(copyStatement.get());
+                    sqlite3_bind_int64(stmt, 1, firstRowid);
+                    sqlite3_bind_int64(stmt, 2, chunkEnd);
+                    perform_step(stmt);
+                    progress.copied_rows += sqlite3_changes(db);
+                    perform_void_exec(db, "COMMIT");
+                    //  the last chunk may end at the largest rowid, which has no successor
+                    if(!lastChunk) {
+                        firstRowid = chunkEnd + 1;
+                    }
+
+                    progress.elapsed = clock_type::now() - start;
+                    if(progress.copied_rows > 0 && progress.total_rows > progress.copied_rows) {
+                        progress.eta = progress.elapsed * (progress.total_rows - progress.copied_rows) /
+                                       progress.copied_rows;
+                    } else {
+                        progress.eta = {};
+                    }
+                    if(options.on_progress) {
+                        options.on_progress(progress);
+                    }
+                }
+
+                perform_void_exec(db, "BEGIN IMMEDIATE");
+                dropTriggers();
+                this->drop_table_internal(db, schemaName, sourceTableName);
+                this->rename_table(db, schemaName, destinationTableName, sourceTableName);
+                perform_void_exec(db, "COMMIT");
+            } catch(...) {
+                if(!sqlite3_get_autocommit(db)) {
+                    sqlite3_exec(db, "ROLLBACK", nullptr, nullptr, nullptr);
+                }
+                try {
+                    dropTriggers();
+                    this->drop_table_internal(db, schemaName, destinationTableName);
+                } catch(const std::system_error&) {
+                }
+                throw;
+            }
+        }
     }
 }
 
@@ -157,3 +157,112 @@ TEST_CASE("Backup crash") {
     auto backup = storage.make_backup_to(backupFilename);
     backup.step(-1);
 }
+
+TEST_CASE("start_backup") {
+    auto makeStorage = [](const std::string& filename) {
+        return make_storage(
+            filename,
+            make_table("users", make_column("id", &User::id, primary_key()), make_column("name", &User::name)));
+    };
+    const std::string sourceFilename = "start_backup_source.sqlite";
+    const std::string backupFilename = "start_backup.sqlite";
+    ::remove(sourceFilename.c_str());
+    ::remove(backupFilename.c_str());
+    auto fill = [](auto& storage) {
+        storage.sync_schema();
+        std::vector<User> users;
+        for(int i = 1; i <= 2000; ++i) {
+            users.push_back(User{i, std::string(100, 'a')});
+        }
+        storage.transaction([&storage, &users] {
+            storage.insert_range(users.begin(), users.end());
+            return true;
+        });
+    };
+    std::vector<backup_progress> reports;
+    backup_options options;
+    options.pages_per_step = 20;
+    options.sleep = std::chrono::milliseconds{0};
+    options.on_progress = [&reports](const backup_progress& progress) {
+        reports.push_back(progress);
+    };
+
+    SECTION("file") {
+        auto storage = makeStorage(sourceFilename);
+        fill(storage);
+        SECTION("copy") {
+            storage.start_backup(backupFilename, options).get();
+            REQUIRE(reports.size() > 1);
+            REQUIRE(reports.front().remaining > 0);
+            REQUIRE(reports.back().remaining == 0);
+            REQUIRE(reports.back().pagecount == reports.front().pagecount);
+            REQUIRE(reports.back().restarts == 0);
+        }
+        SECTION("source changed during the copy") {
+            options.on_progress = [&reports, &storage](const backup_progress& progress) {
+                reports.push_back(progress);
+                if(reports.size() == 1) {
+                    storage.insert(User{3000, "new"});
+                }
+            };
+            storage.start_backup(backupFilename, options).get();
+            REQUIRE(reports.back().remaining == 0);
+            REQUIRE(reports.back().restarts == 1);
+        }
+        auto backupStorage = makeStorage(backupFilename);
+        REQUIRE(backupStorage.count<User>() == storage.count<User>());
+        REQUIRE(backupStorage.get_all<User>(where(c(&User::id) > 1000)) ==
+                storage.get_all<User>(where(c(&User::id) > 1000)));
+    }
+    SECTION("ignored future") {
+        std::promise<void> returned;
+        auto returnedFuture = returned.get_future().share();
+        std::vector<bool> copiedAfterReturn;
+        options.on_progress = [returnedFuture, &copiedAfterReturn](const backup_progress&) {
+            //  the caller returns from start_backup while the copy is still running
+            copiedAfterReturn.push_back(returnedFuture.wait_for(std::chrono::seconds{5}) ==
+                                        std::future_status::ready);
+        };
+        {
+            auto storage = makeStorage(sourceFilename);
+            fill(storage);
+            storage.start_backup(backupFilename, options);
+            returned.set_value();
+            //  the storage waits for the backup when it is destroyed
+        }
+        REQUIRE_FALSE(copiedAfterReturn.empty());
+        REQUIRE(copiedAfterReturn.front());
+        REQUIRE(makeStorage(backupFilename).count<User>() == 2000);
+    }
+    SECTION("in memory") {
+        auto storage = makeStorage("");
+        fill(storage);
+        auto future = storage.start_backup(backupFilename, options);
+        future.get();
+        REQUIRE(reports.back().remaining == 0);
+        REQUIRE(makeStorage(backupFilename).count<User>() == 2000);
+    }
+    SECTION("in memory storage destroyed during the backup") {
+        std::future<void> future;
+        {
+            auto storage = makeStorage("");
+            fill(storage);
+            options.sleep = std::chrono::milliseconds{1};
+            future = storage.start_backup(backupFilename, options);
+        }
+        future.get();
+        REQUIRE(reports.back().remaining == 0);
+        REQUIRE(makeStorage(backupFilename).count<User>() == 2000);
+    }
+    SECTION("cancelled") {
+        auto storage = makeStorage(sourceFilename);
+        fill(storage);
+        options.on_progress = [&reports, &options](const backup_progress& progress) {
+            reports.push_back(progress);
+            options.cancellation.cancel();
+        };
+        auto future = storage.start_backup(backupFilename, options);
+        REQUIRE_THROWS_AS(future.get(), std::system_error);
+        REQUIRE(reports.size() == 1);
+    }
+}
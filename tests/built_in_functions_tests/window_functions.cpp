@@ -0,0 +1,119 @@
+#include <sqlite_orm/sqlite_orm.h>
+#include <catch2/catch_all.hpp>
+
+using namespace sqlite_orm;
+
+#if SQLITE_VERSION_NUMBER >= 3025000
+namespace {
+    struct Employee {
+        int id = 0;
+        std::string department;
+        int salary = 0;
+
+#ifndef SQLITE_ORM_AGGREGATE_NSDMI_SUPPORTED
+        Employee() = default;
+        Employee(int id, std::string department, int salary) :
+            id{id}, department{std::move(department)}, salary{salary} {}
+#endif
+    };
+}
+
+TEST_CASE("window functions") {
+    auto storage = make_storage({},
+                                make_table("employees",
+                                           make_column("id", &Employee::id, primary_key()),
+                                           make_column("department", &Employee::department),
+                                           make_column("salary", &Employee::salary)));
+    storage.sync_schema();
+    storage.replace(Employee{1, "sales", 100});
+    storage.replace(Employee{2, "sales", 300});
+    storage.replace(Employee{3, "sales", 300});
+    storage.replace(Employee{4, "it", 200});
+    storage.replace(Employee{5, "it", 400});
+
+    SECTION("ranking") {
+        auto rows = storage.select(columns(&Employee::id,
+                                           row_number().over(order_by(&Employee::id)),
+                                           rank().over(partition_by(&Employee::department),
+                                                       order_by(&Employee::salary).desc()),
+                                           dense_rank().over(order_by(&Employee::salary).desc())),
+                                   order_by(&Employee::id));
+        std::vector<std::tuple<int, int, int, int>> expected{{1, 1, 3, 4},
+                                                             {2, 2, 1, 2},
+                                                             {3, 3, 1, 2},
+                                                             {4, 4, 2, 3},
+                                                             {5, 5, 1, 1}};
+        REQUIRE(rows == expected);
+    }
+    SECTION("running total") {
+        auto sums = storage.select(
+            sum(&Employee::salary).over(order_by(&Employee::id), rows(unbounded_preceding(), current_row())),
+            order_by(&Employee::id));
+        std::vector<double> totals;
+        for(auto& total: sums) {
+            totals.push_back(*total);
+        }
+        REQUIRE(totals == std::vector<double>{100, 400, 700, 900, 1300});
+    }
+    SECTION("lag and lead") {
+        auto rows = storage.select(columns(lag(&Employee::salary).over(order_by(&Employee::id)),
+                                           lead(&Employee::salary, 1, -1).over(order_by(&Employee::id))),
+                                   where(c(&Employee::department) == "it"));
+        REQUIRE(rows.size() == 2);
+        REQUIRE_FALSE(std::get<0>(rows[0]));
+        REQUIRE(*std::get<1>(rows[0]) == 400);
+        REQUIRE(*std::get<0>(rows[1]) == 200);
+        REQUIRE(*std::get<1>(rows[1]) == -1);
+    }
+    SECTION("named window") {
+        auto byDepartment = window("d", partition_by(&Employee::department));
+        auto rows = storage.select(columns(&Employee::id,
+                                           count<Employee>().over(byDepartment),
+                                           max(&Employee::salary).over(byDepartment)),
+                                   where(c(&Employee::id) > 1),
+                                   byDepartment,
+                                   order_by(&Employee::id));
+        REQUIRE(rows.size() == 4);
+        REQUIRE(std::get<1>(rows[0]) == 2);
+        REQUIRE(*std::get<2>(rows[0]) == 300);
+        REQUIRE(std::get<1>(rows[3]) == 2);
+        REQUIRE(*std::get<2>(rows[3]) == 400);
+    }
+    SECTION("two named windows") {
+        auto byDepartment = window("d", partition_by(&Employee::department));
+        auto byId = window("i", order_by(&Employee::id));
+        auto rows = storage.select(
+            columns(&Employee::id, count<Employee>().over(byDepartment), row_number().over(byId)),
+            where(c(&Employee::id) > 1),
+            byDepartment,
+            byId,
+            order_by(&Employee::id));
+        REQUIRE(rows.size() == 4);
+        for(size_t i = 0; i < rows.size(); ++i) {
+            REQUIRE(std::get<1>(rows[i]) == 2);
+            REQUIRE(std::get<2>(rows[i]) == int(i) + 1);
+        }
+    }
+    SECTION("window before the conditions it is serialized after") {
+        //  both the frame offset and the WHERE value are bound, in the order of the serialized statement
+        auto lastTwo = window("w", order_by(&Employee::id), rows(preceding(1), current_row()));
+        std::vector<std::tuple<int, double>> expected{{3, 300}, {4, 500}, {5, 600}};
+        auto toDouble = [](const std::vector<std::tuple<int, std::unique_ptr<double>>>& rows) {
+            std::vector<std::tuple<int, double>> result;
+            for(auto& row: rows) {
+                result.emplace_back(std::get<0>(row), *std::get<1>(row));
+            }
+            return result;
+        };
+        REQUIRE(toDouble(storage.select(columns(&Employee::id, sum(&Employee::salary).over(lastTwo)),
+                                        lastTwo,
+                                        where(c(&Employee::id) > 2),
+                                        order_by(&Employee::id))) == expected);
+        auto statement = storage.prepare(select(columns(&Employee::id, sum(&Employee::salary).over(lastTwo)),
+                                                lastTwo,
+                                                where(c(&Employee::id) > 2),
+                                                order_by(&Employee::id)));
+        REQUIRE(toDouble(storage.execute(statement)) == expected);
+    }
+}
+#endif
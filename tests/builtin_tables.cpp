@@ -4,6 +4,13 @@
 using namespace sqlite_orm;
 using Catch::Matchers::Equals;
 
+namespace {
+    struct User {
+        int id = 0;
+        std::string name;
+    };
+}
+
 TEST_CASE("builtin tables") {
     SECTION("sqlite_schema") {
         auto storage = make_storage("", make_sqlite_schema_table());
@@ -52,4 +59,197 @@ TEST_CASE("builtin tables") {
         std::ignore = dbstatRows;
     }
 #endif  //  SQLITE_ENABLE_DBSTAT_VTAB
+
+#if SQLITE_VERSION_NUMBER >= 3016000
+    SECTION("pragma functions") {
+        struct Visit {
+            int id = 0;
+            int userId = 0;
+            std::string location;
+        };
+        auto storage =
+            make_storage("",
+                         make_sqlite_schema_table(),
+                         make_index("visits_location", &Visit::location),
+                         make_table("users",
+                                    make_column("id", &User::id, primary_key()),
+                                    make_column("name", &User::name)),
+                         make_table("visits",
+                                    make_column("id", &Visit::id, primary_key()),
+                                    make_column("user_id", &Visit::userId),
+                                    make_column("location", &Visit::location),
+                                    foreign_key(&Visit::userId).references(&User::id)),
+                         make_pragma_table_info_table(),
+                         make_pragma_index_list_table(),
+                         make_pragma_index_info_table(),
+                         make_pragma_foreign_key_list_table());
+        storage.sync_schema();
+        REQUIRE_FALSE(storage.table_exists("pragma_table_info"));
+
+        auto columnNames = storage.select(&pragma_table_info::name,
+                                          where(c(&pragma_table_info::arg) == "visits"),
+                                          order_by(&pragma_table_info::cid));
+        REQUIRE(columnNames == std::vector<std::string>{"id", "user_id", "location"});
+
+        auto primaryKeys = storage.select(columns(&sqlite_master::name, &pragma_table_info::name),
+                                          from<sqlite_master>(),
+                                          cross_join<pragma_table_info>(),
+                                          where(c(&sqlite_master::type) == "table" and
+                                                c(&pragma_table_info::arg) == &sqlite_master::name and
+                                                c(&pragma_table_info::pk) == 1),
+                                          order_by(&sqlite_master::name));
+        REQUIRE(primaryKeys == std::vector<std::tuple<std::string, std::string>>{{"users", "id"}, {"visits", "id"}});
+
+        auto userColumns = storage.get_all<pragma_table_info>(where(c(&pragma_table_info::arg) == "users"));
+        REQUIRE(userColumns.size() == 2);
+        REQUIRE_FALSE(userColumns[1].dflt_value);
+
+        auto indexes = storage.get_all<pragma_index_list>(where(c(&pragma_index_list::arg) == "visits"));
+        REQUIRE(indexes.size() == 1);
+        REQUIRE(indexes[0].name == "visits_location");
+        REQUIRE(indexes[0].origin == "c");
+        REQUIRE(storage.select(&pragma_index_info::name, where(c(&pragma_index_info::arg) == "visits_location")) ==
+                std::vector<std::string>{"location"});
+
+        auto foreignKeys =
+            storage.get_all<pragma_foreign_key_list>(where(c(&pragma_foreign_key_list::arg) == "visits"));
+        REQUIRE(foreignKeys.size() == 1);
+        REQUIRE(foreignKeys[0].table == "users");
+        REQUIRE(foreignKeys[0].from == "user_id");
+        REQUIRE(foreignKeys[0].to == "id");
+    }
+#endif
+
+#if SQLITE_VERSION_NUMBER >= 3026000
+    SECTION("pragma_table_xinfo") {
+        struct Song {
+            int id = 0;
+            std::string title;
+            std::string genre;
+        };
+        auto storage = make_storage("",
+                                    make_table("songs",
+                                               make_column("id", &Song::id, primary_key()),
+                                               make_column("title", &Song::title),
+                                               make_column("genre", &Song::genre, default_value("pop"))),
+                                    make_pragma_table_xinfo_table());
+        storage.sync_schema();
+
+        auto songColumns = storage.get_all<pragma_table_xinfo>(where(c(&pragma_table_xinfo::arg) == "songs"),
+                                                               order_by(&pragma_table_xinfo::cid));
+        REQUIRE(songColumns.size() == 3);
+        REQUIRE(songColumns[0].pk == 1);
+        REQUIRE_FALSE(songColumns[1].dflt_value);
+        REQUIRE(songColumns[2].dflt_value);
+        REQUIRE(*songColumns[2].dflt_value == "'pop'");
+        REQUIRE(songColumns[2].hidden == 0);
+    }
+#endif
+
+    SECTION("generate_series") {
+        auto storage = make_storage("",
+                                    make_table("users",
+                                               make_column("id", &User::id, primary_key()),
+                                               make_column("name", &User::name)),
+                                    make_generate_series_table());
+        storage.sync_schema();
+        REQUIRE_FALSE(storage.table_exists("generate_series"));
+
+        storage.replace(User{2, "Bebe Rexha"});
+        storage.replace(User{4, "Dua Lipa"});
+
+        auto expression = select(columns(&generate_series::value, count(&User::id)),
+                                 from<generate_series>(),
+                                 left_join<User>(on(c(&User::id) == &generate_series::value)),
+                                 where(c(&generate_series::start) == 1 and c(&generate_series::stop) == 5),
+                                 group_by(&generate_series::value));
+        REQUIRE(
+            storage.dump(expression, true) ==
+            R"(SELECT "generate_series"."value", COUNT("users"."id") FROM "generate_series" LEFT JOIN "users" ON "users"."id" = "generate_series"."value"  WHERE (("generate_series"."start" = ?) AND ("generate_series"."stop" = ?)) GROUP BY "generate_series"."value")");
+
+        //  the series extension isn't necessarily available, without it the table doesn't exist
+        std::string seriesError;
+        try {
+            storage.select(&generate_series::value,
+                           where(c(&generate_series::start) == 1 and c(&generate_series::stop) == 1));
+        } catch(const std::system_error& e) {
+            seriesError = e.what();
+        }
+        if(seriesError.empty()) {
+            auto rows = storage.select(expression);
+            std::vector<std::tuple<int64, int>> expected{{1, 0}, {2, 1}, {3, 0}, {4, 1}, {5, 0}};
+            REQUIRE(rows == expected);
+            REQUIRE(storage.select(&generate_series::value,
+                                   where(c(&generate_series::start) == 1 and c(&generate_series::stop) == 5 and
+                                         c(&generate_series::step) == 2)) == std::vector<int64>{1, 3, 5});
+        } else {
+            using Catch::Matchers::ContainsSubstring;
+            REQUIRE_THAT(seriesError, ContainsSubstring("no such table: generate_series"));
+            WARN("generate_series queries skipped, SQLite is built without the series extension");
+        }
+    }
+
+#ifdef SQLITE_ENABLE_JSON1
+    SECTION("json_each and json_tree") {
+        struct Post {
+            int id = 0;
+            std::string tags;
+        };
+        auto storage = make_storage(
+            "",
+            make_table("posts", make_column("id", &Post::id, primary_key()), make_column("tags", &Post::tags)),
+            make_json_each_table(),
+            make_json_tree_table());
+        storage.sync_schema();
+        storage.replace(Post{1, R"(["c++", "sqlite"])"});
+        storage.replace(Post{2, R"(["sqlite", {"orm": ["json"]}])"});
+
+        SECTION("json_each") {
+            auto rows = storage.select(columns(&Post::id, &json_each::fullkey),
+                                       from<Post>(),
+                                       cross_join<json_each>(),
+                                       where(c(&json_each::json) == &Post::tags and c(&json_each::type) == "text"),
+                                       order_by(&Post::id));
+            std::vector<std::tuple<int, std::string>> expected{{1, "$[0]"}, {1, "$[1]"}, {2, "$[0]"}};
+            REQUIRE(rows == expected);
+
+            auto postIds = storage.select(&Post::id,
+                                          from<Post>(),
+                                          cross_join<json_each>(),
+                                          where(c(&json_each::json) == &Post::tags and c(&json_each::value) == "c++"));
+            REQUIRE(postIds == std::vector<int>{1});
+
+            auto elements = storage.get_all<json_each>(where(c(&json_each::json) == R"({"a": [2, null]})" and
+                                                             c(&json_each::root) == "$.a"));
+            REQUIRE(elements.size() == 2);
+            REQUIRE(elements[0].key);
+            REQUIRE(*elements[0].key == "0");
+            REQUIRE(elements[0].value);
+            REQUIRE(*elements[0].value == "2");
+            REQUIRE(elements[0].atom);
+            REQUIRE(elements[1].fullkey == "$.a[1]");
+            REQUIRE(elements[1].type == "null");
+            REQUIRE_FALSE(elements[1].value);
+            REQUIRE_FALSE(elements[1].parent);
+        }
+        SECTION("json_tree") {
+            auto rows = storage.select(&json_tree::fullkey,
+                                       from<Post>(),
+                                       cross_join<json_tree>(),
+                                       where(c(&json_tree::json) == &Post::tags and c(&Post::id) == 2 and
+                                             c(&json_tree::atom) == "json"));
+            REQUIRE(rows == std::vector<std::string>{"$[1].orm[0]"});
+
+            auto elements = storage.get_all<json_tree>(where(c(&json_tree::json) == R"({"a": [1]})"));
+            REQUIRE(elements.size() == 3);
+            REQUIRE_FALSE(elements[0].key);
+            REQUIRE_FALSE(elements[0].atom);
+            REQUIRE(elements[0].value);
+            REQUIRE(*elements[0].value == R"({"a":[1]})");
+            REQUIRE_FALSE(elements[1].atom);
+            REQUIRE(elements[2].atom);
+            REQUIRE(*elements[2].atom == "1");
+        }
+    }
+#endif  //  SQLITE_ENABLE_JSON1
 }
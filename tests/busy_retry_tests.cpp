@@ -0,0 +1,102 @@
+#include <sqlite_orm/sqlite_orm.h>
+#include <catch2/catch_all.hpp>
+#include <cstdio>  //  remove
+#include "catch_matchers.h"
+
+using namespace sqlite_orm;
+
+TEST_CASE("busy_retry_policy backoff") {
+    busy_retry_policy policy;
+    policy.initial_backoff = std::chrono::microseconds{1000};
+    policy.max_backoff = std::chrono::microseconds{5000};
+    policy.multiplier = 2;
+    policy.jitter = 0.5;
+
+    REQUIRE(policy.backoff(1, 0) == std::chrono::microseconds{1000});
+    REQUIRE(policy.backoff(2, 0) == std::chrono::microseconds{2000});
+    REQUIRE(policy.backoff(3, 0) == std::chrono::microseconds{4000});
+    REQUIRE(policy.backoff(4, 0) == std::chrono::microseconds{5000});
+    REQUIRE(policy.backoff(40, 0) == std::chrono::microseconds{5000});
+    REQUIRE(policy.backoff(2, 0.5) == std::chrono::microseconds{1500});
+}
+
+TEST_CASE("retry_on_busy") {
+    const std::string filename = "busy_retry_tests.sqlite";
+    ::remove(filename.c_str());
+    struct Visit {
+        int id = 0;
+        std::string location;
+    };
+    auto makeStorage = [&filename] {
+        return make_storage(filename,
+                            make_table("visits",
+                                       make_column("id", &Visit::id, primary_key()),
+                                       make_column("location", &Visit::location)));
+    };
+    auto makePolicy = [](int maxAttempts) {
+        busy_retry_policy policy;
+        policy.max_attempts = maxAttempts;
+        policy.initial_backoff = std::chrono::microseconds{100};
+        policy.max_backoff = std::chrono::microseconds{1000};
+        return policy;
+    };
+    auto locker = makeStorage();
+    auto storage = makeStorage();
+    locker.open_forever();
+    storage.open_forever();
+    locker.sync_schema();
+    const ErrorCodeExceptionMatcher busyMatcher(sqlite_errc(SQLITE_BUSY));
+
+    SECTION("no policy") {
+        locker.begin_exclusive_transaction();
+        REQUIRE_THROWS_MATCHES(storage.replace(Visit{1, "Zurich"}), std::system_error, busyMatcher);
+        locker.rollback();
+        REQUIRE(storage.busy_retry_stats().retries == 0);
+    }
+    SECTION("busy handler gives up") {
+        storage.retry_on_busy(makePolicy(3));
+        locker.begin_exclusive_transaction();
+        REQUIRE_THROWS_MATCHES(storage.replace(Visit{1, "Zurich"}), std::system_error, busyMatcher);
+        locker.rollback();
+        auto stats = storage.busy_retry_stats();
+        REQUIRE(stats.retries == 2);
+        REQUIRE(stats.transaction_retries == 0);
+        REQUIRE(stats.wait_time.count() > 0);
+
+        storage.reset_busy_retry_stats();
+        REQUIRE(storage.busy_retry_stats().retries == 0);
+        storage.replace(Visit{1, "Zurich"});
+        REQUIRE(storage.count<Visit>() == 1);
+    }
+    SECTION("transaction is started over") {
+        storage.retry_on_busy(makePolicy(3));
+        locker.begin_exclusive_transaction();
+        int calls = 0;
+        auto committed = storage.transaction([&] {
+            if(++calls == 2) {
+                locker.rollback();
+            }
+            storage.replace(Visit{1, "Geneva"});
+            return true;
+        });
+        REQUIRE(committed);
+        REQUIRE(calls == 2);
+        REQUIRE(storage.busy_retry_stats().transaction_retries == 1);
+        REQUIRE(locker.get<Visit>(1).location == "Geneva");
+    }
+    SECTION("transaction gives up") {
+        storage.retry_on_busy(makePolicy(2));
+        locker.begin_exclusive_transaction();
+        int calls = 0;
+        REQUIRE_THROWS_MATCHES(storage.transaction([&] {
+            ++calls;
+            storage.replace(Visit{1, "Bern"});
+            return true;
+        }),
+                               std::system_error,
+                               busyMatcher);
+        locker.rollback();
+        REQUIRE(calls == 2);
+        REQUIRE(storage.get_autocommit());
+    }
+}
@@ -0,0 +1,75 @@
+#include <sqlite_orm/sqlite_orm.h>
+#include <catch2/catch_all.hpp>
+
+using namespace sqlite_orm;
+
+namespace {
+    struct Customer {
+        int id = 0;
+        std::string name;
+        std::string city;
+        int age = 0;
+    };
+
+    struct Order {
+        int id = 0;
+        int customerId = 0;
+        double total = 0;
+    };
+}
+
+TEST_CASE("index advisor") {
+    auto storage = make_storage("",
+                                make_index("idx_customers_name", &Customer::name),
+                                make_table("customers",
+                                           make_column("id", &Customer::id, primary_key()),
+                                           make_column("name", &Customer::name),
+                                           make_column("city", &Customer::city),
+                                           make_column("age", &Customer::age)),
+                                make_table("orders",
+                                           make_column("id", &Order::id, primary_key()),
+                                           make_column("customer_id", &Order::customerId),
+                                           make_column("total", &Order::total)));
+    storage.sync_schema();
+    storage.record_queries(true);
+
+    SECTION("recording") {
+        storage.get_all<Customer>(where(c(&Customer::city) == "Paris"));
+        storage.get_all<Customer>(where(c(&Customer::city) == "Rome"));
+        storage.record_queries(false);
+        storage.get_all<Customer>();
+        REQUIRE(storage.recorded_queries() ==
+                std::vector<std::string>{
+                    R"(SELECT "customers"."id", "customers"."name", "customers"."city", "customers"."age" FROM "customers" WHERE ("customers"."city" = ?))"});
+        storage.clear_recorded_queries();
+        REQUIRE(storage.recorded_queries().empty());
+    }
+    SECTION("composite index") {
+        storage.get_all<Customer>(where(c(&Customer::city) == "Paris" and c(&Customer::age) > 30));
+        auto advices = storage.advise_indexes();
+        REQUIRE(advices.size() == 1);
+        REQUIRE(advices[0].table == "customers");
+        REQUIRE(advices[0].columns == std::vector<std::string>{"city", "age"});
+        REQUIRE(advices[0].sql == R"(CREATE INDEX "idx_customers_city_age" ON "customers" ("city", "age"))");
+        REQUIRE(advices[0].definition == R"(make_index("idx_customers_city_age", &T::city, &T::age))");
+        REQUIRE(advices[0].queries == storage.recorded_queries());
+    }
+    SECTION("join") {
+        storage.select(columns(&Customer::name, &Order::total),
+                       join<Order>(on(c(&Order::customerId) == &Customer::id)),
+                       where(c(&Customer::name) == "Ann"));
+        storage.get_all<Order>(where(c(&Order::customerId) == 1));
+        auto advices = storage.advise_indexes();
+        REQUIRE(advices.size() == 1);
+        REQUIRE(advices[0].table == "orders");
+        REQUIRE(advices[0].columns == std::vector<std::string>{"customer_id"});
+        REQUIRE(advices[0].queries.size() == 2);
+    }
+    SECTION("nothing to advise") {
+        storage.get_all<Customer>(where(c(&Customer::name) == "Ann"));
+        storage.get_pointer<Order>(1);
+        storage.get_all<Order>();
+        REQUIRE(storage.advise_indexes().empty());
+        REQUIRE(storage.recorded_queries().size() == 3);
+    }
+}
@@ -0,0 +1,135 @@
+#include <sqlite_orm/sqlite_orm.h>
+#include <catch2/catch_all.hpp>
+#include <thread>  //  std::thread
+#include <chrono>  //  std::chrono::milliseconds
+#include "catch_matchers.h"
+
+using namespace sqlite_orm;
+
+namespace {
+    struct Number {
+        int value = 0;
+    };
+
+    struct Letter {
+        int value = 0;
+    };
+
+    auto makeStorage() {
+        auto storage = make_storage({},
+                                    make_table("numbers", make_column("number", &Number::value)),
+                                    make_table("letters", make_column("letter", &Letter::value)));
+        storage.sync_schema();
+        std::vector<Number> numbers(2000);
+        std::vector<Letter> letters(2000);
+        for(int i = 0; i < 2000; ++i) {
+            numbers[i].value = i;
+            letters[i].value = i;
+        }
+        storage.transaction([&] {
+            storage.insert_range(numbers.begin(), numbers.end());
+            storage.insert_range(letters.begin(), letters.end());
+            return true;
+        });
+        return storage;
+    }
+
+    //  4 million rows to compare, long enough to be interrupted
+    template<class S>
+    int slowCount(S& storage) {
+        auto rows = storage.select(count<Number>(),
+                                   from<Number>(),
+                                   cross_join<Letter>(),
+                                   where(c(&Number::value) + c(&Letter::value) == -1));
+        return rows.front();
+    }
+}
+
+TEST_CASE("with_deadline") {
+    auto storage = makeStorage();
+
+    SECTION("exceeded") {
+        const ErrorCodeExceptionMatcher deadlineMatcher(orm_error_code::deadline_exceeded);
+        REQUIRE_THROWS_MATCHES(storage.with_deadline(std::chrono::milliseconds{1},
+                                                     [&storage] {
+                                                         return slowCount(storage);
+                                                     }),
+                               std::system_error,
+                               deadlineMatcher);
+
+        //  connection is still usable and no deadline is active anymore
+        REQUIRE(storage.count<Number>() == 2000);
+        REQUIRE(slowCount(storage) == 0);
+    }
+    SECTION("met") {
+        auto count = storage.with_deadline(std::chrono::hours{1}, [&storage] {
+            return storage.count<Number>();
+        });
+        REQUIRE(count == 2000);
+    }
+    SECTION("nested") {
+        const ErrorCodeExceptionMatcher deadlineMatcher(orm_error_code::deadline_exceeded);
+        REQUIRE_THROWS_MATCHES(storage.with_deadline(std::chrono::milliseconds{1},
+                                                     [&storage] {
+                                                         return storage.with_deadline(std::chrono::hours{1},
+                                                                                      [&storage] {
+                                                                                          return slowCount(storage);
+                                                                                      });
+                                                     }),
+                               std::system_error,
+                               deadlineMatcher);
+    }
+}
+
+TEST_CASE("with_cancellation") {
+    auto storage = makeStorage();
+    cancellation_token token;
+    const ErrorCodeExceptionMatcher cancelledMatcher(orm_error_code::query_cancelled);
+
+    SECTION("cancelled before") {
+        token.cancel();
+        REQUIRE_THROWS_MATCHES(storage.with_cancellation(token,
+                                                         [&storage] {
+                                                             return slowCount(storage);
+                                                         }),
+                               std::system_error,
+                               cancelledMatcher);
+        token.reset();
+        REQUIRE(storage.with_cancellation(token, [&storage] {
+            return storage.count<Letter>();
+        }) == 2000);
+    }
+    SECTION("cancelled from another thread") {
+        std::thread canceller{[token]() mutable {
+            std::this_thread::sleep_for(std::chrono::milliseconds{10});
+            token.cancel();
+        }};
+        REQUIRE_THROWS_MATCHES(storage.with_cancellation(token,
+                                                         [&storage] {
+                                                             while(true) {
+                                                                 slowCount(storage);
+                                                             }
+                                                         }),
+                               std::system_error,
+                               cancelledMatcher);
+        canceller.join();
+        REQUIRE(storage.count<Number>() == 2000);
+    }
+}
+
+TEST_CASE("interrupt") {
+    auto storage = makeStorage();
+    std::thread interrupter{[&storage] {
+        std::this_thread::sleep_for(std::chrono::milliseconds{10});
+        storage.interrupt();
+    }};
+    REQUIRE_THROWS_AS(
+        [&storage] {
+            while(true) {
+                slowCount(storage);
+            }
+        }(),
+        std::system_error);
+    interrupter.join();
+    REQUIRE(storage.count<Number>() == 2000);
+}
@@ -1,6 +1,8 @@
 #include <sqlite_orm/sqlite_orm.h>
 #include <catch2/catch_all.hpp>
-#include <numeric>  //  std::iota
+#include <numeric>  //  std::iota, std::accumulate
+#include <algorithm>  //  std::is_sorted
+#include <thread>  //  std::thread, std::this_thread
 
 using namespace sqlite_orm;
 
@@ -107,3 +109,148 @@ TEST_CASE("Iterate select statement") {
 #endif
 }
 #endif
+
+TEST_CASE("parallel_for_each") {
+    struct Item {
+        int id = 0;
+        int value = 0;
+    };
+    auto makeStorage = [](const std::string& filename) {
+        return make_storage(
+            filename,
+            make_table("items", make_column("id", &Item::id, primary_key()), make_column("value", &Item::value)));
+    };
+    using Storage = decltype(makeStorage(""));
+    const char* path = "parallel_for_each.sqlite";
+    ::remove(path);
+    auto check = [](Storage& storage, bool onThreads) {
+        storage.sync_schema();
+        storage.transaction([&storage] {
+            for(int id = 1; id <= 1000; ++id) {
+                storage.replace(Item{id, id % 10});
+            }
+            return true;
+        });
+
+        //  callbacks of different partitions run concurrently, each one only touches its own slots
+        std::vector<int> sums(4);
+        std::vector<int> lastIds(4);
+        std::vector<int> ordered(4, 1);
+        std::vector<std::thread::id> threads(4);
+        storage.parallel_for_each<Item>(4, [&sums, &lastIds, &ordered, &threads](const Item& item, int partition) {
+            if(item.id <= lastIds[partition]) {
+                ordered[partition] = 0;
+            }
+            lastIds[partition] = item.id;
+            sums[partition] += item.value;
+            threads[partition] = std::this_thread::get_id();
+        });
+        REQUIRE(std::accumulate(sums.begin(), sums.end(), 0) == 4500);
+        REQUIRE(lastIds == std::vector<int>{250, 500, 750, 1000});
+        REQUIRE(ordered == std::vector<int>(4, 1));
+        //  the number of partitions doesn't depend on the number of hardware threads
+        REQUIRE(threads[0] == std::this_thread::get_id());
+        for(int partition = 1; partition < 4; ++partition) {
+            REQUIRE((threads[partition] != std::this_thread::get_id()) == onThreads);
+        }
+
+        auto items = storage.parallel_get_all<Item>(3, where(c(&Item::value) == 7));
+        REQUIRE(items.size() == 100);
+        REQUIRE(items.front().id == 7);
+        REQUIRE(items.back().id == 997);
+        REQUIRE(std::is_sorted(items.begin(), items.end(), [](const Item& lhs, const Item& rhs) {
+            return lhs.id < rhs.id;
+        }));
+
+        storage.remove_all<Item>();
+        REQUIRE(storage.parallel_get_all<Item>(4).empty());
+    };
+    SECTION("file") {
+        auto storage = makeStorage(path);
+        check(storage, true);
+    }
+    SECTION("in memory") {
+        auto storage = makeStorage("");
+        check(storage, false);
+    }
+}
+
+TEST_CASE("iterate_pipelined") {
+    struct Item {
+        int id = 0;
+        int value = 0;
+    };
+    auto storage = make_storage(
+        "",
+        make_table("items", make_column("id", &Item::id, primary_key()), make_column("value", &Item::value)));
+    storage.sync_schema();
+    storage.transaction([&storage] {
+        for(int id = 1; id <= 1000; ++id) {
+            storage.replace(Item{id, id % 10});
+        }
+        return true;
+    });
+
+    SECTION("columns") {
+        int expectedId = 1;
+        int sum = 0;
+        for(auto& row: storage.iterate_pipelined(select(columns(&Item::id, &Item::value), order_by(&Item::id)), 8)) {
+            REQUIRE(std::get<0>(row) == expectedId++);
+            sum += std::get<1>(row);
+        }
+        REQUIRE(expectedId == 1001);
+        REQUIRE(sum == 4500);
+    }
+    SECTION("objects") {
+        auto view = storage.iterate_pipelined(select(object<Item>(), where(c(&Item::value) == 3)));
+        std::vector<int> ids;
+        for(auto it = view.begin(); it != view.end(); ++it) {
+            ids.push_back(it->id);
+        }
+        REQUIRE(ids.size() == 100);
+        REQUIRE(ids.back() == 993);
+    }
+    SECTION("empty") {
+        auto view = storage.iterate_pipelined(select(&Item::id, where(c(&Item::id) > 1000)));
+        REQUIRE(view.begin() == view.end());
+    }
+    SECTION("stopped early") {
+        {
+            auto view = storage.iterate_pipelined(select(&Item::id), 4);
+            REQUIRE(*view.begin() == 1);
+        }
+        REQUIRE(storage.count<Item>() == 1000);
+    }
+    SECTION("rows without default constructor") {
+        struct Row {
+            explicit Row(int id) : id{id} {}
+            int id;
+        };
+        std::vector<int> ids;
+        {
+            internal::pipelined_view<Row> view{nullptr, 2, [](internal::row_queue<Row>& queue) {
+                for(int id = 1; id <= 5; ++id) {
+                    if(!queue.push(Row{id})) {
+                        return;
+                    }
+                }
+            }};
+            for(auto& row: view) {
+                ids.push_back(row.id);
+            }
+        }
+        REQUIRE(ids == std::vector<int>{1, 2, 3, 4, 5});
+        {
+            //  rows still queued are destroyed with the view
+            internal::pipelined_view<std::unique_ptr<Row>> view{
+                nullptr,
+                8,
+                [](internal::row_queue<std::unique_ptr<Row>>& queue) {
+                    for(int id = 1; id <= 5; ++id) {
+                        queue.push(std::make_unique<Row>(id));
+                    }
+                }};
+            REQUIRE((*view.begin())->id == 1);
+        }
+    }
+}
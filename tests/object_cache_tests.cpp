@@ -0,0 +1,270 @@
+#include <sqlite_orm/sqlite_orm.h>
+#include <catch2/catch_all.hpp>
+#include <cstdio>  //  remove
+#include "catch_matchers.h"
+
+using namespace sqlite_orm;
+
+TEST_CASE("object cache") {
+    struct Product {
+        int id = 0;
+        std::string name;
+    };
+    auto storage = make_storage("",
+                                make_table("products",
+                                           make_column("id", &Product::id, primary_key()),
+                                           make_column("name", &Product::name)));
+    storage.sync_schema();
+    storage.replace(Product{1, "apple"});
+    storage.replace(Product{2, "pear"});
+    storage.replace(Product{3, "plum"});
+    storage.enable_object_cache<Product>(2);
+
+    REQUIRE(storage.get<Product>(1).name == "apple");
+    REQUIRE(storage.get_pointer<Product>(1)->name == "apple");
+    auto stats = storage.object_cache_stats<Product>();
+    REQUIRE(stats.misses == 1);
+    REQUIRE(stats.hits == 1);
+
+    SECTION("shared handle") {
+        auto first = storage.get_shared<Product>(1);
+        auto second = storage.get_shared<Product>(1);
+        REQUIRE(first == second);
+    }
+    SECTION("not found") {
+        const ErrorCodeExceptionMatcher notFoundMatcher(orm_error_code::not_found);
+        REQUIRE_THROWS_MATCHES(storage.get<Product>(10), std::system_error, notFoundMatcher);
+        REQUIRE_FALSE(storage.get_pointer<Product>(10));
+        REQUIRE(storage.object_cache_stats<Product>().misses == 3);
+    }
+    SECTION("eviction") {
+        storage.get<Product>(2);
+        storage.get<Product>(3);
+        REQUIRE(storage.object_cache_stats<Product>().evictions == 1);
+        storage.get<Product>(1);
+        REQUIRE(storage.object_cache_stats<Product>().misses == 4);
+    }
+    SECTION("invalidated by own writes") {
+        storage.get<Product>(2);
+        storage.update(Product{1, "green apple"});
+        REQUIRE(storage.object_cache_stats<Product>().invalidations == 1);
+        REQUIRE(storage.get<Product>(1).name == "green apple");
+        REQUIRE(storage.get<Product>(2).name == "pear");
+
+        storage.update_all(set(c(&Product::name) = "fruit"));
+        REQUIRE(storage.get<Product>(2).name == "fruit");
+    }
+    SECTION("remove_all with conditions keeps other objects") {
+        storage.get<Product>(2);
+        storage.remove_all<Product>(where(c(&Product::id) == 1));
+        REQUIRE_FALSE(storage.get_pointer<Product>(1));
+        REQUIRE(storage.get<Product>(2).name == "pear");
+        REQUIRE(storage.object_cache_stats<Product>().hits == 2);
+    }
+    SECTION("not filled inside a transaction") {
+        storage.begin_transaction();
+        storage.update(Product{2, "nashi"});
+        REQUIRE(storage.get<Product>(2).name == "nashi");
+        storage.rollback();
+        REQUIRE(storage.get<Product>(2).name == "pear");
+    }
+    SECTION("disable") {
+        storage.enable_object_cache<Product>(0);
+        storage.get<Product>(1);
+        REQUIRE(storage.object_cache_stats<Product>().hits == 0);
+    }
+}
+
+TEST_CASE("object cache and rows deleted by REPLACE") {
+    struct User {
+        int id = 0;
+        std::string email;
+    };
+    auto storage = make_storage("",
+                                make_table("users",
+                                           make_column("id", &User::id, primary_key()),
+                                           make_column("email", &User::email, unique())));
+    storage.sync_schema();
+    storage.enable_object_cache<User>(10);
+    storage.replace(User{1, "x"});
+    REQUIRE(storage.get<User>(1).email == "x");
+
+    SECTION("replace") {
+        //  deletes user 1 without the update hook noticing
+        storage.replace(User{2, "x"});
+    }
+    SECTION("replace_range") {
+        std::vector<User> users{{2, "x"}};
+        storage.replace_range(users.begin(), users.end());
+    }
+    SECTION("insert or replace") {
+        storage.insert(or_replace(), into<User>(), columns(&User::id, &User::email), values(std::make_tuple(2, "x")));
+    }
+#if SQLITE_VERSION_NUMBER >= 3035000
+    SECTION("replace returning") {
+        auto statement = storage.prepare(returning(replace(User{2, "x"}), &User::id));
+        REQUIRE(storage.execute(statement) == std::vector<int>{2});
+    }
+#endif
+    REQUIRE(storage.count<User>() == 1);
+    REQUIRE_FALSE(storage.get_pointer<User>(1));
+}
+
+TEST_CASE("object cache of keys which aren't rowid aliases") {
+    struct Tag {
+        int id = 0;
+        std::string name;
+    };
+    auto storage = make_storage(
+        "",
+        make_table("tags", make_column("id", &Tag::id, primary_key().desc()), make_column("name", &Tag::name)));
+    storage.sync_schema();
+    storage.enable_object_cache<Tag>(10);
+    //  INTEGER PRIMARY KEY DESC doesn't alias the rowid, so these rows get rowids 1 and 2
+    storage.replace(Tag{5, "red"});
+    storage.replace(Tag{1, "green"});
+    REQUIRE(storage.get<Tag>(5).name == "red");
+    storage.update(Tag{5, "blue"});
+    REQUIRE(storage.get<Tag>(5).name == "blue");
+}
+
+TEST_CASE("object caches of tables with the same name in different schemas") {
+    struct Product {
+        int id = 0;
+        std::string name;
+    };
+    struct ArchivedProduct {
+        int id = 0;
+        std::string name;
+    };
+    auto storage = make_storage(
+        "",
+        make_table("products", make_column("id", &Product::id, primary_key()), make_column("name", &Product::name)),
+        make_table("products",
+                   make_column("id", &ArchivedProduct::id, primary_key()),
+                   make_column("name", &ArchivedProduct::name))
+            .in_schema("archive"));
+    storage.attach(":memory:", "archive");
+    storage.sync_schema();
+    storage.replace(Product{1, "apple"});
+    storage.replace(ArchivedProduct{1, "quince"});
+    storage.enable_object_cache<Product>(10);
+    storage.enable_object_cache<ArchivedProduct>(10);
+    REQUIRE(storage.get<Product>(1).name == "apple");
+    REQUIRE(storage.get<ArchivedProduct>(1).name == "quince");
+
+    storage.update(ArchivedProduct{1, "medlar"});
+    REQUIRE(storage.object_cache_stats<Product>().invalidations == 0);
+    REQUIRE(storage.object_cache_stats<ArchivedProduct>().invalidations == 1);
+    REQUIRE(storage.get<Product>(1).name == "apple");
+    REQUIRE(storage.get<ArchivedProduct>(1).name == "medlar");
+    REQUIRE(storage.object_cache_stats<Product>().hits == 1);
+}
+
+TEST_CASE("object cache and changes the update hook doesn't report") {
+    struct User {
+        int id = 0;
+        std::string name;
+    };
+    const std::string filename = "object_cache_tests.sqlite";
+    ::remove(filename.c_str());
+    auto storage = make_storage(
+        filename,
+        make_table("users", make_column("id", &User::id, primary_key()), make_column("name", &User::name)));
+    storage.open_forever();
+    storage.sync_schema();
+    storage.replace(User{1, "Aurora"});
+    storage.enable_object_cache<User>(10);
+    REQUIRE(storage.get_pointer<User>(1));
+
+    SECTION("key assigned") {
+        storage.update_all(set(c(&User::id) = 5), where(c(&User::id) == 1));
+        REQUIRE_FALSE(storage.get_pointer<User>(1));
+        REQUIRE(storage.get<User>(5).name == "Aurora");
+    }
+    SECTION("rowid assigned") {
+        storage.update_all(set(c(rowid<User>()) = 5), where(c(&User::id) == 1));
+        REQUIRE_FALSE(storage.get_pointer<User>(1));
+    }
+    SECTION("key assigned with a dynamic set") {
+        auto assignments = dynamic_set(storage);
+        assignments.push_back(assign(&User::id, 5));
+        storage.update_all(assignments, where(c(&User::id) == 1));
+        REQUIRE_FALSE(storage.get_pointer<User>(1));
+    }
+#if SQLITE_VERSION_NUMBER >= 3035000
+    SECTION("key assigned by update_all returning") {
+        auto statement =
+            storage.prepare(returning(update_all(set(c(&User::id) = 5), where(c(&User::id) == 1)), &User::id));
+        REQUIRE(storage.execute(statement) == std::vector<int>{5});
+        REQUIRE_FALSE(storage.get_pointer<User>(1));
+    }
+#endif
+    SECTION("drop_table") {
+        storage.drop_table("users");
+        storage.sync_schema();
+        REQUIRE_FALSE(storage.get_pointer<User>(1));
+    }
+    SECTION("backup_from") {
+        auto other = make_storage(
+            "",
+            make_table("users", make_column("id", &User::id, primary_key()), make_column("name", &User::name)));
+        other.sync_schema();
+        other.replace(User{1, "Birdy"});
+        storage.backup_from(other);
+        REQUIRE(storage.get<User>(1).name == "Birdy");
+    }
+#if SQLITE_VERSION_NUMBER >= 3036000 && !defined(SQLITE_OMIT_DESERIALIZE)
+    SECTION("deserialize") {
+        auto countUsers = [&storage] {
+            return storage.cached(std::chrono::hours{1}).select(count<User>()).front();
+        };
+        REQUIRE(countUsers() == 1);
+        auto data = storage.serialize();
+        storage.replace(User{1, "Birdy"});
+        storage.replace(User{2, "Cleo"});
+        REQUIRE(countUsers() == 2);
+        storage.deserialize(data);
+        REQUIRE(storage.get<User>(1).name == "Aurora");
+        REQUIRE(countUsers() == 1);
+    }
+#endif
+}
+
+TEST_CASE("object cache detects changes by other connections") {
+    const std::string filename = "object_cache_tests.sqlite";
+    ::remove(filename.c_str());
+    struct Product {
+        int id = 0;
+        std::string name;
+    };
+    auto makeStorage = [&filename] {
+        return make_storage(filename,
+                            make_table("products",
+                                       make_column("id", &Product::id, primary_key()),
+                                       make_column("name", &Product::name)));
+    };
+    auto storage = makeStorage();
+    auto other = makeStorage();
+    storage.sync_schema();
+    storage.replace(Product{1, "apple"});
+
+    SECTION("connection kept open") {
+        storage.open_forever();
+        storage.enable_object_cache<Product>(10);
+        REQUIRE(storage.get<Product>(1).name == "apple");
+        REQUIRE(storage.get<Product>(1).name == "apple");
+        REQUIRE(storage.object_cache_stats<Product>().hits == 1);
+
+        other.update(Product{1, "cherry"});
+        REQUIRE(storage.get<Product>(1).name == "cherry");
+        REQUIRE(storage.object_cache_stats<Product>().invalidations == 1);
+    }
+    SECTION("connection not kept open") {
+        storage.enable_object_cache<Product>(10);
+        storage.get<Product>(1);
+        storage.get<Product>(1);
+        REQUIRE(storage.object_cache_stats<Product>().misses == 0);
+        REQUIRE(storage.object_cache_stats<Product>().hits == 0);
+    }
+}
@@ -0,0 +1,67 @@
+#include <sqlite_orm/sqlite_orm.h>
+#include <catch2/catch_all.hpp>
+
+#include "prepared_common.h"
+
+#if SQLITE_VERSION_NUMBER >= 3035000
+using namespace sqlite_orm;
+
+TEST_CASE("Prepared returning") {
+    using namespace PreparedStatementTests;
+    using Catch::Matchers::UnorderedEquals;
+
+    auto storage = make_storage({},
+                                make_table("users",
+                                           make_column("id", &User::id, primary_key().autoincrement()),
+                                           make_column("name", &User::name)),
+                                make_table("visits",
+                                           make_column("id", &Visit::id, primary_key().autoincrement()),
+                                           make_column("user_id", &Visit::userId),
+                                           make_column("time", &Visit::time)));
+    storage.sync_schema();
+    storage.replace(User{1, "Team BS"});
+    storage.replace(User{2, "Shy'm"});
+
+    SECTION("insert") {
+        auto statement = storage.prepare(returning(insert(User{0, "Maître Gims"}), &User::id));
+        testSerializing(statement);
+        auto ids = storage.execute(statement);
+        REQUIRE(ids == std::vector<int>{3});
+        REQUIRE(storage.get<User>(3).name == "Maître Gims");
+    }
+    SECTION("insert columns") {
+        auto statement =
+            storage.prepare(returning(insert(Visit{0, 2, 100}), columns(&Visit::id, &Visit::userId, &Visit::time)));
+        auto rows = storage.execute(statement);
+        REQUIRE(rows == std::vector<std::tuple<int, int, long>>{{1, 2, 100}});
+
+        rows = storage.execute(statement);
+        REQUIRE(rows == std::vector<std::tuple<int, int, long>>{{2, 2, 100}});
+    }
+    SECTION("insert_range") {
+        std::vector<User> users = {User{0, "Lady Gaga"}, User{0, "Kesha"}};
+        auto statement = storage.prepare(returning(insert_range(users.begin(), users.end()), &User::id));
+        auto ids = storage.execute(statement);
+        REQUIRE_THAT(ids, UnorderedEquals<int>({3, 4}));
+    }
+    SECTION("replace") {
+        auto statement = storage.prepare(returning(replace(User{2, "Louane"}), object<User>()));
+        auto rows = storage.execute(statement);
+        REQUIRE(rows == std::vector<User>{User{2, "Louane"}});
+    }
+    SECTION("update_all") {
+        auto statement =
+            storage.prepare(returning(update_all(set(c(&User::name) = "Zaz"), where(c(&User::id) > 1)),
+                                      columns(&User::id, c(&User::id) * 10)));
+        auto rows = storage.execute(statement);
+        REQUIRE(rows == std::vector<std::tuple<int, double>>{{2, 20}});
+        REQUIRE(storage.get<User>(2).name == "Zaz");
+    }
+    SECTION("remove_all") {
+        auto statement = storage.prepare(returning(remove_all<User>(where(c(&User::id) == 1)), &User::name));
+        auto names = storage.execute(statement);
+        REQUIRE(names == std::vector<std::string>{"Team BS"});
+        REQUIRE(storage.count<User>() == 1);
+    }
+}
+#endif
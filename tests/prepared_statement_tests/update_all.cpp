@@ -157,5 +157,21 @@ TEST_CASE("Prepared update all") {
             }
         }
     }
+#if SQLITE_VERSION_NUMBER >= 3033000
+    {  //  from
+        auto statement = storage.prepare(update_all(set(c(&UserAndVisit::description) = &User::name),
+                                                    from<User>(),
+                                                    where(c(&User::id) == &UserAndVisit::userId and c(&User::id) > 2)));
+        REQUIRE(get<0>(statement) == 2);
+        testSerializing(statement);
+        storage.execute(statement);
+        auto descriptions = storage.select(columns(&UserAndVisit::userId, &UserAndVisit::description),
+                                           order_by(&UserAndVisit::userId));
+        std::vector<std::tuple<decltype(UserAndVisit::userId), decltype(UserAndVisit::description)>> expected;
+        expected.emplace_back(2, "Glad you came");
+        expected.emplace_back(3, storage.get<User>(3).name);
+        REQUIRE(descriptions == expected);
+    }
+#endif
 }
 #endif
@@ -0,0 +1,217 @@
+#include <sqlite_orm/sqlite_orm.h>
+#include <catch2/catch_all.hpp>
+#include <cstdio>  //  remove
+#include <thread>  //  std::this_thread::sleep_for
+
+using namespace sqlite_orm;
+
+TEST_CASE("query cache") {
+    struct Employee {
+        int id = 0;
+        std::string department;
+        double salary = 0;
+    };
+    struct Department {
+        std::string name;
+    };
+    auto storage = make_storage("",
+                                make_table("employees",
+                                           make_column("id", &Employee::id, primary_key()),
+                                           make_column("department", &Employee::department),
+                                           make_column("salary", &Employee::salary)),
+                                make_table("departments", make_column("name", &Department::name)));
+    storage.sync_schema();
+    storage.replace(Employee{1, "sales", 100});
+    storage.replace(Employee{2, "sales", 200});
+    storage.replace(Employee{3, "support", 300});
+
+    auto countBySalary = [&storage](double salary) {
+        return storage.cached(std::chrono::hours{1})
+            .select(columns(&Employee::department, count(&Employee::id)),
+                    where(c(&Employee::salary) >= salary),
+                    group_by(&Employee::department));
+    };
+    auto rows = countBySalary(150);
+    REQUIRE(rows.size() == 2);
+    REQUIRE(countBySalary(150) == rows);
+    REQUIRE(storage.query_cache_stats().hits == 1);
+    REQUIRE(storage.query_cache_stats().misses == 1);
+
+    SECTION("bound values are part of the key") {
+        REQUIRE(countBySalary(100).size() == 2);
+        REQUIRE(countBySalary(250).size() == 1);
+        REQUIRE(storage.query_cache_stats().misses == 3);
+    }
+    SECTION("types of bound numbers are part of the key") {
+        auto idsFrom = [&storage](auto id) {
+            return storage.cached(std::chrono::hours{1}).select(&Employee::id, where(c(&Employee::id) >= id));
+        };
+        //  0.0 and the 64 bit integer 0 have the same bytes
+        REQUIRE(idsFrom(int64(0)).size() == 3);
+        REQUIRE(idsFrom(0.0).size() == 3);
+        REQUIRE(idsFrom(2.5).size() == 1);
+        REQUIRE(storage.query_cache_stats().misses == 4);
+    }
+    SECTION("result types are part of the key") {
+        auto ids = storage.cached(std::chrono::hours{1}).select(&Employee::id);
+        auto tuples = storage.cached(std::chrono::hours{1}).select(columns(&Employee::id));
+        REQUIRE(ids.size() == 3);
+        REQUIRE(tuples.size() == 3);
+        REQUIRE(storage.query_cache_stats().misses == 3);
+    }
+    SECTION("invalidated by a change of a referenced table") {
+        storage.replace(Department{"sales"});
+        REQUIRE(countBySalary(150) == rows);
+        REQUIRE(storage.query_cache_stats().hits == 2);
+
+        storage.update(Employee{1, "sales", 500});
+        rows = countBySalary(150);
+        REQUIRE(storage.query_cache_stats().invalidations == 1);
+        REQUIRE(std::get<1>(rows.front()) == 2);
+    }
+    SECTION("invalidated by remove_all") {
+        storage.remove_all<Employee>();
+        REQUIRE(countBySalary(150).empty());
+    }
+    SECTION("tables referenced only in FROM") {
+        auto countPairs = [&storage] {
+            return storage.cached(std::chrono::hours{1})
+                .select(count<Department>(), from<Department>(), cross_join<Employee>())
+                .front();
+        };
+        REQUIRE(countPairs() == 0);
+        storage.replace(Department{"support"});
+        REQUIRE(countPairs() == 3);
+    }
+    SECTION("expiration") {
+        storage.cached(std::chrono::milliseconds{1}).select(&Employee::id);
+        std::this_thread::sleep_for(std::chrono::milliseconds{5});
+        storage.cached(std::chrono::milliseconds{1}).select(&Employee::id);
+        REQUIRE(storage.query_cache_stats().misses == 3);
+        REQUIRE(storage.query_cache_stats().invalidations == 1);
+    }
+    SECTION("capacity") {
+        storage.set_query_cache_capacity(1);
+        countBySalary(100);
+        REQUIRE(storage.query_cache_stats().evictions == 1);
+        countBySalary(150);
+        REQUIRE(storage.query_cache_stats().misses == 3);
+    }
+    SECTION("not filled inside a transaction") {
+        storage.begin_transaction();
+        storage.remove<Employee>(3);
+        REQUIRE(countBySalary(100).size() == 1);
+        storage.rollback();
+        REQUIRE(countBySalary(100).size() == 2);
+    }
+}
+
+TEST_CASE("query cache detects changes by other connections") {
+    const std::string filename = "query_cache_tests.sqlite";
+    ::remove(filename.c_str());
+    struct Employee {
+        int id = 0;
+        std::string department;
+        double salary = 0;
+    };
+    auto makeStorage = [&filename] {
+        return make_storage(filename,
+                            make_table("employees",
+                                       make_column("id", &Employee::id, primary_key()),
+                                       make_column("department", &Employee::department),
+                                       make_column("salary", &Employee::salary)));
+    };
+    auto storage = makeStorage();
+    auto other = makeStorage();
+    storage.sync_schema();
+    storage.open_forever();
+    storage.replace(Employee{1, "sales", 100});
+
+    auto ids = [&storage] {
+        return storage.cached(std::chrono::hours{1}).select(&Employee::id);
+    };
+    REQUIRE(ids().size() == 1);
+    REQUIRE(ids().size() == 1);
+    REQUIRE(storage.query_cache_stats().hits == 1);
+
+    other.replace(Employee{2, "sales", 100});
+    REQUIRE(ids().size() == 2);
+    REQUIRE(storage.query_cache_stats().misses == 2);
+}
+
+TEST_CASE("query cache tells schemas apart") {
+    struct Employee {
+        int id = 0;
+        std::string department;
+    };
+    struct ArchivedEmployee {
+        int id = 0;
+        std::string department;
+    };
+    auto storage = make_storage("",
+                                make_table("employees",
+                                           make_column("id", &Employee::id, primary_key()),
+                                           make_column("department", &Employee::department)),
+                                make_table("employees",
+                                           make_column("id", &ArchivedEmployee::id, primary_key()),
+                                           make_column("department", &ArchivedEmployee::department))
+                                    .in_schema("archive"));
+    storage.attach(":memory:", "archive");
+    storage.sync_schema();
+    storage.replace(Employee{1, "sales"});
+
+    auto ids = [&storage] {
+        return storage.cached(std::chrono::hours{1}).select(&Employee::id);
+    };
+    REQUIRE(ids().size() == 1);
+    storage.replace(ArchivedEmployee{2, "support"});
+    REQUIRE(ids().size() == 1);
+    REQUIRE(storage.query_cache_stats().hits == 1);
+
+    storage.replace(Employee{3, "support"});
+    REQUIRE(ids().size() == 2);
+    REQUIRE(storage.query_cache_stats().invalidations == 1);
+}
+
+TEST_CASE("query cache and dropped tables") {
+    struct Employee {
+        int id = 0;
+        std::string department;
+    };
+    auto storage = make_storage("",
+                                make_table("employees",
+                                           make_column("id", &Employee::id, primary_key()),
+                                           make_column("department", &Employee::department)));
+    storage.sync_schema();
+    storage.replace(Employee{1, "sales"});
+
+    auto countEmployees = [&storage] {
+        return storage.cached(std::chrono::hours{1}).select(count<Employee>()).front();
+    };
+    REQUIRE(countEmployees() == 1);
+    storage.drop_table("employees");
+    storage.sync_schema();
+    REQUIRE(countEmployees() == 0);
+}
+
+TEST_CASE("query cache skips WITHOUT ROWID tables") {
+    struct Setting {
+        std::string name;
+        std::string value;
+    };
+    auto storage = make_storage("",
+                                make_table("settings",
+                                           make_column("name", &Setting::name, primary_key()),
+                                           make_column("value", &Setting::value))
+                                    .without_rowid());
+    storage.sync_schema();
+    storage.replace(Setting{"theme", "light"});
+
+    auto values = [&storage] {
+        return storage.cached(std::chrono::hours{1}).select(&Setting::value);
+    };
+    REQUIRE(values() == std::vector<std::string>{"light"});
+    storage.replace(Setting{"theme", "dark"});
+    REQUIRE(values() == std::vector<std::string>{"dark"});
+    REQUIRE(storage.query_cache_stats().hits == 0);
+}
@@ -0,0 +1,152 @@
+#include <sqlite_orm/sqlite_orm.h>
+#include <catch2/catch_all.hpp>
+
+#if SQLITE_VERSION_NUMBER >= 3020000
+using namespace sqlite_orm;
+
+namespace {
+    struct Item {
+        int id = 0;
+        std::string name;
+
+#ifndef SQLITE_ORM_AGGREGATE_NSDMI_SUPPORTED
+        Item() = default;
+        Item(int id, std::string name) : id{id}, name{std::move(name)} {}
+#endif
+    };
+
+    struct Weight {
+        int itemId = 0;
+        double weight = 0;
+
+#ifndef SQLITE_ORM_AGGREGATE_NSDMI_SUPPORTED
+        Weight() = default;
+        Weight(int itemId, double weight) : itemId{itemId}, weight{weight} {}
+#endif
+    };
+
+    struct Tag {
+        std::string name;
+        int itemId = 0;
+
+#ifndef SQLITE_ORM_AGGREGATE_NSDMI_SUPPORTED
+        Tag() = default;
+        Tag(std::string name, int itemId) : name{std::move(name)}, itemId{itemId} {}
+#endif
+    };
+}
+
+TEST_CASE("range table") {
+    auto storage = make_storage(
+        "",
+        make_table("items", make_column("id", &Item::id, primary_key()), make_column("name", &Item::name)),
+        make_table("weights",
+                   make_column("item_id", &Weight::itemId, primary_key()),
+                   make_column("weight", &Weight::weight)),
+        make_table("tags", make_column("name", &Tag::name), make_column("item_id", &Tag::itemId)));
+    storage.create_range_table<Weight>();
+    storage.create_range_table<Tag>();
+    storage.sync_schema();
+    REQUIRE_FALSE(storage.table_exists("weights"));
+    REQUIRE_FALSE(storage.table_exists("tags"));
+
+    std::vector<Item> items;
+    for(int i = 1; i <= 1000; ++i) {
+        items.push_back(Item{i, "item" + std::to_string(i)});
+    }
+    storage.insert_range(items.begin(), items.end());
+
+    std::vector<Weight> weights;
+    for(int i = 1000; i >= 1; i -= 3) {
+        weights.push_back(Weight{i, i / 4.0});
+    }
+
+    SECTION("scan") {
+        auto heavy = storage.select(columns(&Weight::itemId, &Weight::weight),
+                                    where(range_source(weights) and c(&Weight::weight) > 248.0),
+                                    order_by(&Weight::itemId));
+        REQUIRE(heavy == std::vector<std::tuple<int, double>>{{994, 248.5}, {997, 249.25}, {1000, 250}});
+        REQUIRE(storage.count<Weight>(where(range_source(weights))) == int(weights.size()));
+    }
+    SECTION("join by key") {
+        auto joined = storage.select(columns(&Item::name, &Weight::weight),
+                                     join<Weight>(on(c(&Weight::itemId) == &Item::id)),
+                                     where(range_source(weights) and c(&Item::id) < 10),
+                                     order_by(&Item::id));
+        REQUIRE(joined == std::vector<std::tuple<std::string, double>>{{"item1", 0.25}, {"item4", 1}, {"item7", 1.75}});
+
+        auto total = storage.sum(&Weight::weight,
+                                 join<Item>(on(c(&Item::id) == &Weight::itemId)),
+                                 where(range_source(weights)));
+        REQUIRE(total);
+        REQUIRE(*total == 41791.75);
+
+        REQUIRE(storage.select(&Weight::weight, where(range_source(weights) and c(&Weight::itemId) == 2)).empty());
+        REQUIRE(storage.select(&Weight::weight, where(range_source(weights) and c(&Weight::itemId) == 4)) ==
+                std::vector<double>{1});
+
+        //  the range table is the inner loop of a LEFT JOIN, so the range goes to the ON clause
+        auto leftJoined =
+            storage.select(columns(&Item::id, &Weight::weight),
+                           left_join<Weight>(on(range_source(weights) and c(&Weight::itemId) == &Item::id)),
+                           where(c(&Item::id) <= 4),
+                           order_by(&Item::id));
+        REQUIRE(leftJoined == std::vector<std::tuple<int, double>>{{1, 0.25}, {2, 0}, {3, 0}, {4, 1}});
+    }
+    SECTION("key lookups see changes of the range between statements") {
+        auto weightOf = [&storage, &weights](int itemId) {
+            return storage.select(&Weight::weight, where(range_source(weights) and c(&Weight::itemId) == itemId));
+        };
+        REQUIRE(weightOf(4) == std::vector<double>{1});
+        weights.back().itemId = 2;
+        REQUIRE(weightOf(2) == std::vector<double>{0.25});
+        REQUIRE(weightOf(4) == std::vector<double>{1});
+    }
+    SECTION("key lookups compare values like SQLite") {
+        auto weightOf = [&storage, &weights](auto itemId) {
+            return storage.select(&Weight::weight, where(range_source(weights) and c(&Weight::itemId) == itemId));
+        };
+        REQUIRE(weightOf(4.0) == std::vector<double>{1});
+        REQUIRE(weightOf(4.5).empty());
+        REQUIRE(weightOf("4x").empty());
+    }
+    SECTION("key lookups into another range while a range is scanned") {
+        using Catch::Matchers::UnorderedEquals;
+        std::vector<Weight> others;
+        for(int i = 1; i <= 2000; ++i) {
+            others.push_back(Weight{i, i * 2.0});
+        }
+        //  a range isn't a table, its keys needn't be unique
+        weights.push_back(Weight{4, 3});
+        std::vector<std::tuple<double, double>> rows;
+        for(auto& weight: storage.iterate<Weight>(where(range_source(weights) and c(&Weight::itemId) == 4))) {
+            auto other = storage.select(&Weight::weight, where(range_source(others) and c(&Weight::itemId) == 4));
+            rows.emplace_back(weight.weight, other.at(0));
+        }
+        REQUIRE_THAT(rows, UnorderedEquals(std::vector<std::tuple<double, double>>{{1, 8}, {3, 8}}));
+    }
+    SECTION("join without key") {
+        std::vector<Tag> tags{{"red", 1}, {"green", 2}, {"blue", 1}};
+        auto tagged = storage.select(columns(&Item::name, &Tag::name),
+                                     join<Tag>(on(c(&Tag::itemId) == &Item::id)),
+                                     where(range_source(tags.data(), tags.size())),
+                                     order_by(&Tag::name));
+        REQUIRE(tagged == std::vector<std::tuple<std::string, std::string>>{{"item1", "blue"},
+                                                                            {"item2", "green"},
+                                                                            {"item1", "red"}});
+    }
+    SECTION("prepared statement") {
+        std::vector<Weight> few{{1, 1.5}};
+        auto statement =
+            storage.prepare(select(&Item::name,
+                                   join<Weight>(on(c(&Weight::itemId) == &Item::id)),
+                                   where(range_source(few))));
+        REQUIRE(storage.execute(statement) == std::vector<std::string>{"item1"});
+        REQUIRE(statement.sql() ==
+                R"(SELECT "items"."name" FROM "items" JOIN "weights" ON "weights"."item_id" = "items"."id"  WHERE ("weights"."sqlite_orm_source" = ?))");
+    }
+    SECTION("a range table can't be queried without a range") {
+        REQUIRE_THROWS_AS(storage.select(&Weight::weight), std::system_error);
+    }
+}
+#endif
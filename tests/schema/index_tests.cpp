@@ -126,3 +126,148 @@ TEST_CASE("Compound index") {
     REQUIRE_NOTHROW(storage.sync_schema());
     REQUIRE_NOTHROW(storage.insert(User{1, "juan"}));
 }
+
+TEST_CASE("sync_schema index changes") {
+    struct User {
+        int id = 0;
+        std::string name;
+    };
+    const char* storagePath = "sync_schema_index_changes.sqlite";
+    ::remove(storagePath);
+    auto makeTable = [] {
+        return make_table("users", make_column("id", &User::id, primary_key()), make_column("name", &User::name));
+    };
+    auto indexSql = [storagePath] {
+        auto schemaStorage = make_storage(storagePath, make_sqlite_schema_table());
+        return schemaStorage.select(&sqlite_master::sql, where(c(&sqlite_master::name) == "users_name"));
+    };
+    {
+        auto storage = make_storage(storagePath,
+                                    make_index("users_name", &User::name, where(c(&User::id) > 10)),
+                                    makeTable());
+        REQUIRE(storage.sync_schema().at("users_name") == sync_schema_result::already_in_sync);
+        REQUIRE(storage.sync_schema_simulate().at("users_name") == sync_schema_result::already_in_sync);
+        storage.insert(User{0, "a"});
+        storage.insert(User{0, "a"});
+    }
+    SECTION("collation and order") {
+        auto storage = make_storage(storagePath,
+                                    make_index("users_name", indexed_column(&User::name).collate("nocase").desc()),
+                                    makeTable());
+        REQUIRE(storage.sync_schema_simulate().at("users_name") == sync_schema_result::dropped_and_recreated);
+        REQUIRE(storage.sync_schema().at("users_name") == sync_schema_result::dropped_and_recreated);
+        REQUIRE(indexSql() ==
+                std::vector<std::string>{R"(CREATE INDEX "users_name" ON "users" ("name" COLLATE nocase DESC))"});
+        REQUIRE(storage.sync_schema().at("users_name") == sync_schema_result::already_in_sync);
+
+        //  the table has been analyzed after the rebuild
+        auto statStorage = make_storage(storagePath, make_sqlite_schema_table());
+        REQUIRE(statStorage.table_exists("sqlite_stat1"));
+    }
+    SECTION("structure is compared rather than SQL text") {
+        {
+            sqlite3* db = nullptr;
+            REQUIRE(sqlite3_open(storagePath, &db) == SQLITE_OK);
+            REQUIRE(sqlite3_exec(db, "DROP INDEX users_name", nullptr, nullptr, nullptr) == SQLITE_OK);
+            REQUIRE(sqlite3_exec(db,
+                                 "create index users_name on users(NAME collate binary asc) where id>10",
+                                 nullptr,
+                                 nullptr,
+                                 nullptr) == SQLITE_OK);
+            sqlite3_close(db);
+        }
+        auto storage = make_storage(storagePath,
+                                    make_index("users_name", &User::name, where(c(&User::id) > 10)),
+                                    makeTable());
+        REQUIRE(storage.sync_schema_simulate().at("users_name") == sync_schema_result::already_in_sync);
+
+        auto changedCondition = make_storage(storagePath,
+                                             make_index("users_name", &User::name, where(c(&User::id) > 11)),
+                                             makeTable());
+        REQUIRE(changedCondition.sync_schema_simulate().at("users_name") ==
+                sync_schema_result::dropped_and_recreated);
+        auto fullIndex = make_storage(storagePath, make_index("users_name", &User::name), makeTable());
+        REQUIRE(fullIndex.sync_schema_simulate().at("users_name") == sync_schema_result::dropped_and_recreated);
+    }
+    SECTION("indexed expressions") {
+        {
+            sqlite3* db = nullptr;
+            REQUIRE(sqlite3_open(storagePath, &db) == SQLITE_OK);
+            REQUIRE(sqlite3_exec(db, "DROP INDEX users_name", nullptr, nullptr, nullptr) == SQLITE_OK);
+            REQUIRE(sqlite3_exec(db,
+                                 "create index users_name on users(lower( name ) desc, [id])",
+                                 nullptr,
+                                 nullptr,
+                                 nullptr) == SQLITE_OK);
+            sqlite3_close(db);
+        }
+        auto storage = make_storage(
+            storagePath,
+            make_index<User>("users_name", indexed_column(lower(&User::name)).desc(), indexed_column(&User::id)),
+            makeTable());
+        REQUIRE(storage.sync_schema_simulate().at("users_name") == sync_schema_result::already_in_sync);
+
+        auto changedExpression = make_storage(
+            storagePath,
+            make_index<User>("users_name", indexed_column(upper(&User::name)).desc(), indexed_column(&User::id)),
+            makeTable());
+        REQUIRE(changedExpression.sync_schema_simulate().at("users_name") ==
+                sync_schema_result::dropped_and_recreated);
+        REQUIRE(changedExpression.sync_schema().at("users_name") == sync_schema_result::dropped_and_recreated);
+        REQUIRE(changedExpression.sync_schema_simulate().at("users_name") == sync_schema_result::already_in_sync);
+    }
+    SECTION("uniqueness fails the whole rebuild") {
+        auto storage = make_storage(storagePath,
+                                    make_index("users_id", &User::id),
+                                    make_unique_index("users_name", &User::name),
+                                    makeTable());
+        REQUIRE_THROWS_AS(storage.sync_schema(), std::system_error);
+        REQUIRE(indexSql() ==
+                std::vector<std::string>{R"(CREATE INDEX "users_name" ON "users" ("name") WHERE ("id" > 10))"});
+        REQUIRE(storage.table_exists("users"));
+    }
+}
+
+TEST_CASE("sync_schema index changes in an attached database") {
+    struct User {
+        int id = 0;
+        std::string name;
+    };
+    struct ArchivedUser {
+        int id = 0;
+        std::string name;
+    };
+    const char* storagePath = "index_changes_main.sqlite";
+    const char* archivePath = "index_changes_archive.sqlite";
+    ::remove(storagePath);
+    ::remove(archivePath);
+    auto makeUsersTable = [] {
+        return make_table("users", make_column("id", &User::id, primary_key()), make_column("name", &User::name));
+    };
+    auto makeArchivedUsersTable = [] {
+        return make_table("users",
+                          make_column("id", &ArchivedUser::id, primary_key()),
+                          make_column("name", &ArchivedUser::name))
+            .in_schema("archive");
+    };
+    {
+        auto storage = make_storage(storagePath,
+                                    make_index("users_name", &ArchivedUser::name),
+                                    makeUsersTable(),
+                                    makeArchivedUsersTable());
+        storage.attach(archivePath, "archive");
+        storage.sync_schema();
+    }
+    auto storage = make_storage(storagePath,
+                                make_index("users_name", indexed_column(&ArchivedUser::name).desc()),
+                                makeUsersTable(),
+                                makeArchivedUsersTable());
+    storage.attach(archivePath, "archive");
+    REQUIRE(storage.sync_schema().at("users_name") == sync_schema_result::dropped_and_recreated);
+
+    //  the archived table has been analyzed rather than the main one with the same name
+    auto mainSchema = make_storage(storagePath, make_sqlite_schema_table());
+    auto archiveSchema = make_storage(archivePath, make_sqlite_schema_table());
+    REQUIRE_FALSE(mainSchema.table_exists("sqlite_stat1"));
+    REQUIRE(archiveSchema.table_exists("sqlite_stat1"));
+}
@@ -0,0 +1,86 @@
+#include <sqlite_orm/sqlite_orm.h>
+#include <catch2/catch_all.hpp>
+
+using namespace sqlite_orm;
+
+TEST_CASE("sharded storage") {
+    std::vector<std::string> filenames{"shard_0.sqlite", "shard_1.sqlite", "shard_2.sqlite"};
+    for(auto& filename: filenames) {
+        ::remove(filename.c_str());
+    }
+    struct Event {
+        int id = 0;
+        std::string name;
+        int score = 0;
+    };
+    auto makeStorage = [](const std::string& filename) {
+        return make_storage(filename,
+                            make_table("events",
+                                       make_column("id", &Event::id, primary_key()),
+                                       make_column("name", &Event::name),
+                                       make_column("score", &Event::score)));
+    };
+    auto storage = make_sharded_storage(filenames, makeStorage, [](const Event& event) {
+        return event.id;
+    });
+    REQUIRE(storage.shards_count() == 3);
+    REQUIRE(storage.sync_schema().at("events") == sync_schema_result::new_table_created);
+
+    for(int id = 1; id <= 9; ++id) {
+        storage.replace(Event{id, "event" + std::to_string(id), (id * 7) % 10});
+    }
+    for(size_t i = 0; i < storage.shards_count(); ++i) {
+        REQUIRE(storage.shard(i).count<Event>() == 3);
+        for(auto& event: storage.shard(i).get_all<Event>()) {
+            REQUIRE(storage.shard_index(event.id) == i);
+        }
+    }
+
+    REQUIRE(storage.get<Event>(4).name == "event4");
+    REQUIRE_FALSE(storage.get_pointer<Event>(10));
+    storage.update(Event{4, "renamed", 8});
+    REQUIRE(storage.get<Event>(4).name == "renamed");
+    storage.remove<Event>(9);
+    REQUIRE_FALSE(storage.get_pointer<Event>(9));
+
+    REQUIRE(storage.count<Event>() == 8);
+    REQUIRE(storage.count<Event>(where(c(&Event::score) > 5)) == 4);
+    REQUIRE(storage.get_all<Event>().size() == 8);
+
+    SECTION("merged") {
+        auto events = storage.get_all_merged<Event>(
+            [](const Event& lhs, const Event& rhs) {
+                return lhs.score < rhs.score;
+            },
+            order_by(&Event::score));
+        std::vector<int> scores;
+        for(auto& event: events) {
+            scores.push_back(event.score);
+        }
+        REQUIRE(scores == std::vector<int>{1, 2, 4, 5, 6, 7, 8, 9});
+
+        auto names = storage.select_merged(std::greater<std::string>{},
+                                           &Event::name,
+                                           where(c(&Event::id) < 4),
+                                           order_by(&Event::name).desc());
+        REQUIRE(names == std::vector<std::string>{"event3", "event2", "event1"});
+    }
+    SECTION("shard_index doesn't depend on the platform") {
+        REQUIRE(storage.shard_index(7) == 1);
+        REQUIRE(storage.shard_index(int64{-1}) == 0);
+        //  64-bit FNV-1a of "user42" is 17867622135862781120
+        REQUIRE(storage.shard_index(std::string{"user42"}) == 2);
+    }
+    SECTION("insert keeps the key") {
+        REQUIRE(storage.insert(Event{20, "twenty", 3}) == 20);
+        REQUIRE(storage.shard(storage.shard_index(20)).count<Event>(where(c(&Event::id) == 20)) == 1);
+        REQUIRE(storage.get<Event>(20).name == "twenty");
+        REQUIRE_THROWS_AS(storage.insert(Event{20, "again", 4}), std::system_error);
+        REQUIRE(storage.count<Event>() == 9);
+    }
+    SECTION("remove_all") {
+        storage.remove_all<Event>(where(c(&Event::score) < 5));
+        REQUIRE(storage.select(&Event::id, where(c(&Event::score) < 5)).empty());
+        REQUIRE(storage.count<Event>() == 5);
+    }
+}
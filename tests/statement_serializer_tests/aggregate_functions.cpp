@@ -86,6 +86,11 @@ TEST_CASE("statement_serializer aggregate functions") {
                 value = serialize(expression, context);
                 expected = R"(COUNT(*) FILTER (WHERE "id" < 10))";
             }
+            SECTION("without type with filter") {
+                auto expression = count().filter(where(less_than(&User::id, 10)));
+                value = serialize(expression, context);
+                expected = R"(COUNT(*) FILTER (WHERE "id" < 10))";
+            }
 #ifdef SQLITE_ORM_WITH_CPP20_ALIASES
             SECTION("with table reference") {
                 constexpr auto user = c<User>();
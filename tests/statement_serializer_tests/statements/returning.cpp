@@ -0,0 +1,47 @@
+#include <sqlite_orm/sqlite_orm.h>
+#include <catch2/catch_all.hpp>
+
+#if SQLITE_VERSION_NUMBER >= 3035000
+using namespace sqlite_orm;
+
+TEST_CASE("statement_serializer returning") {
+    using internal::serialize;
+    struct User {
+        int id = 0;
+        std::string name;
+    };
+    auto table = make_table("users", make_column("id", &User::id, primary_key()), make_column("name", &User::name));
+    using db_objects_t = internal::db_objects_tuple<decltype(table)>;
+    db_objects_t dbObjects{table};
+    using context_t = internal::serializer_context<db_objects_t>;
+    context_t context{dbObjects};
+
+    std::string value;
+    std::string expected;
+
+    SECTION("insert") {
+        User user{0, "Juan"};
+        auto statement = returning(insert(user), &User::id);
+        value = serialize(statement, context);
+        expected = R"(INSERT INTO "users" ("name") VALUES ('Juan') RETURNING "id")";
+    }
+    SECTION("replace") {
+        User user{1, "Juan"};
+        auto statement = returning(replace(user), columns(&User::id, &User::name));
+        value = serialize(statement, context);
+        expected = R"(REPLACE INTO "users" ("id", "name") VALUES (1, 'Juan') RETURNING "id", "name")";
+    }
+    SECTION("update_all") {
+        auto statement = returning(update_all(set(c(&User::name) = "Pedro"), where(c(&User::id) < 10)),
+                                   columns(&User::id, length(&User::name)));
+        value = serialize(statement, context);
+        expected = R"(UPDATE "users" SET "name" = 'Pedro' WHERE ("id" < 10) RETURNING "id", LENGTH("name"))";
+    }
+    SECTION("remove_all") {
+        auto statement = returning(remove_all<User>(where(c(&User::id) == 1)), object<User>());
+        value = serialize(statement, context);
+        expected = R"(DELETE FROM "users" WHERE ("id" = 1) RETURNING *)";
+    }
+    REQUIRE(value == expected);
+}
+#endif
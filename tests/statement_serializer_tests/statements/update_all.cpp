@@ -27,6 +27,11 @@ TEST_CASE("statement_serializer update_all") {
         std::string email;
         int supportRepId = 0;
     };
+
+    struct Company {
+        std::string name;
+        std::string phone;
+    };
     auto contactsTable = make_table("contacts",
                                     make_column("contact_id", &Contact::id, primary_key()),
                                     make_column("first_name", &Contact::firstName),
@@ -46,15 +51,39 @@ TEST_CASE("statement_serializer update_all") {
                                      make_column("Fax", &Customer::fax),
                                      make_column("Email", &Customer::email),
                                      make_column("SupportRepId", &Customer::supportRepId));
-    using db_objects_t = internal::db_objects_tuple<decltype(contactsTable), decltype(customersTable)>;
-    auto dbObjects = db_objects_t{contactsTable, customersTable};
+    auto companiesTable =
+        make_table("companies", make_column("name", &Company::name), make_column("phone", &Company::phone));
+    using db_objects_t =
+        internal::db_objects_tuple<decltype(contactsTable), decltype(customersTable), decltype(companiesTable)>;
+    auto dbObjects = db_objects_t{contactsTable, customersTable, companiesTable};
     using context_t = internal::serializer_context<db_objects_t>;
     context_t context{dbObjects};
 
-    auto statement =
-        update_all(set(c(&Contact::phone) = select(&Customer::phone, from<Customer>(), where(c(&Customer::id) == 1))));
-    auto value = serialize(statement, context);
-    decltype(value) expected =
-        R"(UPDATE "contacts" SET "phone" = (SELECT "customers"."Phone" FROM "customers" WHERE ("customers"."CustomerId" = 1)))";
-    REQUIRE(value == expected);
+    SECTION("subquery") {
+        auto statement = update_all(
+            set(c(&Contact::phone) = select(&Customer::phone, from<Customer>(), where(c(&Customer::id) == 1))));
+        auto value = serialize(statement, context);
+        decltype(value) expected =
+            R"(UPDATE "contacts" SET "phone" = (SELECT "customers"."Phone" FROM "customers" WHERE ("customers"."CustomerId" = 1)))";
+        REQUIRE(value == expected);
+    }
+    SECTION("from") {
+        auto statement = update_all(set(c(&Customer::phone) = &Contact::phone),
+                                    from<Contact>(),
+                                    where(c(&Contact::lastName) == &Customer::lastName));
+        auto value = serialize(statement, context);
+        decltype(value) expected =
+            R"(UPDATE "customers" SET "Phone" = "contacts"."phone" FROM "contacts" WHERE ("contacts"."last_name" = "customers"."LastName"))";
+        REQUIRE(value == expected);
+    }
+    SECTION("from with join") {
+        auto statement = update_all(set(c(&Contact::phone) = &Company::phone),
+                                    from<Customer>(),
+                                    inner_join<Company>(on(c(&Company::name) == &Customer::company)),
+                                    where(c(&Customer::id) == &Contact::id));
+        auto value = serialize(statement, context);
+        decltype(value) expected =
+            R"(UPDATE "contacts" SET "phone" = "companies"."phone" FROM "customers" INNER JOIN "companies" ON "companies"."name" = "customers"."Company"  WHERE ("customers"."CustomerId" = "contacts"."contact_id"))";
+        REQUIRE(value == expected);
+    }
 }
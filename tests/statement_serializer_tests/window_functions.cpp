@@ -0,0 +1,149 @@
+#include <sqlite_orm/sqlite_orm.h>
+#include <catch2/catch_all.hpp>
+
+using namespace sqlite_orm;
+
+TEST_CASE("statement_serializer window functions") {
+    using internal::serialize;
+    struct Employee {
+        int id = 0;
+        std::string department;
+        double salary = 0;
+    };
+    auto table = make_table("employees",
+                            make_column("id", &Employee::id, primary_key()),
+                            make_column("department", &Employee::department),
+                            make_column("salary", &Employee::salary));
+    using db_objects_t = internal::db_objects_tuple<decltype(table)>;
+    auto dbObjects = db_objects_t{table};
+    using context_t = internal::serializer_context<db_objects_t>;
+    context_t context{dbObjects};
+    context.skip_table_name = false;
+
+    std::string value;
+    decltype(value) expected;
+
+    SECTION("row_number") {
+        auto expression = row_number().over();
+        value = serialize(expression, context);
+        expected = R"(ROW_NUMBER() OVER ())";
+    }
+    SECTION("rank") {
+        auto expression = rank().over(partition_by(&Employee::department), order_by(&Employee::salary).desc());
+        value = serialize(expression, context);
+        expected = R"(RANK() OVER (PARTITION BY "employees"."department" ORDER BY "employees"."salary" DESC))";
+    }
+    SECTION("fts5 rank") {
+        value = serialize(rank(), context);
+        expected = "rank";
+    }
+    SECTION("dense_rank") {
+        auto expression = dense_rank().over(order_by(&Employee::salary));
+        value = serialize(expression, context);
+        expected = R"(DENSE_RANK() OVER (ORDER BY "employees"."salary"))";
+    }
+    SECTION("ntile") {
+        auto expression = ntile(4).over(order_by(&Employee::salary));
+        value = serialize(expression, context);
+        expected = R"(NTILE(4) OVER (ORDER BY "employees"."salary"))";
+    }
+    SECTION("lag") {
+        auto expression = lag(&Employee::salary, 2, 0).over(order_by(&Employee::id));
+        value = serialize(expression, context);
+        expected = R"(LAG("employees"."salary", 2, 0) OVER (ORDER BY "employees"."id"))";
+    }
+    SECTION("lead") {
+        auto expression = lead(&Employee::salary).over(order_by(&Employee::id));
+        value = serialize(expression, context);
+        expected = R"(LEAD("employees"."salary") OVER (ORDER BY "employees"."id"))";
+    }
+    SECTION("nth_value") {
+        auto expression = nth_value(&Employee::salary, 2)
+                              .over(partition_by(&Employee::department),
+                                    order_by(&Employee::salary),
+                                    rows(unbounded_preceding(), unbounded_following()));
+        value = serialize(expression, context);
+        expected =
+            R"(NTH_VALUE("employees"."salary", 2) OVER (PARTITION BY "employees"."department" ORDER BY "employees"."salary" ROWS BETWEEN UNBOUNDED PRECEDING AND UNBOUNDED FOLLOWING))";
+    }
+    SECTION("aggregate") {
+        auto expression = sum(&Employee::salary).over(order_by(&Employee::id), rows(unbounded_preceding()));
+        value = serialize(expression, context);
+        expected =
+            R"(SUM("employees"."salary") OVER (ORDER BY "employees"."id" ROWS BETWEEN UNBOUNDED PRECEDING AND CURRENT ROW))";
+    }
+    SECTION("filter") {
+        auto expression =
+            count(&Employee::id).filter(where(c(&Employee::salary) > 100)).over(partition_by(&Employee::department));
+        value = serialize(expression, context);
+        expected =
+            R"(COUNT("employees"."id") FILTER (WHERE "employees"."salary" > 100) OVER (PARTITION BY "employees"."department"))";
+    }
+    SECTION("count(*)") {
+        auto expression = count<Employee>().over(partition_by(&Employee::department));
+        value = serialize(expression, context);
+        expected = R"(COUNT(*) OVER (PARTITION BY "employees"."department"))";
+    }
+    SECTION("frames") {
+        SECTION("range") {
+            auto expression =
+                avg(&Employee::salary).over(order_by(&Employee::salary), range(preceding(100), following(100)));
+            value = serialize(expression, context);
+            expected =
+                R"(AVG("employees"."salary") OVER (ORDER BY "employees"."salary" RANGE BETWEEN 100 PRECEDING AND 100 FOLLOWING))";
+        }
+        SECTION("groups") {
+            auto expression =
+                first_value(&Employee::id).over(order_by(&Employee::salary), groups(current_row(), following(1)));
+            value = serialize(expression, context);
+            expected =
+                R"(FIRST_VALUE("employees"."id") OVER (ORDER BY "employees"."salary" GROUPS BETWEEN CURRENT ROW AND 1 FOLLOWING))";
+        }
+    }
+    SECTION("named window") {
+        auto byDepartment = window("d", partition_by(&Employee::department), order_by(&Employee::salary));
+        SECTION("over") {
+            auto expression = last_value(&Employee::salary).over(byDepartment);
+            value = serialize(expression, context);
+            expected = R"(LAST_VALUE("employees"."salary") OVER "d")";
+        }
+        SECTION("clause") {
+            value = serialize(byDepartment, context);
+            expected = R"(WINDOW "d" AS (PARTITION BY "employees"."department" ORDER BY "employees"."salary"))";
+        }
+        SECTION("select") {
+            auto expression =
+                select(columns(&Employee::id, percent_rank().over(byDepartment), cume_dist().over(byDepartment)),
+                       where(c(&Employee::salary) > 0),
+                       byDepartment,
+                       order_by(&Employee::id));
+            expression.highest_level = true;
+            value = serialize(expression, context);
+            expected =
+                R"(SELECT "employees"."id", PERCENT_RANK() OVER "d", CUME_DIST() OVER "d" FROM "employees" WHERE ("employees"."salary" > 0) WINDOW "d" AS (PARTITION BY "employees"."department" ORDER BY "employees"."salary") ORDER BY "employees"."id")";
+        }
+        SECTION("select with the window after order by and limit") {
+            auto expression = select(columns(&Employee::id, percent_rank().over(byDepartment)),
+                                     order_by(&Employee::id),
+                                     limit(5),
+                                     byDepartment,
+                                     group_by(&Employee::id).having(count(&Employee::department) > 0));
+            expression.highest_level = true;
+            value = serialize(expression, context);
+            expected =
+                R"(SELECT "employees"."id", PERCENT_RANK() OVER "d" FROM "employees" GROUP BY "employees"."id" HAVING COUNT("employees"."department") > 0 WINDOW "d" AS (PARTITION BY "employees"."department" ORDER BY "employees"."salary") ORDER BY "employees"."id" LIMIT 5)";
+        }
+        SECTION("select with two windows") {
+            auto bySalary = window("s", order_by(&Employee::salary));
+            auto expression = select(columns(percent_rank().over(byDepartment), rank().over(bySalary)),
+                                     byDepartment,
+                                     order_by(&Employee::id),
+                                     bySalary);
+            expression.highest_level = true;
+            value = serialize(expression, context);
+            expected =
+                R"(SELECT PERCENT_RANK() OVER "d", RANK() OVER "s" FROM "employees" WINDOW "d" AS (PARTITION BY "employees"."department" ORDER BY "employees"."salary"), "s" AS (ORDER BY "employees"."salary") ORDER BY "employees"."id")";
+        }
+    }
+    REQUIRE(value == expected);
+}
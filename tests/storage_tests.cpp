@@ -203,6 +203,310 @@ TEST_CASE("Storage copy") {
     storageCopy.remove_all<User>();
 }
 
+#if SQLITE_VERSION_NUMBER >= 3027000
+TEST_CASE("vacuum_into") {
+    struct User {
+        int id = 0;
+        std::string name;
+    };
+    auto makeStorage = [](const std::string& filename) {
+        return make_storage(
+            filename,
+            make_table("users", make_column("id", &User::id, primary_key()), make_column("name", &User::name)));
+    };
+    const char* snapshotPath = "vacuum_into.sqlite";
+    ::remove(snapshotPath);
+    auto storage = makeStorage("");
+    storage.sync_schema();
+    storage.replace(User{1, "Anne"});
+    storage.replace(User{2, "Bob"});
+    storage.vacuum_into(snapshotPath);
+    auto snapshot = makeStorage(snapshotPath);
+    REQUIRE(snapshot.count<User>() == 2);
+    REQUIRE(snapshot.get<User>(2).name == "Bob");
+    REQUIRE_THROWS_AS(storage.vacuum_into(snapshotPath), std::system_error);
+}
+#endif
+
+#if SQLITE_VERSION_NUMBER >= 3036000 && !defined(SQLITE_OMIT_DESERIALIZE)
+TEST_CASE("serialize") {
+    struct User {
+        int id = 0;
+        std::string name;
+    };
+    auto makeStorage = [](const std::string& filename) {
+        return make_storage(
+            filename,
+            make_table("users", make_column("id", &User::id, primary_key()), make_column("name", &User::name)));
+    };
+    const char* path = "serialize.sqlite";
+    ::remove(path);
+    std::vector<char> data;
+    auto serialize = [&data](auto& source) {
+        source.sync_schema();
+        source.replace(User{1, "Anne"});
+        source.replace(User{2, "Bob"});
+        data = source.serialize();
+    };
+    SECTION("file") {
+        auto source = makeStorage(path);
+        serialize(source);
+    }
+    SECTION("in memory") {
+        auto source = makeStorage("");
+        serialize(source);
+    }
+    REQUIRE(data.size() > 0);
+    REQUIRE(data.size() % 512 == 0);
+    REQUIRE(std::string(data.data(), 15) == "SQLite format 3");
+
+    auto worker = makeStorage("");
+    worker.deserialize(data);
+    worker.replace(User{3, "Carl"});
+    REQUIRE(worker.count<User>() == 3);
+
+    auto readonlyWorker = makeStorage("");
+    readonlyWorker.deserialize(data, true);
+    REQUIRE(readonlyWorker.get<User>(1).name == "Anne");
+    REQUIRE_THROWS_AS(readonlyWorker.replace(User{3, "Carl"}), std::system_error);
+}
+#endif
+
+TEST_CASE("clone_in_memory") {
+    struct User {
+        int id = 0;
+        std::string name;
+    };
+    auto makeStorage = [](const std::string& filename) {
+        return make_storage(
+            filename,
+            make_table("users", make_column("id", &User::id, primary_key()), make_column("name", &User::name)));
+    };
+    using Storage = decltype(makeStorage(""));
+    const char* path = "clone_in_memory.sqlite";
+    ::remove(path);
+    auto fixture = [](Storage& storage) {
+        storage.sync_schema();
+        storage.replace(User{1, "Anne"});
+        storage.replace(User{2, "Bob"});
+    };
+    auto check = [](Storage& templateStorage) {
+        auto clone = templateStorage.clone_in_memory();
+        auto other = templateStorage.clone_in_memory();
+        REQUIRE(clone.filename() == ":memory:");
+        REQUIRE(clone.get_all<User>().size() == 2);
+        clone.remove<User>(1);
+        clone.replace(User{3, "Carl"});
+        REQUIRE(clone.get_all<User>().size() == 2);
+        REQUIRE(other.get_all<User>().size() == 2);
+        REQUIRE(other.get_pointer<User>(1));
+        REQUIRE_FALSE(templateStorage.get_pointer<User>(3));
+    };
+    SECTION("in memory") {
+        auto templateStorage = makeStorage("");
+        fixture(templateStorage);
+        check(templateStorage);
+    }
+    SECTION("file") {
+        auto templateStorage = makeStorage(path);
+        fixture(templateStorage);
+        check(templateStorage);
+    }
+#if SQLITE_VERSION_NUMBER >= 3036000 && !defined(SQLITE_OMIT_DESERIALIZE)
+    SECTION("deserialized") {
+        auto source = makeStorage("");
+        fixture(source);
+        auto templateStorage = makeStorage("");
+        templateStorage.deserialize(source.serialize());
+        check(templateStorage);
+    }
+#endif
+}
+
+TEST_CASE("clone_in_memory leaves attached databases out") {
+    struct User {
+        int id = 0;
+        std::string name;
+    };
+    struct ArchivedUser {
+        int id = 0;
+        std::string name;
+    };
+    const char* archivePath = "clone_in_memory_archive.sqlite";
+    ::remove(archivePath);
+    auto templateStorage = make_storage(
+        "",
+        make_table("users", make_column("id", &User::id, primary_key()), make_column("name", &User::name)),
+        make_table("users",
+                   make_column("id", &ArchivedUser::id, primary_key()),
+                   make_column("name", &ArchivedUser::name))
+            .in_schema("archive"));
+    templateStorage.attach(archivePath, "archive");
+    templateStorage.sync_schema();
+    templateStorage.replace(ArchivedUser{1, "Anne"});
+
+    auto clone = templateStorage.clone_in_memory();
+    REQUIRE_THROWS_AS(clone.replace(ArchivedUser{2, "Bob"}), std::system_error);
+    REQUIRE(templateStorage.count<ArchivedUser>() == 1);
+}
+
+TEST_CASE("attach") {
+    struct User {
+        int id = 0;
+        std::string name;
+    };
+    struct Order {
+        int id = 0;
+        int userId = 0;
+        std::string product;
+    };
+    const char* path = "attach_main.sqlite";
+    const char* archivePath = "attach_archive.sqlite";
+    ::remove(path);
+    ::remove(archivePath);
+    auto storage = make_storage(
+        path,
+        make_index("idx_orders_user", &Order::userId),
+        make_table("users", make_column("id", &User::id, primary_key()), make_column("name", &User::name)),
+        make_table("orders",
+                   make_column("id", &Order::id, primary_key()),
+                   make_column("user_id", &Order::userId),
+                   make_column("product", &Order::product))
+            .in_schema("archive"));
+    storage.attach(archivePath, "archive");
+    auto syncResult = storage.sync_schema();
+    REQUIRE(syncResult.at("orders") == sync_schema_result::new_table_created);
+    REQUIRE_FALSE(storage.table_exists("orders"));
+    {
+        auto archive = make_storage(archivePath, make_sqlite_schema_table());
+        REQUIRE(archive.select(&sqlite_master::name, order_by(&sqlite_master::name)) ==
+                std::vector<std::string>{"idx_orders_user", "orders"});
+    }
+    storage.replace(User{1, "Anne"});
+    storage.replace(User{2, "Bob"});
+    storage.replace(Order{1, 1, "Book"});
+    storage.insert(Order{0, 2, "Pen"});
+    storage.insert(Order{0, 1, "Lamp"});
+
+    REQUIRE(storage.get<Order>(1).product == "Book");
+    REQUIRE(storage.count<Order>() == 3);
+    storage.update(Order{1, 1, "Novel"});
+    storage.update_all(set(c(&Order::product) = "Pencil"), where(c(&Order::product) == "Pen"));
+    storage.remove<Order>(3);
+    REQUIRE(storage.get_all<Order>(where(c(&Order::userId) == 2)).at(0).product == "Pencil");
+
+    auto rows = storage.select(columns(&User::name, &Order::product),
+                               inner_join<Order>(on(c(&Order::userId) == &User::id)),
+                               order_by(&Order::id));
+    REQUIRE(rows == std::vector<std::tuple<std::string, std::string>>{{"Anne", "Novel"}, {"Bob", "Pencil"}});
+    auto statement = storage.prepare(select(&Order::product, from<Order>()));
+    REQUIRE(statement.sql() == R"(SELECT "orders"."product" FROM "archive"."orders")");
+
+    syncResult = storage.sync_schema();
+    REQUIRE(syncResult.at("orders") == sync_schema_result::already_in_sync);
+    REQUIRE(syncResult.at("idx_orders_user") == sync_schema_result::already_in_sync);
+
+    storage.detach("archive");
+    REQUIRE_THROWS(storage.count<Order>());
+    storage.attach(archivePath, "archive");
+    REQUIRE(storage.count<Order>() == 2);
+}
+
+TEST_CASE("sync_schema of an attached table named like a main table") {
+    struct Order {
+        int id = 0;
+        std::string product;
+    };
+    struct ArchivedOrder {
+        int id = 0;
+        std::string product;
+        int year = 0;
+    };
+    const char* path = "attach_same_name_main.sqlite";
+    const char* archivePath = "attach_same_name_archive.sqlite";
+    ::remove(path);
+    ::remove(archivePath);
+    auto makeStorage = [path](auto yearColumn) {
+        return make_storage(
+            path,
+            make_table("orders", make_column("id", &Order::id, primary_key()), make_column("product", &Order::product)),
+            make_table("orders",
+                       make_column("id", &ArchivedOrder::id, primary_key()),
+                       make_column("product", &ArchivedOrder::product),
+                       std::move(yearColumn))
+                .in_schema("archive"));
+    };
+    {
+        auto storage = makeStorage(make_column("year", &ArchivedOrder::year));
+        storage.attach(archivePath, "archive");
+        storage.sync_schema();
+        storage.replace(Order{1, "Book"});
+        storage.replace(Order{2, "Pen"});
+        storage.replace(ArchivedOrder{1, "Lamp", 2020});
+    }
+    auto storage = makeStorage(make_column("year", &ArchivedOrder::year, default_value(2000)));
+    storage.attach(archivePath, "archive");
+    SECTION("copy") {
+        storage.sync_schema(true);
+    }
+    SECTION("online copy") {
+        online_migration_options options;
+        options.chunk_size = 1;
+        storage.sync_schema_online(options);
+    }
+    REQUIRE(storage.get_all<Order>(order_by(&Order::id)).size() == 2);
+    REQUIRE(storage.get<Order>(2).product == "Pen");
+    REQUIRE(storage.get<ArchivedOrder>(1).year == 2020);
+    storage.insert(into<ArchivedOrder>(),
+                   columns(&ArchivedOrder::id, &ArchivedOrder::product),
+                   values(std::make_tuple(2, "Cup")));
+    REQUIRE(storage.get<ArchivedOrder>(2).year == 2000);
+    {
+        auto archive = make_storage(archivePath, make_sqlite_schema_table());
+        REQUIRE(archive.select(&sqlite_master::name, where(c(&sqlite_master::type) != "index")) ==
+                std::vector<std::string>{"orders"});
+    }
+    REQUIRE(storage.sync_schema_simulate(true).at("orders") == sync_schema_result::already_in_sync);
+}
+
+TEST_CASE("queries of an attached table named like a main table") {
+    struct Employee {
+        int id = 0;
+        std::string department;
+    };
+    struct ArchivedEmployee {
+        int id = 0;
+        std::string department;
+    };
+    auto storage = make_storage("",
+                                make_table("employees",
+                                           make_column("id", &Employee::id, primary_key()),
+                                           make_column("department", &Employee::department)),
+                                make_table("employees",
+                                           make_column("id", &ArchivedEmployee::id, primary_key()),
+                                           make_column("department", &ArchivedEmployee::department))
+                                    .in_schema("archive"));
+    storage.attach(":memory:", "archive");
+    storage.sync_schema();
+    storage.replace(Employee{1, "sales"});
+    storage.replace(ArchivedEmployee{7, "support"});
+    storage.replace(ArchivedEmployee{8, "support"});
+
+    REQUIRE(storage.dump(select(&ArchivedEmployee::id)) ==
+            R"(SELECT "employees"."id" FROM "archive"."employees")");
+    REQUIRE(storage.select(&ArchivedEmployee::id) == std::vector<int>{7, 8});
+    REQUIRE(storage.select(&Employee::id) == std::vector<int>{1});
+    REQUIRE(storage.count<ArchivedEmployee>() == 2);
+    REQUIRE(storage.count<Employee>() == 1);
+
+    storage.update_all(set(c(&ArchivedEmployee::department) = "sales"));
+    REQUIRE(storage.count<ArchivedEmployee>(where(c(&ArchivedEmployee::department) == "sales")) == 2);
+    REQUIRE(storage.get<Employee>(1).department == "sales");
+    storage.update_all(set(c(&Employee::department) = "marketing"));
+    REQUIRE(storage.get<Employee>(1).department == "marketing");
+    REQUIRE(storage.get<ArchivedEmployee>(7).department == "sales");
+}
+
 #if SQLITE_VERSION_NUMBER >= 3006019
 TEST_CASE("column_name") {
     struct User {
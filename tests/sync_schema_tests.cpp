@@ -553,3 +553,156 @@ TEST_CASE("sync_schema with generated columns") {
     }
 }
 #endif
+
+TEST_CASE("sync_schema_online") {
+    struct ItemBefore {
+        int id = 0;
+        std::string name;
+        int price = 0;
+    };
+    struct Item {
+        int id = 0;
+        std::string name;
+        int price = 0;
+    };
+    const char* storagePath = "sync_schema_online.sqlite";
+    ::remove(storagePath);
+    {
+        auto storage = make_storage(storagePath,
+                                    make_table("items",
+                                               make_column("id", &ItemBefore::id, primary_key()),
+                                               make_column("name", &ItemBefore::name),
+                                               make_column("price", &ItemBefore::price)));
+        storage.sync_schema();
+        std::vector<ItemBefore> items;
+        for(int i = 1; i <= 2500; ++i) {
+            items.push_back(ItemBefore{i, "item" + std::to_string(i), i});
+        }
+        storage.transaction([&storage, &items] {
+            storage.insert_range(items.begin(), items.end());
+            return true;
+        });
+    }
+    auto makeStorage = [storagePath] {
+        return make_storage(storagePath,
+                            make_table("items",
+                                       make_column("id", &Item::id, primary_key()),
+                                       make_column("name", &Item::name),
+                                       make_column("price", &Item::price, default_value(0))));
+    };
+    auto storage = makeStorage();
+    //  another connection writing while the table is being copied
+    auto writer = make_storage(storagePath,
+                               make_table("items",
+                                          make_column("id", &ItemBefore::id, primary_key()),
+                                          make_column("name", &ItemBefore::name),
+                                          make_column("price", &ItemBefore::price)));
+    REQUIRE(storage.sync_schema_simulate(true).at("items") == sync_schema_result::dropped_and_recreated);
+
+    std::vector<online_migration_progress> reports;
+    online_migration_options options;
+    options.chunk_size = 1000;
+    options.on_progress = [&reports, &writer](const online_migration_progress& progress) {
+        reports.push_back(progress);
+        if(reports.size() == 1) {
+            writer.update_all(set(c(&ItemBefore::name) = "renamed"), where(c(&ItemBefore::id) == 10));
+            writer.remove<ItemBefore>(2000);
+            writer.insert(ItemBefore{0, "new", 7});
+        }
+    };
+    auto result = storage.sync_schema_online(options);
+    REQUIRE(result.at("items") == sync_schema_result::dropped_and_recreated);
+
+    REQUIRE(reports.size() == 3);
+    REQUIRE(reports[0].table == "items");
+    REQUIRE(reports[0].total_rows == 2500);
+    REQUIRE(reports[0].copied_rows == 1000);
+    REQUIRE(reports[2].copied_rows == 2499);
+
+    REQUIRE(storage.count<Item>() == 2500);
+    REQUIRE(storage.get<Item>(10).name == "renamed");
+    REQUIRE_FALSE(storage.get_pointer<Item>(2000));
+    REQUIRE(storage.get<Item>(2501).name == "new");
+    REQUIRE(storage.get<Item>(2500).price == 2500);
+    REQUIRE_FALSE(storage.table_exists("items_backup"));
+    auto schemaStorage = make_storage(storagePath, make_sqlite_schema_table());
+    REQUIRE(schemaStorage.select(&sqlite_master::name, where(c(&sqlite_master::type) == "trigger")).empty());
+    REQUIRE(storage.sync_schema_simulate(true).at("items") == sync_schema_result::already_in_sync);
+}
+
+TEST_CASE("sync_schema_online and extreme rowids") {
+    struct Item {
+        int64 id = 0;
+        int price = 0;
+    };
+    const char* storagePath = "sync_schema_online_rowids.sqlite";
+    ::remove(storagePath);
+    const int64 smallest = std::numeric_limits<int64>::min();
+    const int64 largest = std::numeric_limits<int64>::max();
+    {
+        auto storage = make_storage(
+            storagePath,
+            make_table("items", make_column("id", &Item::id, primary_key()), make_column("price", &Item::price)));
+        storage.sync_schema();
+        storage.replace(Item{smallest, 1});
+        storage.replace(Item{0, 2});
+        storage.replace(Item{largest, 3});
+    }
+    auto storage = make_storage(storagePath,
+                                make_table("items",
+                                           make_column("id", &Item::id, primary_key()),
+                                           make_column("price", &Item::price, default_value(0))));
+    online_migration_options options;
+    options.chunk_size = 1;
+    REQUIRE(storage.sync_schema_online(options).at("items") == sync_schema_result::dropped_and_recreated);
+    REQUIRE(storage.select(&Item::id, order_by(&Item::id)) == std::vector<int64>{smallest, 0, largest});
+}
+
+#if SQLITE_VERSION_NUMBER >= 3014000
+TEST_CASE("sync_schema_if_changed") {
+    struct User {
+        int id = 0;
+        std::string name;
+        int age = 0;
+    };
+    const char* storagePath = "sync_schema_if_changed.sqlite";
+    ::remove(storagePath);
+    auto storage = make_storage(storagePath,
+                                make_index("users_name", &User::name),
+                                make_table("users",
+                                           make_column("id", &User::id, primary_key()),
+                                           make_column("name", &User::name)));
+    int introspections = 0;
+    storage.on_trace(SQLITE_TRACE_STMT, [&introspections](const trace_event& event) {
+        if(std::string(event.sql).find("table_xinfo") != std::string::npos) {
+            ++introspections;
+        }
+    });
+    REQUIRE(storage.sync_schema_if_changed().at("users") == sync_schema_result::new_table_created);
+    REQUIRE(storage.table_exists("_sqlite_orm_schema"));
+
+    introspections = 0;
+    auto result = storage.sync_schema_if_changed();
+    REQUIRE(result.size() == 2);
+    REQUIRE(result.at("users") == sync_schema_result::already_in_sync);
+    REQUIRE(result.at("users_name") == sync_schema_result::already_in_sync);
+    REQUIRE(introspections == 0);
+
+    SECTION("changed mapping") {
+        auto newStorage = make_storage(storagePath,
+                                       make_index("users_name", &User::name),
+                                       make_table("users",
+                                                  make_column("id", &User::id, primary_key()),
+                                                  make_column("name", &User::name),
+                                                  make_column("age", &User::age, default_value(0))));
+        REQUIRE(newStorage.sync_schema_if_changed().at("users") == sync_schema_result::new_columns_added);
+        REQUIRE(newStorage.sync_schema_simulate().at("users") == sync_schema_result::already_in_sync);
+        REQUIRE(storage.sync_schema_if_changed().at("users") == sync_schema_result::old_columns_removed);
+    }
+    SECTION("schema changed outside of the storage") {
+        storage.drop_table("users");
+        REQUIRE(storage.sync_schema_if_changed().at("users") == sync_schema_result::new_table_created);
+        REQUIRE(introspections > 0);
+    }
+}
+#endif
@@ -244,6 +244,22 @@ TEST_CASE("Aggregate functions") {
         auto groupConcat = storage.group_concat(&User::name, where(is_equal(&User::id, 1)));
         REQUIRE(groupConcat == "Bebe Rexha");
     }
+#if SQLITE_VERSION_NUMBER >= 3030000
+    //  several filtered aggregates computed by a single query
+    {
+        auto rows = storage.select(columns(count().filter(where(c(&User::age) < 30)),
+                                           count(&User::id).filter(where(c(&User::age) >= 30)),
+                                           sum(&User::age).filter(where(c(&User::id) > 1)),
+                                           group_concat(&User::name, ", ").filter(where(c(&User::id) != 2))),
+                                   from<User>());
+        REQUIRE(rows.size() == 1);
+        REQUIRE(std::get<0>(rows[0]) == 2);
+        REQUIRE(std::get<1>(rows[0]) == 1);
+        REQUIRE(std::get<2>(rows[0]));
+        REQUIRE(*std::get<2>(rows[0]) == 63);
+        REQUIRE(std::get<3>(rows[0]) == "Bebe Rexha, Cheryl Cole");
+    }
+#endif
 }
 
 TEST_CASE("Open forever") {
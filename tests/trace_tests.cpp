@@ -0,0 +1,122 @@
+#include <sqlite_orm/sqlite_orm.h>
+#include <catch2/catch_all.hpp>
+
+#if SQLITE_VERSION_NUMBER >= 3014000
+using namespace sqlite_orm;
+using Catch::Matchers::ContainsSubstring;
+
+TEST_CASE("on_trace") {
+    struct User {
+        int id = 0;
+        std::string name;
+    };
+    auto storage = make_storage(
+        "",
+        make_table("users", make_column("id", &User::id, primary_key()), make_column("name", &User::name)));
+    storage.sync_schema();
+
+    std::vector<unsigned int> types;
+    std::vector<std::string> statements;
+    storage.on_trace(SQLITE_TRACE_STMT | SQLITE_TRACE_PROFILE | SQLITE_TRACE_ROW,
+                     [&types, &statements](const trace_event& event) {
+                         REQUIRE(event.stmt);
+                         REQUIRE(event.db);
+                         types.push_back(event.type);
+                         if(event.type == SQLITE_TRACE_STMT) {
+                             statements.emplace_back(event.sql);
+                         } else if(event.type == SQLITE_TRACE_PROFILE) {
+                             REQUIRE(event.nanoseconds >= 0);
+                         }
+                     });
+    storage.replace(User{1, "Bebe Rexha"});
+    storage.replace(User{2, "Zara Larsson"});
+    auto rows = storage.get_all<User>();
+    REQUIRE(rows.size() == 2);
+
+    std::vector<unsigned int> expected = {SQLITE_TRACE_STMT,
+                                          SQLITE_TRACE_PROFILE,
+                                          SQLITE_TRACE_STMT,
+                                          SQLITE_TRACE_PROFILE,
+                                          SQLITE_TRACE_STMT,
+                                          SQLITE_TRACE_ROW,
+                                          SQLITE_TRACE_ROW,
+                                          SQLITE_TRACE_PROFILE};
+    REQUIRE(types == expected);
+    REQUIRE(statements.size() == 3);
+    REQUIRE_THAT(statements[2], ContainsSubstring("SELECT"));
+
+    SECTION("remove") {
+        storage.on_trace(0, {});
+        types.clear();
+        storage.get_all<User>();
+        REQUIRE(types.empty());
+    }
+}
+
+TEST_CASE("on_trace survives reconnect") {
+    const std::string filename = "trace_tests.sqlite";
+    ::remove(filename.c_str());
+    struct User {
+        int id = 0;
+        std::string name;
+    };
+    auto storage = make_storage(
+        filename,
+        make_table("users", make_column("id", &User::id, primary_key()), make_column("name", &User::name)));
+    std::vector<unsigned int> types;
+    storage.on_trace(SQLITE_TRACE_PROFILE | SQLITE_TRACE_CLOSE, [&types](const trace_event& event) {
+        types.push_back(event.type);
+    });
+    REQUIRE_FALSE(storage.is_opened());
+    storage.sync_schema();
+    types.clear();
+
+    storage.replace(User{1, "Ava Max"});
+    storage.replace(User{2, "Dua Lipa"});
+    std::vector<unsigned int> expected = {SQLITE_TRACE_PROFILE,
+                                          SQLITE_TRACE_CLOSE,
+                                          SQLITE_TRACE_PROFILE,
+                                          SQLITE_TRACE_CLOSE};
+    REQUIRE(types == expected);
+}
+
+TEST_CASE("slow_query_logger") {
+    struct User {
+        int id = 0;
+        std::string name;
+    };
+    auto storage = make_storage(
+        "",
+        make_table("users", make_column("id", &User::id, primary_key()), make_column("name", &User::name)));
+    storage.sync_schema();
+    std::vector<slow_query> queries;
+    auto sink = [&queries](const slow_query& query) {
+        queries.push_back(query);
+    };
+
+    SECTION("everything is slow") {
+        storage.on_trace(SQLITE_TRACE_PROFILE, slow_query_logger{std::chrono::nanoseconds{0}, sink});
+        storage.replace(User{1, "Rita Ora"});
+        storage.get_all<User>(where(c(&User::name) == "Rita Ora"));
+        REQUIRE(queries.size() == 2);
+        REQUIRE_THAT(queries[1].sql, ContainsSubstring("'Rita Ora'"));
+        REQUIRE(queries[1].vm_step > 0);
+#if SQLITE_VERSION_NUMBER >= 3020000
+        REQUIRE(queries[1].run == 1);
+#endif
+    }
+    SECTION("sampling") {
+        storage.on_trace(SQLITE_TRACE_PROFILE, slow_query_logger{std::chrono::nanoseconds{0}, sink, 2});
+        for(int i = 0; i < 6; ++i) {
+            storage.get_all<User>();
+        }
+        REQUIRE(queries.size() == 3);
+    }
+    SECTION("nothing is slow") {
+        storage.on_trace(SQLITE_TRACE_PROFILE, slow_query_logger{std::chrono::hours{1}, sink});
+        storage.replace(User{1, "Rita Ora"});
+        storage.get_all<User>();
+        REQUIRE(queries.empty());
+    }
+}
+#endif
@@ -344,3 +344,83 @@ TEST_CASE("Transaction guard") {
     }
     ::remove("guard.sqlite");
 }
+
+TEST_CASE("savepoint") {
+    const std::string filename = "savepoint_test.sqlite";
+    ::remove(filename.c_str());
+    auto storage = make_storage(
+        filename,
+        make_table("objects", make_column("id", &Object::id, primary_key()), make_column("name", &Object::name)));
+    storage.sync_schema();
+
+    SECTION("nested in a transaction") {
+        auto guard = storage.transaction_guard();
+        storage.replace(Object{1, "Ada"});
+        {
+            auto savepoint = storage.savepoint("inner");
+            storage.replace(Object{2, "Grace"});
+        }
+        {
+            auto savepoint = storage.savepoint("inner");
+            storage.replace(Object{3, "Barbara"});
+            savepoint.commit();
+        }
+        REQUIRE_FALSE(storage.get_autocommit());
+        guard.commit();
+        REQUIRE(storage.get_all<Object>() == std::vector<Object>{Object{1, "Ada"}, Object{3, "Barbara"}});
+    }
+    SECTION("nested savepoints") {
+        auto outer = storage.savepoint("outer");
+        storage.replace(Object{1, "Ada"});
+        {
+            auto inner = storage.savepoint("inner");
+            storage.replace(Object{2, "Grace"});
+            inner.commit();
+        }
+        outer.rollback();
+        REQUIRE(storage.count<Object>() == 0);
+        REQUIRE(storage.get_autocommit());
+    }
+    SECTION("outside of a transaction") {
+        storage.begin_savepoint("single");
+        storage.replace(Object{1, "Ada"});
+        storage.release_savepoint("single");
+        REQUIRE(storage.count<Object>() == 1);
+        REQUIRE_FALSE(storage.is_opened());
+    }
+    SECTION("unknown savepoint") {
+        REQUIRE_THROWS_AS(storage.release_savepoint("unknown"), std::system_error);
+    }
+}
+
+TEST_CASE("batch_scope") {
+    const std::string filename = "batch_scope_test.sqlite";
+    ::remove(filename.c_str());
+    auto storage = make_storage(
+        filename,
+        make_table("objects", make_column("id", &Object::id, primary_key()), make_column("name", &Object::name)));
+    storage.sync_schema();
+    auto addObject = [&storage](int id, bool succeed) {
+        auto scope = storage.batch_scope();
+        storage.replace(Object{id, "Linus"});
+        if(succeed) {
+            scope.commit();
+        }
+    };
+
+    SECTION("starts a transaction") {
+        addObject(1, true);
+        addObject(2, false);
+        REQUIRE(storage.count<Object>() == 1);
+        REQUIRE_FALSE(storage.is_opened());
+    }
+    SECTION("reuses the outer transaction") {
+        auto guard = storage.transaction_guard();
+        addObject(1, true);
+        REQUIRE_FALSE(storage.get_autocommit());
+        addObject(2, false);
+        addObject(3, true);
+        guard.commit();
+        REQUIRE(storage.get_all<Object>() == std::vector<Object>{Object{1, "Linus"}, Object{3, "Linus"}});
+    }
+}
@@ -0,0 +1,211 @@
+#include <sqlite_orm/sqlite_orm.h>
+#include <catch2/catch_all.hpp>
+#include <cstdio>  //  remove
+#include <stdexcept>  //  std::runtime_error
+
+using namespace sqlite_orm;
+
+namespace {
+    struct Change {
+        int operation = 0;
+        int64 rowid = 0;
+
+        bool operator==(const Change& other) const {
+            return this->operation == other.operation && this->rowid == other.rowid;
+        }
+    };
+}
+
+TEST_CASE("on_change") {
+    struct User {
+        int id = 0;
+        std::string name;
+    };
+    struct Tag {
+        int id = 0;
+        std::string text;
+    };
+    auto storage = make_storage(
+        "",
+        make_table("users", make_column("id", &User::id, primary_key()), make_column("name", &User::name)),
+        make_table("tags", make_column("id", &Tag::id, primary_key()), make_column("text", &Tag::text)));
+    storage.sync_schema();
+    std::vector<Change> changes;
+    storage.on_change<User>([&changes](int operation, int64 rowid) {
+        changes.push_back(Change{operation, rowid});
+    });
+
+    storage.replace(User{1, "Ariana Grande"});
+    storage.replace(User{2, "Billie Eilish"});
+    storage.update(User{2, "Billie"});
+    storage.remove<User>(1);
+    storage.replace(Tag{1, "pop"});
+    std::vector<Change> expected = {Change{SQLITE_INSERT, 1},
+                                    Change{SQLITE_INSERT, 2},
+                                    Change{SQLITE_UPDATE, 2},
+                                    Change{SQLITE_DELETE, 1}};
+    REQUIRE(changes == expected);
+
+    SECTION("remove") {
+        storage.on_change<User>({});
+        changes.clear();
+        storage.replace(User{3, "Halsey"});
+        REQUIRE(changes.empty());
+    }
+    SECTION("rename_table") {
+        storage.rename_table("users", "singers");
+        storage.rename_table<User>("singers");
+        changes.clear();
+        storage.replace(User{3, "Halsey"});
+        expected = {Change{SQLITE_INSERT, 3}};
+        REQUIRE(changes == expected);
+    }
+}
+
+TEST_CASE("on_change survives reconnect") {
+    const std::string filename = "update_hook_tests.sqlite";
+    ::remove(filename.c_str());
+    struct User {
+        int id = 0;
+        std::string name;
+    };
+    struct Tag {
+        int id = 0;
+        std::string text;
+    };
+    auto storage = make_storage(
+        filename,
+        make_table("users", make_column("id", &User::id, primary_key()), make_column("name", &User::name)),
+        make_table("tags", make_column("id", &Tag::id, primary_key()), make_column("text", &Tag::text)));
+    storage.sync_schema();
+    std::vector<Change> changes;
+    storage.on_change<Tag>([&changes](int operation, int64 rowid) {
+        changes.push_back(Change{operation, rowid});
+    });
+    REQUIRE_FALSE(storage.is_opened());
+    storage.replace(Tag{5, "rock"});
+    storage.remove<Tag>(5);
+    std::vector<Change> expected = {Change{SQLITE_INSERT, 5}, Change{SQLITE_DELETE, 5}};
+    REQUIRE(changes == expected);
+
+    storage.clear_change_callbacks();
+    storage.replace(Tag{6, "jazz"});
+    REQUIRE(changes.size() == 2);
+}
+
+TEST_CASE("on_change tells schemas apart") {
+    struct User {
+        int id = 0;
+        std::string name;
+    };
+    struct ArchivedUser {
+        int id = 0;
+        std::string name;
+    };
+    const std::string filename = "update_hook_tests.sqlite";
+    const std::string archiveFilename = "update_hook_tests_archive.sqlite";
+    ::remove(filename.c_str());
+    ::remove(archiveFilename.c_str());
+    auto storage = make_storage(
+        filename,
+        make_table("users", make_column("id", &User::id, primary_key()), make_column("name", &User::name)),
+        make_table("users",
+                   make_column("id", &ArchivedUser::id, primary_key()),
+                   make_column("name", &ArchivedUser::name))
+            .in_schema("archive"));
+    storage.attach(archiveFilename, "archive");
+    storage.sync_schema();
+    std::vector<Change> changes;
+    std::vector<Change> archivedChanges;
+    storage.on_change<User>([&changes](int operation, int64 rowid) {
+        changes.push_back(Change{operation, rowid});
+    });
+    storage.on_change<ArchivedUser>([&archivedChanges](int operation, int64 rowid) {
+        archivedChanges.push_back(Change{operation, rowid});
+    });
+
+    storage.replace(User{1, "Adele"});
+    storage.replace(ArchivedUser{7, "Cher"});
+    storage.remove<ArchivedUser>(7);
+    std::vector<Change> expected = {Change{SQLITE_INSERT, 1}};
+    std::vector<Change> archivedExpected = {Change{SQLITE_INSERT, 7}, Change{SQLITE_DELETE, 7}};
+    REQUIRE(changes == expected);
+    REQUIRE(archivedChanges == archivedExpected);
+}
+
+TEST_CASE("on_change rethrows exceptions after the statement") {
+    struct User {
+        int id = 0;
+        std::string name;
+    };
+    auto storage = make_storage(
+        "",
+        make_table("users", make_column("id", &User::id, primary_key()), make_column("name", &User::name)));
+    storage.sync_schema();
+    int callsCount = 0;
+    storage.on_change<User>([&callsCount](int, int64 rowid) {
+        ++callsCount;
+        if(rowid == 1) {
+            throw std::runtime_error("rejected");
+        }
+    });
+
+    REQUIRE_THROWS_WITH(storage.replace(User{1, "Dua Lipa"}), "rejected");
+    //  the change isn't undone
+    REQUIRE(storage.count<User>() == 1);
+    storage.replace(User{2, "Rosalia"});
+    //  the statement isn't aborted by the first exception
+    REQUIRE_THROWS_WITH(storage.update_all(set(c(&User::name) = "Kylie")), "rejected");
+    REQUIRE(callsCount == 4);
+    REQUIRE(storage.count<User>(where(c(&User::name) == "Kylie")) == 2);
+    REQUIRE_NOTHROW(storage.remove<User>(2));
+}
+
+#ifdef SQLITE_ENABLE_PREUPDATE_HOOK
+TEST_CASE("on_preupdate") {
+    struct User {
+        int id = 0;
+        std::string name;
+    };
+    struct Tag {
+        int id = 0;
+        std::string text;
+    };
+    auto storage = make_storage(
+        "",
+        make_table("users", make_column("id", &User::id, primary_key()), make_column("name", &User::name)),
+        make_table("tags", make_column("id", &Tag::id, primary_key()), make_column("text", &Tag::text)));
+    storage.sync_schema();
+    storage.replace(User{1, "Lorde"});
+    std::vector<std::string> log;
+    storage.on_preupdate<User>([&log](const preupdate_change<User>& change) {
+        std::string entry = std::to_string(change.operation) + ":";
+        if(change.old_object) {
+            entry += change.old_object->name;
+        }
+        entry += "->";
+        if(change.new_object) {
+            entry += change.new_object->name;
+        }
+        log.push_back(std::move(entry));
+    });
+
+    storage.update(User{1, "Ella"});
+    storage.replace(User{2, "Sia"});
+    //  truncate optimization doesn't suppress the pre-update hook
+    storage.remove_all<User>();
+    std::vector<std::string> expected = {std::to_string(SQLITE_UPDATE) + ":Lorde->Ella",
+                                         std::to_string(SQLITE_INSERT) + ":->Sia",
+                                         std::to_string(SQLITE_DELETE) + ":Ella->",
+                                         std::to_string(SQLITE_DELETE) + ":Sia->"};
+    REQUIRE(log == expected);
+
+    SECTION("exception") {
+        storage.on_preupdate<User>([](const preupdate_change<User>&) {
+            throw std::runtime_error("rejected");
+        });
+        REQUIRE_THROWS_WITH(storage.replace(User{3, "Tove Lo"}), "rejected");
+        REQUIRE(storage.count<User>() == 1);
+    }
+}
+#endif